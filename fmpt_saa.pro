@@ -21,15 +21,21 @@ CONFIG   -= app_bundle
 
 TEMPLATE = app
 
+## descomentar para compilar los contadores de llamadas y tiempos (Profiler.h)
+##DEFINES += FMPT_PROFILE
+
 
 SOURCES += \
     src/VCLemu.cpp \
     src/Exceptions.cpp \
+    src/Profiler.cpp \
+    src/Workers.cpp \
     #---------------------------------------------------------
     src/Constants.cpp \
     src/Scalars.cpp \
     src/Vectors.cpp \
     src/Geometry.cpp \
+    src/SpatialGrid.cpp \
     #---------------------------------------------------------
     src/Strings.cpp \
     src/StrPR.cpp \
@@ -68,6 +74,7 @@ SOURCES += \
     src/RoboticPositionerList1.cpp \
     src/RoboticPositionerList2.cpp \
     src/RoboticPositionerList3.cpp \
+    src/CollisionFreeSampler.cpp \
     #---------------------------------------------------------
     src/FiberMOSModel.cpp \
     src/FiberConnectionModel.cpp \
@@ -81,6 +88,7 @@ SOURCES += \
     src/Allocation.cpp \
     src/AllocationList.cpp \
     src/MotionProgramValidator.cpp \
+    src/ClearanceTrace.cpp \
     src/MotionProgramGenerator.cpp \
     #---------------------------------------------------------
     src/PositionerCenter.cpp \
@@ -94,11 +102,14 @@ SOURCES += \
 HEADERS += \
     src/VCLemu.h \
     src/Exceptions.h \
+    src/Profiler.h \
+    src/Workers.h \
     #---------------------------------------------------------
     src/Constants.h \
     src/Scalars.h \
     src/Vectors.h \
     src/Geometry.h \
+    src/SpatialGrid.h \
     #---------------------------------------------------------
     src/Strings.h \
     src/StrPR.h \
@@ -139,6 +150,7 @@ HEADERS += \
     src/RoboticPositionerList1.h \
     src/RoboticPositionerList2.h \
     src/RoboticPositionerList3.h \
+    src/CollisionFreeSampler.h \
     #---------------------------------------------------------
     src/FiberMOSModel.h \
     src/FiberConnectionModel.h \
@@ -152,6 +164,7 @@ HEADERS += \
     src/Allocation.h \
     src/AllocationList.h \
     src/MotionProgramValidator.h \
+    src/ClearanceTrace.h \
     src/MotionProgramGenerator.h \
     #---------------------------------------------------------
     src/PositionerCenter.h \
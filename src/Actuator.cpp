@@ -27,6 +27,7 @@
 #include "Strings.h"
 #include "RoboticPositioner.h"
 #include "TextFile.h"
+#include "Profiler.h"
 
 #include <algorithm> //std::min, std::max
 
@@ -647,9 +648,12 @@ void TActuator::setId(int Id)
 
     //ADVERTENCIA: está permitida la duplicidad de números de identificación Id.
 
-    p_Id = Id; //asigna el nuevo valor
+    assignId(Id); //asigna el nuevo valor
 }
 
+//number of changes of the identifiers of all actuators
+std::atomic<unsigned int> TActuator::IdsVersion(0);
+
 //--------------------------------------------------------------------------
 //PROPIEDADES DE ÁREA:
 
@@ -1675,7 +1679,7 @@ void TActuator::copyStatus(const TActuator *A)
     p_PAkd = A->p_PAkd;
     p_Purpose = A->p_Purpose;
 
-    p_Id = A->p_Id;
+    assignId(A->p_Id);
     AdjacentEAs.Clone(A->AdjacentEAs);
     AdjacentRPs.Clone(A->AdjacentRPs);
     Pending = A->Pending;
@@ -1736,7 +1740,8 @@ void TActuator::clone(const TActuator *A)
 
 //vuilda clone of an actuator
 TActuator::TActuator(const TActuator *A) :
-    TCilinder(A) //clone the cilinder
+    TCilinder(A), //clone the cilinder
+    p_Id(A!=NULL ? A->p_Id : 0) //a new actuator does not change an Id
 {
     //check the precondition
     if(A == NULL)
@@ -1965,7 +1970,7 @@ void TActuator::setOrigins(int Id, double x0, double y0, double thetaO1)
         throw EImproperArgument("identificator number Idshould beupper zero");
 
     //asigna los nuevos valores
-    p_Id = Id;
+    assignId(Id);
     p_P0.x = x0;
     p_P0.y = y0;
     p_thetaO1 = thetaO1;
@@ -2062,7 +2067,7 @@ void TActuator::setPositionP3(int Id, double x3, double y3)
         throw EImproperFileLoadedValue(AnsiString("point to assign should be in the domine of the RP ")+IntToStr(Id));
 
     //asigna el identificador
-    p_Id = Id;
+    assignId(Id);
     //asigna el punto
     setAnglesRadians(theta_1, theta___3);
 }
@@ -2827,9 +2832,15 @@ bool TActuator::notInvadeManeuveringDomain(const TActuator *A) const
 //MÉTODOS PARA DETERMINAR LAS COLISIONES
 //CON ACTUADORES ADYACENTES:
 
+//number of distances calculated by the methods distanceMin
+//in this thread, for get the statistics without share counters
+static thread_local unsigned long long Ndistances_thread = 0;
+
 //determina la distancia mínima con una EA
 double TActuator::distanceMin(const TExclusionArea *EA)
 {
+    PROFILE_SCOPE(pfActuatorDistanceMin);
+
     //comprueba las precondiciones
     if(EA == NULL)
         throw EImproperArgument("pointer EA should point to built exclusion area");
@@ -2845,6 +2856,7 @@ double TActuator::distanceMin(const TExclusionArea *EA)
 
     //calcula la distancia con la barrera del EA
     double dm = distanceMin(&(EA->Barrier));
+    Ndistances_thread++;
 
     //actualiza la distancia mínima
     if(dm < AdjacentEAs[i].Dmin)
@@ -2857,6 +2869,8 @@ double TActuator::distanceMin(const TExclusionArea *EA)
 //determina la distancia mínima con un actuador
 double TActuator::distanceMin(const TActuator *Actuator)
 {
+    PROFILE_SCOPE(pfActuatorDistanceMin);
+
     //comprueba las precondiciones
     if(Actuator == NULL)
         throw EImproperArgument("pointer Actuator should point to built barrier");
@@ -2881,6 +2895,7 @@ double TActuator::distanceMin(const TActuator *Actuator)
     }
     else
         dm = distanceMin(Actuator->getBarrier());
+    Ndistances_thread++;
 
     //actualiza la distancia mínima
     if(dm < AdjacentRPs[i].Dmin)
@@ -2890,6 +2905,51 @@ double TActuator::distanceMin(const TActuator *Actuator)
 
     return dm;
 }
+//determine the minimun distance with the RP of a slot of AdjacentRPs,
+//reusing the distance of the edge of the slot if it is calculated
+double TActuator::distanceMin(TAdjacentRP& ARP)
+{
+    PROFILE_SCOPE(pfActuatorDistanceMin);
+
+    //check the precondition
+    if(ARP.RP == NULL)
+        throw EImproperArgument("adjacent RP ARP should has an attached RP");
+
+    //calculates the minimun distance or get it from the edge
+    double dm;
+    TAdjacencyEdge *E = ARP.Edge;
+    if(E!=NULL && E->calculated)
+        dm = E->D;
+    else {
+        //calcula la distancia mínima
+        //con el brazo o la barrera, en función de PAkd
+        dm = distance(ARP.RP->getActuator());
+        Ndistances_thread++;
+
+        //store the distance in the edge for the symmetric slot
+        if(E != NULL) {
+            E->D = dm;
+            E->calculated = true;
+        }
+    }
+
+    //The method distance calculates the minimun in both senses,
+    //so the distance is the same for both slots of the edge.
+
+    //actualiza la distancia mínima
+    if(dm < ARP.Dmin)
+        ARP.Dmin = dm;
+    //actualiza la distancia final
+    ARP.Dend = dm;
+
+    return dm;
+}
+//get the number of distances calculated by the methods distanceMin
+//in the current thread
+unsigned long long TActuator::getNdistances(void)
+{
+    return Ndistances_thread;
+}
 
 //determina si hay colisión con una EA
 bool TActuator::thereIsCollision(const TExclusionArea *EA)
@@ -29,6 +29,8 @@
 #include "Constants.h"
 #include "adjacentitem.h"
 
+#include <atomic>
+
 //---------------------------------------------------------------------------
 
 //espacio de nombres de modelos
@@ -169,6 +171,12 @@ protected:
 
     int p_Id;
 
+    //number of changes of the identifiers of all actuators
+    static std::atomic<unsigned int> IdsVersion;
+    //assign the identifier, counting the change
+    void assignId(int Id) {
+        if(Id != p_Id) {p_Id = Id; IdsVersion++;}}
+
     //COTAS ÚTILES:
 
     double p_r_min;
@@ -418,6 +426,11 @@ public:
     int getId(void) const {return p_Id;}
     void setId(int);
 
+    //number of changes of the identifiers of all actuators
+    //used by the lists of RPs to detect that their index of identifiers
+    //is out of date
+    static unsigned int getIdsVersion(void) {return IdsVersion;}
+
     //El número de identificación debe ser una propiedad del actuador
     //para que los actuadores adyacentes puedan ser identificados.
 
@@ -995,6 +1008,16 @@ public:
     double distanceMin(const TExclusionArea*);
     //determina la distancia mínima con un actuador
     double distanceMin(const TActuator*);
+    //determine the minimun distance with the RP of a slot of AdjacentRPs,
+    //reusing the distance of the edge of the slot if it is calculated
+    //Precondition:
+    //  the edges of the slots shall be invalidated each time that
+    //  the RPs are moved.
+    double distanceMin(TAdjacentRP&);
+    //get the number of distances calculated by the methods distanceMin
+    //in the current thread (the distances reused from the edges
+    //are not counted)
+    static unsigned long long getNdistances(void);
 
     //determina si hay colisión con un EA
     bool thereIsCollision(const TExclusionArea*);
@@ -26,6 +26,7 @@
 #include "Geometry.h"
 #include "Strings.h" //StrTrim
 #include "StrPR.h" //StrReadInt
+#include <mutex> //mutex, lock_guard
 
 using namespace Strings;
 
@@ -43,6 +44,8 @@ namespace Positioning {
 
 //list of built objects
 TItemsList<TAllocation*> TAllocation::Builts;
+//mutex for access to the list of built objects from several threads
+static mutex Builts_mutex;
 
 //---------------------------------------------------------------------------
 //PROPERTIES IN TEXT FORMAT:
@@ -205,6 +208,7 @@ TAllocation::TAllocation(TRoboticPositioner *t_RP, double x, double y)
     //check the preconditions
     if(t_RP == NULL)
         throw EImproperArgument("pointer RP should point to built robotic positioner");
+    lock_guard<mutex> lock(Builts_mutex);
     for(int i=0; i<Builts.getCount(); i++)
         if(t_RP == Builts[i]->getRP())
             throw EImproperArgument("robotic positioner RP should not be allocated to an previously built allocation");
@@ -222,6 +226,7 @@ TAllocation::TAllocation(TRoboticPositioner *t_RP, TDoublePoint t_PP)
     //check the preconditions
     if(t_RP == NULL)
         throw EImproperArgument("pointer RP should point to built robotic positioner");
+    lock_guard<mutex> lock(Builts_mutex);
     for(int i=0; i<Builts.getCount(); i++)
         if(t_RP == Builts[i]->getRP())
             throw EImproperArgument("robotic positioner RP should not be allocated to an previously built allocation");
@@ -238,6 +243,8 @@ TAllocation::TAllocation(TRoboticPositioner *t_RP, TDoublePoint t_PP)
 //  throw an exception EImproperCall
 TAllocation::~TAllocation()
 {
+    lock_guard<mutex> lock(Builts_mutex);
+
     //debe haber algún punto objetivo construido
     if(Builts.getCount() < 1)
         throw EImproperCall("should be some allocation built");
@@ -300,6 +307,25 @@ void TAllocation::RandomizePP(void)
 //if the the projection point isn't on the domain of its attached RP:
 //  throw an exception EImpropercall
 double TAllocation::MoveToPP(void)
+{
+    //determines the stable position more closer to the projection point
+    //and determines the distance from the stable position to the projection point
+    double p_1nsp, p___3nsp;
+    double d = getStablePositionForPP(p_1nsp, p___3nsp);
+
+    //assign the positions to the rotors
+    RP->getActuator()->setAnglesSteps(p_1nsp, p___3nsp);
+
+    //returns the distance from the target point to the projection point
+    return d;
+}
+
+//determine the stable position of the rotors of the attached RP
+//which places the point P3 as close as possible to the PP,
+//and return the distance from the stable position to the PP
+//if the the projection point isn't on the domain of its attached RP:
+//  throw an exception EImpropercall
+double TAllocation::getStablePositionForPP(double& p_1nsp, double& p___3nsp)
 {
     //determines if the projection point is in the domain of the attached RP
     //and calculates the position angles of the rotors
@@ -312,14 +338,8 @@ double TAllocation::MoveToPP(void)
 
     //determines the stable position more closer to the projection point
     //and determines the distance from the stable position to the projection point
-    double p_1nsp, p___3nsp;
-    double d = RP->getActuator()->getNearestStablePosition(p_1nsp, p___3nsp, theta_1, theta___3);
-
-    //assign the positions to the rotors
-    RP->getActuator()->setAnglesSteps(p_1nsp, p___3nsp);
-
-    //returns the distance from the target point to the projection point
-    return d;
+    //(without move the rotors)
+    return RP->getActuator()->getNearestStablePosition(p_1nsp, p___3nsp, theta_1, theta___3);
 }
 
 //---------------------------------------------------------------------------
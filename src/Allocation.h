@@ -177,6 +177,15 @@ public:
         /// @exception EImpropercall if the the projection point
         /// isn't in the domain of its attached RP.
         double MoveToPP(void);
+        /// @brief Determine the stable position of the rotors of the attached RP
+        /// which places the point P3 as close as possible to the PP,
+        /// and return the distance from the stable position to the PP.
+        /// @brief This method does not move the rotors of the RP
+        /// (MoveToPP = getStablePositionForPP + setAnglesSteps),
+        /// so it can be invoked concurrently for different allocations.
+        /// @exception EImpropercall if the the projection point
+        /// isn't in the domain of its attached RP.
+        double getStablePositionForPP(double& p_1nsp, double& p___3nsp);
 };
 
 //---------------------------------------------------------------------------
@@ -24,6 +24,13 @@
 
 #include "AllocationList.h"
 #include "Strings.h"
+#include "Workers.h"
+
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <exception> //exception_ptr
+#include <vector>
 
 //---------------------------------------------------------------------------
 
@@ -162,7 +169,8 @@ void TAllocationList::setAllocationsText(AnsiString &S)
 //construye una lista de puntos objetivo
 //adscrita a una lista de RPs
 TAllocationList::TAllocationList(TRoboticPositionerList *RPL) :
-    TItemsList<TAllocation*>(100, TAllocation::CompareIds)
+    TItemsList<TAllocation*>(100, TAllocation::CompareIds),
+    Nthreads(0)
 {
     //el puntero RoboticPositionerList debería apuntar a una lista de RPs contruida
     if(RPL == NULL)
@@ -394,14 +402,12 @@ void TAllocationList::RandomizeWithoutCollision(void)
     }
 }
 
-//asigna los puntos objetivo
-//al punto P3 de sus posicionadores adscritos
-//si algún punto objetivo no está en el dominio de
-//su posicionador adscrito lanza EImproperCall
-//de todos los posicionadores de la lista
-void TAllocationList::MoveToTargetP3(void)
+//determine the stable positions of all allocations of the list
+//in Nthreads threads, and assign them to the RPs in the order of the list
+//if times != NULL, store in times the time (in seconds) spent computing
+//the stable position of each allocation
+void TAllocationList::MoveToTargetP3Batch(TVector<double> *times)
 {
-    try {
     //comprueba las precondiciones
     TVector<int> indices;
     searchOutDomineTAllocations(indices);
@@ -415,15 +421,88 @@ void TAllocationList::MoveToTargetP3(void)
         throw EImproperCall(AnsiString("there is some allocation out of the scope of their atached RP: ")+Ids.getText());
     }
 
-    //para cada punto objetivo de la lista
-    for(int i=0; i<getCount(); i++)
-        //asigna el punto objetivo a su RP adscrito
-        Items[i]->MoveToPP();
+    //COMPUTE THE STABLE POSITIONS:
+
+    //The RPs are not checked for collisions at this stage, and
+    //TAllocation::getStablePositionForPP does not move the rotors,
+    //so the stable positions can be computed concurrently.
+
+    //determines the number of threads
+    int N = Workers::getNworkers(Nthreads, getCount());
+
+    //stable positions and computing times of each allocation
+    vector<double> p_1s(getCount()), p___3s(getCount());
+    vector<double> dts(getCount(), 0);
+    vector<exception_ptr> errors(getCount());
+
+    //computes the stable position of the allocations
+    atomic<int> next(0);
+    auto compute = [&]() {
+        int i;
+        while((i = next++) < getCount()) {
+            chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+            try {
+                Items[i]->getStablePositionForPP(p_1s[i], p___3s[i]);
+            }
+            catch(...) {
+                errors[i] = current_exception();
+            }
+            chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+            dts[i] = chrono::duration<double>(t1 - t0).count();
+        }
+    };
+    if(N <= 1)
+        compute();
+    else {
+        vector<thread> workers;
+        for(int w=0; w<N; w++)
+            workers.push_back(thread([&]() {
+                Workers::setWorker(true);
+                compute();
+            }));
+        for(unsigned int w=0; w<workers.size(); w++)
+            workers[w].join();
+    }
+
+    //ASSIGN THE STABLE POSITIONS:
+
+    //assign the positions in the order of the list,
+    //until the first allocation which has failed
+    try {
+        for(int i=0; i<getCount(); i++) {
+            if(errors[i])
+                rethrow_exception(errors[i]);
+            Items[i]->getRP()->getActuator()->setAnglesSteps(p_1s[i], p___3s[i]);
+        }
     }
     catch(Exception& E) {
         E.Message.Insert(1, "moving the RPs to their attached target points: ");
         throw;
     }
+
+    //return the computing times in case of required
+    if(times != NULL) {
+        times->Clear();
+        for(int i=0; i<getCount(); i++)
+            times->Add(dts[i]);
+    }
+}
+
+//asigna los puntos objetivo
+//al punto P3 de sus posicionadores adscritos
+//si algún punto objetivo no está en el dominio de
+//su posicionador adscrito lanza EImproperCall
+//de todos los posicionadores de la lista
+void TAllocationList::MoveToTargetP3(void)
+{
+    MoveToTargetP3Batch(NULL);
+}
+//assign the target points to the point P3 of their attached RPs
+//and get the time (in seconds) spent computing the stable position
+//of each allocation
+void TAllocationList::MoveToTargetP3(TVector<double>& times)
+{
+    MoveToTargetP3Batch(&times);
 }
 
 /// @brief Get the Final Position List from a Initial Position List.
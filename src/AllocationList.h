@@ -50,7 +50,20 @@ class TAllocationList : public TItemsList<TAllocation*> {
 protected:
         TRoboticPositionerList *RoboticPositionerList;
 
+        /// @brief Determine the stable positions of all allocations
+        /// of the list in Nthreads threads, and assign them to the RPs
+        /// in the order of the list.
+        /// @brief If times != NULL, the time (in seconds) spent computing
+        /// the stable position of each allocation, will be stored in times.
+        void MoveToTargetP3Batch(TVector<double> *times);
+
 public:
+        /// @brief number of threads for the parallel phases
+        /// (MoveToTargetP3 and the ones of the derived classes)
+        /// - if zero, it will be taken the number of hardware threads
+        /// - default value: 0
+        unsigned int Nthreads;
+
         /// Get the extern-attached RP list.
         TRoboticPositionerList *getRoboticPositionerList(void) const {
             return RoboticPositionerList;}
@@ -116,6 +129,13 @@ public:
         /// @exception EImproperCall if there is some projection point
         /// out of the P3-domain of their allocated RP.
         void MoveToTargetP3(void);
+        /// @brief For all allocations of the list, set the projection point
+        /// to the P3 of the attached RP, and get the time (in seconds)
+        /// spent computing the stable position of each allocation.
+        /// @brief
+        /// @exception EImproperCall if there is some projection point
+        /// out of the P3-domain of their allocated RP.
+        void MoveToTargetP3(TVector<double>& times);
 
         //NOTA: cuando un punto es asignado al punto P3 de un posicionador
         //cuya cuantificación está activada, cada rotor se moverá a
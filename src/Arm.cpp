@@ -26,9 +26,12 @@
 #include "Constants.h"
 #include "Strings.h"
 #include "TextFile.h"
+#include "Profiler.h"
 
 #include <math.h>
 #include <algorithm> //std::min, std::max
+#include <string.h> //memcpy
+#include <stdint.h> //uint64_t
 
 //---------------------------------------------------------------------------
 
@@ -37,6 +40,124 @@ using namespace Strings;
 //namespace for models
 namespace Models {
 
+//---------------------------------------------------------------------------
+//TArmImageCache
+//---------------------------------------------------------------------------
+
+//obtiene el índice de la entrada correspondiente a una clave
+unsigned int TArmImageCache::indexOf(double theta2, TDoublePoint P1) const
+{
+    //mezcla los bits de las componentes de la clave
+    double key[3] = {theta2, P1.x, P1.y};
+    uint64_t h = 0;
+    for(int i=0; i<3; i++) {
+        uint64_t x;
+        memcpy(&x, &key[i], sizeof(x));
+        h ^= x + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+
+    return (unsigned int)(h%Capacity);
+}
+
+void TArmImageCache::setCapacity(unsigned int t_Capacity)
+{
+    clear();
+    Capacity = t_Capacity;
+}
+
+//número máximo de entradas de todas las tablas
+unsigned int TArmImageCache::Budget = 16384;
+//número de entradas reservadas por las tablas construidas
+std::atomic<unsigned int> TArmImageCache::Reserved(0);
+
+//construye una caché vacía deshabilitada
+TArmImageCache::TArmImageCache(void) :
+    Entries(), Used(), Capacity(0), Lookups(0), Hits(0)
+{
+}
+//construye una caché vacía con la capacidad de otra
+TArmImageCache::TArmImageCache(const TArmImageCache& ImageCache) :
+    Entries(), Used(), Capacity(ImageCache.Capacity), Lookups(0), Hits(0)
+{
+}
+//asigna la capacidad de otra caché, vaciando esta
+TArmImageCache& TArmImageCache::operator=(const TArmImageCache& ImageCache)
+{
+    setCapacity(ImageCache.Capacity);
+    return *this;
+}
+//libera la tabla
+TArmImageCache::~TArmImageCache()
+{
+    clear();
+}
+
+//vacía la caché y libera su tabla
+void TArmImageCache::clear(void)
+{
+    //devuelve las entradas de la tabla al presupuesto global
+    if(!Used.empty())
+        Reserved -= Capacity;
+
+    //libera la memoria de la tabla
+    vector<TArmImage>().swap(Entries);
+    vector<bool>().swap(Used);
+    Lookups = 0;
+    Hits = 0;
+}
+
+//busca la imagen correspondiente a la posición (P1, theta2)
+//si no la encuentra devuelve NULL
+const TArmImage *TArmImageCache::find(double theta2, TDoublePoint P1)
+{
+    if(Capacity == 0)
+        return NULL;
+
+    Lookups++;
+    if(Used.empty())
+        return NULL;
+
+    unsigned int i = indexOf(theta2, P1);
+    if(!Used[i])
+        return NULL;
+
+    const TArmImage& I = Entries[i];
+    if(I.theta2!=theta2 || I.P1!=P1)
+        return NULL;
+
+    Hits++;
+    return &I;
+}
+//obtiene la entrada donde debe almacenarse la imagen
+//de la posición (P1, theta2), asignándole la clave
+TArmImage *TArmImageCache::insert(double theta2, TDoublePoint P1)
+{
+    if(Capacity == 0)
+        return NULL;
+
+    //construye la tabla en el primer uso,
+    //si cabe en el presupuesto global
+    if(Used.empty()) {
+        unsigned int n = Reserved.fetch_add(Capacity);
+        if(n + Capacity > Budget) {
+            Reserved -= Capacity;
+            return NULL;
+        }
+        Entries.resize(Capacity);
+        Used.resize(Capacity, false);
+    }
+
+    unsigned int i = indexOf(theta2, P1);
+    Used[i] = true;
+    TArmImage& I = Entries[i];
+    I.theta2 = theta2;
+    I.P1 = P1;
+    return &I;
+}
+
 //---------------------------------------------------------------------------
 //TArm
 //---------------------------------------------------------------------------
@@ -77,6 +198,9 @@ void TArm::processateTemplate(void)
     P__3.x = L13*cos(theta__3);
     P__3.y = L13*sin(theta__3);
 
+    //las imágenes almacenadas corresponden a la plantilla anterior
+    ImageCache.clear();
+
     //contruye el contorno del brazo a partir de la plantilla
     Destroy(Contour__);
     Contour__.Copy(Contour____);
@@ -165,8 +289,21 @@ void TArm::processateF(void)
 //  {Contour, V}
 void TArm::calculateImage(void)
 {
-    //calcula los coeficientes de rotación de theta2
+    PROFILE_SCOPE(pfArmCalculateImage);
+
     double theta = gettheta2();
+
+    //si la imagen está en la caché, la restaura
+    const TArmImage *I = ImageCache.find(theta, P1);
+    if(I != NULL) {
+        P2 = I->P2;
+        P3 = I->P3;
+        V = I->V;
+        Contour.setFlatImage(I->Contour);
+        return;
+    }
+
+    //calcula los coeficientes de rotación de theta2
     const double COS = cos(theta);
     const double SIN = sin(theta);
 
@@ -182,6 +319,15 @@ void TArm::calculateImage(void)
     //rota y traslada el punto V
     V.x = V__.x*COS - V__.y*SIN + P1.x;
     V.y = V__.x*SIN + V__.y*COS + P1.y;
+
+    //almacena la imagen en la caché
+    TArmImage *J = ImageCache.insert(theta, P1);
+    if(J != NULL) {
+        J->P2 = P2;
+        J->P3 = P3;
+        J->V = V;
+        Contour.getFlatImage(J->Contour);
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -217,6 +363,9 @@ void TArm::setP__2(const TDoublePoint& t_P__2)
 
     P__2 = t_P__2; //asigna el nuevo valor
 
+    //las imágenes almacenadas corresponden a la plantilla anterior
+    ImageCache.clear();
+
     //asimila P__2
     L12 = P__2.Mod();
     double aux = gettheta2();
@@ -277,6 +426,9 @@ void TArm::setP__3(const TDoublePoint& t_P__3)
 
     P__3 = t_P__3; //asigna el nuevo valor
 
+    //las imágenes almacenadas corresponden a la plantilla anterior
+    ImageCache.clear();
+
     //asimila las propiedades de plantilla
     L13 = P__3.Mod();
     theta__3 = P__3.Arg();
@@ -1707,6 +1859,9 @@ void TArm::clone(TArm *Arm)
     P1 = Arm->getP1();
     SPM = Arm->getSPM();
 
+    //copia la capacidad de la caché de imágenes, pero no su contenido
+    ImageCache.setCapacity(Arm->ImageCache.getCapacity());
+
     //copia las propiedades de localización de solo lectura
     P2 = Arm->getP2();
     P3 = Arm->getP3();
@@ -30,6 +30,10 @@
 #include "Function.h"
 #include "FiberMOSModelConstants.h"
 #include "Constants.h"
+#include "ContourFigureList.h"
+
+#include <vector>
+#include <atomic>
 
 //---------------------------------------------------------------------------
 
@@ -41,6 +45,99 @@ using namespace Lists;
 namespace Models {
 
 //---------------------------------------------------------------------------
+//---------------------------------------------------------------------------
+//TArmImageCache
+//---------------------------------------------------------------------------
+
+//imagen del brazo en S0 para una posición (P1, theta2)
+struct TArmImage {
+    //posición del brazo (clave de la imagen)
+    double theta2;
+    TDoublePoint P1;
+
+    //puntos y contorno del brazo en S0
+    TDoublePoint P2;
+    TDoublePoint P3;
+    TDoublePoint V;
+    TFlatImage Contour;
+
+    //construye una imagen vacía
+    TArmImage(void) : theta2(0), P1(0, 0), P2(0, 0), P3(0, 0), V(0, 0),
+        Contour() {}
+};
+
+//clase caché de imágenes del brazo
+//Como los rotores están cuantificados, las posiciones (P1, theta2)
+//que puede adoptar un brazo son finitas, y las búsquedas de posiciones
+//vuelven una y otra vez a las mismas. La caché es una tabla de acceso
+//directo de tamaño acotado, que se construye en el primer uso,
+//y donde cada nueva imagen reemplaza a la que ocupa su entrada.
+//Las claves se comparan con igualdad exacta, de modo que una imagen
+//restaurada es idéntica a la imagen calculada.
+//La caché está deshabilitada por defecto. Las tablas de todas
+//las cachés reservan sus entradas de un presupuesto global,
+//de modo que la memoria total queda acotada aunque se habilite
+//la caché en todos los brazos; cuando el presupuesto se agota,
+//las cachés que no han podido construir su tabla no almacenan imágenes.
+//La caché es propia de cada brazo, porque la imagen en S0 depende
+//de la posición P1 del RP, y no puede compartirse entre brazos
+//con la misma plantilla.
+class TArmImageCache {
+    //número máximo de entradas de todas las tablas
+    static unsigned int Budget;
+    //número de entradas reservadas por las tablas construidas
+    static std::atomic<unsigned int> Reserved;
+
+    //entradas de la tabla y sus flags de ocupación
+    vector<TArmImage> Entries;
+    vector<bool> Used;
+    //número de entradas de la tabla (0 si la caché está deshabilitada)
+    unsigned int Capacity;
+
+    //obtiene el índice de la entrada correspondiente a una clave
+    unsigned int indexOf(double theta2, TDoublePoint P1) const;
+
+public:
+    //número máximo de entradas de todas las tablas
+    //valor por defecto: 16384
+    static unsigned int getBudget(void) {return Budget;}
+    static void setBudget(unsigned int t_Budget) {Budget = t_Budget;}
+    //número de entradas reservadas por las tablas construidas
+    static unsigned int getReserved(void) {return Reserved;}
+
+    //número de búsquedas y de aciertos desde la última limpieza
+    unsigned int Lookups;
+    unsigned int Hits;
+
+    //número de entradas de la tabla
+    //si es cero la caché está deshabilitada
+    //valor por defecto: 0
+    unsigned int getCapacity(void) const {return Capacity;}
+    void setCapacity(unsigned int);
+
+    //construye una caché vacía deshabilitada
+    TArmImageCache(void);
+    //construye una caché vacía con la capacidad de otra
+    TArmImageCache(const TArmImageCache&);
+    //asigna la capacidad de otra caché, vaciando esta
+    TArmImageCache& operator=(const TArmImageCache&);
+    //libera la tabla
+    ~TArmImageCache();
+
+    //vacía la caché y libera su tabla
+    //debe invocarse cada vez que cambie la plantilla del brazo
+    void clear(void);
+
+    //busca la imagen correspondiente a la posición (P1, theta2)
+    //si no la encuentra devuelve NULL
+    const TArmImage *find(double theta2, TDoublePoint P1);
+    //obtiene la entrada donde debe almacenarse la imagen
+    //de la posición (P1, theta2), asignándole la clave
+    //si la caché está deshabilitada o su tabla no cabe
+    //en el presupuesto global devuelve NULL
+    TArmImage *insert(double theta2, TDoublePoint P1);
+};
+
 //TArm
 //---------------------------------------------------------------------------
 
@@ -747,6 +844,14 @@ public:
     const TContourFigureList &getContour(void) const {
         return (const TContourFigureList&)Contour;}
 
+    //------------------------------------------------------------------
+    //CACHÉ DE IMÁGENES:
+
+    //imágenes del brazo en S0 para las últimas posiciones
+    //usada por calculateImage y vaciada al cambiar la plantilla
+    //deshabilitada por defecto
+    TArmImageCache ImageCache;
+
     //------------------------------------------------------------------
     //PROPIEDADES DE PLANTILLA
     //DE LECTURA/ESCRITURA EN FORMATO TEXTO
@@ -1056,6 +1056,32 @@ TDoublePoint TCilinder::newP1(void)
 
     return P1;
 }
+//calcula P3 según (P0, theta_1, theta___3)
+//sin mover los rotores ni calcular el contorno del brazo
+TDoublePoint TCilinder::newP3(double theta_1, double theta___3) const
+{
+    //calcula P1 según (P0, theta_1)
+    TDoublePoint P1;
+    P1.x = getP0().x + getL01()*cos(getthetaO1() - theta_1);
+    P1.y = getP0().y + getL01()*sin(getthetaO1() - theta_1);
+
+    //calcula la orientación del brazo en S0
+    double thetaO3 = getthetaO1() - theta_1 + gettheta_O3o();
+    double theta2 = thetaO3 + theta___3 - getArm()->gettheta__3();
+
+    //ADVERTENCIA: las operaciones deben realizarse en el mismo orden
+    //que en TArm::calculateImage, para obtener exactamente el mismo punto.
+
+    //rota y traslada el punto P__3
+    const double COS = cos(theta2);
+    const double SIN = sin(theta2);
+    TDoublePoint P__3 = getArm()->getP__3();
+    TDoublePoint P3;
+    P3.x = P__3.x*COS - P__3.y*SIN + P1.x;
+    P3.y = P__3.x*SIN + P__3.y*COS + P1.y;
+
+    return P3;
+}
 
 //---------------------------------------------------------------------------
 //MÉTODOS DE CONTRUCCION, COPIA Y DESTRUCCIÓN:
@@ -1844,7 +1870,14 @@ bool TCilinder::theta___3ToGor_3(double &theta___3, double r_3)
 //si theta_3 no está al alcance devuelve falso
 bool TCilinder::theta_1ToGotheta_3(double& theta_1, double theta_3)
 {
-    double theta___3 = getArm()->gettheta___3();
+    return theta_1ToGotheta_3(theta_1, theta_3, getArm()->gettheta___3());
+}
+//dada la posición theta___3 indicada,
+//calcula theta_1 para que P3 vaya a theta_3
+//si theta_3 no está al alcance devuelve falso
+bool TCilinder::theta_1ToGotheta_3(double& theta_1, double theta_3,
+                                   double theta___3) const
+{
     double L03 = sqrt(getL01()*getL01() + getArm()->getL13()*getArm()->getL13() - 2*getL01()*getArm()->getL13()*cos(theta___3));
     double theta_31 = asin(L03/(getArm()->getL13()*sin(theta___3)));
     theta_1 = theta_3 + theta_31;
@@ -1870,34 +1903,25 @@ double TCilinder::searchNearestStablePosition(double& p_1nsp, double& p___3nsp,
     if(getArm()->isntInDomainp___3(p___3min) || getArm()->isntInDomainp___3(p___3max))
         throw EImproperArgument("searching interval [p___3min, p___3max] should be in the domain of rotor 2");
 
-    //GUARDA LA CONFIGURACIÓN ORIGINAL DEL ACTUADOR:
-
-    //guarda el estado de habilitación de los cuantificadores de los rotores
-    pushQuantify_();
-    getArm()->pushQuantify___();
-    //guarda las posiciones angulares de los rotores
-    pushtheta_1();
-    getArm()->pushtheta___3();
-
-    //REALIZA LA BÚSQUEDA:
-
-    //activa los cuantificadores de los rotores
-    setQuantify_(true);
-    getArm()->setQuantify___(true);
+    //Las posiciones estables se evalúan en forma cerrada mediante newP3,
+    //cuantificando los ángulos del mismo modo que setAnglesSteps
+    //con los cuantificadores activados, de modo que no es necesario
+    //mover los rotores ni calcular el contorno del brazo.
 
     //inicializa la distancia de P a P3 a infinito
     double R = DBL_MAX;
 
     //por cada punto estable del intervalo de búsqueda
     for(double p_1=ceil(p_1min); p_1<=floor(p_1max); p_1++) {
-        for(double p___3=ceil(p___3min); p___3<=floor(p___3max); p___3++) {
-            //asigna las posiciones angulares en pasos
-            setAnglesSteps(p_1, p___3);
+        //traduce p_1 a radianes cuantificados
+        double theta_1 = Qtheta_1(getG().Image(p_1));
 
-            //ADVERTECNIA: la cuentificación de los rotores debe estar habilitada.
+        for(double p___3=ceil(p___3min); p___3<=floor(p___3max); p___3++) {
+            //traduce p___3 a radianes cuantificados
+            double theta___3 = getArm()->Qtheta___3(getArm()->getG().Image(p___3));
 
             //calcula la distancia al punto dado
-            double new_R = Mod(getArm()->getP3() - P);
+            double new_R = Mod(newP3(theta_1, theta___3) - P);
 
             //si el punto P3 coincide exactamente con el punto dado
             if(new_R == 0) {
@@ -1905,16 +1929,6 @@ double TCilinder::searchNearestStablePosition(double& p_1nsp, double& p___3nsp,
                 p_1nsp = p_1;
                 p___3nsp = p___3;
 
-                //RESTAURA Y DESCARTA LA CONFIGURACIÓN ORIGINAL DEL ACTUADOR:
-
-                //restaura y descarta las posiciones angulares de los rotores
-                getArm()->restoreAndPoptheta___3();
-                restoreAndPoptheta_1();
-                //restaura y desempila el estado de habilitación de
-                //los cuantificadores de los rotores
-                getArm()->restoreAndPopQuantify___();
-                restoreAndPopQuantify_();
-
                 //termina la búsqueda indicando la distancia al punto hallado
                 return new_R;
             }
@@ -1928,16 +1942,6 @@ double TCilinder::searchNearestStablePosition(double& p_1nsp, double& p___3nsp,
         }
     }
 
-    //RESTAURA Y DESCARTA LA CONFIGURACIÓN ORIGINAL DEL ACTUADOR:
-
-    //restaura y descarta las posiciones angulares de los rotores
-    getArm()->restoreAndPoptheta___3();
-    restoreAndPoptheta_1();
-    //restaura y desempila el estado de habilitación de
-    //los cuantificadores de los rotores
-    getArm()->restoreAndPopQuantify___();
-    restoreAndPopQuantify_();
-
     //termina la búsqueda indicando la distancia al punto hallado
     return R;
 }
@@ -1948,39 +1952,36 @@ double TCilinder::searchNearestStablePosition(double& p_1nsp, double& p___3nsp,
 double TCilinder::getNearestStablePosition(double &p_1nsp, double &p___3nsp,
                                            double theta_1, double theta___3)
 {
-    //GUARDA LA CONFIGURACIÓN ORIGINAL DEL ACTUADOR:
+    //comprueba las precondiciones
+    if(isntInDomaintheta_1(theta_1))
+        throw EImproperArgument("angle theta_1 should be in [thata_1min, thata_1max]");
+    if(getArm()->isntInDomaintheta___3(theta___3))
+        throw EImproperArgument("angle theta___3 should be in [theta___3min, theta___3max]");
 
-    //guarda el estado de habilitación de los cuantificadores de los rotores
-    pushQuantify_();
-    getArm()->pushQuantify___();
-    //guarda las posiciones angulares de los rotores
-    pushtheta_1();
-    getArm()->pushtheta___3();
+    //Los rotores no se mueven: todos los puntos se calculan en forma cerrada
+    //mediante newP3 y las posiciones en pasos mediante las funciones F.
 
     //DETERMINA LAS COORDENAS CARTESIANAS DEL PUNTO DADO:
 
-    //desactiva la cuantificación de los rotores
-    setQuantify_(false);
-    getArm()->setQuantify___(false);
-
-    //mueve los rotores a las posiciones indicadas
-    setAnglesRadians(theta_1, theta___3);
-
-    //guarda el punto dado (P)
-    TDoublePoint P = getArm()->getP3();
+    //calcula el punto dado (P) sin cuantificar los ángulos
+    TDoublePoint P = newP3(theta_1, theta___3);
 
     //ADVERTENCIA: las coordenadas de P3 vienen dadas en S0.
 
     //BUSCA EL PUNTO MÁS PRÓXIMO AL PUNTO P ENTRE LOS
     //CORRESPONDIENTES A LAS POSICIONES ANGULARES ADYACENTES:
 
+    //traduce las posiciones dadas a pasos sin cuantificar
+    double p_1 = getF().Image(theta_1);
+    double p___3 = getArm()->getF().Image(theta___3);
+
     //calcula los límites del intervalo de búsqueda
     //añadiendo un incremento extra en cada dirección
     //para corregir el error numérico
-    double p_1min = floor(getp_1() - ERR_NUM);
-    double p_1max = ceil(getp_1() + ERR_NUM);
-    double p___3min = floor(getArm()->getp___3() - ERR_NUM);
-    double p___3max = ceil(getArm()->getp___3() + ERR_NUM);
+    double p_1min = floor(p_1 - ERR_NUM);
+    double p_1max = ceil(p_1 + ERR_NUM);
+    double p___3min = floor(p___3 - ERR_NUM);
+    double p___3max = ceil(p___3 + ERR_NUM);
 
     //restringe el intervalo de búsqueda al dominio de los rotores
     p_1min = max(p_1min, getp_1min());
@@ -2044,27 +2045,27 @@ double TCilinder::getNearestStablePosition(double &p_1nsp, double &p___3nsp,
     //------------------------------------------------------------------
     //BUSCA EL PUNTO MÁS CERCANO EN EL INTERVALO CERRADO [p___3min, p___3max]:
 
-    //Recué que la cuantificación de los rotores sigue desactivada.
-
     //calcula el argumento positivo del punto objetivo P
     double theta_ = ArgPos(P);
 
     //busca la mejor solución para cada p___3
     for(double p___3 = p___3min; p___3 <= p___3max; p___3++) {
-        //asigna el p___3 indicado
-        getArm()->setp___3(p___3);
-
         //calcula el valor de theta_1 para que P3 quede lo más cerca posible de P
+        //con el rotor 2 en p___3 sin cuantificar
         double theta_1;
-        theta_1ToGotheta_3(theta_1, theta_);
+        theta_1ToGotheta_3(theta_1, theta_, getArm()->getG().Image(p___3));
 
         //El valor de theta_1 debe hacer que P3 esté en la dirección radial de P.
 
+        //comprueba que theta_1 está en el dominio del rotor 1
+        if(isntInDomaintheta_1(theta_1))
+            throw EImproperArgument("angle theta_1 should be in [thata_1min, thata_1max]");
+
         //calcula [p_1min, p_1max] incluyendo un incremento adicional
         //en cada dirección para corregir el error numérico
-        settheta_1(theta_1);
-        double p_1min = max(floor(getp_1()) - ERR_NUM, getp_1min());
-        double p_1max = min(ceil(getp_1()) + ERR_NUM, getp_1max());
+        double p_1 = getF().Image(theta_1);
+        double p_1min = max(floor(p_1) - ERR_NUM, getp_1min());
+        double p_1max = min(ceil(p_1) + ERR_NUM, getp_1max());
 
         //restringe el íntervalo de búsqueda al dominio del rotor 1
         p_1min = max(p_1min, getp_1min());
@@ -2086,16 +2087,6 @@ double TCilinder::getNearestStablePosition(double &p_1nsp, double &p___3nsp,
             p_1nsp = new_p_1nsp;
             p___3nsp = new_p___3nsp;
 
-            //RESTAURA Y DESCARTA LA CONFIGURACIÓN ORIGINAL DEL ACTUADOR:
-
-            //restaura y descarta las posiciones angulares de los rotores
-            getArm()->restoreAndPoptheta___3();
-            restoreAndPoptheta_1();
-            //restaura y desempila el estado de habilitación de
-            //los cuantificadores de los rotores
-            getArm()->restoreAndPopQuantify___();
-            restoreAndPopQuantify_();
-
             //termina la búsqueda indicando la distancia al punto hallado
             return new_R;
         }
@@ -2108,17 +2099,6 @@ double TCilinder::getNearestStablePosition(double &p_1nsp, double &p___3nsp,
         }
     }
 
-    //------------------------------------------------------------------
-    //RESTAURA Y DESCARTA LA CONFIGURACIÓN ORIGINAL DEL ACTUADOR:
-
-    //restaura y descarta las posiciones angulares de los rotores
-    getArm()->restoreAndPoptheta___3();
-    restoreAndPoptheta_1();
-    //restaura y desempila el estado de habilitación de
-    //los cuantificadores de los rotores
-    getArm()->restoreAndPopQuantify___();
-    restoreAndPopQuantify_();
-
     //termina la búsqueda indicando la distancia al punto hallado
     return R;
 }
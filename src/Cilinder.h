@@ -106,6 +106,9 @@ protected:
 
     //calculate P1 according to (P0, theta_1)
     TDoublePoint newP1(void);
+    //calculate P3 according to (P0, theta_1, theta___3)
+    //without moving the rotors nor calculating the arm contour
+    TDoublePoint newP3(double theta_1, double theta___3) const;
 
 public:
     //------------------------------------------------------------------
@@ -828,10 +831,17 @@ public:
     //calcula theta_1 para que P3 vaya a theta_3
     //si theta_3 no está al alcance devuelve falso
     bool theta_1ToGotheta_3(double& theta_1, double theta_3);
+    //dada la posición theta___3 indicada,
+    //calcula theta_1 para que P3 vaya a theta_3
+    //si theta_3 no está al alcance devuelve falso
+    bool theta_1ToGotheta_3(double& theta_1, double theta_3,
+                            double theta___3) const;
 
     //busca la posición estable que hace que el punto P3 quede lo más próximo a P
     //en el intervalo [p_1min, p_1max]x[p___3min, p___3max]
     //devuelve la distancia de P a P3
+    //las posiciones candidatas se evalúan en forma cerrada,
+    //sin mover los rotores ni calcular el contorno del brazo
     double searchNearestStablePosition(double& p_1nsp, double& p___3nsp,
                                        TDoublePoint P,
                                        double p_1min, double p_1max,
@@ -840,6 +850,7 @@ public:
     //determina las posiciones angulares estables que hacen que  el punto P3
     //se ubique lo más cerca posible del punto correspondiente a unas posiciones
     //angulares de los rotores devuelve la distancia al punto hallado
+    //no modifica la posición de los rotores
     double getNearestStablePosition(double &p_1nsp, double &p___3nsp,
                                     double theta_1, double theta___3);
 
@@ -0,0 +1,287 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file ClearanceTrace.cpp
+/// @brief compact binary trace of the clearance profiles of a validation
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "ClearanceTrace.h"
+#include "Exceptions.h"
+
+#include <fstream> //ifstream, ofstream
+#include <stdint.h> //uint32_t
+#include <string.h> //memcpy, memcmp
+#include <float.h> //DBL_MAX
+
+//---------------------------------------------------------------------------
+
+//namespace for positioning
+namespace Positioning {
+
+//---------------------------------------------------------------------------
+
+//Format of the trace:
+//  header: magic (8 bytes), version (uint32), byte order (uint32),
+//      number of profiles (uint32);
+//  for each profile: Id (int32), IdA (int32), isEA (uint8),
+//      gesture (int32), vmaxabs (double), number of samples N (uint32),
+//      and N pairs of differences (dt, dD) in float32.
+
+//magic number and version of the format of the trace
+static const char CLEARANCE_TRACE_MAGIC[8] = {'F', 'M', 'P', 'T', 'C', 'L', 'T', 'R'};
+static const uint32_t CLEARANCE_TRACE_VERSION = 1;
+//mark for discard the traces written with other byte order
+static const uint32_t CLEARANCE_TRACE_BYTE_ORDER = 0x01020304;
+
+//write a value in binary format at the end of a buffer
+template <class T> static void putValue(string& buffer, T value)
+{
+    buffer.append((const char*)&value, sizeof(T));
+}
+//read a value in binary format from the position i of a buffer
+template <class T> static T getValue(const string& buffer, size_t& i)
+{
+    if(buffer.length() < i || buffer.length() - i < sizeof(T))
+        throw EImproperFileLoadedValue("unexpected end of the clearance trace");
+    T value;
+    memcpy(&value, buffer.data() + i, sizeof(T));
+    i += sizeof(T);
+    return value;
+}
+
+//---------------------------------------------------------------------------
+//TClosestApproach:
+
+//build a closest approach not found
+TClosestApproach::TClosestApproach(void) :
+    gesture(-1), t(0), D(DBL_MAX)
+{
+}
+
+//---------------------------------------------------------------------------
+//TClearanceTrace:
+
+//read the headers of the profiles of the buffer
+void TClearanceTrace::readHeaders(void)
+{
+    p_Headers.clear();
+
+    //check the header of the trace
+    if(p_Bytes.length() < sizeof(CLEARANCE_TRACE_MAGIC) ||
+            memcmp(p_Bytes.data(), CLEARANCE_TRACE_MAGIC, sizeof(CLEARANCE_TRACE_MAGIC)) != 0)
+        throw EImproperFileLoadedValue("the clearance trace should start with the magic number");
+    size_t i = sizeof(CLEARANCE_TRACE_MAGIC);
+    if(getValue<uint32_t>(p_Bytes, i) != CLEARANCE_TRACE_VERSION)
+        throw EImproperFileLoadedValue("unknown version of the clearance trace");
+    if(getValue<uint32_t>(p_Bytes, i) != CLEARANCE_TRACE_BYTE_ORDER)
+        throw EImproperFileLoadedValue("the clearance trace has other byte order");
+    uint32_t Nprofiles = getValue<uint32_t>(p_Bytes, i);
+
+    //read the header of each profile, and jump its samples
+    for(uint32_t k=0; k<Nprofiles; k++) {
+        TEdgeHeader H;
+        H.Id = getValue<int32_t>(p_Bytes, i);
+        H.IdA = getValue<int32_t>(p_Bytes, i);
+        H.isEA = getValue<uint8_t>(p_Bytes, i) != 0;
+        H.gesture = getValue<int32_t>(p_Bytes, i);
+        H.vmaxabs = getValue<double>(p_Bytes, i);
+        H.N = getValue<uint32_t>(p_Bytes, i);
+        H.offset = i;
+        if((p_Bytes.length() - i)/(2*sizeof(float)) < H.N)
+            throw EImproperFileLoadedValue("unexpected end of the clearance trace");
+        i += size_t(H.N)*2*sizeof(float);
+        p_Headers.push_back(H);
+    }
+
+    if(i != p_Bytes.length())
+        throw EImproperFileLoadedValue("unexpected bytes at the end of the clearance trace");
+}
+
+//decode the samples of the profile i
+void TClearanceTrace::decodeSamples(vector<double>& t, vector<double>& D, int i) const
+{
+    const TEdgeHeader& H = p_Headers[i];
+    t.resize(H.N);
+    D.resize(H.N);
+    size_t j = H.offset;
+    double t_ = 0, D_ = 0;
+    for(unsigned int k=0; k<H.N; k++) {
+        t_ += getValue<float>(p_Bytes, j);
+        D_ += getValue<float>(p_Bytes, j);
+        t[k] = t_;
+        D[k] = D_;
+    }
+}
+
+//set the encoded trace
+void TClearanceTrace::setBytes(const string& bytes)
+{
+    try {
+        p_Bytes = bytes;
+        readHeaders();
+    }
+    catch(Exception& E) {
+        p_Bytes.clear();
+        p_Headers.clear();
+        E.Message.Insert(1, "setting clearance trace: ");
+        throw;
+    }
+}
+
+//build an empty trace
+TClearanceTrace::TClearanceTrace(void) :
+    p_Bytes(), p_Headers()
+{
+    TClearanceProfileList CPL;
+    build(CPL);
+}
+
+//encode a list of clearance profiles
+void TClearanceTrace::build(const TClearanceProfileList& CPL)
+{
+    //select the profiles to encode
+    vector<const TClearanceProfile*> Profiles;
+    for(int i=0; i<CPL.getCount(); i++) {
+        const TClearanceProfile *CP = CPL.GetPointer(i);
+        if(!CP->isEA && CP->Id>CP->IdA &&
+                CPL.search(CP->gesture, CP->IdA, CP->Id, false) < CPL.getCount())
+            continue;
+        Profiles.push_back(CP);
+    }
+
+    //encode the header of the trace
+    string bytes(CLEARANCE_TRACE_MAGIC, sizeof(CLEARANCE_TRACE_MAGIC));
+    putValue(bytes, CLEARANCE_TRACE_VERSION);
+    putValue(bytes, CLEARANCE_TRACE_BYTE_ORDER);
+    putValue(bytes, uint32_t(Profiles.size()));
+
+    //encode each profile
+    for(unsigned int i=0; i<Profiles.size(); i++) {
+        const TClearanceProfile *CP = Profiles[i];
+        putValue(bytes, int32_t(CP->Id));
+        putValue(bytes, int32_t(CP->IdA));
+        putValue(bytes, uint8_t(CP->isEA));
+        putValue(bytes, int32_t(CP->gesture));
+        putValue(bytes, CP->vmaxabs);
+        putValue(bytes, uint32_t(CP->D.size()));
+
+        //encode the differences with the decoded previous sample
+        double t_ = 0, D_ = 0;
+        for(unsigned int k=0; k<CP->D.size(); k++) {
+            float dt = float(CP->t[k] - t_);
+            float dD = float(CP->D[k] - D_);
+            putValue(bytes, dt);
+            putValue(bytes, dD);
+            t_ += dt;
+            D_ += dD;
+        }
+    }
+
+    setBytes(bytes);
+}
+
+//decode the profile i of the trace
+void TClearanceTrace::getProfile(TClearanceProfile& CP, int i) const
+{
+    //check the precondition
+    if(i<0 || getCount()<=i)
+        throw EImproperArgument("index i should indicate a profile of the trace");
+
+    const TEdgeHeader& H = p_Headers[i];
+    CP.Id = H.Id;
+    CP.IdA = H.IdA;
+    CP.isEA = H.isEA;
+    CP.gesture = H.gesture;
+    CP.vmaxabs = H.vmaxabs;
+    decodeSamples(CP.t, CP.D, i);
+}
+//decode all profiles of the trace
+void TClearanceTrace::getProfiles(TClearanceProfileList& CPL) const
+{
+    CPL.Clear();
+    for(int i=0; i<getCount(); i++) {
+        TClearanceProfile *CP = new TClearanceProfile();
+        getProfile(*CP, i);
+        CPL.Add(CP);
+    }
+}
+
+//get the closest approach of a pair (RP, adjacent)
+//in all gestures of the trace
+bool TClearanceTrace::getClosestApproach(TClosestApproach& CA,
+                                         int Id, int IdA, bool isEA) const
+{
+    //the pairs of RPs are stored with Id < IdA,
+    //but the symmetric pair can be stored too
+    CA = TClosestApproach();
+    bool found = false;
+    vector<double> t, D;
+    for(int i=0; i<getCount(); i++) {
+        const TEdgeHeader& H = p_Headers[i];
+        if(H.isEA != isEA)
+            continue;
+        if(!(H.Id==Id && H.IdA==IdA) && (isEA || !(H.Id==IdA && H.IdA==Id)))
+            continue;
+
+        found = true;
+        decodeSamples(t, D, i);
+        for(unsigned int k=0; k<D.size(); k++)
+            if(D[k] < CA.D) {
+                CA.gesture = H.gesture;
+                CA.t = t[k];
+                CA.D = D[k];
+            }
+    }
+    return found;
+}
+
+//write the trace in a binary file
+void TClearanceTrace::writeToFile(const string& path) const
+{
+    ofstream ofs(path.c_str(), ios::out | ios::binary | ios::trunc);
+    ofs.write(p_Bytes.data(), p_Bytes.length());
+    ofs.close();
+    if(!ofs)
+        throw ECantComplete("can't write the file '"+path+"'");
+}
+//read the trace from a binary file
+void TClearanceTrace::readFromFile(const string& path)
+{
+    ifstream ifs(path.c_str(), ios::in | ios::binary);
+    if(!ifs)
+        throw ECantComplete("can't read the file '"+path+"'");
+    string bytes((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+    if(ifs.bad())
+        throw ECantComplete("can't read the file '"+path+"'");
+
+    try {
+        setBytes(bytes);
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "reading file '"+path+"': ");
+        throw;
+    }
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Positioning
+
+//---------------------------------------------------------------------------
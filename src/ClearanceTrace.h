@@ -0,0 +1,135 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file ClearanceTrace.h
+/// @brief compact binary trace of the clearance profiles of a validation
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef CLEARANCETRACE_H
+#define CLEARANCETRACE_H
+
+#include "MotionProgramValidator.h"
+
+#include <string>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+//namespace for positioning
+namespace Positioning {
+
+//---------------------------------------------------------------------------
+//TClearanceTrace:
+//---------------------------------------------------------------------------
+
+/// @brief Closest approach of a pair (RP, adjacent) in a trace.
+class TClosestApproach {
+public:
+    /// Index of the gesture in the MP.
+    int gesture;
+    /// Time of the closest approach in the gesture (ms).
+    double t;
+    /// Distance between the contours in the closest approach (mm).
+    double D;
+
+    /// Build a closest approach not found.
+    TClosestApproach(void);
+};
+
+/// @brief A clearance trace is the list of clearance profiles of
+/// the validation of a MP, encoded in a compact binary format.
+/// @brief Each edge of the adjacency graph has a profile per gesture.
+/// The pairs of RPs are stored only once, with Id < IdA, because
+/// both directions of the edge have the same samples.
+/// @brief The times and the distances of each profile are encoded
+/// as differences with the previous sample, in float32. The differences
+/// are taken from the decoded values, so the numerical error not is
+/// accumulated, and each decoded value differs from the original value
+/// less than the precision of float32 of the difference.
+class TClearanceTrace {
+    //encoded trace
+    std::string p_Bytes;
+
+    //header of the profile of an edge
+    class TEdgeHeader {
+    public:
+        int Id;
+        int IdA;
+        bool isEA;
+        int gesture;
+        double vmaxabs;
+        //number of samples
+        unsigned int N;
+        //position of the samples in the buffer
+        size_t offset;
+    };
+    //header of each profile, in the order of the buffer
+    std::vector<TEdgeHeader> p_Headers;
+
+    //read the headers of the profiles of the buffer
+    void readHeaders(void);
+    //decode the samples of the profile i
+    void decodeSamples(std::vector<double>& t, std::vector<double>& D, int i) const;
+
+public:
+    /// Get the encoded trace.
+    const std::string& getBytes(void) const {return p_Bytes;}
+    /// @brief Set the encoded trace.
+    /// @exception EImproperFileLoadedValue if the trace is not valid.
+    void setBytes(const std::string& bytes);
+
+    /// Get the number of profiles of the trace.
+    int getCount(void) const {return int(p_Headers.size());}
+
+    /// Build an empty trace.
+    TClearanceTrace(void);
+
+    /// @brief Encode a list of clearance profiles.
+    /// @brief For the pairs of RPs with Id > IdA, only is encoded
+    /// the profile (IdA, Id) of the same gesture, if it is in the list.
+    void build(const TClearanceProfileList& CPL);
+
+    /// @brief Decode the profile i of the trace.
+    void getProfile(TClearanceProfile& CP, int i) const;
+    /// @brief Decode all profiles of the trace.
+    void getProfiles(TClearanceProfileList& CPL) const;
+
+    /// @brief Get the closest approach of a pair (RP, adjacent)
+    /// in all gestures of the trace.
+    /// @return false: if the pair is not in the trace.
+    /// @note The order of the RPs of a pair of RPs is indifferent.
+    bool getClosestApproach(TClosestApproach& CA,
+                            int Id, int IdA, bool isEA=false) const;
+
+    /// @brief Write the trace in a binary file.
+    /// @exception ECantComplete if the file can't be written.
+    void writeToFile(const std::string& path) const;
+    /// @brief Read the trace from a binary file.
+    /// @exception ECantComplete if the file can't be read.
+    /// @exception EImproperFileLoadedValue if the trace is not valid.
+    void readFromFile(const std::string& path);
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Positioning
+
+//---------------------------------------------------------------------------
+#endif // CLEARANCETRACE_H
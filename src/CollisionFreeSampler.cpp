@@ -0,0 +1,298 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file CollisionFreeSampler.cpp
+/// @brief sampler of random configurations of a RP list without collisions
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "CollisionFreeSampler.h"
+#include "Workers.h"
+
+#include <algorithm> //std::stable_sort, std::min, std::max
+#include <unordered_map>
+#include <thread>
+#include <atomic>
+#include <exception> //exception_ptr
+
+//---------------------------------------------------------------------------
+
+//espacio de nombres de modelos
+namespace Models {
+
+//---------------------------------------------------------------------------
+//GENERATOR OF RANDOM NUMBERS:
+
+//Function rand() can't be used by concurrent threads, and its sequence
+//depends on the order of the calls, so each RP has its own generator.
+
+//mix the bits of a number (finalizer of SplitMix64)
+static unsigned long long mix64(unsigned long long z)
+{
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+//generator SplitMix64 of a RP
+class TRandomGenerator {
+    unsigned long long s;
+
+public:
+    //build the generator of the RP of position i for a seed
+    TRandomGenerator(unsigned long long seed, int i) :
+        s(mix64(mix64(seed) ^ (unsigned long long)i)) {;}
+
+    //get a random number in [0, 1)
+    double next(void) {
+        s += 0x9E3779B97F4A7C15ULL;
+        return double(mix64(s) >> 11)*(1.0/9007199254740992.0);
+    }
+    //get a random number in [xmin, xmax]
+    double uniform(double xmin, double xmax) {
+        return min(xmin + (xmax - xmin)*next(), xmax);
+    }
+};
+
+//---------------------------------------------------------------------------
+//TCollisionFreeSampler
+//---------------------------------------------------------------------------
+
+//color of the RP of a position of the list
+int TCollisionFreeSampler::getColor(int i) const
+{
+    //check the precondition
+    if(i<0 || int(p_Colors.size())<=i)
+        throw EImproperArgument("index i should indicate a RP of the list");
+
+    return p_Colors[i];
+}
+
+//build a sampler attached to a RP list
+//and precompute the coloring and the domains
+TCollisionFreeSampler::TCollisionFreeSampler(TRoboticPositionerList *RPL) :
+    p_RPL(RPL),
+    p_Adjacents(), p_Colors(), p_Classes(), p_Domains(),
+    Nthreads(0)
+{
+    //check the preconditions
+    if(RPL == NULL)
+        throw EImproperArgument("pointer RPL should point to built robotic positioner list");
+
+    build();
+}
+
+//precompute the coloring of the adjacency graph
+//and the domains of the rotors of each RP
+void TCollisionFreeSampler::build(void)
+{
+    const int N = p_RPL->getCount();
+
+    //BUILD THE ADJACENCY GRAPH:
+
+    //map the RPs to their positions in the list
+    unordered_map<const TRoboticPositioner*, int> positions;
+    for(int i=0; i<N; i++)
+        positions[p_RPL->Get(i)] = i;
+
+    //translate the adjacent RPs to positions
+    p_Adjacents.assign(N, vector<int>());
+    vector<int> degrees(N, 0);
+    for(int i=0; i<N; i++) {
+        const TAdjacentRPList& ARPL = p_RPL->Get(i)->getActuator()->AdjacentRPs;
+        for(int k=0; k<ARPL.getCount(); k++) {
+            unordered_map<const TRoboticPositioner*, int>::const_iterator it = positions.find(ARPL[k].RP);
+            if(it != positions.end()) {
+                p_Adjacents[i].push_back(it->second);
+                degrees[i]++;
+            }
+            else
+                p_Adjacents[i].push_back(-1);
+        }
+    }
+
+    //COLOR THE GRAPH:
+
+    //The RPs are colored in decreasing order of degree (Welsh-Powell),
+    //assigning to each RP the lowest color not used by its adjacents.
+
+    vector<int> order(N);
+    for(int i=0; i<N; i++)
+        order[i] = i;
+    stable_sort(order.begin(), order.end(),
+                [&degrees](int a, int b) {return degrees[a] > degrees[b];});
+
+    p_Colors.assign(N, -1);
+    int Ncolors = 0;
+    vector<char> used;
+    for(int n=0; n<N; n++) {
+        int i = order[n];
+        used.assign(Ncolors + 1, false);
+        for(unsigned int k=0; k<p_Adjacents[i].size(); k++) {
+            int j = p_Adjacents[i][k];
+            if(j>=0 && p_Colors[j]>=0)
+                used[p_Colors[j]] = true;
+        }
+        int c = 0;
+        while(used[c])
+            c++;
+        p_Colors[i] = c;
+        if(c >= Ncolors)
+            Ncolors = c + 1;
+    }
+
+    //build the classes with the RPs in the order of the list
+    p_Classes.assign(Ncolors, vector<int>());
+    for(int i=0; i<N; i++)
+        p_Classes[p_Colors[i]].push_back(i);
+
+    //PRECOMPUTE THE DOMAINS:
+
+    //determine the domains as in randomizep_1 and randomizep___3
+    p_Domains.assign(N, TDomains());
+    for(int i=0; i<N; i++) {
+        TActuator *A = p_RPL->Get(i)->getActuator();
+        TDomains& D = p_Domains[i];
+        D.p_1min = max(0., A->getp_1min());
+        D.p_1max = min(floor(A->getSB1()), A->getp_1max());
+        D.p___3min = max(0., A->getArm()->getp___3min());
+        D.p___3max = min(floor(A->getArm()->getSB2()/2), A->getArm()->getp___3max());
+    }
+}
+
+//determines if a RP collides with some EA adjacent or
+//some RP adjacent of the previous classes
+bool TCollisionFreeSampler::collidesWithPlaced(int i) const
+{
+    TActuator *A = p_RPL->Get(i)->getActuator();
+
+    for(int k=0; k<A->AdjacentEAs.getCount(); k++)
+        if(A->thereIsCollision(A->AdjacentEAs[k].EA))
+            return true;
+
+    const vector<int>& Adjacents = p_Adjacents[i];
+    for(int k=0; k<A->AdjacentRPs.getCount(); k++) {
+        int j = Adjacents[k];
+        if((j<0 || p_Colors[j]<p_Colors[i]) &&
+                A->thereIsCollision(A->AdjacentRPs[k].RP->getActuator()))
+            return true;
+    }
+
+    return false;
+}
+
+//sample the rotors of a RP until it doesn't collides
+//with the placed adjacents, or the draws are exhausted
+bool TCollisionFreeSampler::sampleRP(int i, unsigned long long seed, int Nmax) const
+{
+    TActuator *A = p_RPL->Get(i)->getActuator();
+    const TDomains& D = p_Domains[i];
+    TRandomGenerator RG(seed, i);
+
+    for(int n=0; n<Nmax; n++) {
+        //draw the rotors in their domains
+        double p_1 = RG.uniform(D.p_1min, D.p_1max);
+        double p___3 = RG.uniform(D.p___3min, D.p___3max);
+        A->setp_1(p_1);
+        A->getArm()->setp___3(p___3);
+
+        if(!collidesWithPlaced(i))
+            return true;
+    }
+
+    return false;
+}
+
+//move the rotors of the RPs to random positions
+//with uniform distribution in their domains,
+//where they don't collide with their adjacents
+bool TCollisionFreeSampler::randomizeWithoutCollision(unsigned long long seed, int Nmax)
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(Nmax < 1)
+        throw EImproperArgument("maximun number of draws Nmax should be upper zero");
+    if(int(p_Colors.size()) != p_RPL->getCount())
+        throw EImproperCall("the sampler should be built for the current RP list");
+
+    //MAKE ACTIONS:
+
+    bool ok = true;
+
+    //sample the classes in order
+    for(unsigned int c=0; c<p_Classes.size() && ok; c++) {
+        const vector<int>& Class = p_Classes[c];
+        const int N = int(Class.size());
+
+        //results of each RP of the class
+        //(vector<char> instead vector<bool>, for allow concurrent writting)
+        vector<char> oks(N, false);
+        vector<exception_ptr> errors(N);
+
+        //determines the number of threads
+        int Nthreads_ = Workers::getNworkers(Nthreads, N);
+
+        //if there is only a thread, sample the RPs in this thread
+        if(Nthreads_ <= 1) {
+            for(int n=0; n<N; n++)
+                oks[n] = sampleRP(Class[n], seed, Nmax);
+        }
+        //else, distribute the RPs among the threads
+        else {
+            atomic<int> next(0);
+            vector<thread> workers;
+            for(int w=0; w<Nthreads_; w++)
+                workers.push_back(thread([&]() {
+                    Workers::setWorker(true);
+                    int n;
+                    while((n = next++) < N) {
+                        try {
+                            oks[n] = sampleRP(Class[n], seed, Nmax);
+                        }
+                        catch(...) {
+                            errors[n] = current_exception();
+                        }
+                    }
+                }));
+            for(unsigned int w=0; w<workers.size(); w++)
+                workers[w].join();
+
+            //rethrow the exception of the first RP which has failed
+            for(int n=0; n<N; n++)
+                if(errors[n])
+                    rethrow_exception(errors[n]);
+        }
+
+        for(int n=0; n<N; n++)
+            if(!oks[n])
+                ok = false;
+    }
+
+    //the RPs have been moved, so the distances of the edges aren't valid
+    for(int i=0; i<p_RPL->getCount(); i++)
+        p_RPL->Get(i)->getActuator()->AdjacentRPs.invalidateEdges();
+
+    return ok;
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Models
+
+//---------------------------------------------------------------------------
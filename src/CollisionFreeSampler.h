@@ -0,0 +1,129 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file CollisionFreeSampler.h
+/// @brief sampler of random configurations of a RP list without collisions
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef COLLISIONFREESAMPLER_H
+#define COLLISIONFREESAMPLER_H
+
+#include "RoboticPositionerList3.h"
+
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+//espacio de nombres de modelos
+namespace Models {
+
+//---------------------------------------------------------------------------
+//TCollisionFreeSampler
+//---------------------------------------------------------------------------
+
+//sampler of random configurations of the rotors of a RP list,
+//where the RPs don't collide with their adjacents
+//
+//The RPs are sampled by classes of a coloring of the adjacency graph,
+//so the RPs of a class aren't adjacent and can be sampled in parallel,
+//and each RP only is checked with the EAs and the RPs of the previous
+//classes, which already have their final positions.
+//
+//Each RP draws its rotors uniformly in their domains until they don't
+//collide with the placed adjacents (rejection sampling), so the position
+//of each RP is uniform in the set of positions free of collision with
+//the placed adjacents. As in TRoboticPositionerList1::randomizeWithoutCollision,
+//the RPs are placed one after other, so the configuration as a whole
+//isn't uniform in the set of configurations free of collision.
+//
+//Each RP has its own generator of random numbers, derived from
+//the seed and the position of the RP in the list, so the result
+//only depends on the seed, and not on the number of threads.
+class TCollisionFreeSampler {
+    //sampled RP list
+    TRoboticPositionerList *p_RPL;
+
+    //adjacent RPs of each RP, as positions in the list
+    //or -1 for the adjacent RPs which aren't in the list
+    std::vector<std::vector<int> > p_Adjacents;
+    //color of each RP
+    std::vector<int> p_Colors;
+    //positions of the RPs of each class
+    std::vector<std::vector<int> > p_Classes;
+
+    //domains of the rotors of each RP in steps
+    class TDomains {
+    public:
+        //domain of the rotor 1
+        double p_1min, p_1max;
+        //domain of the rotor 2
+        double p___3min, p___3max;
+    };
+    std::vector<TDomains> p_Domains;
+
+    //determines if a RP collides with some EA adjacent or
+    //some RP adjacent of the previous classes
+    bool collidesWithPlaced(int i) const;
+    //sample the rotors of a RP until it doesn't collides
+    //with the placed adjacents, or the draws are exhausted
+    bool sampleRP(int i, unsigned long long seed, int Nmax) const;
+
+public:
+    //number of threads used for sample each class
+    //default value: 0 (the number of concurrent threads supported)
+    unsigned int Nthreads;
+
+    //sampled RP list
+    TRoboticPositionerList *getRPL(void) const {return p_RPL;}
+    //number of classes of the coloring
+    int getNcolors(void) const {return int(p_Classes.size());}
+    //color of the RP of a position of the list
+    int getColor(int i) const;
+
+    //build a sampler attached to a RP list
+    //and precompute the coloring and the domains
+    TCollisionFreeSampler(TRoboticPositionerList *RPL);
+
+    //precompute the coloring of the adjacency graph
+    //and the domains of the rotors of each RP
+    //This method shall be called each time that the RP list,
+    //the adjacencies or the domains of the rotors change.
+    void build(void);
+
+    //move the rotors of the RPs to random positions
+    //with uniform distribution in their domains,
+    //where they don't collide with their adjacents
+    //Inputs:
+    //  seed: seed of the random numbers
+    //  Nmax: maximun number of draws for each RP
+    //Outputs:
+    //  randomizeWithoutCollision: false if some RP has made Nmax draws
+    //      colliding with the placed adjacents
+    //When the sampler fails, the RPs are left in the last draws,
+    //and other seed or a greater Nmax shall be used.
+    bool randomizeWithoutCollision(unsigned long long seed, int Nmax=1000);
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Models
+
+//---------------------------------------------------------------------------
+#endif // COLLISIONFREESAMPLER_H
@@ -28,6 +28,7 @@
 #include "Strings.h"
 #include "Geometry.h"
 #include "Constants.h"
+#include "Profiler.h"
 
 #include <algorithm> //std::min, std::max
 
@@ -39,6 +40,58 @@ using namespace Operators;
 //espacio de nombres de modelos
 namespace Models {
 
+//---------------------------------------------------------------------------
+//TFlatSegments
+//---------------------------------------------------------------------------
+
+//reconstruye los arrays a partir de las figuras en representación plana
+void TFlatSegments::build(const vector<TFlatFigure>& Flat)
+{
+    xa.clear();
+    ya.clear();
+    xb.clear();
+    yb.clear();
+    for(unsigned int i=0; i<Flat.size(); i++) {
+        const TFlatFigure& FF = Flat[i];
+        if(FF.type == cftSegment) {
+            xa.push_back(FF.Pa.x);
+            ya.push_back(FF.Pa.y);
+            xb.push_back(FF.Pb.x);
+            yb.push_back(FF.Pb.y);
+        }
+    }
+    Count = xa.size();
+
+    //completa los arrays repitiendo el último segmento
+    if(Count > 0) {
+        unsigned int L = distanceBatchLanes();
+        while(xa.size()%L != 0) {
+            xa.push_back(xa.back());
+            ya.push_back(ya.back());
+            xb.push_back(xb.back());
+            yb.push_back(yb.back());
+        }
+    }
+}
+
+//calcula la distancia mínima entre el segmento (Pa, Pb)
+//y los segmentos de la lista
+double TFlatSegments::distanceMin(TDoublePoint Pa, TDoublePoint Pb) const
+{
+    //evalúa los segmentos en lotes de tamaño acotado
+    const unsigned int Nmax = 64;
+    double D[Nmax];
+    double dmin = DBL_MAX;
+    for(unsigned int j0=0; j0<xa.size(); j0+=Nmax) {
+        unsigned int N = std::min(Nmax, (unsigned int)xa.size() - j0);
+        distanceSegmentSegments(D, Pa, Pb, &xa[j0], &ya[j0], &xb[j0], &yb[j0], N);
+        for(unsigned int j=0; j<N; j++)
+            if(D[j] < dmin)
+                dmin = D[j];
+    }
+    return dmin;
+}
+
 //---------------------------------------------------------------------------
 //TContourFigureList
 //--------------------------------------------------------------------------
@@ -47,7 +100,8 @@ namespace Models {
 //construye un contorno
 TContourFigureList::TContourFigureList(int Capacity) :
     TItemsList<TContourFigure*>(Capacity, NULL, NULL, NULL,
-                                TContourFigure::ContourFigurePrint, TContourFigure::ContourFigureRead)
+                                TContourFigure::ContourFigurePrint, TContourFigure::ContourFigureRead),
+    FlatCount(-1), FlatVersion(0), Flat(), Segments(), Bounds()
 {
 }
 
@@ -83,6 +137,15 @@ void TContourFigureList::Copy(const TContourFigureList &CFL)
             throw EImpossibleError("contour figure type unknown");
         }
     }
+
+    //copia la representación plana
+    Flat = CFL.Flat;
+    Segments = CFL.Segments;
+    Bounds = CFL.Bounds;
+    if(CFL.flatIsUpdated())
+        setFlatUpdated();
+    else
+        invalidateFlat();
 }
 TContourFigureList& TContourFigureList::operator=(const TContourFigureList& C)
 {
@@ -116,6 +179,15 @@ TContourFigureList& TContourFigureList::operator=(const TContourFigureList& C)
         }
     }
 
+    //copia la representación plana
+    Flat = C.Flat;
+    Segments = C.Segments;
+    Bounds = C.Bounds;
+    if(C.flatIsUpdated())
+        setFlatUpdated();
+    else
+        invalidateFlat();
+
     //devuelve la referencia a esta lista de figurasde contorno
     //para permitir anidar asignaciones
     return *this;
@@ -143,7 +215,8 @@ void TContourFigureList::Clone(const TContourFigureList& CFL)
 TContourFigureList::TContourFigureList(const TContourFigureList &CFL) :
     TItemsList<TContourFigure*>(CFL.getCapacity(), CFL.Compare,
                                 CFL.Evaluate, CFL.Assign,
-                                CFL.Print, CFL.Read)
+                                CFL.Print, CFL.Read),
+    FlatCount(-1), FlatVersion(0), Flat(), Segments(), Bounds()
 {
     //clona el contorno
     Clone(CFL);
@@ -162,6 +235,95 @@ bool TContourFigureList::operator!=(const TContourFigureList& CFL) const
     return false;
 }
 
+//--------------------------------------------------------------------------
+//REPRESENTACIÓN PLANA Y LÍMITES:
+
+//obtiene la suma de las versiones de las figuras no nulas
+unsigned int TContourFigureList::getVersionSum(void) const
+{
+    unsigned int Version = 0;
+    for(int i=0; i<getCount(); i++)
+        if(Items[i] != NULL)
+            Version += Items[i]->getVersion();
+
+    return Version;
+}
+
+//actualiza la representación plana de las figuras
+//y los límites del contorno
+void TContourFigureList::updateFlat(void)
+{
+    //obtiene las figuras no nulas en representación plana con sus límites,
+    //y la caja límite del contorno
+    Flat.resize(getCount());
+    unsigned int N = 0;
+    Bounds.clearBox();
+    for(int i=0; i<getCount(); i++) {
+        TContourFigure *F = Items[i];
+        if(F != NULL) {
+            TFlatFigure& FF = Flat[N++];
+            F->getFlat(FF);
+            FF.calculateBounds();
+            Bounds.addToBox(FF.Bounds);
+        }
+    }
+    Flat.resize(N);
+    Segments.build(Flat);
+
+    //el círculo límite del contorno se centra en la caja límite
+    //y contiene los círculos límite de las figuras
+    Bounds.Pc.x = (Bounds.xmin + Bounds.xmax)/2;
+    Bounds.Pc.y = (Bounds.ymin + Bounds.ymax)/2;
+    Bounds.R = 0;
+    for(unsigned int i=0; i<Flat.size(); i++) {
+        double R = Mod(Flat[i].Bounds.Pc - Bounds.Pc) + Flat[i].Bounds.R;
+        if(R > Bounds.R)
+            Bounds.R = R;
+    }
+
+    //indica que la representación plana está actualizada
+    setFlatUpdated();
+}
+
+//obtiene la imagen plana del contorno
+//la representación plana debe estar actualizada
+void TContourFigureList::getFlatImage(TFlatImage& FI) const
+{
+    //la representación plana debe estar actualizada
+    if(!flatIsUpdated())
+        throw EImproperCall("the flat representation of the contour should be updated");
+
+    FI.Flat = Flat;
+    FI.Segments = Segments;
+    FI.Bounds = Bounds;
+}
+//restaura las figuras del contorno y su representación plana
+//a partir de una imagen plana obtenida de un contorno
+//con las mismas figuras
+void TContourFigureList::setFlatImage(const TFlatImage& FI)
+{
+    //asigna los vértices de las figuras no nulas
+    unsigned int N = 0;
+    for(int i=0; i<getCount(); i++) {
+        TContourFigure *F = Items[i];
+        if(F != NULL) {
+            if(N >= FI.Flat.size())
+                throw EImproperArgument("flat image FI should be obtained from a contour with the same figures");
+            F->setFlat(FI.Flat[N++]);
+        }
+    }
+    if(N != FI.Flat.size())
+        throw EImproperArgument("flat image FI should be obtained from a contour with the same figures");
+
+    //asigna la representación plana
+    Flat = FI.Flat;
+    Segments = FI.Segments;
+    Bounds = FI.Bounds;
+
+    //indica que la representación plana está actualizada
+    setFlatUpdated();
+}
+
 //--------------------------------------------------------------------------
 //MÉTODOS DE CARACTERIZACIÓN:
 
@@ -428,6 +590,8 @@ double TContourFigureList::distanceMax(TDoublePoint P) const
 //determina la distancia mínima de un contorno a este contorno
 double TContourFigureList::distanceMin(const TContourFigureList &C) const
 {
+    PROFILE_SCOPE(pfContourFigureListDistanceMin);
+
     //el contorno C debería contener al menos una figura
     if(C.areAllNULL())
         throw EImproperArgument("contour C should contain one figure almost");
@@ -438,6 +602,81 @@ double TContourFigureList::distanceMin(const TContourFigureList &C) const
 
     double d; //distancia entre el par de figuras
     double dmin = DBL_MAX; //distancia mínima hasta el momento
+
+    //si las representaciones planas están actualizadas
+    if(flatIsUpdated() && C.flatIsUpdated()) {
+        //Se descartan los pares de figuras cuyos límites garantizan que su
+        //distancia no es inferior a dmin + ERR_NUM. El margen ERR_NUM absorbe
+        //el error numérico de las funciones de distancia, de modo que
+        //el resultado es el mismo que si se calculasen todas las distancias.
+
+        const unsigned int N = Flat.size();
+        const unsigned int No = C.Flat.size();
+
+        //empieza por el par formado por la figura de este contorno
+        //más próxima al círculo límite del otro contorno, y la figura
+        //del otro contorno más próxima al círculo límite de este,
+        //para reducir dmin lo antes posible sin recorrer todos los pares
+        unsigned int i0 = 0, j0 = 0;
+        double dlow = DBL_MAX;
+        for(unsigned int i=0; i<N; i++) {
+            d = Flat[i].Bounds.distanceMinCircles(C.Bounds);
+            if(d < dlow) {
+                dlow = d;
+                i0 = i;
+            }
+        }
+        dlow = DBL_MAX;
+        for(unsigned int j=0; j<No; j++) {
+            d = C.Flat[j].Bounds.distanceMinCircles(Bounds);
+            if(d < dlow) {
+                dlow = d;
+                j0 = j;
+            }
+        }
+        dmin = flatDistance(Flat[i0], C.Flat[j0]);
+        if(dmin <= 0)
+            return 0;
+
+        //por cada figura de este contorno
+        for(unsigned int i=0; i<N; i++) {
+            const TFlatFigure& FF = Flat[i];
+            //si la figura no puede reducir dmin, la descarta
+            if(FF.Bounds.isFartherThan(C.Bounds, dmin + ERR_NUM))
+                continue;
+            //si la figura es un segmento, calcula en lote
+            //la distancia a los segmentos del otro contorno
+            if(FF.type==cftSegment && C.Segments.Count>0) {
+                d = C.Segments.distanceMin(FF.Pa, FF.Pb);
+                if(d <= 0)
+                    return 0;
+                else if(d < dmin)
+                    dmin = d;
+            }
+            //por cada figura del otro contorno
+            for(unsigned int j=0; j<No; j++) {
+                const TFlatFigure& FFo = C.Flat[j];
+                //si el par ya ha sido calculado en lote, lo descarta
+                if(FF.type==cftSegment && FFo.type==cftSegment)
+                    continue;
+                //si el par ya ha sido calculado o no puede reducir dmin, lo descarta
+                if((i==i0 && j==j0) || FF.Bounds.isFartherThan(FFo.Bounds, dmin + ERR_NUM))
+                    continue;
+                //calcula la distancia entre figuras
+                d = flatDistance(FF, FFo);
+                //si la distancia no puedo reducirse más
+                if(d <= 0)
+                    return 0; //devuelve cero
+                else //si no
+                    //actualiza la distancia mínima
+                    if(d < dmin)
+                        dmin = d;
+            }
+        }
+
+        return dmin; //devuelve la distancia mínima
+    }
+
     TFigure *F; //puntero a una figura indicada de este contorno
     TFigure *Fo; //puntero a una figura indicada del otro contorno
     int i, j;
@@ -485,6 +724,48 @@ bool TContourFigureList::collides(const TContourFigureList &C, double SPM) const
         throw EImproperArgument("contour C should contain one figure almost");
 
     double d; //distancia entre el par de figuras
+
+    //si las representaciones planas están actualizadas
+    if(flatIsUpdated() && C.flatIsUpdated()) {
+        //Se descartan los pares de figuras cuyos límites garantizan que su
+        //distancia no es inferior a SPM + ERR_NUM. El margen ERR_NUM absorbe
+        //el error numérico de las funciones de distancia.
+
+        //si los contornos están suficientemente separados, no colisionan
+        if(Bounds.isFartherThan(C.Bounds, SPM + ERR_NUM))
+            return false;
+
+        //por cada figura de este contorno
+        for(unsigned int i=0; i<Flat.size(); i++) {
+            const TFlatFigure& FF = Flat[i];
+            //si la figura no puede colisionar, la descarta
+            if(FF.Bounds.isFartherThan(C.Bounds, SPM + ERR_NUM))
+                continue;
+            //si la figura es un segmento, calcula en lote
+            //la distancia a los segmentos del otro contorno
+            if(FF.type==cftSegment && C.Segments.Count>0)
+                if(C.Segments.distanceMin(FF.Pa, FF.Pb) < SPM)
+                    return true;
+            //por cada figura del otro contorno
+            for(unsigned int j=0; j<C.Flat.size(); j++) {
+                const TFlatFigure& FFo = C.Flat[j];
+                //si el par ya ha sido calculado en lote, lo descarta
+                if(FF.type==cftSegment && FFo.type==cftSegment)
+                    continue;
+                //si el par no puede colisionar, lo descarta
+                if(FF.Bounds.isFartherThan(FFo.Bounds, SPM + ERR_NUM))
+                    continue;
+                //calcula la distancia entre figuras
+                d = flatDistance(FF, FFo);
+                //si la distancia no puedo reducirse más
+                if(d < SPM)
+                    return true; //indica que si colisiona
+            }
+        }
+
+        return false; //indica que no colisiona
+    }
+
     TFigure *F; //puntero a una figura indicada de este contorno
     TFigure *Fo; //puntero a una figura indicada del otro contorno
     int i, j;
@@ -630,6 +911,9 @@ void TContourFigureList::getRotatedAndTranslated(TContourFigureList &Contour,
         //traslada la figura geométrica según el vector V
         F->translate(V);
     }
+
+    //actualiza la representación plana del contorno
+    Contour.updateFlat();
     //if(Contour.isAContourSorted())
     //      int xxx = 0;
 }
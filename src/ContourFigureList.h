@@ -29,6 +29,8 @@
 #include "PointersList.h"
 #include "Vectors.h"
 
+#include <vector>
+
 //---------------------------------------------------------------------------
 
 using namespace Mathematics;
@@ -37,6 +39,41 @@ using namespace Lists;
 //espacio de nombres de modelos
 namespace Models {
 
+//---------------------------------------------------------------------------
+//TFlatSegments
+//---------------------------------------------------------------------------
+
+//segmentos de una lista de figuras en representación plana,
+//en estructura de arrays para las funciones de distancia en lote:
+//los arrays se completan hasta un múltiplo de distanceBatchLanes()
+//repitiendo el último segmento, lo cual no altera la distancia mínima
+struct TFlatSegments {
+    //vértices (xa[j], ya[j]) y (xb[j], yb[j]) de los segmentos
+    vector<double> xa, ya, xb, yb;
+    //número de segmentos, sin contar los de relleno
+    unsigned int Count;
+
+    //construye una lista de segmentos vacía
+    TFlatSegments(void) : xa(), ya(), xb(), yb(), Count(0) {}
+
+    //reconstruye los arrays a partir de las figuras en representación plana
+    void build(const vector<TFlatFigure>& Flat);
+    //calcula la distancia mínima entre el segmento (Pa, Pb)
+    //y los segmentos de la lista
+    double distanceMin(TDoublePoint Pa, TDoublePoint Pb) const;
+};
+
+//imagen plana de un contorno: la representación plana de sus figuras
+//con sus límites, que permite restaurar el contorno sin recalcularlo
+struct TFlatImage {
+    vector<TFlatFigure> Flat;
+    TFlatSegments Segments;
+    TBounds Bounds;
+
+    //construye una imagen plana vacía
+    TFlatImage(void) : Flat(), Segments(), Bounds() {}
+};
+
 //---------------------------------------------------------------------------
 //TContourFigureList
 //---------------------------------------------------------------------------
@@ -48,7 +85,108 @@ namespace Models {
 
 //clase lista de figuras de contorno
 class TContourFigureList : public TItemsList<TContourFigure*> {
+protected:
+    //número de figuras de la lista cuando se actualizó
+    //la representación plana, o -1 si no está actualizada
+    int FlatCount;
+    //suma de las versiones de las figuras cuando se actualizó
+    //la representación plana
+    unsigned int FlatVersion;
+
+    //obtiene la suma de las versiones de las figuras no nulas
+    unsigned int getVersionSum(void) const;
+    //indica que la representación plana corresponde
+    //a las figuras actuales
+    void setFlatUpdated(void) {
+        FlatCount = getCount(); FlatVersion = getVersionSum();}
+
 public:
+    //-------------------------------------------------------------------
+    //REPRESENTACIÓN PLANA Y LÍMITES:
+
+    //figuras no nulas de la lista en representación plana,
+    //con sus límites
+    //solo es válida si flatIsUpdated()
+    vector<TFlatFigure> Flat;
+    //segmentos de Flat en estructura de arrays
+    //solo son válidos si flatIsUpdated()
+    TFlatSegments Segments;
+    //límites del contorno
+    //solo son válidos si flatIsUpdated()
+    TBounds Bounds;
+
+    //actualiza la representación plana de las figuras
+    //y los límites del contorno
+    void updateFlat(void);
+    //determina si la representación plana está actualizada
+    bool flatIsUpdated(void) const {
+        return FlatCount == getCount() && FlatVersion == getVersionSum();}
+    //invalida la representación plana
+    void invalidateFlat(void) {FlatCount = -1;}
+
+    //obtiene la imagen plana del contorno
+    //la representación plana debe estar actualizada
+    void getFlatImage(TFlatImage& FI) const;
+    //restaura las figuras del contorno y su representación plana
+    //a partir de una imagen plana obtenida de un contorno
+    //con las mismas figuras
+    void setFlatImage(const TFlatImage& FI);
+
+    //La representación plana es actualizada en getRotatedAndTranslated,
+    //y es usada en distanceMin y collides para recorrer las figuras
+    //en un vector contiguo y descartar los pares de figuras que no
+    //pueden determinar el resultado. Los pares segmento-segmento se
+    //evalúan en lote sobre Segments.
+    //Como las versiones de las figuras solo crecen, cualquier modificación
+    //de una figura de la lista (a través de sus métodos) incrementa
+    //la suma de las versiones, y la representación plana deja de estar
+    //actualizada, de modo que distanceMin y collides recurren
+    //a las figuras hasta que se invoque a updateFlat.
+
+    //-------------------------------------------------------------------
+    //MÉTODOS DE MODIFICACIÓN DE LA LISTA:
+
+    //Los siguientes métodos enmascaran los métodos heredados que
+    //modifican la lista, para invalidar la representación plana
+    //aunque no cambie el número de figuras.
+    //Las figuras modificadas a través de sus punteros invalidan
+    //la representación plana incrementando su versión.
+
+    //redimensiona la lista
+    void setCount(int N) {invalidateFlat(); TItemsList<TContourFigure*>::setCount(N);}
+    void NewFirst(int N=1) {invalidateFlat(); TItemsList<TContourFigure*>::NewFirst(N);}
+    void NewLast(int N=1) {invalidateFlat(); TItemsList<TContourFigure*>::NewLast(N);}
+    void DelFirst(int N=1) {invalidateFlat(); TItemsList<TContourFigure*>::DelFirst(N);}
+    void DelLast(int N=1) {invalidateFlat(); TItemsList<TContourFigure*>::DelLast(N);}
+
+    //escribe el elemento indicado
+    void Set(int i, TContourFigure* const& F) {
+        invalidateFlat(); TItemsList<TContourFigure*>::Set(i, F);}
+
+    //añade figuras a la lista
+    void Add(TContourFigure* const& F) {
+        invalidateFlat(); TItemsList<TContourFigure*>::Add(F);}
+    void Add(TItemsList<TContourFigure*>& L) {
+        invalidateFlat(); TItemsList<TContourFigure*>::Add(L);}
+    void InsertFirst(TContourFigure*& F) {
+        invalidateFlat(); TItemsList<TContourFigure*>::InsertFirst(F);}
+    void Insert(int i, TContourFigure* const& F) {
+        invalidateFlat(); TItemsList<TContourFigure*>::Insert(i, F);}
+
+    //borra figuras de la lista
+    void Delete(int i) {invalidateFlat(); TItemsList<TContourFigure*>::Delete(i);}
+    void Clear(void) {invalidateFlat(); TItemsList<TContourFigure*>::Clear();}
+
+    //asigna la lista en formato texto
+    void setItemsText(int i, const AnsiString& S) {
+        invalidateFlat(); TItemsList<TContourFigure*>::setItemsText(i, S);}
+    void setText(const AnsiString& S) {
+        invalidateFlat(); TItemsList<TContourFigure*>::setText(S);}
+    void setRowText(const AnsiString& S) {
+        invalidateFlat(); TItemsList<TContourFigure*>::setRowText(S);}
+    void setColumnText(const AnsiString& S) {
+        invalidateFlat(); TItemsList<TContourFigure*>::setColumnText(S);}
+
     //-------------------------------------------------------------------
     //MÉTODOS DE CONSTRUCCIÓN, COPIA Y CLONACIÓN:
 
@@ -130,7 +268,8 @@ public:
 
     //MÉTODOS DE TRANSFORMACIONES GEOMÉTRICAS:
 
-    //obtiene la lista de figuras rotada y trasladada.
+    //obtiene la lista de figuras rotada y trasladada,
+    //con la representación plana actualizada.
     //si el número de figuras de la lista no coincide:
     //      lanza EImproperArgument
     //si alguna figuradelalista no es del mimo tipo
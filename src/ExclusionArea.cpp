@@ -29,6 +29,7 @@
 #include "Strings.h" //StrIndent
 #include "TextFile.h"
 #include "RoboticPositioner.h"
+#include <mutex> //mutex, lock_guard
 
 //---------------------------------------------------------------------------
 
@@ -46,6 +47,8 @@ namespace Models {
 
 //lista de objetos construidos
 TItemsList<TExclusionArea*> TExclusionArea::Builts;
+//mutex for access to the list of built objects from several threads
+static mutex Builts_mutex;
 
 //---------------------------------------------------------------------------
 //PROPIEDADES:
@@ -411,6 +414,7 @@ TExclusionArea::TExclusionArea(void) :
     calculateSPM();
 
     //añade el objeto a la lista de contruidos
+    lock_guard<mutex> lock(Builts_mutex);
     Builts.Add(this);
 }
 //construye un área de exclusión
@@ -432,6 +436,7 @@ TExclusionArea::TExclusionArea(int Id, TDoublePoint P0, double thetaO1) :
     calculateSPM();
 
     //añade el objeto a la lista de contruidos
+    lock_guard<mutex> lock(Builts_mutex);
     Builts.Add(this);
 }
 
@@ -463,6 +468,7 @@ TExclusionArea::TExclusionArea(const TExclusionArea *EA) :
     clone(EA);
 
     //añade el objeto a la lista de contruidos
+    lock_guard<mutex> lock(Builts_mutex);
     Builts.Add(this);
 }
 
@@ -470,6 +476,8 @@ TExclusionArea::TExclusionArea(const TExclusionArea *EA) :
 //si el objeto no está en Builts lanza EImproperCall
 TExclusionArea::~TExclusionArea()
 {
+    lock_guard<mutex> lock(Builts_mutex);
+
     //debe haber algún objeto para destruir
     if(Builts.getCount() < 1)
         throw EImproperCall("there isn't an object to destroy");
@@ -365,73 +365,116 @@ void TExclusionAreaList::calculateLocationParameters(void)
 void TExclusionAreaList::determineAdjacents(const TRoboticPositionerList& RPL)
 {
     //por cada EA de la lista
-    for(int i=0; i<getCount(); i++) {
-        //apunta el EA indicado para facilitar su acceso
-        TExclusionArea *EA = Items[i];
-
-        //inicializa la lista de RPs adyacentes
-        EA->AdjacentRPs.Clear();
-
-        //para cada una de los RPs de la lista
-        for(int j=0; j<RPL.getCount(); j++) {
-            //apunta el RP indicada para facilitar su acceso
-            TRoboticPositioner *RP = RPL[j];
-            //si están lo bastante cerca como para colisionar
-            if(Mod(RP->getActuator()->getP0() - EA->Barrier.getP0()) <
-                    (RP->getActuator()->getr_max() + RP->getActuator()->getSPMall_a() +
-                     EA->Barrier.getr_max() + EA->Barrier.getSPM()) + ERR_NUM) {
-                //añade el RP a la lista de RPs adyacentes
-                EA->AdjacentRPs.Add(RP);
-            }
-        }
-    }
+    for(int i=0; i<getCount(); i++)
+        //determina sus RPs adyacentes
+        determineAdjacents(Items[i], RPL);
 }
 //ordena las listas de RPs adyacentes en
 //sentido levógiro empezando por el más próximo a 0
 void TExclusionAreaList::sortAdjacents(void)
 {
-    TPairTD<TRoboticPositioner> *P;
-    TPointersList<TPairTD<TRoboticPositioner> > LP(10, TPairTD<TRoboticPositioner>::Comparex,
-                                                   NULL, NULL, TPairTD<TRoboticPositioner>::Printx);
-
     //por cada EA de la lista
+    for(int i=0; i<getCount(); i++)
+        //ordena su lista de RPs adyacentes
+        sortAdjacents(Items[i]);
+}
+
+//determine again the RPs adjacents to the EAs which were adjacent
+//or become adjacent to some of the given RPs
+void TExclusionAreaList::updateAdjacents(const TRoboticPositionerList& RPL,
+                                         const TItemsList<TRoboticPositioner*>& Changed)
+{
+    //for each EA of the list
     for(int i=0; i<getCount(); i++) {
-        //apunta el EA indicado para facilitar su acceso
         TExclusionArea *EA = Items[i];
 
-        //vacia la lista de punteros a pares
-        LP.Clear();
-
-        //por cada posicionador adyacente
-        for(int j=0; j<EA->AdjacentRPs.getCount(); j++) {
-            //apunta el posicionador adyacente indicado para facilitar su acceso
-            TRoboticPositioner *RPA = EA->AdjacentRPs[j];
-
-            //construye el par (RPA, theta)
-            //con theta en [0, 2*M_PI)
-            P = new TPairTD<TRoboticPositioner>(RPA);
-            TDoublePoint V = RPA->getActuator()->getP0() - EA->Barrier.getP0();
-            if(Mod(V) != 0)
-                P->x = ArgPos(V);
+        //determine if the EA is affected:
+        //  some changed RP is in the list of adjacents, or
+        //  some changed RP is near enough to be adjacent
+        bool affected = false;
+        for(int k=0; k<Changed.getCount() && !affected; k++) {
+            TRoboticPositioner *RP = Changed[k];
+            if(Mod(RP->getActuator()->getP0() - EA->Barrier.getP0()) <
+                    (RP->getActuator()->getr_max() + RP->getActuator()->getSPMall_a() +
+                     EA->Barrier.getr_max() + EA->Barrier.getSPM()) + ERR_NUM)
+                affected = true;
             else
-                P->x = 0;
-
-            //ADVERTENCIA: un posicionador adyacente puede estar
-            //ubicado en el mismo lugar que el de referencia.
+                for(int j=0; j<EA->AdjacentRPs.getCount(); j++)
+                    if(EA->AdjacentRPs[j] == RP) {
+                        affected = true;
+                        break;
+                    }
+        }
 
-            //añade el par a la lista
-            LP.Add(P);
+        //determine and sort the adjacents of the affected EA
+        if(affected) {
+            determineAdjacents(EA, RPL);
+            sortAdjacents(EA);
         }
+    }
+}
 
-        //ordena la lista de posicionadores de menor a mayor ángulo
-        if(LP.getCount() > 1)
-            LP.SortInc(0, LP.getCount()-1);
+//determine the RPs adjacents to an EA
+void TExclusionAreaList::determineAdjacents(TExclusionArea *EA, const TRoboticPositionerList& RPL)
+{
+    //inicializa la lista de RPs adyacentes
+    EA->AdjacentRPs.Clear();
+
+    //search the candidates in the grid of the RPL, with a margin upper
+    //than ERR_NUM for absorb the numerical error, in the same order of the list
+    std::vector<int> candidates;
+    RPL.searchAdjacencyCandidates(candidates, EA->Barrier.getP0(),
+                                  EA->Barrier.getr_max() + EA->Barrier.getSPM() + 2*ERR_NUM);
+
+    //para cada una de los RPs candidatos
+    for(unsigned int k=0; k<candidates.size(); k++) {
+        //apunta el RP indicada para facilitar su acceso
+        TRoboticPositioner *RP = RPL[candidates[k]];
+        //si están lo bastante cerca como para colisionar
+        if(Mod(RP->getActuator()->getP0() - EA->Barrier.getP0()) <
+                (RP->getActuator()->getr_max() + RP->getActuator()->getSPMall_a() +
+                 EA->Barrier.getr_max() + EA->Barrier.getSPM()) + ERR_NUM) {
+            //añade el RP a la lista de RPs adyacentes
+            EA->AdjacentRPs.Add(RP);
+        }
+    }
+}
+//sort the list of RPs adjacents to an EA
+void TExclusionAreaList::sortAdjacents(TExclusionArea *EA)
+{
+    TPairTD<TRoboticPositioner> *P;
+    TPointersList<TPairTD<TRoboticPositioner> > LP(10, TPairTD<TRoboticPositioner>::Comparex,
+                                                   NULL, NULL, TPairTD<TRoboticPositioner>::Printx);
 
-        //transcribe la lista
-        EA->AdjacentRPs.Clear();
-        for(int j=0; j<LP.getCount(); j++)
-            EA->AdjacentRPs.Add(LP[j].P);
+    //por cada posicionador adyacente
+    for(int j=0; j<EA->AdjacentRPs.getCount(); j++) {
+        //apunta el posicionador adyacente indicado para facilitar su acceso
+        TRoboticPositioner *RPA = EA->AdjacentRPs[j];
+
+        //construye el par (RPA, theta)
+        //con theta en [0, 2*M_PI)
+        P = new TPairTD<TRoboticPositioner>(RPA);
+        TDoublePoint V = RPA->getActuator()->getP0() - EA->Barrier.getP0();
+        if(Mod(V) != 0)
+            P->x = ArgPos(V);
+        else
+            P->x = 0;
+
+        //ADVERTENCIA: un posicionador adyacente puede estar
+        //ubicado en el mismo lugar que el de referencia.
+
+        //añade el par a la lista
+        LP.Add(P);
     }
+
+    //ordena la lista de posicionadores de menor a mayor ángulo
+    if(LP.getCount() > 1)
+        LP.SortInc(0, LP.getCount()-1);
+
+    //transcribe la lista
+    EA->AdjacentRPs.Clear();
+    for(int j=0; j<LP.getCount(); j++)
+        EA->AdjacentRPs.Add(LP[j].P);
 }
 
 //asimila la configurración de posicionadores dada ejecutando:
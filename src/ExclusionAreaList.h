@@ -51,6 +51,13 @@ protected:
 
     double p_rmax;
 
+    //ADJACENCY:
+
+    //determine the RPs adjacents to an EA
+    void determineAdjacents(TExclusionArea *EA, const TRoboticPositionerList& RPL);
+    //sort the list of RPs adjacents to an EA
+    void sortAdjacents(TExclusionArea *EA);
+
 /*    double p_xmin;
     double p_xmax;
     double p_ymin;
@@ -190,6 +197,15 @@ public:
     //sentido levógiro empezando por el más próximo a 0
     void sortAdjacents(void);
 
+    //determine again the RPs adjacents to the EAs which were adjacent
+    //or become adjacent to some of the given RPs,
+    //keeping the other lists of adjacents, so that the result is the same
+    //than determineAdjacents followed by sortAdjacents
+    //All given RPs shall be in the list RPL, and only them shall be
+    //changed since the last assimilation.
+    void updateAdjacents(const TRoboticPositionerList& RPL,
+                         const TItemsList<TRoboticPositioner*>& Changed);
+
     //asimila la configurración de posicionadores dada ejecutando:
     //  calculateSPM();
     //  calculateLocationParameters();
@@ -27,6 +27,10 @@
 #include "StrPR.h"
 
 #include <algorithm> //transform
+#include <cstring> //memchr, strncmp
+#include <cerrno> //errno
+#include <climits> //INT_MIN, INT_MAX
+#include <cmath> //HUGE_VAL
 
 using namespace Strings;
 
@@ -406,6 +410,382 @@ bool TObservingSource::operator!=(const TObservingSource& OS)
     return false;
 }
 
+//---------------------------------------------------------------------------
+//FUNCTIONS FOR READ A FMOSA IN A SINGLE PASS:
+
+//All functions works on a slice [first, last) of the string,
+//reproducing the behavior of the functions used by the former parser
+//(StrDivideInLines, StrTrim, StrSplit, strToFloat, strToInt, ...),
+//without build intermediate strings.
+
+//determine if a char is kept by StrTrim
+//(printable or latin printable, and distinct of space)
+static inline bool isTrimKept(char c)
+{
+    unsigned char uc = (unsigned char)c;
+    return (uc>=160 || (uc<128 && isprint(uc))) && c!=' ';
+}
+
+//discard the marginal chars which are discarded by StrTrim
+static inline void trimSlice(const char*& first, const char*& last)
+{
+    while(first<last && !isTrimKept(*first))
+        first++;
+    while(first<last && !isTrimKept(*(last - 1)))
+        last--;
+}
+
+//determine if the trimmed slice is equal to the label
+static bool trimmedSliceIs(const char *first, const char *last, const char *label)
+{
+    trimSlice(first, last);
+    size_t n = strlen(label);
+    return size_t(last - first) == n && strncmp(first, label, n) == 0;
+}
+
+//travel the separators (' ', '\t' or "\r\n") in the same way as
+//strTravelSeparatorsIfAny (including a '\r' in the last position)
+static inline void travelSeparators(const char*& p, const char *last)
+{
+    while(p < last) {
+        if(*p==' ' || *p=='\t')
+            p++;
+        else if(*p=='\r' && (p+1==last || *(p + 1)=='\n'))
+            p += (p+1 == last) ? 1 : 2;
+        else
+            return;
+    }
+}
+
+//search and return the first non separator char in a slice
+//in the same way as strFirstNonseparatorChar
+static char firstNonseparatorChar(const char *first, const char *last)
+{
+    const char *p = first;
+    while(p < last) {
+        if(*p==' ' || *p=='\t')
+            p++;
+        else if(*p == '\r') {
+            if(p+1>=last || *(p + 1)!='\n')
+                throw EImproperArgument("\r should be followed by \n");
+            p += 2;
+        } else
+            return *p;
+    }
+    return 0;
+}
+
+//determine if a line is a comment or is empty
+static inline bool isSkippableLine(const char *first, const char *last)
+{
+    if(firstNonseparatorChar(first, last) == '#')
+        return true;
+    trimSlice(first, last);
+    return first >= last;
+}
+
+//look for unexpected text after a value
+static void checkUnexpectedText(const char *p, const char *last)
+{
+    travelSeparators(p, last);
+    if(p < last)
+        throw EImproperArgument("unexpected text: \""+StrFirstChars(string(p, last - p)).str+"\"");
+}
+
+//skip the separators before a value, throwing an exception
+//if there is a '\r' which is not followed by '\n'
+static void skipLeadingSeparators(const char*& p, const char *last)
+{
+    while(p < last) {
+        if(*p==' ' || *p=='\t')
+            p++;
+        else if(*p == '\r') {
+            if(p+1>=last || *(p + 1)!='\n')
+                throw EImproperArgument("'\\n' not found");
+            p += 2;
+        } else
+            return;
+    }
+}
+
+//copy a numeric token in a null terminated buffer
+//and translate it using the function strto
+//return false if the token has not been translated whole
+template <class T, class F>
+static bool convertToken(T& value, const char *first, const char *last, F strto)
+{
+    char buffer[64];
+    string aux;
+    const char *s;
+    size_t n = last - first;
+    if(n < sizeof(buffer)) {
+        memcpy(buffer, first, n);
+        buffer[n] = '\0';
+        s = buffer;
+    } else {
+        aux.assign(first, n);
+        s = aux.c_str();
+    }
+    char *end;
+    errno = 0;
+    value = strto(s, &end);
+    return end == s + n;
+}
+
+static double strtodWrapper(const char *s, char **end) {return strtod(s, end);}
+static long strtolWrapper(const char *s, char **end) {return strtol(s, end, 10);}
+
+//translate a slice to double in the same way as strToFloat
+static double sliceToFloat(const char *first, const char *last)
+{
+    try {
+        const char *p = first;
+        skipLeadingSeparators(p, last);
+
+        //delimit the token: [+-]digits[.[digits]][(e|E)[+-]digits]
+        const char *t = p;
+        if(p<last && (*p=='+' || *p=='-'))
+            p++;
+        if(p>=last || *p<'0' || '9'<*p)
+            throw EImproperArgument("floating point value not found");
+        while(p<last && '0'<=*p && *p<='9')
+            p++;
+        if(p<last && *p==get_decimal_separator()) {
+            p++;
+            while(p<last && '0'<=*p && *p<='9')
+                p++;
+        }
+        if(p<last && (*p=='e' || *p=='E')) {
+            //the exponent is taken only if it has some decimal char
+            const char *e = p++;
+            if(p<last && (*p=='+' || *p=='-'))
+                p++;
+            if(p>=last || *p<'0' || '9'<*p)
+                p = e;
+            else
+                while(p<last && '0'<=*p && *p<='9')
+                    p++;
+        }
+
+        //look for unexpected text
+        checkUnexpectedText(p, last);
+
+        //translate the value to numerical type
+        double value;
+        bool ok = convertToken(value, t, p, strtodWrapper);
+        if(!ok || (errno==ERANGE && (value==HUGE_VAL || value==-HUGE_VAL)))
+            throw EImproperArgument(AnsiString("can't convert string to double"));
+
+        return value;
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "converting string to float: ");
+        throw;
+    }
+}
+
+//translate a slice to int in the same way as strToInt
+static int sliceToInt(const char *first, const char *last)
+{
+    try {
+        const char *p = first;
+        skipLeadingSeparators(p, last);
+
+        //delimit the token: [+-]digits
+        const char *t = p;
+        if(p<last && (*p=='+' || *p=='-'))
+            p++;
+        if(p>=last || *p<'0' || '9'<*p)
+            throw EImproperArgument("integer value not found");
+        while(p<last && '0'<=*p && *p<='9')
+            p++;
+
+        //look for unexpected text
+        checkUnexpectedText(p, last);
+
+        //translate the value to numerical type
+        long value;
+        bool ok = convertToken(value, t, p, strtolWrapper);
+        if(!ok || errno==ERANGE || value<INT_MIN || INT_MAX<value)
+            throw EImproperArgument(AnsiString("can't convert string to int"));
+
+        return int(value);
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "converting string to int: ");
+        throw;
+    }
+}
+
+//translate a slice to bool in the same way as strToBool
+static bool sliceToBool(const char *first, const char *last)
+{
+    try {
+        const char *p = first;
+        travelSeparators(p, last);
+
+        //read the value
+        bool value;
+        size_t n = last - p;
+        if(n>=1 && (*p=='0' || *p=='1')) {
+            value = (*p == '1');
+            p++;
+        } else if(n>=5 && (*p=='f' || *p=='F') && strncmp(p + 1, "alse", 4)==0) {
+            value = false;
+            p += 5;
+        } else if(n>=4 && (*p=='t' || *p=='T') && strncmp(p + 1, "rue", 3)==0) {
+            value = true;
+            p += 4;
+        } else
+            throw EImproperArgument("boolean value not found");
+
+        //look for unexpected text
+        checkUnexpectedText(p, last);
+
+        return value;
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "converting string to bool: ");
+        throw;
+    }
+}
+
+//translate a slice to TPointType in the same way as strToPointType
+static TPointType sliceToPointType(const char *first, const char *last)
+{
+    const char *p = first;
+    travelSeparators(p, last);
+
+    size_t n = last - p;
+    if(n>=9 && strncmp(p, "REFERENCE", 9)==0)
+        return ptREFERENCE;
+    if(n>=7 && strncmp(p, "UNKNOWN", 7)==0)
+        return ptUNKNOWN;
+    if(n>=6 && strncmp(p, "SOURCE", 6)==0)
+        return ptSOURCE;
+    if(n>=5 && strncmp(p, "BLANK", 5)==0)
+        return ptBLANK;
+
+    throw EImproperArgument("Point Type should be [\"UNKNOWN\" | \"SOURCE\" | \"REFERENCE\" | \"BLANCK\"] but it is: \""+StrFirstChars(strTrim(string(p, last - p))).str+"\"");
+}
+
+//split a line in fields separated by '|' in the same way as StrSplit
+//return the number of fields (up to N + 1)
+static int splitFields(const char *fields_first[], const char *fields_last[], int N,
+                       const char *first, const char *last)
+{
+    if(first >= last)
+        return 0;
+
+    int count = 0;
+    const char *p = first;
+    while(count <= N) {
+        const char *q = (const char*)memchr(p, '|', last - p);
+        if(count < N) {
+            fields_first[count] = p;
+            fields_last[count] = (q == NULL) ? last : q;
+        }
+        count++;
+        if(q == NULL)
+            break;
+        p = q + 1;
+    }
+    return count;
+}
+
+//determine if a comment is the header of the OB section:
+//  "# Id | Ra | Dec | Pos"
+static bool isOBHeader(string str)
+{
+    try {
+        transform(str.begin(), str.end(), str.begin(), (int (*)(int))tolower);
+        unsigned int i = 0;
+        strTravelSeparatorsIfAny(str, i);
+        strTravelLabel("#", str, i);
+        strTravelSeparatorsIfAny(str, i);
+        strTravelLabel("id", str, i);
+        strTravelSeparatorsIfAny(str, i);
+        strTravelLabel("|", str, i);
+        strTravelSeparatorsIfAny(str, i);
+        strTravelLabel("ra", str, i);
+        strTravelSeparatorsIfAny(str, i);
+        strTravelLabel("|", str, i);
+        strTravelSeparatorsIfAny(str, i);
+        strTravelLabel("dec", str, i);
+        strTravelSeparatorsIfAny(str, i);
+        strTravelLabel("|", str, i);
+        strTravelSeparatorsIfAny(str, i);
+        strTravelLabel("pos", str, i);
+    }
+    catch(...) {
+        return false;
+    }
+    return true;
+}
+
+//cursor to the lines of a text in the same way as StrDivideInLines:
+//lines are separated by "\r\n", where the '\r' is not preceded by
+//other '\r' which has been taken as a char of the line
+class TLineCursor {
+    const char *p;      //first char of the next line
+    const char *end;    //pos-last char of the text
+    bool finished;      //indicates if there aren't more lines
+
+public:
+    int i;              //index to the actual line
+    const char *first;  //first char of the actual line
+    const char *last;   //pos-last char of the actual line
+    bool there_is;      //indicates if there is actual line
+
+    //point to the next line
+    void next(void)
+    {
+        i++;
+        if(finished) {
+            there_is = false;
+            return;
+        }
+        first = p;
+        const char *q = p;
+        while(true) {
+            q = (const char*)memchr(q, '\n', end - q);
+            //count the '\r' which precede the '\n' (or the end of the text)
+            const char *r = (q == NULL) ? end : q;
+            const char *s = r;
+            while(s>first && *(s - 1)=='\r')
+                s--;
+            bool odd = ((r - s) % 2) == 1;
+
+            if(q == NULL) {
+                //the last '\r' without pair is discarded
+                last = odd ? end - 1 : end;
+                p = end;
+                finished = true;
+                break;
+            }
+            if(odd) {
+                last = q - 1;
+                p = q + 1;
+                break;
+            }
+            q++;
+        }
+        there_is = true;
+    }
+    //determine if the actual line is a comment or is empty
+    bool skippable(void) const {return isSkippableLine(first, last);}
+    //determine if the actual line contains only the label
+    bool is(const char *label) const {return trimmedSliceIs(first, last, label);}
+
+    //point to the first line of the text
+    TLineCursor(const string& str) :
+        p(str.data()), end(str.data() + str.length()), finished(false),
+        i(-1), first(NULL), last(NULL), there_is(false)
+    {
+        next();
+    }
+};
+
 //---------------------------------------------------------------------------
 //class TFMOSA:
 
@@ -558,197 +938,284 @@ string TFMOSA::getDate_of_generation(void) const
     return "";
 }
 
-//read the OB section in tampon variables
-void TFMOSA::readOBText(int& _Id, double& _Ra, double& _Dec, double& _Pos,
-                             const string& str)
-{
-    try {
-        //decompose the row in fields
-        TStrings Strings;
-        StrSplit(Strings, str, '|');
-
-        //check the number of fields
-        if(Strings.getCount() != 4)
-            throw EImproperArgument("should have 4 fields separated by '|': \"<Id> | <Ra> | <Dec> | <Pos>\"");
-
-        //trims Id property
-        try {
-            int aux = strToInt(Strings[0].str);
-            if(aux < 0)
-                throw EImproperArgument("value for block identifier Id shouldbe nonnegative");
-            _Id = (unsigned int)aux;
-        } catch(Exception& E) {
-            E.Message.Insert(1, "reading Id: ");
-            throw;
-        }
-
-        //translate the (RA, Dec) properties
-        try {
-            _Ra = strToFloat(Strings[1].str);
-        } catch(Exception& E) {
-            E.Message.Insert(1, "reading Ra: ");
-            throw;
-        }
-        try {
-            _Dec = strToFloat(Strings[2].str);
-        } catch(Exception& E) {
-            E.Message.Insert(1, "reading Dec: ");
-            throw;
-        }
-
-        //translate Pos property (if it is not empty)
-        try {
-            _Pos = strToFloat(Strings[3].str);
-        } catch(Exception& E) {
-            E.Message.Insert(1, "reading Pos: ");
-            throw;
-        }
-    }
-    catch(Exception& E) {
-        E.Message.Insert(1, "reading OB section: ");
-        throw;
-    }
-}
-
 //set a FMOSA in text format
 void TFMOSA::setTableText(unsigned int& Bid, const string& str)
 {
-    int i; //index to rows
+    //point to the first line
+    TLineCursor L(str);
+    //column of the actual line where is the value which is read
+    int column = 1;
 
     try {
-        //divide the string str in lines
-        TStrings Strings;
-        StrDivideInLines(Strings, str);
-
-        //--------------------------------------------------------------
-
-        //initialize the index to the first line
-        i = 0;
-
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.there_is)
             throw EImproperArgument("label @@SOB@@ not found");
 
         //--------------------------------------------------------------
 
         //discard the empty lines and read the comments
         TFMOSA t_FMOSA;
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0)) {
-            if(strFirstNonseparatorChar(Strings[i].str)=='#')
-                t_FMOSA.comments.Add(StrTrim(Strings[i]));
-            i++;
+        while(L.there_is && L.skippable()) {
+            if(firstNonseparatorChar(L.first, L.last) == '#') {
+                const char *first = L.first;
+                const char *last = L.last;
+                trimSlice(first, last);
+                t_FMOSA.comments.Add(AnsiString(string(first, last - first)));
+            }
+            L.next();
         }
 
         //delete the header of the OB
-        try {
-            string str = t_FMOSA.comments[t_FMOSA.comments.getCount() - 1].str;
-            transform(str.begin(), str.end(), str.begin(), (int (*)(int))tolower);
-            unsigned int i = 0;
-            strTravelSeparatorsIfAny(str, i);
-            strTravelLabel("#", str, i);
-            strTravelSeparatorsIfAny(str, i);
-            strTravelLabel("id", str, i);
-            strTravelSeparatorsIfAny(str, i);
-            strTravelLabel("|", str, i);
-            strTravelSeparatorsIfAny(str, i);
-            strTravelLabel("ra", str, i);
-            strTravelSeparatorsIfAny(str, i);
-            strTravelLabel("|", str, i);
-            strTravelSeparatorsIfAny(str, i);
-            strTravelLabel("dec", str, i);
-            strTravelSeparatorsIfAny(str, i);
-            strTravelLabel("|", str, i);
-            strTravelSeparatorsIfAny(str, i);
-            strTravelLabel("pos", str, i);
+        if(t_FMOSA.comments.getCount() > 0 && isOBHeader(t_FMOSA.comments[t_FMOSA.comments.getCount() - 1].str))
             t_FMOSA.comments.setCount(t_FMOSA.comments.getCount() - 1);
-        }
-        catch(...) {
-            //do nothing
-        }
-
-        //check if there are more lines
-        if(i >= Strings.getCount())
-            throw EImproperArgument("label @@SOB@@ not found");
 
         //check if actual line contains the label @@SOB@@
-        if(StrTrim(Strings[i]) != AnsiString("@@SOB@@"))
+        if(!L.there_is || !L.is("@@SOB@@"))
             throw EImproperArgument("label @@SOB@@ not found");
 
         //discard the label @@SOB@@
-        i++;
+        L.next();
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
-            i++;
+        while(L.there_is && L.skippable())
+            L.next();
 
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.there_is)
             throw EImproperArgument("OB parameters not found: <Id> | <Ra> | <Dec> | <Pos>");
 
         //read the OB section in tampon variables
         int t_Id;
-        readOBText(t_Id, t_FMOSA.Ra, t_FMOSA.Dec, t_FMOSA.Pos, Strings[i].str);
+        try {
+            //decompose the row in fields
+            const char *ff[4], *fl[4];
+            if(splitFields(ff, fl, 4, L.first, L.last) != 4)
+                throw EImproperArgument("should have 4 fields separated by '|': \"<Id> | <Ra> | <Dec> | <Pos>\"");
+
+            //translate the values
+            try {
+                column = ff[0] - L.first + 1;
+                t_Id = sliceToInt(ff[0], fl[0]);
+                if(t_Id < 0)
+                    throw EImproperArgument("value for block identifier Id shouldbe nonnegative");
+            } catch(Exception& E) {
+                E.Message.Insert(1, "reading Id: ");
+                throw;
+            }
+            try {
+                column = ff[1] - L.first + 1;
+                t_FMOSA.Ra = sliceToFloat(ff[1], fl[1]);
+            } catch(Exception& E) {
+                E.Message.Insert(1, "reading Ra: ");
+                throw;
+            }
+            try {
+                column = ff[2] - L.first + 1;
+                t_FMOSA.Dec = sliceToFloat(ff[2], fl[2]);
+            } catch(Exception& E) {
+                E.Message.Insert(1, "reading Dec: ");
+                throw;
+            }
+            try {
+                column = ff[3] - L.first + 1;
+                t_FMOSA.Pos = sliceToFloat(ff[3], fl[3]);
+            } catch(Exception& E) {
+                E.Message.Insert(1, "reading Pos: ");
+                throw;
+            }
+            column = 1;
+        }
+        catch(Exception& E) {
+            E.Message.Insert(1, "reading OB section: ");
+            throw;
+        }
 
         //contabilize the readed line
-        i++;
+        L.next();
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
-            i++;
-
-        //check if there are more lines
-        if(i >= Strings.getCount())
-            throw EImproperArgument("label @@EOB@@ not found");
+        while(L.there_is && L.skippable())
+            L.next();
 
         //check if actual line contains the label @@EOB@@
-        if(StrTrim(Strings[i]) != AnsiString("@@EOB@@"))
+        if(!L.there_is || !L.is("@@EOB@@"))
             throw EImproperArgument("label @@EOB@@ not found");
 
         //discard the label @@EOB@@
-        i++;
-
-        //check if there are more lines
-        if(i >= Strings.getCount())
-            throw EImproperArgument("label @@SOS@@ not found");
+        L.next();
 
         //--------------------------------------------------------------
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i]).Length()<=0))
-            i++;
-
-        //check if there are more lines
-        if(i >= Strings.getCount())
-            throw EImproperArgument("label @@SOS@@ not found");
+        while(L.there_is && L.skippable())
+            L.next();
 
         //check if actual line contains the label @@SOS@@
-        if(StrTrim(Strings[i]) != AnsiString("@@SOS@@"))
+        if(!L.there_is || !L.is("@@SOS@@"))
             throw EImproperArgument("label @@SOS@@ not found");
 
         //discard the label @@SOS@@
-        i++;
+        L.next();
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
-            i++;
+        while(L.there_is && L.skippable())
+            L.next();
 
         //check if there are more lines
-        if(i >= Strings.getCount())
+        if(!L.there_is)
             throw EImproperArgument("OS parameters not found: \"<Name> | <RA> | <Dec> | <Mag> | <Type> | <Pr> | <Bid> | <Pid> | <X(mm)> | <Y(mm)> | | <Angle(deg)> | <Enabled> | <Comment>\"");
 
         //read all lines (using a tampon variable) until the close label @@EOS@
         try {
-            while(i<Strings.getCount() && StrTrim(Strings[i])!=AnsiString("@@EOS@@")) {
+            while(L.there_is && !L.is("@@EOS@@")) {
                 TObservingSource *OS = new TObservingSource();
                 t_FMOSA.Add(OS);
-                OS->setText(Strings[i].str);
+
+                try {
+                    //decompose the row in fields
+                    const char *ff[13], *fl[13];
+                    if(splitFields(ff, fl, 13, L.first, L.last) != 13)
+                        throw EImproperArgument("should have 13 fields separated by '|': \"<Name> | <RA> | <Dec> | <Mag> | <Type> | <Pr> | <Bid> | <Pid> | <X(mm)> | <Y(mm)> | <Angle(deg)> | <Enabled> | <Comment>\"");
+
+                    //trims Name property
+                    const char *first = ff[0];
+                    const char *last = fl[0];
+                    trimSlice(first, last);
+                    OS->Name.assign(first, last - first);
+
+                    //translate the (RA, Dec) properties
+                    try {
+                        column = ff[1] - L.first + 1;
+                        OS->RA = sliceToFloat(ff[1], fl[1]);
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading Ra: ");
+                        throw;
+                    }
+                    try {
+                        column = ff[2] - L.first + 1;
+                        OS->Dec = sliceToFloat(ff[2], fl[2]);
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading Dec: ");
+                        throw;
+                    }
+
+                    //translate Mag property (if it is not empty)
+                    try {
+                        column = ff[3] - L.first + 1;
+                        first = ff[3];
+                        last = fl[3];
+                        trimSlice(first, last);
+                        OS->there_is_Mag = first < last;
+                        if(OS->there_is_Mag)
+                            OS->Mag = sliceToFloat(first, last);
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading Mag: ");
+                        throw;
+                    }
+
+                    //translate Type property
+                    try {
+                        column = ff[4] - L.first + 1;
+                        OS->Type = sliceToPointType(ff[4], fl[4]);
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading Type: ");
+                        throw;
+                    }
+
+                    //translate Pr property (if it is not empty)
+                    try {
+                        column = ff[5] - L.first + 1;
+                        first = ff[5];
+                        last = fl[5];
+                        trimSlice(first, last);
+                        OS->there_is_Pr = first < last;
+                        if(OS->there_is_Pr) {
+                            int Pr = sliceToInt(first, last);
+                            if(Pr < 0)
+                                throw EImproperArgument("priority Pr should be nonnegative");
+                            OS->Pr = (unsigned int)Pr;
+                        }
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading Pr: ");
+                        throw;
+                    }
+
+                    //translate Bid property (if it is not empty)
+                    try {
+                        column = ff[6] - L.first + 1;
+                        first = ff[6];
+                        last = fl[6];
+                        trimSlice(first, last);
+                        OS->there_is_Bid = first < last;
+                        if(OS->there_is_Bid) {
+                            int Bid = sliceToInt(first, last);
+                            if(Bid < 0)
+                                throw EImproperArgument("block identifier Bid should be nonnegative");
+                            OS->Bid = (unsigned int)Bid;
+                        }
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading Bid: ");
+                        throw;
+                    }
+
+                    //translate projection point properties
+                    try {
+                        column = ff[7] - L.first + 1;
+                        int Pid = sliceToInt(ff[7], fl[7]);
+                        if(Pid < 0)
+                            throw EImproperArgument("positioner identifier Pid should be nonnegative");
+                        OS->Pid = (unsigned int)Pid;
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading Pid: ");
+                        throw;
+                    }
+                    try {
+                        column = ff[8] - L.first + 1;
+                        OS->X = sliceToFloat(ff[8], fl[8]);
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading X: ");
+                        throw;
+                    }
+                    try {
+                        column = ff[9] - L.first + 1;
+                        OS->Y = sliceToFloat(ff[9], fl[9]);
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading Y: ");
+                        throw;
+                    }
+                    try {
+                        column = ff[10] - L.first + 1;
+                        OS->Angle = sliceToFloat(ff[10], fl[10]);
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading Angle: ");
+                        throw;
+                    }
+                    try {
+                        column = ff[11] - L.first + 1;
+                        OS->Enabled = sliceToBool(ff[11], fl[11]);
+                    } catch(Exception& E) {
+                        E.Message.Insert(1, "reading Enabled: ");
+                        throw;
+                    }
+
+                    //trims Comment property
+                    first = ff[12];
+                    last = fl[12];
+                    trimSlice(first, last);
+                    OS->Comment.assign(first, last - first);
+                    column = 1;
+                }
+                catch(Exception& E) {
+                    E.Message.Insert(1, "setting an OS: ");
+                    throw;
+                }
 
                 //check the precondition
                 if(OS->Type != ptUNKNOWN)
                     if(OS->Bid != (unsigned int)t_Id)
                         throw EImproperArgument("all Bid should be equal to Id");
 
-                i++;
+                L.next();
             }
         }
         catch(Exception& E) {
@@ -756,39 +1223,35 @@ void TFMOSA::setTableText(unsigned int& Bid, const string& str)
             throw;
         }
 
-        //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
-            i++;
-
-        //check if there are more lines
-        if(i >= Strings.getCount())
-            throw EImproperArgument("label @@EOS@@ not found");
-
         //check if actual line contains the label @@EOS@@
-        if(StrTrim(Strings[i]) != AnsiString("@@EOS@@"))
+        if(!L.there_is || !L.is("@@EOS@@"))
             throw EImproperArgument("label @@EOS@@ not found");
 
         //discard the label @@EOS@@
-        i++;
+        L.next();
 
         //discard the coments and empty lines
-        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i]).Length()<=0))
-            i++;
+        while(L.there_is && L.skippable())
+            L.next();
 
         //look for unexpected text
-        if(i < Strings.getCount())
+        if(L.there_is)
             throw EImproperArgument("only should to be OB and OS block");
 
         //--------------------------------------------------------------
 
-        //set the tampons variables
-        t_FMOSA.Id = (unsigned int)t_Id;
-        *this = t_FMOSA;
+        //move the OSs from the tampon variable without copy them
+        Clear();
+        for(int i=0; i<t_FMOSA.getCount(); i++)
+            Add(t_FMOSA.GetPointer(i));
+        t_FMOSA.ClearWithoutDestroy();
 
-        //REMEMBER: not define the operator= may produce erased of attributes. E.i:
-        //  *this = t_FMOSA;
-        //When TFMOSA::operator= is not defined, is called the function TPointersList<>::operator=,
-        //but properties of the FMOSA also will be assigned.
+        //set the tampons variables
+        comments = t_FMOSA.comments;
+        Id = (unsigned int)t_Id;
+        Ra = t_FMOSA.Ra;
+        Dec = t_FMOSA.Dec;
+        Pos = t_FMOSA.Pos;
 
         //set the last valid setted string
         str_original = str;
@@ -797,7 +1260,7 @@ void TFMOSA::setTableText(unsigned int& Bid, const string& str)
         Bid = Id;
     }
     catch(Exception& E) {
-        E.Message.Insert(1, "setting FMOSA in text format in row "+inttostr(i+1)+": ");
+        E.Message.Insert(1, "setting FMOSA in text format in row "+inttostr(L.i+1)+", column "+inttostr(column)+": ");
         throw;
     }
 }
@@ -145,10 +145,6 @@ private:
     /// if not found return empty string
     string getDate_of_generation(void) const;
 
-    /// read the OB section in tampon variables
-    void readOBText(int& _Id, double& _Ra, double& _Dec, double& _Pos,
-                    const string& str);
-
 public:
     /// @brief last valid setted FMOSA in text format including comments
     /// - default value: ""
@@ -163,7 +159,10 @@ public:
     double Dec;         ///< the declination of the block
     double Pos;         ///< position angle
 
-    /// set a FMOSA in text format
+    /// @brief set a FMOSA in text format
+    /// - the string is read in a single pass without divide it in lines
+    ///   nor in fields, converting the values directly from the string.
+    /// - in case of error the message indicates the row and the column.
     void setTableText(unsigned int& Bid, const string& str);
 
     /// get the FMOSA in text format
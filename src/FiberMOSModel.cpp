@@ -208,6 +208,69 @@ void TFiberMOSModel::assimilate()
     EAL.determineAdjacents(RPL);
     EAL.sortAdjacents();
 }
+//assimilate the changes of the given RPs,
+//recalculating only the adjacency of the affected RPs and EAs
+void TFiberMOSModel::assimilate(const TItemsList<TRoboticPositioner*>& Changed)
+{
+    RPL.assimilate(EAL, Changed);
+    EAL.updateAdjacents(RPL, Changed);
+}
+
+//restore the state of the RPs and the EAs from a clone of this FMM
+void TFiberMOSModel::restoreState(const TFiberMOSModel& FMM)
+{
+    //check the preconditions
+    if(FMM.RPL.getCount() != RPL.getCount())
+        throw EImproperArgument("FMM should contains the same RPs than this FMM");
+    for(int i=0; i<RPL.getCount(); i++) {
+        const TActuator *A = RPL[i]->getActuator();
+        const TActuator *A_ = FMM.RPL[i]->getActuator();
+        if(A_->getId() != A->getId() ||
+                A_->AdjacentRPs.getCount() != A->AdjacentRPs.getCount() ||
+                A_->AdjacentEAs.getCount() != A->AdjacentEAs.getCount())
+            throw EImproperArgument("FMM should contains the same RPs than this FMM");
+    }
+    if(FMM.EAL.getCount() != EAL.getCount())
+        throw EImproperArgument("FMM should contains the same EAs than this FMM");
+    for(int i=0; i<EAL.getCount(); i++)
+        if(FMM.EAL[i]->getId() != EAL[i]->getId())
+            throw EImproperArgument("FMM should contains the same EAs than this FMM");
+
+    //for each RP of the list
+    for(int i=0; i<RPL.getCount(); i++) {
+        TRoboticPositioner *RP = RPL[i];
+        TActuator *A = RP->getActuator();
+        const TActuator *A_ = FMM.RPL[i]->getActuator();
+
+        //The adjacents of the clone point to other RPs and EAs,
+        //so the adjacents of the RP must be kept.
+        TAdjacentEAList AdjacentEAs(A->AdjacentEAs);
+        TAdjacentRPList AdjacentRPs(A->AdjacentRPs);
+
+        //copy all properties of the RP of the clone
+        RP->clone(FMM.RPL[i]);
+
+        //restore the adjacents with the distances of the clone
+        A->AdjacentEAs.Clone(AdjacentEAs);
+        A->AdjacentRPs.Clone(AdjacentRPs);
+        for(int j=0; j<A->AdjacentEAs.getCount(); j++) {
+            A->AdjacentEAs[j].Dmin = A_->AdjacentEAs[j].Dmin;
+            A->AdjacentEAs[j].Dend = A_->AdjacentEAs[j].Dend;
+        }
+        for(int j=0; j<A->AdjacentRPs.getCount(); j++) {
+            A->AdjacentRPs[j].Dmin = A_->AdjacentRPs[j].Dmin;
+            A->AdjacentRPs[j].Dend = A_->AdjacentRPs[j].Dend;
+        }
+    }
+
+    //for each EA of the list
+    for(int i=0; i<EAL.getCount(); i++)
+        EAL[i]->Pending = FMM.EAL[i]->Pending;
+
+    //the restored slots are unlinked, so the edges shall be rebuilt
+    //(the new edges are not calculated)
+    RPL.buildAdjacencyEdges();
+}
 
 //MÉTODOS PARA DETERMINAR SI HAY COLISIONES:
 
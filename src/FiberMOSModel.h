@@ -135,6 +135,19 @@ public:
 
         //asimila la configuración de las listas de objetos
         void assimilate(void);
+        //assimilate the changes of the given RPs,
+        //recalculating only the adjacency of the affected RPs and EAs
+        //All given RPs shall be in the list RPL, and only them shall be
+        //changed since the last assimilation.
+        void assimilate(const TItemsList<TRoboticPositioner*>& Changed);
+
+        //restore the state of the RPs and the EAs from a clone of this FMM:
+        //positions, quantifiers, purposes, status, motion functions and
+        //the distances to the adjacents, keeping the adjacents of this FMM,
+        //so that the FMM hasn't to be reassimilated
+        //The FMM shall be a clone of this FMM, whose geometry has not
+        //been changed since the clonation.
+        void restoreState(const TFiberMOSModel& FMM);
 
         //MÉTODOS PARA DETERMINAR SI HAY COLISIONES:
 
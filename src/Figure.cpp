@@ -26,6 +26,9 @@
 #include "Strings.h"
 #include "Geometry.h"
 #include "Scalars.h"
+#include "Constants.h" //ERR_NUM
+
+#include <float.h> //DBL_MAX
 
 //---------------------------------------------------------------------------
 
@@ -1079,6 +1082,200 @@ void TCircunference::translate(TDoublePoint V)
     P.y += V.y;
 }
 
+//--------------------------------------------------------------------------
+//TBounds
+//--------------------------------------------------------------------------
+
+//construye unos límites vacíos
+TBounds::TBounds(void) :
+    xmin(DBL_MAX), xmax(-DBL_MAX), ymin(DBL_MAX), ymax(-DBL_MAX),
+    Pc(0, 0), R(0)
+{
+}
+
+//inicializa la caja límite para que esté vacía
+void TBounds::clearBox(void)
+{
+    xmin = DBL_MAX;
+    xmax = -DBL_MAX;
+    ymin = DBL_MAX;
+    ymax = -DBL_MAX;
+}
+//amplía la caja límite para que contenga un punto
+void TBounds::addToBox(TDoublePoint P)
+{
+    if(P.x < xmin)
+        xmin = P.x;
+    if(P.x > xmax)
+        xmax = P.x;
+    if(P.y < ymin)
+        ymin = P.y;
+    if(P.y > ymax)
+        ymax = P.y;
+}
+//amplía la caja límite para que contenga otra caja límite
+void TBounds::addToBox(const TBounds& B)
+{
+    if(B.xmin < xmin)
+        xmin = B.xmin;
+    if(B.xmax > xmax)
+        xmax = B.xmax;
+    if(B.ymin < ymin)
+        ymin = B.ymin;
+    if(B.ymax > ymax)
+        ymax = B.ymax;
+}
+//amplía la caja límite en una distancia d por cada lado
+void TBounds::inflateBox(double d)
+{
+    xmin -= d;
+    xmax += d;
+    ymin -= d;
+    ymax += d;
+}
+
+//determina si la distancia entre los conjuntos de puntos
+//es garantizadamente mayor o igual que d
+bool TBounds::isFartherThan(const TBounds& B, double d) const
+{
+    //si la distancia es no positiva, se cumple siempre
+    if(d <= 0)
+        return true;
+
+    //separación entre las cajas límite en cada eje
+    double gx = 0;
+    if(xmin > B.xmax)
+        gx = xmin - B.xmax;
+    else if(B.xmin > xmax)
+        gx = B.xmin - xmax;
+    double gy = 0;
+    if(ymin > B.ymax)
+        gy = ymin - B.ymax;
+    else if(B.ymin > ymax)
+        gy = B.ymin - ymax;
+    //si las cajas límite están suficientemente separadas
+    if(gx*gx + gy*gy >= d*d)
+        return true;
+
+    //separación entre los círculos límite
+    double dx = Pc.x - B.Pc.x;
+    double dy = Pc.y - B.Pc.y;
+    double s = d + R + B.R;
+    //si los círculos límite están suficientemente separados
+    if(dx*dx + dy*dy >= s*s)
+        return true;
+
+    return false;
+
+    //Nótese que se comparan los cuadrados de las distancias
+    //para evitar el cálculo de raices cuadradas.
+}
+//calcula una cota inferior de la distancia entre los conjuntos
+//de puntos usando los círculos límite
+double TBounds::distanceMinCircles(const TBounds& B) const
+{
+    return Mod(Pc - B.Pc) - R - B.R;
+}
+
+//--------------------------------------------------------------------------
+//TFlatFigure
+//--------------------------------------------------------------------------
+
+//calcula los límites de la figura
+void TFlatFigure::calculateBounds(void)
+{
+    //la caja límite contiene los vértices
+    Bounds.clearBox();
+    Bounds.addToBox(Pa);
+    Bounds.addToBox(Pb);
+
+    switch(type) {
+    case cftSegment:
+        //el círculo límite es el que tiene el segmento por diámetro
+        Bounds.Pc = (Pa + Pb)/2;
+        Bounds.R = Mod(Pb - Pa)/2;
+        break;
+
+    case cftArc: {
+        //la caja límite contiene además los puntos extremos de
+        //la circunferencia que están en el arco, el cual va desde Pb
+        //hasta Pa en sentido levógiro
+        //(las cotas no deben lanzar excepciones, de modo que
+        //si el arco es degenerado se acota por la circunferencia)
+        TDoublePoint P[4];
+        P[0] = TDoublePoint(Pc.x + R, Pc.y);
+        P[1] = TDoublePoint(Pc.x, Pc.y + R);
+        P[2] = TDoublePoint(Pc.x - R, Pc.y);
+        P[3] = TDoublePoint(Pc.x, Pc.y - R);
+        if(Pa==Pc || Pb==Pc) {
+            for(int i=0; i<4; i++)
+                Bounds.addToBox(P[i]);
+        } else {
+            double thetaini = ArgPos(Pb.x - Pc.x, Pb.y - Pc.y);
+            double thetafin = ArgPos(Pa.x - Pc.x, Pa.y - Pc.y) - thetaini;
+            if(thetafin < 0)
+                thetafin += M_2PI;
+            for(int i=0; i<4; i++) {
+                double theta = i*M_PI/2 - thetaini;
+                if(theta < 0)
+                    theta += M_2PI;
+                if(theta <= thetafin)
+                    Bounds.addToBox(P[i]);
+            }
+        }
+
+        //Los vértices Pa y Pb pueden estar a una distancia de Pc distinta
+        //de R, dentro del margen ERR_NUM, de modo que se amplía la caja.
+        Bounds.inflateBox(ERR_NUM);
+
+        //si el arco no es mayor que una semicircunferencia
+        if(Det(Pb - Pc, Pa - Pc) >= 0) {
+            //el círculo límite es el que tiene la cuerda por diámetro
+            Bounds.Pc = (Pa + Pb)/2;
+            Bounds.R = Mod(Pb - Pa)/2 + ERR_NUM;
+        }
+        //si el arco es mayor que una semicircunferencia
+        else {
+            //el círculo límite es el de la circunferencia
+            Bounds.Pc = Pc;
+            Bounds.R = R + ERR_NUM;
+        }
+        break;
+    }
+
+    default:
+        throw EImpossibleError("contour figure type unknown");
+    }
+}
+
+//calcula la distancia mínima entre dos figuras en representación plana
+//invocando a la misma función de Geometry que invocaría
+//el método distance de la figura correspondiente
+double flatDistance(const TFlatFigure& F1, const TFlatFigure& F2)
+{
+    switch(F1.type) {
+    case cftSegment:
+        switch(F2.type) {
+        case cftSegment:
+            return distanceSegmentSegment(F1.Pa, F1.Pb, F2.Pa, F2.Pb);
+        case cftArc:
+            return distanceSegmentArc(F1.Pa, F1.Pb, F2.Pa, F2.Pb, F2.Pc, F2.R);
+        }
+        break;
+
+    case cftArc:
+        switch(F2.type) {
+        case cftSegment:
+            return distanceArcSegment(F1.Pa, F1.Pb, F1.Pc, F1.R, F2.Pa, F2.Pb);
+        case cftArc:
+            return distanceArcArc(F1.Pa, F1.Pb, F1.Pc, F1.R, F2.Pa, F2.Pb, F2.Pc, F2.R);
+        }
+        break;
+    }
+
+    throw EImpossibleError("contour figure type unknown");
+}
+
 //--------------------------------------------------------------------------
 //TContourFigure
 //--------------------------------------------------------------------------
@@ -1144,7 +1341,7 @@ void  TContourFigure::ContourFigureRead(TContourFigure* &F,
 //inicializa la propiedad Color a su valor por defecto
 //Pa y Pb quedarán sin inicializar
 TContourFigure::TContourFigure(void) : TFigure(),
-    p_Pa(0, 0), p_Pb(0, 0), inverted(false)
+    p_Pa(0, 0), p_Pb(0, 0), p_Version(0), inverted(false)
 {
 }
 
@@ -1164,12 +1361,14 @@ TContourFigure::~TContourFigure()
 void TSegment::setPa(TDoublePoint Pa)
 {
     p_Pa = Pa;
+    p_Version++;
 }
 //coordenadas cartesianas del punto final
 //valor por defecto: (0, 0)
 void TSegment::setPb(TDoublePoint Pb)
 {
     p_Pb = Pb;
+    p_Version++;
 }
 
 //CONUNTOS DE PROPIEDADES EN FORMATO TEXTO:
@@ -1345,6 +1544,7 @@ void TSegment::Copy(TSegment *O)
     p_Pa = O->p_Pa;
     p_Pb = O->p_Pb;
     //#Color = O->Color;
+    p_Version++;
 }
 TSegment& TSegment::operator=(const TSegment &O)
 {
@@ -1352,6 +1552,7 @@ TSegment& TSegment::operator=(const TSegment &O)
     p_Pa = O.p_Pa;
     p_Pb = O.p_Pb;
     //#Color = O.Color;
+    p_Version++;
 
     return *this;
 }
@@ -1370,6 +1571,7 @@ void TSegment::SetValues(TDoublePoint Pa, TDoublePoint Pb)
     //asigna los nuevos valores
     p_Pa = Pa;
     p_Pb = Pb;
+    p_Version++;
 }
 
 //MÉTODOS DE CÁLCULO DE DISTANCIAS:
@@ -1479,6 +1681,7 @@ void TSegment::getRotated(TFigure *F, double theta)
     S->p_Pa.y = p_Pa.x*SIN + p_Pa.y*COS;
     S->p_Pb.x = p_Pb.x*COS - p_Pb.y*SIN;
     S->p_Pb.y = p_Pb.x*SIN + p_Pb.y*COS;
+    S->p_Version++;
 }
 //traslada la figura geométrica según el vector V
 void TSegment::translate(TDoublePoint V)
@@ -1488,6 +1691,27 @@ void TSegment::translate(TDoublePoint V)
     p_Pa.y += V.y;
     p_Pb.x += V.x;
     p_Pb.y += V.y;
+    p_Version++;
+}
+
+//MÉTODOS DE REPRESENTACIÓN PLANA:
+
+//obtiene la figura en representación plana, sin los límites
+void TSegment::getFlat(TFlatFigure& FF) const
+{
+    FF.type = cftSegment;
+    FF.Pa = p_Pa;
+    FF.Pb = p_Pb;
+    FF.Pc = TDoublePoint(0, 0);
+    FF.R = 0;
+}
+//asigna los vértices a partir de una representación plana
+//obtenida de una figura del mismo tipo
+void TSegment::setFlat(const TFlatFigure& FF)
+{
+    p_Pa = FF.Pa;
+    p_Pb = FF.Pb;
+    p_Version++;
 }
 
 //--------------------------------------------------------------------------
@@ -1506,6 +1730,7 @@ void TArc::setPa(TDoublePoint Pa)
 
     //asigna el nuevo valor
     p_Pa = Pa;
+    p_Version++;
 }
 void TArc::setPb(TDoublePoint Pb)
 {
@@ -1519,6 +1744,7 @@ void TArc::setPb(TDoublePoint Pb)
 
     //asigna el nuevo valor
     p_Pb = Pb;
+    p_Version++;
 }
 void TArc::setPc(TDoublePoint Pc)
 {
@@ -1532,6 +1758,7 @@ void TArc::setPc(TDoublePoint Pc)
 
     //asigna el nuevo valor
     p_Pc = Pc;
+    p_Version++;
 }
 void TArc::setR(double R)
 {
@@ -1543,6 +1770,7 @@ void TArc::setR(double R)
 
     //asigna el nuevo valor
     p_R = R;
+    p_Version++;
 }
 
 //PROPIEDADES DE DEFINICIÓN EN FORMATO TEXTO:
@@ -1837,6 +2065,7 @@ void TArc::Copy(TArc *O)
     p_Pb = O->p_Pb;
     p_Pc = O->p_Pc;
     p_R = O->p_R;
+    p_Version++;
 }
 TArc& TArc::operator=(const TArc &O)
 {
@@ -1845,6 +2074,7 @@ TArc& TArc::operator=(const TArc &O)
     p_Pb = O.p_Pb;
     p_Pc = O.p_Pc;
     p_R = O.p_R;
+    p_Version++;
 
     return *this;
 }
@@ -1920,6 +2150,7 @@ void TArc::SetValues(TDoublePoint Pa, TDoublePoint Pb, TDoublePoint Pc, double R
     p_Pb = Pb_;
     p_Pc = Pc;
     p_R = R;
+    p_Version++;
 }
 
 //MÉTODOS DE CÁLCULO DE DISTANCIAS:
@@ -2028,6 +2259,7 @@ void TArc::getRotated(TFigure *F, double theta)
     A->p_Pb.y = p_Pb.x*SIN + p_Pb.y*COS;
     A->p_Pc.x = p_Pc.x*COS - p_Pc.y*SIN;
     A->p_Pc.y = p_Pc.x*SIN + p_Pc.y*COS;
+    A->p_Version++;
 }
 //traslada la figura geométrica según el vector V
 void TArc::translate(TDoublePoint V)
@@ -2039,6 +2271,29 @@ void TArc::translate(TDoublePoint V)
     p_Pa.y += V.y;
     p_Pb.y += V.y;
     p_Pc.y += V.y;
+    p_Version++;
+}
+
+//MÉTODOS DE REPRESENTACIÓN PLANA:
+
+//obtiene la figura en representación plana, sin los límites
+void TArc::getFlat(TFlatFigure& FF) const
+{
+    FF.type = cftArc;
+    FF.Pa = p_Pa;
+    FF.Pb = p_Pb;
+    FF.Pc = p_Pc;
+    FF.R = p_R;
+}
+//asigna los vértices a partir de una representación plana
+//obtenida de una figura del mismo tipo
+void TArc::setFlat(const TFlatFigure& FF)
+{
+    p_Pa = FF.Pa;
+    p_Pb = FF.Pb;
+    p_Pc = FF.Pc;
+    p_R = FF.R;
+    p_Version++;
 }
 
 //--------------------------------------------------------------------------
@@ -462,6 +462,78 @@ public:
     //#void Paint(TPloterShapes*);
 };
 
+//--------------------------------------------------------------------------
+//TBounds
+//--------------------------------------------------------------------------
+
+//clase límites de un conjunto de puntos:
+//caja límite alineada con los ejes (AABB) y círculo límite
+class TBounds {
+public:
+    //caja límite
+    double xmin, xmax, ymin, ymax;
+    //centro del círculo límite
+    TDoublePoint Pc;
+    //radio del círculo límite
+    double R;
+
+    //construye unos límites vacíos
+    TBounds(void);
+
+    //inicializa la caja límite para que esté vacía
+    void clearBox(void);
+    //amplía la caja límite para que contenga un punto
+    void addToBox(TDoublePoint P);
+    //amplía la caja límite para que contenga otra caja límite
+    void addToBox(const TBounds& B);
+    //amplía la caja límite en una distancia d por cada lado
+    void inflateBox(double d);
+
+    //determina si la distancia entre los conjuntos de puntos
+    //es garantizadamente mayor o igual que d
+    bool isFartherThan(const TBounds& B, double d) const;
+    //calcula una cota inferior de la distancia entre los conjuntos
+    //de puntos usando los círculos límite
+    double distanceMinCircles(const TBounds& B) const;
+};
+
+//Los límites se usan para descartar los pares de figuras que no pueden
+//reducir la distancia mínima encontrada hasta el momento, de modo que
+//sólo es necesario que sean conservadores, no que sean mínimos.
+
+//--------------------------------------------------------------------------
+//TFlatFigure
+//--------------------------------------------------------------------------
+
+//tipos de figura de contorno
+enum TContourFigureType {cftSegment, cftArc};
+
+//estructura figura de contorno en representación plana:
+//contiene el tipo de figura, los vértices, el centro y el radio
+//y los límites de la figura, de modo que un contorno puede ser
+//almacenado en un vector contiguo, y las distancias pueden ser
+//calculadas sin identificación de tipos en tiempo de ejecución
+struct TFlatFigure {
+    //tipo de figura
+    TContourFigureType type;
+    //vértices de la figura
+    TDoublePoint Pa, Pb;
+    //centro y radio del arco
+    //(sin uso en los segmentos)
+    TDoublePoint Pc;
+    double R;
+    //límites de la figura
+    TBounds Bounds;
+
+    //calcula los límites de la figura
+    void calculateBounds(void);
+};
+
+//calcula la distancia mínima entre dos figuras en representación plana
+//invocando a la misma función de Geometry que invocaría
+//el método distance de la figura correspondiente
+double flatDistance(const TFlatFigure& F1, const TFlatFigure& F2);
+
 //--------------------------------------------------------------------------
 //TContourFigure
 //--------------------------------------------------------------------------
@@ -474,6 +546,9 @@ protected:
     TDoublePoint p_Pa;
     TDoublePoint p_Pb;
 
+    //número de modificaciones de la figura
+    unsigned int p_Version;
+
 public:
     //PROPIEDADES DE DEFINICIÓN:
 
@@ -503,6 +578,18 @@ public:
     //  Pini corresponde a Pa
     //  Pfin corresponde a Pb
 
+    //número de modificaciones de la figura
+    //es incrementado por todos los métodos que modifican la geometría
+    //de la figura, de modo que las listas de figuras pueden detectar
+    //que su representación plana ha quedado obsoleta
+    unsigned int getVersion(void) const {return p_Version;}
+
+    //obtiene la figura en representación plana, sin los límites
+    virtual void getFlat(TFlatFigure& FF) const = 0;
+    //asigna los vértices a partir de una representación plana
+    //obtenida de una figura del mismo tipo
+    virtual void setFlat(const TFlatFigure& FF) = 0;
+
     //MÉTODOS ESTÁTICOS DE LISTA:
 
     //imprime las propiedades de un objeto en una cadena de texto
@@ -621,6 +708,14 @@ public:
     //traslada la figura geométrica según el vector V
     void translate(TDoublePoint V);
 
+    //MÉTODOS DE REPRESENTACIÓN PLANA:
+
+    //obtiene la figura en representación plana, sin los límites
+    void getFlat(TFlatFigure& FF) const;
+    //asigna los vértices a partir de una representación plana
+    //obtenida de una figura del mismo tipo
+    void setFlat(const TFlatFigure& FF);
+
     //MÉTODOS GRÁFICOS:
 
     //dibuja el segmento
@@ -790,6 +885,14 @@ public:
     //traslada la figura geométrica según el vector V
     void translate(TDoublePoint V);
 
+    //MÉTODOS DE REPRESENTACIÓN PLANA:
+
+    //obtiene la figura en representación plana, sin los límites
+    void getFlat(TFlatFigure& FF) const;
+    //asigna los vértices a partir de una representación plana
+    //obtenida de una figura del mismo tipo
+    void setFlat(const TFlatFigure& FF);
+
     //MÉTODOS GRÁFICOS:
 
     //dibuja el arco
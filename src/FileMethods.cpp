@@ -25,6 +25,11 @@
 #include "FileMethods.h"
 #include "TextFile.h" //StrReadFromFile, StrWriteToFile
 
+#include <fstream> //ifstream, ofstream
+#include <typeinfo> //typeid
+#include <stdint.h> //uint32_t, uint64_t
+#include <string.h> //memcpy, memcmp
+
 using namespace Strings;
 
 //---------------------------------------------------------------------------
@@ -417,6 +422,15 @@ void readInstanceFromDir(TFiberMOSModel& FMM, const string& dir)
         if(l.name() != "C")
             throw EImproperCall("improper locale information (call to setlocale(LC_ALL, \"C\") for set or retrieve locale)");
 
+        //try load the instance from the binary cache, if it is up to date
+        try {
+            if(readInstanceFromCache(FMM, dir))
+                return;
+        }
+        catch(EImproperFileLoadedValue&) {
+            //the instance will be loaded from the text files
+        }
+
         //contruye una variable tampón
         TFiberMOSModel t_FMM;
 
@@ -451,6 +465,523 @@ void readInstanceFromDir(TFiberMOSModel& FMM, const string& dir)
     }
 }
 
+//---------------------------------------------------------------------------
+//FILE FUNCTIONS FOR Fiber MOS Model CACHES:
+
+//magic number and version of the format of the binary cache
+static const char INSTANCE_CACHE_MAGIC[8] = {'F', 'M', 'P', 'T', 'F', 'M', 'M', 'C'};
+static const uint32_t INSTANCE_CACHE_VERSION = 1;
+//mark for discard the caches written with other byte order
+static const uint32_t INSTANCE_CACHE_BYTE_ORDER = 0x01020304;
+//size of the header:
+//  magic, version, byte order, fingerprint, payload size, payload checksum
+static const size_t INSTANCE_CACHE_HEADER_SIZE = 8 + 4 + 4 + 8 + 8 + 8;
+
+//get the path of the binary cache of the instance of a directory
+static string instanceCachePath(const string& dir)
+{
+    return dir+"/InstanceCache.bin";
+}
+
+//initial value of the FNV-1a hash of 64 bits
+static const uint64_t FNV1A_OFFSET = 14695981039346656037ULL;
+//accumulate a block of bytes in a FNV-1a hash of 64 bits
+static void hashBytes(uint64_t& h, const char *p, size_t n)
+{
+    for(size_t k=0; k<n; k++) {
+        h ^= (unsigned char)p[k];
+        h *= 1099511628211ULL;
+    }
+}
+
+//read all bytes of a file in one read
+//returns false if the file can't be read
+static bool readBytesFromFile(string& bytes, const string& path)
+{
+    ifstream ifs(path.c_str(), ios::in | ios::binary);
+    if(!ifs)
+        return false;
+    ifs.seekg(0, ios::end);
+    streamoff size = ifs.tellg();
+    if(size < 0)
+        return false;
+    bytes.resize(size_t(size));
+    ifs.seekg(0, ios::beg);
+    if(size > 0)
+        ifs.read(&bytes[0], size);
+    return bool(ifs);
+}
+
+//accumulate the name and the content of a text file of an instance
+//in the fingerprint of the instance
+//returns false if the file can't be read
+static bool hashInstanceFile(uint64_t& h, const string& dir, const string& name)
+{
+    string bytes;
+    if(!readBytesFromFile(bytes, dir+"/"+name))
+        return false;
+
+    uint64_t size = bytes.length();
+    hashBytes(h, name.c_str(), name.length() + 1);
+    hashBytes(h, (const char*)&size, sizeof(size));
+    hashBytes(h, bytes.data(), bytes.length());
+    return true;
+}
+
+//get the fingerprint of the text files of an instance of a FMM,
+//given the identifiers of their EAs and RPs
+//returns false if some file can't be read
+static bool getInstanceFingerprint(uint64_t& h, const string& dir,
+                                   const vector<int>& EAIds, const vector<int>& RPIds)
+{
+    h = FNV1A_OFFSET;
+
+    if(!hashInstanceFile(h, dir, "Instance.txt"))
+        return false;
+
+    if(!hashInstanceFile(h, dir, "ExclusionAreaOriginsTable.txt"))
+        return false;
+    for(unsigned int i=0; i<EAIds.size(); i++) {
+        string subdir = "ExclusionArea"+inttostr(EAIds[i]);
+        if(!hashInstanceFile(h, dir, subdir+"/Contour_.txt") ||
+                !hashInstanceFile(h, dir, subdir+"/Instance.txt"))
+            return false;
+    }
+
+    if(!hashInstanceFile(h, dir, "RoboticPositionerOriginsTable.txt"))
+        return false;
+    for(unsigned int i=0; i<RPIds.size(); i++) {
+        string subdir = "RoboticPositioner"+inttostr(RPIds[i]);
+        if(!hashInstanceFile(h, dir, subdir+"/Contour____.txt") ||
+                !hashInstanceFile(h, dir, subdir+"/Contour_.txt") ||
+                !hashInstanceFile(h, dir, subdir+"/Instance.txt") ||
+                !hashInstanceFile(h, dir, subdir+"/F1.txt") ||
+                !hashInstanceFile(h, dir, subdir+"/F2.txt"))
+            return false;
+    }
+
+    return true;
+}
+
+//write a value in binary format at the end of a buffer
+template <class T> static void putValue(string& buffer, T value)
+{
+    buffer.append((const char*)&value, sizeof(T));
+}
+//write a string in binary format at the end of a buffer
+static void putString(string& buffer, const string& str)
+{
+    putValue(buffer, uint32_t(str.length()));
+    buffer.append(str);
+}
+//write a point in binary format at the end of a buffer
+static void putPoint(string& buffer, TDoublePoint P)
+{
+    putValue(buffer, P.x);
+    putValue(buffer, P.y);
+}
+//write a contour of segments and arcs in binary format at the end of a buffer
+static void putContour(string& buffer, const TContourFigureList& Contour)
+{
+    putValue(buffer, uint32_t(Contour.getCount()));
+    for(int i=0; i<Contour.getCount(); i++) {
+        const TContourFigure *F = Contour[i];
+        if(typeid(*F) == typeid(TSegment)) {
+            putValue(buffer, uint8_t(0));
+            putPoint(buffer, F->getPa());
+            putPoint(buffer, F->getPb());
+        }
+        else if(typeid(*F) == typeid(TArc)) {
+            const TArc *A = (const TArc*)F;
+            putValue(buffer, uint8_t(1));
+            putPoint(buffer, A->getPa());
+            putPoint(buffer, A->getPb());
+            putPoint(buffer, A->getPc());
+            putValue(buffer, A->getR());
+        }
+        else
+            throw EImproperArgument("contour figure list should contains only segments and arcs");
+    }
+}
+//write the points of a function in binary format at the end of a buffer
+static void putFunction(string& buffer, const TFunction& F)
+{
+    putValue(buffer, uint32_t(F.getCount()));
+    for(int i=0; i<F.getCount(); i++) {
+        putValue(buffer, F.getX(i));
+        putValue(buffer, F.getY(i));
+    }
+}
+
+//read a value in binary format from the position i of a buffer
+template <class T> static T getValue(const string& buffer, size_t& i)
+{
+    if(buffer.length() - i < sizeof(T))
+        throw EImproperFileLoadedValue("unexpected end of the instance cache");
+    T value;
+    memcpy(&value, buffer.data() + i, sizeof(T));
+    i += sizeof(T);
+    return value;
+}
+//read a string in binary format from the position i of a buffer
+static string getString(const string& buffer, size_t& i)
+{
+    uint32_t n = getValue<uint32_t>(buffer, i);
+    if(buffer.length() - i < n)
+        throw EImproperFileLoadedValue("unexpected end of the instance cache");
+    string str = buffer.substr(i, n);
+    i += n;
+    return str;
+}
+//read a point in binary format from the position i of a buffer
+static TDoublePoint getPoint(const string& buffer, size_t& i)
+{
+    double x = getValue<double>(buffer, i);
+    double y = getValue<double>(buffer, i);
+    return TDoublePoint(x, y);
+}
+//read a contour of segments and arcs in binary format
+//from the position i of a buffer
+static void getContour(TContourFigureList& Contour, const string& buffer, size_t& i)
+{
+    Destroy(Contour);
+    uint32_t n = getValue<uint32_t>(buffer, i);
+    for(uint32_t k=0; k<n; k++) {
+        uint8_t type = getValue<uint8_t>(buffer, i);
+        TDoublePoint Pa = getPoint(buffer, i);
+        TDoublePoint Pb = getPoint(buffer, i);
+        if(type == 0)
+            Contour.Add(new TSegment(Pa, Pb));
+        else if(type == 1) {
+            TDoublePoint Pc = getPoint(buffer, i);
+            double R = getValue<double>(buffer, i);
+            Contour.Add(new TArc(Pa, Pb, Pc, R));
+        }
+        else
+            throw EImproperFileLoadedValue("unknown type of contour figure in the instance cache");
+    }
+}
+//read the points of a function in binary format
+//from the position i of a buffer
+static void getFunction(TFunction& F, const string& buffer, size_t& i)
+{
+    uint32_t n = getValue<uint32_t>(buffer, i);
+    TVector<double> X, Y;
+    for(uint32_t k=0; k<n; k++) {
+        X.Add(getValue<double>(buffer, i));
+        Y.Add(getValue<double>(buffer, i));
+    }
+    F.Set(X, Y);
+}
+
+//write the binary cache of the instance of a Fiber MOS Model
+//in the directory which contains the instance in text format
+void writeInstanceCacheToDir(const string& dir, const TFiberMOSModel& FMM)
+{
+    try {
+        //get the identifiers of the EAs and the RPs
+        vector<int> EAIds, RPIds;
+        for(int i=0; i<FMM.EAL.getCount(); i++)
+            EAIds.push_back(FMM.EAL[i]->getId());
+        for(int i=0; i<FMM.RPL.getCount(); i++)
+            RPIds.push_back(FMM.RPL[i]->getActuator()->getId());
+
+        //get the fingerprint of the text files of the instance
+        uint64_t fingerprint;
+        if(!getInstanceFingerprint(fingerprint, dir, EAIds, RPIds))
+            throw EImproperArgument("directory '"+dir+"' should contain the instance of the FMM in text format");
+
+        //build the payload
+        string payload;
+
+        //the identifiers go first, for check the fingerprint
+        //before decoding the rest of the payload
+        putValue(payload, uint32_t(EAIds.size()));
+        for(unsigned int i=0; i<EAIds.size(); i++)
+            putValue(payload, int32_t(EAIds[i]));
+        putValue(payload, uint32_t(RPIds.size()));
+        for(unsigned int i=0; i<RPIds.size(); i++)
+            putValue(payload, int32_t(RPIds[i]));
+
+        //instance properties of the FMM
+        putString(payload, FMM.Instance_version);
+        putValue(payload, FMM.RPL.getPAem());
+        putValue(payload, FMM.RPL.getPem());
+
+        //for each EA of the list
+        for(int i=0; i<FMM.EAL.getCount(); i++) {
+            const TExclusionArea *EA = FMM.EAL[i];
+
+            putPoint(payload, EA->Barrier.getP0());
+            putValue(payload, EA->Barrier.getthetaO1());
+            putContour(payload, EA->Barrier.getContour_());
+            putValue(payload, EA->getEo());
+            putValue(payload, EA->getEp());
+        }
+
+        //for each RP of the list
+        for(int i=0; i<FMM.RPL.getCount(); i++) {
+            const TRoboticPositioner *RP = FMM.RPL[i];
+            const TActuator *A = RP->getActuator();
+            const TArm *Arm = A->getArm();
+
+            //origins and contours
+            putPoint(payload, A->getP0());
+            putValue(payload, A->getthetaO1());
+            putContour(payload, Arm->getContour____());
+            putContour(payload, A->getBarrier()->getContour_());
+
+            //actuator instance
+            putValue(payload, A->getL01());
+            putValue(payload, A->gettheta_1min());
+            putValue(payload, A->gettheta_1max());
+            putValue(payload, A->gettheta_1());
+            putValue(payload, A->gettheta_O3o());
+            putValue(payload, Arm->getL12());
+            putValue(payload, Arm->getL13());
+            putValue(payload, Arm->gettheta__O3());
+            putValue(payload, Arm->getR3());
+            putValue(payload, Arm->gettheta___3min());
+            putValue(payload, Arm->gettheta___3max());
+            putValue(payload, Arm->gettheta___3());
+            putValue(payload, A->getSPMmin());
+            putValue(payload, A->getSPMsim());
+            putValue(payload, int32_t(A->getPAkd()));
+
+            //CMF instance
+            putValue(payload, RP->CMF.getSF1()->getvmaxabs());
+            putValue(payload, RP->CMF.getSF2()->getvmaxabs());
+            putValue(payload, RP->CMF.getRF1()->getvmaxabs());
+            putValue(payload, RP->CMF.getRF2()->getvmaxabs());
+            putValue(payload, RP->CMF.getRF1()->getamaxabs());
+            putValue(payload, RP->CMF.getRF2()->getamaxabs());
+            putValue(payload, int32_t(RP->CMF.getMFM()));
+            putValue(payload, int32_t(RP->CMF.getSSM()));
+            putValue(payload, int32_t(RP->CMF.getRSM()));
+            putValue(payload, int32_t(RP->CMF.getId1()));
+            putValue(payload, int32_t(RP->CMF.getId2()));
+
+            //tolerances
+            putValue(payload, RP->getEo());
+            putValue(payload, RP->getEp());
+            putValue(payload, RP->getTstop());
+            putValue(payload, RP->getTshiff());
+            putValue(payload, RP->getSPMadd());
+
+            //status
+            putValue(payload, uint8_t(RP->Disabled));
+            putValue(payload, RP->getFaultProbability());
+            putValue(payload, int32_t(RP->FaultType));
+
+            //compression functions
+            putFunction(payload, A->getF());
+            putFunction(payload, Arm->getF());
+        }
+
+        //calculate the checksum of the payload
+        uint64_t checksum = FNV1A_OFFSET;
+        hashBytes(checksum, payload.data(), payload.length());
+
+        //build the header
+        string header(INSTANCE_CACHE_MAGIC, sizeof(INSTANCE_CACHE_MAGIC));
+        putValue(header, INSTANCE_CACHE_VERSION);
+        putValue(header, INSTANCE_CACHE_BYTE_ORDER);
+        putValue(header, fingerprint);
+        putValue(header, uint64_t(payload.length()));
+        putValue(header, checksum);
+
+        //write the cache in a temporal file and rename it,
+        //so that a reader never finds a cache partially written
+        string path = instanceCachePath(dir);
+        string tmp_path = path+".tmp";
+        {
+            ofstream ofs(tmp_path.c_str(), ios::out | ios::binary | ios::trunc);
+            ofs.write(header.data(), header.length());
+            ofs.write(payload.data(), payload.length());
+            ofs.close();
+            if(!ofs)
+                throw ECantComplete("can't write the file '"+tmp_path+"'");
+        }
+        if(rename(tmp_path.c_str(), path.c_str()) != 0) {
+            remove(tmp_path.c_str());
+            throw ECantComplete("can't rename the file '"+tmp_path+"'");
+        }
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "writing instance cache of FMM: ");
+        throw;
+    }
+}
+
+//read an instance of a Fiber MOS Model
+//from the binary cache of a directory
+bool readInstanceFromCache(TFiberMOSModel& FMM, const string& dir)
+{
+    //read the cache in one read
+    string bytes;
+    if(!readBytesFromFile(bytes, instanceCachePath(dir)))
+        return false;
+
+    //check the header
+    if(bytes.length() < INSTANCE_CACHE_HEADER_SIZE ||
+            memcmp(bytes.data(), INSTANCE_CACHE_MAGIC, sizeof(INSTANCE_CACHE_MAGIC)) != 0)
+        return false;
+    size_t i = sizeof(INSTANCE_CACHE_MAGIC);
+    if(getValue<uint32_t>(bytes, i) != INSTANCE_CACHE_VERSION ||
+            getValue<uint32_t>(bytes, i) != INSTANCE_CACHE_BYTE_ORDER)
+        return false;
+    uint64_t fingerprint = getValue<uint64_t>(bytes, i);
+    uint64_t size = getValue<uint64_t>(bytes, i);
+    uint64_t checksum = getValue<uint64_t>(bytes, i);
+
+    //check the payload
+    if(bytes.length() - i != size)
+        return false;
+    uint64_t h = FNV1A_OFFSET;
+    hashBytes(h, bytes.data() + i, bytes.length() - i);
+    if(h != checksum)
+        return false;
+
+    //read the identifiers and check the fingerprint
+    vector<int> EAIds, RPIds;
+    try {
+        uint32_t n = getValue<uint32_t>(bytes, i);
+        for(uint32_t k=0; k<n; k++)
+            EAIds.push_back(getValue<int32_t>(bytes, i));
+        n = getValue<uint32_t>(bytes, i);
+        for(uint32_t k=0; k<n; k++)
+            RPIds.push_back(getValue<int32_t>(bytes, i));
+    }
+    catch(EImproperFileLoadedValue&) {
+        return false;
+    }
+    if(!getInstanceFingerprint(h, dir, EAIds, RPIds) || h != fingerprint)
+        return false;
+
+    try {
+        //initialize the FMM
+        TFiberMOSModel t_FMM;
+        FMM.Clone(&t_FMM);
+
+        //read the instance properties of the FMM
+        FMM.Instance_version = getString(bytes, i);
+        double PAem = getValue<double>(bytes, i);
+        double Pem = getValue<double>(bytes, i);
+
+        TContourFigureList Contour;
+        TFunction F;
+
+        //build the EAs in the same order as the text files are read
+        for(unsigned int k=0; k<EAIds.size(); k++) {
+            TExclusionArea *EA = new TExclusionArea();
+            FMM.EAL.Add(EA);
+
+            TDoublePoint P0 = getPoint(bytes, i);
+            double thetaO1 = getValue<double>(bytes, i);
+            EA->setOrigins(EAIds[k], P0.x, P0.y, thetaO1);
+            getContour(Contour, bytes, i);
+            EA->Barrier.setContour_(Contour);
+            EA->setEo(getValue<double>(bytes, i));
+            EA->setEp(getValue<double>(bytes, i));
+        }
+
+        //build the RPs in the same order as the text files are read
+        for(unsigned int k=0; k<RPIds.size(); k++) {
+            TRoboticPositioner *RP = new TRoboticPositioner();
+            FMM.RPL.Add(RP);
+            TActuator *A = RP->getActuator();
+            TArm *Arm = A->getArm();
+
+            //origins and contours
+            TDoublePoint P0 = getPoint(bytes, i);
+            double thetaO1 = getValue<double>(bytes, i);
+            A->setOrigins(RPIds[k], P0.x, P0.y, thetaO1);
+            getContour(Contour, bytes, i);
+            Arm->setContour____(Contour);
+            getContour(Contour, bytes, i);
+            A->getBarrier()->setContour_(Contour);
+
+            //actuator instance
+            A->setL01(getValue<double>(bytes, i));
+            double theta_1min = getValue<double>(bytes, i);
+            double theta_1max = getValue<double>(bytes, i);
+            double theta_1 = getValue<double>(bytes, i);
+            double theta_O3o = getValue<double>(bytes, i);
+            double L12 = getValue<double>(bytes, i);
+            double L13 = getValue<double>(bytes, i);
+            double theta__O3 = getValue<double>(bytes, i);
+            double R3 = getValue<double>(bytes, i);
+            double theta___3min = getValue<double>(bytes, i);
+            double theta___3max = getValue<double>(bytes, i);
+            double theta___3 = getValue<double>(bytes, i);
+            Arm->setTemplate(L12, L13, theta__O3, R3);
+            Arm->setOrientationRadians(theta___3min, theta___3max, theta___3);
+            A->setSPMmin(getValue<double>(bytes, i));
+            A->setSPMsim(getValue<double>(bytes, i));
+            A->setPAkd(TKnowledgeDegree(getValue<int32_t>(bytes, i)));
+            A->setOrientationRadians(theta_1min, theta_1max, theta_1, theta_O3o);
+
+            //CMF instance
+            RP->CMF.getSF1()->setvmaxabs(getValue<double>(bytes, i));
+            RP->CMF.getSF2()->setvmaxabs(getValue<double>(bytes, i));
+            RP->CMF.getRF1()->setvmaxabs(getValue<double>(bytes, i));
+            RP->CMF.getRF2()->setvmaxabs(getValue<double>(bytes, i));
+            RP->CMF.getRF1()->setamaxabs(getValue<double>(bytes, i));
+            RP->CMF.getRF2()->setamaxabs(getValue<double>(bytes, i));
+            RP->CMF.setMFM(TMotionFunctionMode(getValue<int32_t>(bytes, i)));
+            RP->CMF.setSSM(TSquareSynchronismMode(getValue<int32_t>(bytes, i)));
+            RP->CMF.setRSM(TRampSynchronismMode(getValue<int32_t>(bytes, i)));
+            RP->CMF.setId1(getValue<int32_t>(bytes, i));
+            RP->CMF.setId2(getValue<int32_t>(bytes, i));
+
+            //tolerances
+            RP->setEo(getValue<double>(bytes, i));
+            RP->setEp(getValue<double>(bytes, i));
+            RP->setTstop(getValue<double>(bytes, i));
+            RP->setTshiff(getValue<double>(bytes, i));
+            RP->setSPMadd(getValue<double>(bytes, i));
+
+            //status
+            RP->Disabled = getValue<uint8_t>(bytes, i) != 0;
+            RP->setFaultProbability(getValue<double>(bytes, i));
+            RP->FaultType = TFaultType(getValue<int32_t>(bytes, i));
+
+            //compression functions
+            getFunction(F, bytes, i);
+            A->setF(F);
+            getFunction(F, bytes, i);
+            Arm->setF(F);
+
+            //WARNING: the assignation of F1 and F2 produces the quantification
+            //of the positions with the new functions, so the positions
+            //(which are already quantified) must be reassigned.
+            A->settheta_1(theta_1);
+            Arm->settheta___3(theta___3);
+        }
+        //the Ids have been assigned after add the RPs
+        FMM.RPL.updateIndex();
+        Destroy(Contour);
+
+        //check that all the payload has been read
+        if(i != bytes.length())
+            throw EImproperFileLoadedValue("unexpected data at the end of the instance cache");
+
+        //assign the tolerances of the RPL
+        FMM.RPL.setTolerance(PAem, Pem);
+
+        //assimilate the instance:
+        //the adjacents of each RP and EA and the map of the RPL
+        //depend on the position of the objects in the memory,
+        //reason why they are determined here instead of being stored
+        FMM.assimilate();
+    }
+    catch(Exception& E) {
+        throw EImproperFileLoadedValue("reading instance cache of FMM: " + E.Message.str);
+    }
+
+    return true;
+}
+
 //---------------------------------------------------------------------------
 //FILE FUNCTIONS FOR Fiber Connection Models:
 
@@ -73,8 +73,33 @@ void readInstanceFromDir(TRoboticPositionerList&, const string& dir,
 void writeInstanceToDir(const string& dir, const TFiberMOSModel&);
 //read an instance of a Fiber MOS Model
 //from a directory
+//If the directory contains an up to date binary cache of the instance,
+//the instance is loaded from the cache instead of the text files.
 void readInstanceFromDir(TFiberMOSModel&, const string& dir);
 
+//---------------------------------------------------------------------------
+//FILE FUNCTIONS FOR Fiber MOS Model CACHES:
+//---------------------------------------------------------------------------
+
+//The binary cache of a Fiber MOS Model instance is the file
+//'InstanceCache.bin' in the directory of the instance. It contains:
+//  a header with a magic number, the format version, the fingerprint of
+//  the text files of the instance and the checksum of the payload;
+//  a payload with the values of the instance in binary format.
+//The cache is stale when the fingerprint does not match the text files,
+//so that any modification of the text files invalidates the cache.
+
+//write the binary cache of the instance of a Fiber MOS Model
+//in the directory which contains the instance in text format
+//The FMM shall be the instance stored in the directory.
+void writeInstanceCacheToDir(const string& dir, const TFiberMOSModel&);
+//read an instance of a Fiber MOS Model
+//from the binary cache of a directory
+//Returns false, without modify the FMM, if the cache is missing,
+//corrupt, of other version or stale. Throws EImproperFileLoadedValue
+//if the values of the cache can't be assigned to the FMM.
+bool readInstanceFromCache(TFiberMOSModel&, const string& dir);
+
 //---------------------------------------------------------------------------
 //FILE FUNCTIONS FOR Fiber Connection Models:
 //---------------------------------------------------------------------------
@@ -31,6 +31,12 @@
 
 #include <algorithm> //std::min, std::max
 
+#if defined(__AVX2__)
+#include <immintrin.h> //AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h> //SSE2
+#endif
+
 //---------------------------------------------------------------------------
 
 //espacio de nombres de clases y funciones matemáticas
@@ -2080,6 +2086,172 @@ double distanceCircleArc(TDoublePoint Pc, double R1,
     return Distances.getMin(); //devuelve la distancia mínima
 }
 
+//---------------------------------------------------------------------------
+//DISTANCIAS MÍNIMAS EN LOTE:
+
+//Las operaciones sobre carriles reproducen una a una las operaciones
+//de las funciones escalares, en el mismo orden, de modo que
+//los resultados son idénticos bit a bit. Las ramas se evalúan todas
+//y se seleccionan mediante máscaras.
+
+#if defined(__AVX2__)
+
+typedef __m256d TLanes;
+#define LANES 4
+static inline TLanes lset(double x) {return _mm256_set1_pd(x);}
+static inline TLanes lload(const double *p) {return _mm256_loadu_pd(p);}
+static inline void lstore(double *p, TLanes a) {_mm256_storeu_pd(p, a);}
+static inline TLanes ladd(TLanes a, TLanes b) {return _mm256_add_pd(a, b);}
+static inline TLanes lsub(TLanes a, TLanes b) {return _mm256_sub_pd(a, b);}
+static inline TLanes lmul(TLanes a, TLanes b) {return _mm256_mul_pd(a, b);}
+static inline TLanes ldiv(TLanes a, TLanes b) {return _mm256_div_pd(a, b);}
+static inline TLanes lsqrt(TLanes a) {return _mm256_sqrt_pd(a);}
+static inline TLanes lmin(TLanes a, TLanes b) {return _mm256_min_pd(a, b);}
+static inline TLanes land(TLanes a, TLanes b) {return _mm256_and_pd(a, b);}
+static inline TLanes lor(TLanes a, TLanes b) {return _mm256_or_pd(a, b);}
+static inline TLanes lxor(TLanes a, TLanes b) {return _mm256_xor_pd(a, b);}
+static inline TLanes leq(TLanes a, TLanes b) {return _mm256_cmp_pd(a, b, _CMP_EQ_OQ);}
+static inline TLanes lneq(TLanes a, TLanes b) {return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ);}
+static inline TLanes llt(TLanes a, TLanes b) {return _mm256_cmp_pd(a, b, _CMP_LT_OQ);}
+static inline TLanes lle(TLanes a, TLanes b) {return _mm256_cmp_pd(a, b, _CMP_LE_OQ);}
+//selecciona b en los carriles donde la máscara m es cierta y a en el resto
+static inline TLanes lselect(TLanes m, TLanes a, TLanes b) {return _mm256_blendv_pd(a, b, m);}
+
+#elif defined(__SSE2__)
+
+typedef __m128d TLanes;
+#define LANES 2
+static inline TLanes lset(double x) {return _mm_set1_pd(x);}
+static inline TLanes lload(const double *p) {return _mm_loadu_pd(p);}
+static inline void lstore(double *p, TLanes a) {_mm_storeu_pd(p, a);}
+static inline TLanes ladd(TLanes a, TLanes b) {return _mm_add_pd(a, b);}
+static inline TLanes lsub(TLanes a, TLanes b) {return _mm_sub_pd(a, b);}
+static inline TLanes lmul(TLanes a, TLanes b) {return _mm_mul_pd(a, b);}
+static inline TLanes ldiv(TLanes a, TLanes b) {return _mm_div_pd(a, b);}
+static inline TLanes lsqrt(TLanes a) {return _mm_sqrt_pd(a);}
+static inline TLanes lmin(TLanes a, TLanes b) {return _mm_min_pd(a, b);}
+static inline TLanes land(TLanes a, TLanes b) {return _mm_and_pd(a, b);}
+static inline TLanes lor(TLanes a, TLanes b) {return _mm_or_pd(a, b);}
+static inline TLanes lxor(TLanes a, TLanes b) {return _mm_xor_pd(a, b);}
+static inline TLanes leq(TLanes a, TLanes b) {return _mm_cmpeq_pd(a, b);}
+static inline TLanes lneq(TLanes a, TLanes b) {return _mm_cmpneq_pd(a, b);}
+static inline TLanes llt(TLanes a, TLanes b) {return _mm_cmplt_pd(a, b);}
+static inline TLanes lle(TLanes a, TLanes b) {return _mm_cmple_pd(a, b);}
+//selecciona b en los carriles donde la máscara m es cierta y a en el resto
+static inline TLanes lselect(TLanes m, TLanes a, TLanes b) {return _mm_or_pd(_mm_and_pd(m, b), _mm_andnot_pd(m, a));}
+
+#endif
+
+#ifdef LANES
+
+//cambia el signo de los carriles, como el operador unario -
+static inline TLanes lneg(TLanes a) {return lxor(a, lset(-0.0));}
+//std::min(a, b) devuelve (b < a) ? b : a
+static inline TLanes lstdmin(TLanes a, TLanes b) {return lmin(b, a);}
+//Abs(x) devuelve (x < 0) ? -1*x : x
+static inline TLanes labs(TLanes x) {return lselect(llt(x, lset(0)), x, lneg(x));}
+
+//réplica de distanceSegmentPoint(A, B, P) sobre carriles
+static inline TLanes ldistanceSegmentPoint(TLanes ax, TLanes ay,
+                                           TLanes bx, TLanes by,
+                                           TLanes px, TLanes py)
+{
+    //distancias a los vértices
+    TLanes vx = lsub(px, ax);
+    TLanes vy = lsub(py, ay);
+    TLanes dA = lsqrt(ladd(lmul(vx, vx), lmul(vy, vy)));
+    TLanes wx = lsub(px, bx);
+    TLanes wy = lsub(py, by);
+    TLanes dB = lsqrt(ladd(lmul(wx, wx), lmul(wy, wy)));
+
+    //versor en la dirección A a B
+    TLanes mx = lsub(bx, ax);
+    TLanes my = lsub(by, ay);
+    TLanes module = lsqrt(ladd(lmul(mx, mx), lmul(my, my)));
+    mx = ldiv(mx, module);
+    my = ldiv(my, module);
+
+    //distancias al origen en la dirección de m
+    TLanes da = ladd(lmul(ax, mx), lmul(ay, my));
+    TLanes db = ladd(lmul(bx, mx), lmul(by, my));
+    TLanes d = ladd(lmul(px, mx), lmul(py, my));
+
+    //distancia a la recta que pasa por A y B
+    TLanes dl = labs(ladd(lmul(vx, lneg(my)), lmul(vy, mx)));
+
+    //selecciona la rama como lo haría la función escalar
+    TLanes before = llt(d, da);
+    TLanes r = lselect(llt(db, d), dl, dB);
+    r = lselect(before, r, dA);
+    //si el segmento se reduce a un punto es la distancia al punto
+    TLanes degenerated = land(leq(ax, bx), leq(ay, by));
+    return lselect(degenerated, r, dA);
+}
+
+#endif //LANES
+
+//número de pares que las funciones en lote evalúan a la vez
+unsigned int distanceBatchLanes(void)
+{
+#ifdef LANES
+    return LANES;
+#else
+    return 1;
+#endif
+}
+
+//calcula las distancias D[j] entre el segmento (Pa, Pb) y
+//los N segmentos ((xa[j], ya[j]), (xb[j], yb[j]))
+void distanceSegmentSegments(double *D,
+                             TDoublePoint Pa, TDoublePoint Pb,
+                             const double *xa, const double *ya,
+                             const double *xb, const double *yb,
+                             unsigned int N)
+{
+    unsigned int j = 0;
+
+#ifdef LANES
+    const TLanes Pax = lset(Pa.x), Pay = lset(Pa.y);
+    const TLanes Pbx = lset(Pb.x), Pby = lset(Pb.y);
+    const TLanes zero = lset(0), one = lset(1);
+
+    //(Pa - Pb) es común a todos los pares
+    const TLanes ux = lsub(Pax, Pbx), uy = lsub(Pay, Pby);
+
+    for(; j+LANES<=N; j+=LANES) {
+        TLanes Qax = lload(xa + j), Qay = lload(ya + j);
+        TLanes Qbx = lload(xb + j), Qby = lload(yb + j);
+
+        //determina si los segmentos se intersecan
+        //como en intersectionSegmentSegment
+        TLanes vx = lsub(Qax, Qbx), vy = lsub(Qay, Qby);
+        TLanes denom = lsub(lmul(ux, vy), lmul(uy, vx));
+        TLanes wx = lsub(Pbx, Qbx), wy = lsub(Pby, Qby);
+        TLanes a1 = ldiv(lneg(lsub(lmul(wx, vy), lmul(wy, vx))), denom);
+        TLanes zx = lsub(Qbx, Pbx), zy = lsub(Qby, Pby);
+        TLanes b1 = ldiv(lsub(lmul(zx, uy), lmul(zy, ux)), denom);
+        TLanes out = lor(lor(lle(b1, zero), lle(one, b1)),
+                         lor(lle(a1, zero), lle(one, a1)));
+        TLanes intersect = land(lneq(denom, zero), lxor(out, leq(zero, zero)));
+
+        //calcula la distancia de cada punto al otro segmento
+        TLanes d1 = ldistanceSegmentPoint(Pax, Pay, Pbx, Pby, Qax, Qay);
+        TLanes d2 = ldistanceSegmentPoint(Pax, Pay, Pbx, Pby, Qbx, Qby);
+        TLanes d3 = ldistanceSegmentPoint(Qax, Qay, Qbx, Qby, Pax, Pay);
+        TLanes d4 = ldistanceSegmentPoint(Qax, Qay, Qbx, Qby, Pbx, Pby);
+        TLanes d = lstdmin(lstdmin(d1, d2), lstdmin(d3, d4));
+
+        lstore(D + j, lselect(intersect, d, zero));
+    }
+#endif //LANES
+
+    //los pares restantes se evalúan con la función escalar
+    for(; j<N; j++)
+        D[j] = distanceSegmentSegment(Pa, Pb,
+                                      TDoublePoint(xa[j], ya[j]),
+                                      TDoublePoint(xb[j], yb[j]));
+}
+
 //---------------------------------------------------------------------------
 //DISTANCIAS MÁXIMAS ENTRE PARES DE FIGURAS:
 
@@ -351,6 +351,28 @@ double distanceCircleCuadrilateral(TDoublePoint Pc, double R,
 double distanceCircleArc(TDoublePoint Pc, double R1,
     TDoublePoint Qa, TDoublePoint Qb, TDoublePoint Qc, double R2);
 
+//---------------------------------------------------------------------------
+//DISTANCIAS MÍNIMAS EN LOTE:
+
+//Las figuras del lote se dan en estructura de arrays (SoA), y las
+//distancias son las mismas que devolvería la función homónima
+//evaluada par a par. Cuando el compilador dispone de AVX2 o SSE2
+//los lotes se evalúan con instrucciones vectoriales, y en otro caso
+//se evalúan con la función escalar.
+
+//número de pares que las funciones en lote evalúan a la vez
+//(los lotes cuyo tamaño es múltiplo de este número
+//se evalúan íntegramente con instrucciones vectoriales)
+unsigned int distanceBatchLanes(void);
+
+//calcula las distancias D[j] entre el segmento (Pa, Pb) y
+//los N segmentos ((xa[j], ya[j]), (xb[j], yb[j]))
+void distanceSegmentSegments(double *D,
+                             TDoublePoint Pa, TDoublePoint Pb,
+                             const double *xa, const double *ya,
+                             const double *xb, const double *yb,
+                             unsigned int N);
+
 //---------------------------------------------------------------------------
 //DISTANCIAS MÁXIMAS ENTRE PARES DE FIGURAS:
 
@@ -780,6 +780,110 @@ void TMotionProgram::getDendMCStext(string& str, const string& label,
     str += "\r\n}";
 }
 
+//Set the comments of the MIs from MP-Dmins or MP-Dends in the format MCS.
+//Inputs:
+//  str: MP-Dmins or MP-Dends of the MP.
+//  Dend: flag indicating if str contains MP-Dends.
+//Outputs:
+//  MP: the MP with the comments of their MIs.
+static void setCommentsMCStext(TMotionProgram& MP, const string& str, bool Dend)
+{
+    //split the string in lines
+    vector<string> Lines;
+    string line;
+    for(unsigned int i=0; i<=str.length(); i++) {
+        if(i==str.length() || str[i]=='\n') {
+            string aux;
+            strTrim(aux, line);
+            if(aux.length() > 0)
+                Lines.push_back(aux);
+            line = "";
+        }
+        else if(str[i] != '\r')
+            line += str[i];
+    }
+
+    //check the delimiters of the MP
+    if(Lines.size()<2 || Lines.front()[Lines.front().length()-1]!='{' || Lines.back()!="}")
+        throw EImproperArgument("missing delimiters of motion program");
+
+    //read the comment of each MI of each group
+    int group = -1;
+    bool open = false;
+    for(unsigned int l=1; l+1<Lines.size(); l++) {
+        const string& S = Lines[l];
+
+        if(S == "}") {
+            if(!open)
+                throw EImproperArgument("missing start delimiter of group "+inttostr(group+1));
+            open = false;
+        }
+        else if(S.compare(0, 6, "group_")==0 && S[S.length()-1]=='{') {
+            if(open)
+                throw EImproperArgument("missing end delimiter of group "+inttostr(group+1));
+            group++;
+            if(group >= MP.getCount())
+                throw EImproperArgument("there are more groups than message lists in the motion program");
+            open = true;
+        }
+        else if(S.compare(0, 2, "rp")==0 && open) {
+            size_t colon = S.find(':');
+            if(colon == string::npos)
+                throw EImproperArgument("missing ':' in line \""+S+"\"");
+            int Id;
+            try {
+                Id = strToInt(S.substr(2, colon - 2));
+            } catch(Exception& E) {
+                E.Message.Insert(1, "reading identifier of RP in line \""+S+"\": ");
+                throw;
+            }
+            string comment;
+            strTrim(comment, S.substr(colon + 1));
+
+            //search the MI of the RP in the group
+            TMessageList *ML = MP.GetPointer(group);
+            int j = 0;
+            while(j<ML->getCount() && ML->GetPointer(j)->getId()!=Id)
+                j++;
+            if(j >= ML->getCount())
+                throw EImproperArgument("the RP"+inttostr(Id)+" isn't programmed in the group "+inttostr(group+1));
+            if(Dend)
+                ML->GetPointer(j)->setCommentDend(comment);
+            else
+                ML->GetPointer(j)->setCommentDmin(comment);
+        }
+        else
+            throw EImproperArgument("improper line \""+S+"\"");
+    }
+
+    //check the number of groups
+    if(open || group+1 != MP.getCount())
+        throw EImproperArgument("the number of groups should be equal to the number of message lists in the motion program");
+}
+
+//Set the comments Dmin of the MIs from MP-Dmins in the format MCS.
+void TMotionProgram::setDminMCStext(const string& str)
+{
+    try {
+        setCommentsMCStext(*this, str, false);
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "setting MP-Dmins: ");
+        throw;
+    }
+}
+//Set the comments Dend of the MIs from MP-Dends in the format MCS.
+void TMotionProgram::setDendMCStext(const string& str)
+{
+    try {
+        setCommentsMCStext(*this, str, true);
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "setting MP-Dends: ");
+        throw;
+    }
+}
+
 //---------------------------------------------------------------------------
 
 } //namespace Positiong
@@ -151,6 +151,16 @@ public:
     /// @param[in] Bid identifier of the CB.
     void getDendMCStext(string& str, const string& label,
                                unsigned int Bid) const;
+
+    /// @brief Set the comments Dmin of the MIs from MP-Dmins in the format MCS.
+    /// @param[in] str MP-Dmins of this MP, as obtained by getDminMCStext.
+    /// @exception EImproperArgument if the MP-Dmins don't correspond to this MP.
+    void setDminMCStext(const string& str);
+
+    /// @brief Set the comments Dend of the MIs from MP-Dends in the format MCS.
+    /// @param[in] str MP-Dends of this MP, as obtained by getDendMCStext.
+    /// @exception EImproperArgument if the MP-Dends don't correspond to this MP.
+    void setDendMCStext(const string& str);
 };
 
 //---------------------------------------------------------------------------
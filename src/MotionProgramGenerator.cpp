@@ -30,8 +30,15 @@
 #include "OutputsParkProg.h" //for function generateParkProg_online
 #include "OutputsPairPPDP.h" //for function generatePairPPDP_online
 #include "adjacentitem.h"
+#include "Profiler.h"
+#include "Workers.h"
 
 #include <algorithm> //std::min, std::max
+#include <thread>
+#include <atomic>
+#include <exception> //exception_ptr
+#include <unordered_map>
+#include <vector>
 #include <config.h> //PACKAGE_VERSION
 
 //---------------------------------------------------------------------------
@@ -80,70 +87,99 @@ void TMotionProgramGenerator::segregateRPsInDisjointSets(
     //shall be taken how obstacles, so that the sets separated only for
     //these RPs, are disjoint sets.
 
+    //The disjoint sets are built with a union-find structure keyed by
+    //the index of the RPs in the list Outsiders. Each set keeps its RPs
+    //in a linked list, so that the sets can be joined in constant time,
+    //preserving the order in which the sets and their RPs are listed:
+    //  - the sets are sorted by their first RP in the list Outsiders;
+    //  - when a RP joins several sets, the RPs of the sets are concatenated
+    //    in the order of the sets, and then the RP is appended.
+
+    int N = Outsiders.getCount();
+
+    //index the RPs of the list Outsiders
+    unordered_map<const TRoboticPositioner*, int> indices;
+    indices.reserve(N);
+    for(int i=0; i<N; i++)
+        indices.insert(make_pair(Outsiders[i], i));
+
+    vector<int> parent(N); //parent of each RP in the union-find forest
+    vector<int> head(N), tail(N); //linked list of RPs of each root
+    vector<int> next(N, -1); //next RP in the linked list of its set
+
+    //find the root of the set of a RP, compressing the path
+    auto find = [&parent](int i) {
+        int root = i;
+        while(parent[root] != root)
+            root = parent[root];
+        while(parent[i] != root) {
+            int j = parent[i];
+            parent[i] = root;
+            i = j;
+        }
+        return root;
+    };
+
     //for each RP of the list Outsiders
-    for(int i=0; i<Outsiders.getCount(); i++) {
+    for(int i=0; i<N; i++) {
         //points the indicated RP to facilitate its access
         TRoboticPositioner *RP = Outsiders[i];
 
-        //determines the list of adjacent RPs which are in insecurity position
-        //and are in the list Outsiders
-        TItemsList<TRoboticPositioner*> Adjacents;
+        //determines the roots of the sets which contain adjacent RPs
+        //in insecurity position, already segregated
+        vector<int> roots;
         for(int j=0; j<RP->getActuator()->AdjacentRPs.getCount(); j++) {
             TRoboticPositioner *RPA = RP->getActuator()->AdjacentRPs[j].RP;
             if(RPA->getActuator()->ArmIsOutSafeArea()) {
-                int k = Outsiders.Search(RPA);
-                if(k < Outsiders.getCount())
-                    Adjacents.Add(RPA);
+                unordered_map<const TRoboticPositioner*, int>::const_iterator it = indices.find(RPA);
+                if(it!=indices.end() && it->second<i)
+                    roots.push_back(find(it->second));
             }
         }
 
-        //NOTE: list Adjacents is of type TItemsList<TRoboticPositioner*>,
-        //not TRoboticPositionerList.
-
         //Here has been found the adjacents of a RP in the list RP->getActuator()->AdjacentRPs.
         //The content of that list is determined when the instance of the Fiber MOS Model is assimilated.
         //That list will contains the RPs whose points P0 are to a distance less than:
         //  RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() +
         //  RPj->getActuator()->getr_max() + RPj->getActuator()->getSPMall_a()
 
-        //search the adjacents in the disjoint sets
-        TVector<int> index;
-        for(int j=0; j<Adjacents.getCount(); j++) {
-            TRoboticPositioner *RPA = Adjacents[j];
-            for(int k=0; k<DisjointSets.getCount(); k++) {
-                TRoboticPositionerList *Set = DisjointSets.GetPointer(k);
-                int l = Set->Search(RPA);
-                int m = index.Search(k);
-                if(l<Set->getCount() && m>=index.getCount())
-                    index.Add(k);
-            }
-        }
+        //The root of each set is its first RP in the list Outsiders,
+        //so sorting the roots sorts the sets.
+        sort(roots.begin(), roots.end());
+        roots.erase(unique(roots.begin(), roots.end()), roots.end());
 
         //if not found the adjacents in the disjoint sets
-        if(index.getCount() <= 0) {
+        if(roots.empty()) {
             //add the RP in a new set
-            TRoboticPositionerList *Set = new TRoboticPositionerList();
-            Set->Add(RP);
-            DisjointSets.Add(Set);
+            parent[i] = i;
+            head[i] = i;
+            tail[i] = i;
         }
         //if has found some adjacent in the disjoint sets
         else {
             //join the disjoint sets where the RPAs was found
-            index.SortInc();
-            TRoboticPositionerList *Set = DisjointSets.GetPointer(index[0]);
-            for(int j=1; j<index.getCount(); j++) {
-                TRoboticPositionerList *SetToAdd = DisjointSets.GetPointer(index[j]);
-                for(int k=0; k<SetToAdd->getCount(); k++) {
-                    TRoboticPositioner *RPToAdd = SetToAdd->Get(k);
-                    Set->Add(RPToAdd);
-                }
+            int root = roots[0];
+            for(unsigned int j=1; j<roots.size(); j++) {
+                int r = roots[j];
+                next[tail[root]] = head[r];
+                tail[root] = tail[r];
+                parent[r] = root;
             }
-            for(int j=index.getCount()-1; j>=1; j--)
-                DisjointSets.Delete(index[j]);
-            //add the RP to the Set
-            Set->Add(RP);
+            //add the RP to the set
+            next[tail[root]] = i;
+            tail[root] = i;
+            parent[i] = root;
         }
     }
+
+    //build the disjoint sets in the order of their roots
+    for(int i=0; i<N; i++)
+        if(parent[i] == i) {
+            TRoboticPositionerList *Set = new TRoboticPositionerList();
+            for(int j=head[i]; j>=0; j=next[j])
+                Set->Add(Outsiders[j]);
+            DisjointSets.Add(Set);
+        }
 }
 
 //Determines if not all RPs of a list follow the MEGARA distribution.
@@ -404,6 +440,8 @@ bool TMotionProgramGenerator::motionProgramsAreIncongruent(TRoboticPositioner* &
     vector<int> Ids;
     //index to the RP attached to the pair (MPturn, MPretraction)
     int j;
+    //list of RPs where search the RP
+    const TRoboticPositionerList& PoseRPL = getPoseRPL();
 
     //--------------------------------------------------------
     //For the MPturn:
@@ -425,10 +463,10 @@ bool TMotionProgramGenerator::motionProgramsAreIncongruent(TRoboticPositioner* &
         TMessageInstruction *MI = ML->getFirstPointer();
 
         //search the RP of the message list in the FMM
-        j = getFiberMOSModel()->RPL.searchId(MI->getId());
+        j = PoseRPL.searchId(MI->getId());
 
         //check if the message instruction is directed to a RP of the FMM
-        if(j >= getFiberMOSModel()->RPL.getCount())
+        if(j >= PoseRPL.getCount())
             return true;
 
         //add the Id of the message list to the vector
@@ -459,10 +497,10 @@ bool TMotionProgramGenerator::motionProgramsAreIncongruent(TRoboticPositioner* &
         TMessageInstruction *MI = ML->getFirstPointer();
 
         //search the RP of the message list in the FMM
-        j = getFiberMOSModel()->RPL.searchId(MI->getId());
+        j = PoseRPL.searchId(MI->getId());
 
         //...the message instruction is directed to a RP of the FMM
-        if(j >= getFiberMOSModel()->RPL.getCount())
+        if(j >= PoseRPL.getCount())
             return true;
 
         //add the Id of the message list to the vector
@@ -493,7 +531,7 @@ bool TMotionProgramGenerator::motionProgramsAreIncongruent(TRoboticPositioner* &
             return true;
 
     //point the RP attached to the pair (MPturn, MPretraction)
-    RP = getFiberMOSModel()->RPL[j];
+    RP = PoseRPL[j];
 
     return false; //indicates that the pair is congruent
 }
@@ -523,6 +561,8 @@ bool TMotionProgramGenerator::motionProgramsAreIncongruent(TRoboticPositioner* &
 bool TMotionProgramGenerator::motionProgramsAreValid(const TMotionProgram& MPturn,
                                                      const TMotionProgram& MPretraction) const
 {
+    PROFILE_SCOPE(pfMotionProgramsAreValid);
+
     //CHECK THE PRECONDITIONS:
 
     for(int i=0; i<getFiberMOSModel()->RPL.getCount(); i++) {
@@ -541,7 +581,7 @@ bool TMotionProgramGenerator::motionProgramsAreValid(const TMotionProgram& MPtur
     //MAKE ACTIONS:
 
     //store the actual positions
-    getFiberMOSModel()->RPL.pushPositions();
+    getPoseRPL().pushPositions();
 
     //validate MPturn
     bool valid = validateMotionProgram(RP->MPturn);
@@ -563,9 +603,9 @@ bool TMotionProgramGenerator::motionProgramsAreValid(const TMotionProgram& MPtur
     }
 
     //restore the initial status of the Fiber MOS Model
-    getFiberMOSModel()->RPL.restoreAndPopPositions();
+    getPoseRPL().restoreAndPopPositions();
     if(!valid)
-        getFiberMOSModel()->RPL.restoreAndPopQuantifys();
+        getPoseRPL().restoreAndPopQuantifys();
 
     //return the result of the validation process
     return valid;
@@ -645,7 +685,9 @@ bool TMotionProgramGenerator::searchSolutionInNegativeSense(double& p_1new, TRob
     //The content of the list of adjacents shall be restablished at the end of the process.
 
     //save the content of the list of adjacents
-    TAdjacentRPList AdjacentRPs = RP->getActuator()->AdjacentRPs;
+    //(by assignment, so that the slots keep their edges)
+    TAdjacentRPList AdjacentRPs;
+    AdjacentRPs = RP->getActuator()->AdjacentRPs;
 
     //suppose that there is solution until the contrary is proved
     bool there_is_solution = true;
@@ -798,7 +840,9 @@ bool TMotionProgramGenerator::searchSolutionInPositiveSense(double& p_1new, TRob
     //The content of the list of adjacents shall be restablished at the end of the process.
 
     //save the content of the list of adjacents
-    TAdjacentRPList AdjacentRPs = RP->getActuator()->AdjacentRPs;
+    //(by assignment, so that the slots keep their edges)
+    TAdjacentRPList AdjacentRPs;
+    AdjacentRPs = RP->getActuator()->AdjacentRPs;
 
     //suppose that there is solution until the contrary is proved
     bool there_is_solution = true;
@@ -902,6 +946,8 @@ bool TMotionProgramGenerator::searchSolutionInPositiveSense(double& p_1new, TRob
 //  (MPturn, MPretraction, Dmin) which will contains the last proposal.
 bool TMotionProgramGenerator::searchSolution(TRoboticPositioner *RP)
 {
+    PROFILE_SCOPE(pfSearchSolution);
+
     //CHECK THE PRECONDITIONS:
 
     if(RP == NULL)
@@ -913,9 +959,9 @@ bool TMotionProgramGenerator::searchSolution(TRoboticPositioner *RP)
             throw EImproperCall("all RPs of the Fiber MOS Model should be configurated for MP generation");
     }
 
-    int i = getFiberMOSModel()->RPL.Search(RP);
-    if(i >= getFiberMOSModel()->RPL.getCount())
-        throw EImproperArgument("the RP should be in the Fiber MOS Model");
+    int i = getPoseRPL().Search(RP);
+    if(i >= getPoseRPL().getCount())
+        throw EImproperArgument("the RP should be in the Fiber MOS Model or in the overlay");
 
     if(RP->getActuator()->ArmIsInSafeArea())
         throw EImproperArgument("the RP should be in unsecurity position");
@@ -964,6 +1010,106 @@ bool TMotionProgramGenerator::searchSolution(TRoboticPositioner *RP)
     return RP_is_recoverable;
 }
 
+//Build a clon of a RP to be used in a pose overlay.
+//The clon is attached to the same adjacent RPs and EAs than the RP,
+//but without the edges of the adjacency graph, which are shared
+//with the adjacents. So the clon can be moved and validated
+//in the overlay, while the Fiber MOS Model is only read.
+//Inputs:
+//  RP: the RP to be cloned.
+//Outputs:
+//  buildOverlayClon: the clon of the RP, which will have stacked
+//      the actual positions of their rotors.
+//Preconditions:
+//  Pointer RP shall point to built RP.
+//Notes:
+//  The constructors of RPs are not thread-safe,
+//  so this function shall be called in the main thread.
+static TRoboticPositioner *buildOverlayClon(const TRoboticPositioner *RP)
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(RP == NULL)
+        throw EImproperArgument("pointer RP should point to built RP");
+
+    //MAKE ACTIONS:
+
+    //clone the RP
+    TRoboticPositioner *RP_ = new TRoboticPositioner(RP);
+
+    //the stacks of positions are not cloned, so they shall be restablished
+    RP_->getActuator()->pushthetas();
+
+    return RP_;
+}
+
+//Search the best recovery program for a individual RP,
+//it is to say, the recovery program with the maximun Dsec
+//in the interval [0, DsecMax].
+//Inputs:
+//  RP: the RP to be recovered.
+//Outputs:
+//  searchBestSolution: indicates if the RP is recoverable.
+//  RP->MPturn, RP->MPretraction: the generated MPs.
+//  RP->Dsec: the maximun Dsec with which there is solution.
+//Preconditions:
+//  The RP shall accomplish the preconditions of searchSolution.
+//Postconditions:
+//  The RP will be in their initial status, except their properties
+//  (MPturn, MPretraction, Dsec) which will contains the solution.
+bool TMotionProgramGenerator::searchBestSolution(TRoboticPositioner *RP)
+{
+    //determines if there is solution with the minimun Dsec
+    RP->setDsec(0);
+    bool RP_is_recoverable = searchSolution(RP);
+
+    //if there is solution, search the best solution
+    if(RP_is_recoverable) {
+        //determines if there is solution with the maximun Dsec
+        RP->setDsec(RP->getDsecMax());
+        RP_is_recoverable = searchSolution(RP);
+
+        //if with the maximun Dsec there is'nt solution, perform a binary search
+        if(!RP_is_recoverable) {
+            //initialize the searching interval
+            double DsecMin = 0;
+            double DsecMax = RP->getDsecMax();
+
+            //variables for jumping point
+            double Dsec = DsecMax;
+            double PrevDsec;
+
+            do {
+                //save the last value of the jumping point
+                PrevDsec = Dsec;
+
+                //calculates the new jumping point
+                Dsec = (DsecMax + DsecMin)/2;
+
+                //set the jumping point in the RP
+                RP->setDsec(Dsec);
+
+                //search a solution
+                RP_is_recoverable = searchSolution(RP);
+
+                //actualize the searching interval
+                if(RP_is_recoverable)
+                    DsecMin = Dsec;
+                else
+                    DsecMax = Dsec;
+
+            } while(Dsec != PrevDsec);
+
+            //set the solution and regenerate the motion program
+            RP->setDsec(DsecMin);
+            RP_is_recoverable = searchSolution(RP);
+        }
+    }
+
+    //return the result of the search
+    return RP_is_recoverable;
+}
+
 //Determines the RPs which can be recovered in each subset of each set.
 //Inputs:
 //  DDS: structure to contain disjoint disperse subsets.
@@ -1067,64 +1213,108 @@ void TMotionProgramGenerator::segregateRecoverables(
     //AND IF A COLLISION IS DETECTED, MODIFY THE INDIVIDUAL MP AND
     //REITERATES THE PROCESS:
 
+    //list the RPs of DDS in the order of DDS
+    TRoboticPositionerList RPs;
     for(int i=0; i<DDS.getCount(); i++) {
         TPointersList<TRoboticPositionerList> *DisjointSet = DDS.GetPointer(i);
         for(int j=0; j<DisjointSet->getCount(); j++) {
             TRoboticPositionerList *DisperseSubset = DisjointSet->GetPointer(j);
-            for(int k=0; k<DisperseSubset->getCount(); k++) {
-                TRoboticPositioner *RP = DisperseSubset->Get(k);
-
-                //determines if there is solution with the minimun Dsec
-                RP->setDsec(0);
-                bool RP_is_recoverable = searchSolution(RP);
-
-                //if there is solution, search the best solution
-                if(RP_is_recoverable) {
-                    //determines if there is solution with the maximun Dsec
-                    RP->setDsec(RP->getDsecMax());
-                    RP_is_recoverable = searchSolution(RP);
-
-                    //if with the maximun Dsec there is'nt solution, perform a binary search
-                    if(!RP_is_recoverable) {
-                        //initialize the searching interval
-                        double DsecMin = 0;
-                        double DsecMax = RP->getDsecMax();
+            for(int k=0; k<DisperseSubset->getCount(); k++)
+                RPs.Add(DisperseSubset->Get(k));
+        }
+    }
 
-                        //variables for jumping point
-                        double Dsec = DsecMax;
-                        double PrevDsec;
+    //determines the number of threads
+    int N = Workers::getNworkers(Nthreads, RPs.getCount());
 
-                        do {
-                            //save the last value of the jumping point
-                            PrevDsec = Dsec;
+    //results of each RP
+    //(vector<char> instead vector<bool>, for allow concurrent writting)
+    vector<char> recoverables(RPs.getCount(), false);
 
-                            //calculates the new jumping point
-                            Dsec = (DsecMax + DsecMin)/2;
+    //if there is only a thread, search the solutions in the Fiber MOS Model
+    if(N <= 1) {
+        for(int l=0; l<RPs.getCount(); l++)
+            recoverables[l] = searchBestSolution(RPs[l]);
+    }
+    //else, search the solutions in private overlays
+    else {
+        //build the overlay of each RP in this thread,
+        //because the constructors of RPs are not thread-safe
+        vector<TRoboticPositionerList*> Overlays(RPs.getCount());
+        vector<TMotionProgramGenerator*> MPGs(RPs.getCount());
+        for(int l=0; l<RPs.getCount(); l++) {
+            Overlays[l] = new TRoboticPositionerList();
+            Overlays[l]->Add(buildOverlayClon(RPs[l]));
+            MPGs[l] = new TMotionProgramGenerator(getFiberMOSModel());
+            MPGs[l]->setdt1Max(dt1Max);
+            MPGs[l]->setOverlay(Overlays[l]);
+        }
 
-                            //set the jumping point in the RP
-                            RP->setDsec(Dsec);
+        //distribute the RPs among the threads
+        vector<exception_ptr> errors(RPs.getCount());
+        atomic<int> next(0);
+        vector<thread> workers;
+        for(int w=0; w<N; w++)
+            workers.push_back(thread([&]() {
+                Workers::setWorker(true);
+                int l;
+                while((l = next++) < RPs.getCount()) {
+                    try {
+                        TRoboticPositioner *RP = Overlays[l]->Get(0);
+                        recoverables[l] = MPGs[l]->searchBestSolution(RP);
+                    }
+                    catch(...) {
+                        errors[l] = current_exception();
+                    }
+                }
+            }));
+        for(unsigned int w=0; w<workers.size(); w++)
+            workers[w].join();
+
+        //accumulate the statistics of the validations of the MPGs
+        for(int l=0; l<RPs.getCount(); l++) {
+            Nsteps += MPGs[l]->Nsteps;
+            Ndistances += MPGs[l]->Ndistances;
+        }
 
-                            //search a solution
-                            RP_is_recoverable = searchSolution(RP);
+        //search the first RP which has failed
+        int first = 0;
+        while(first<RPs.getCount() && !errors[first])
+            first++;
+
+        //write the solutions in the original RPs
+        if(first >= RPs.getCount())
+            for(int l=0; l<RPs.getCount(); l++) {
+                TRoboticPositioner *RP = RPs[l];
+                const TRoboticPositioner *RP_ = Overlays[l]->Get(0);
+                RP->setDsec(RP_->getDsec());
+                RP->MPturn.Clone(RP_->MPturn);
+                RP->MPretraction.Clone(RP_->MPretraction);
+            }
 
-                            //actualize the searching interval
-                            if(RP_is_recoverable)
-                                DsecMin = Dsec;
-                            else
-                                DsecMax = Dsec;
+        //destroy the MPGs and the overlays
+        for(int l=0; l<RPs.getCount(); l++) {
+            delete MPGs[l];
+            delete Overlays[l]->Get(0);
+            delete Overlays[l];
+        }
 
-                        } while(Dsec != PrevDsec);
+        //rethrow the exception of the first RP which has failed
+        if(first < RPs.getCount())
+            rethrow_exception(errors[first]);
+    }
 
-                        //set the solution and regenerate the motion program
-                        RP->setDsec(DsecMin);
-                        RP_is_recoverable = searchSolution(RP);
-                    }
-                }
+    //REACT ACCORDING THE RESULT OF THE SEARCH:
 
-                //-----------------------------------------------------------
-                //REACT ACCORDING THE RESULT OF THE SEARCH:
+    int l = 0;
+    for(int i=0; i<DDS.getCount(); i++) {
+        TPointersList<TRoboticPositionerList> *DisjointSet = DDS.GetPointer(i);
+        for(int j=0; j<DisjointSet->getCount(); j++) {
+            TRoboticPositionerList *DisperseSubset = DisjointSet->GetPointer(j);
+            for(int k=0; k<DisperseSubset->getCount(); k++) {
+                TRoboticPositioner *RP = DisperseSubset->Get(k);
 
-                if(RP_is_recoverable) {
+                if(recoverables[l++]) {
                     //add the RP to the indicated disperse subset of RecoverablesDDS
                     RecoverablesDDS.GetPointer(i)->GetPointer(j)->Add(RP);
                 } else { //if there isn't solution
@@ -219,6 +219,18 @@ protected:
     /// (MPturn, MPretraction, Dmin) which will contains the last proposal.
     bool searchSolution(TRoboticPositioner *RP);
 
+    /// @brief Search the best recovery program for a individual RP,
+    /// it is to say, the recovery program with the maximun Dsec
+    /// in the interval [0, DsecMax].
+    /// @param[in] RP the RP to be recovered.
+    /// @param[out] RP->MPturn, RP->MPretraction the generated MPs.
+    /// @param[out] RP->Dsec the maximun Dsec with which there is solution.
+    /// @return true: if the RP is recoverable.
+    /// @pre The RP shall accomplish the preconditions of searchSolution.
+    /// @post The RP will be in their initial status, except their properties
+    /// (MPturn, MPretraction, Dsec) which will contains the solution.
+    bool searchBestSolution(TRoboticPositioner *RP);
+
     /// @brief Determines the RPs which can be recovered in each subset of each set.
     /// @param[in] DDS structure to contain disjoint disperse subsets.
     /// @param[out] RecoverablesDDS structure to contain the RPs which can be recovered.
@@ -239,6 +251,11 @@ protected:
     /// - have stored their initial positions.
     /// - have disabled the quantifiers of their rotors.
     /// - have programmed any movement.
+    /// @note The search of each RP is performed on a private clon of the RP,
+    /// attached as pose overlay to the Fiber MOS Model, which is only read,
+    /// so the RPs can be searched in Nthreads threads
+    /// (inherited from TAllocationList), and the results are
+    /// written in the original RPs in the order of DDS.
     void segregateRecoverables(
       TPointersList<TPointersList<TRoboticPositionerList> >& RecoverablesDDS,
       TPointersList<TPointersList<TRoboticPositionerList> >& UnrecoverablesDDS,
@@ -25,6 +25,10 @@
 #include "MotionProgramValidator.h"
 #include "TextFile.h" //StrWriteToFile
 #include "Geometry.h" //distanceLineToPoint
+#include "Profiler.h"
+#include "Workers.h"
+
+#include <algorithm> //stable_sort
 
 //---------------------------------------------------------------------------
 
@@ -46,13 +50,27 @@ void getRPsIncludedInMP(TRoboticPositionerList& RPL,
     if(FMM == NULL)
         throw EImproperArgument("pointer FMM should point to built Fiber MOS Model");
 
-    //check if all message of instruction in the MP are addressed to an existent RP of the Fiber MOS Model
+    //MAKE ACTIONS:
+
+    getRPsIncludedInMP(RPL, MP, FMM->RPL);
+}
+//Get the list of RPs included in a MP.
+//Precondition:
+//  All message of instruction in the MP shall be addressed
+//  to an existent RP of the list Source.
+void getRPsIncludedInMP(TRoboticPositionerList& RPL,
+                        const TMotionProgram& MP,
+                        const TRoboticPositionerList& Source)
+{
+    //CHECK THE PRECONDITION:
+
+    //check if all message of instruction in the MP are addressed to an existent RP of the list Source
     for(int i=0; i<MP.getCount(); i++) {
         const TMessageList *ML = MP.GetPointer(i);
         for(int j=0; j<ML->getCount(); j++) {
             const TMessageInstruction *MI = ML->GetPointer(j);
-            int k = FMM->RPL.searchId(MI->getId());
-            if(k >= FMM->RPL.getCount())
+            int k = Source.searchId(MI->getId());
+            if(k >= Source.getCount())
                 throw EImproperArgument("all message of instruction in the MP shall be addressed to an existent RP of the Fiber MOS Model");
         }
     }
@@ -68,19 +86,19 @@ void getRPsIncludedInMP(TRoboticPositionerList& RPL,
         for(int j=0; j<ML->getCount(); j++) {
             const TMessageInstruction *MI = ML->GetPointer(j);
 
-            //search the identifier RP in the Fiber MOS Model
-            int k = FMM->RPL.searchId(MI->getId());
+            //search the identifier RP in the list Source
+            int k = Source.searchId(MI->getId());
             //if not has found the identifier Id
-            if(k >= FMM->RPL.getCount())
+            if(k >= Source.getCount())
                 //indicates lateral effect
                 throw EImpossibleError("lateral effect");
             //if has found the identifier Id
             else {
                 //actualice the RPL avoiding repetitions
-                TRoboticPositioner *RP = FMM->RPL[k];
+                TRoboticPositioner *RP = Source[k];
                 int l = RPL.searchId(RP->getActuator()->getId());
                 if(l >= RPL.getCount())
-                    RPL.Add(FMM->RPL[k]);
+                    RPL.Add(Source[k]);
             }
         }
     }
@@ -168,6 +186,429 @@ void getRPsIncludedInMPs(TRoboticPositionerList& RPL,
     }
 }
 
+//Segregate the RPs of a list in clusters of RPs transitively adjacent.
+//Two RPs are adjacent when one of them is in the list AdjacentRPs
+//of the other. The RPs of each cluster are in the same order than
+//in the list RPL, and the clusters are sorted by its first RP.
+void segregateRPsInClusters(TPointersList<TRoboticPositionerList>& Clusters,
+                            const TRoboticPositionerList& RPL)
+{
+    //initialize the output
+    Clusters.Clear();
+
+    //build the adjacency graph restricted to the RPs of the RPL,
+    //in both senses, because the adjacency can be asymmetric
+    vector<vector<int> > Adjacents(RPL.getCount());
+    for(int i=0; i<RPL.getCount(); i++) {
+        TRoboticPositioner *RP = RPL[i];
+        for(int k=0; k<RP->getActuator()->AdjacentRPs.getCount(); k++) {
+            int j = RPL.Search(RP->getActuator()->AdjacentRPs[k].RP);
+            if(j < RPL.getCount()) {
+                Adjacents[i].push_back(j);
+                Adjacents[j].push_back(i);
+            }
+        }
+    }
+
+    //label each RP with the index of its cluster
+    vector<int> labels(RPL.getCount(), -1);
+    int N = 0;
+    for(int i=0; i<RPL.getCount(); i++) {
+        if(labels[i] >= 0)
+            continue;
+
+        //traverse the connected component of the RP
+        vector<int> pending(1, i);
+        labels[i] = N;
+        while(pending.size() > 0) {
+            int j = pending.back();
+            pending.pop_back();
+            for(unsigned int k=0; k<Adjacents[j].size(); k++) {
+                int l = Adjacents[j][k];
+                if(labels[l] < 0) {
+                    labels[l] = N;
+                    pending.push_back(l);
+                }
+            }
+        }
+        N++;
+    }
+
+    //add the RPs to the clusters in the order of the RPL
+    for(int i=0; i<N; i++)
+        Clusters.Add(new TRoboticPositionerList());
+    for(int i=0; i<RPL.getCount(); i++)
+        Clusters[labels[i]].Add(RPL[i]);
+}
+
+//###########################################################################
+//TClearanceProfile:
+//###########################################################################
+
+//build a clearance profile with the indicated values
+TClearanceProfile::TClearanceProfile(int t_Id, int t_IdA, bool t_isEA,
+                                     int t_gesture, double t_vmaxabs) :
+    Id(t_Id), IdA(t_IdA), isEA(t_isEA),
+    gesture(t_gesture), vmaxabs(t_vmaxabs)
+{
+}
+
+//add a sample (t, D) to the profile
+void TClearanceProfile::addSample(double t_t, double t_D)
+{
+    t.push_back(t_t);
+    D.push_back(t_D);
+}
+
+//get the minimun calculated distance
+double TClearanceProfile::getDmin(void) const
+{
+    double Dmin = DBL_MAX;
+    for(unsigned int i=0; i<D.size(); i++)
+        if(D[i] < Dmin)
+            Dmin = D[i];
+    return Dmin;
+}
+//get the time of the minimun calculated distance
+double TClearanceProfile::gettDmin(void) const
+{
+    double Dmin = DBL_MAX;
+    double tDmin = 0;
+    for(unsigned int i=0; i<D.size(); i++)
+        if(D[i] < Dmin) {
+            Dmin = D[i];
+            tDmin = t[i];
+        }
+    return tDmin;
+}
+//get a lower bound for the distance in the instant t
+double TClearanceProfile::getDlow(double t_t) const
+{
+    double Dlow = DBL_MAX;
+    for(unsigned int i=0; i<D.size(); i++) {
+        double aux = D[i] - vmaxabs*fabs(t_t - t[i]);
+        if(aux < Dlow)
+            Dlow = aux;
+    }
+    return Dlow;
+}
+
+//get the profile in text format
+AnsiString TClearanceProfile::getText(void) const
+{
+    string str = "gesture: "+inttostr(gesture)+"; RP"+inttostr(Id);
+    if(isEA)
+        str += " with EA";
+    else
+        str += " with RP";
+    str += inttostr(IdA);
+    str += "; vmaxabs: "+floattostr(vmaxabs);
+    str += "; Dmin: "+floattostr(getDmin());
+    str += "; tDmin: "+floattostr(gettDmin());
+    str += "; samples: {";
+    for(unsigned int i=0; i<D.size(); i++) {
+        if(i > 0)
+            str += ", ";
+        str += "("+floattostr(t[i])+", "+floattostr(D[i])+")";
+    }
+    str += "}";
+
+    return AnsiString(str);
+}
+
+//---------------------------------------------------------------------------
+//TClearanceProfileList:
+
+//build a list by default
+TClearanceProfileList::TClearanceProfileList(void) :
+    TPointersList<TClearanceProfile>(64)
+{
+}
+
+//search the profile of a pair of a gesture
+int TClearanceProfileList::search(int gesture, int Id, int IdA, bool isEA) const
+{
+    int i = 0;
+    while(i < getCount()) {
+        const TClearanceProfile *CP = Items[i];
+        if(CP->gesture==gesture && CP->Id==Id && CP->IdA==IdA && CP->isEA==isEA)
+            return i;
+        i++;
+    }
+    return i;
+}
+
+//get the list in text format (one profile per line)
+AnsiString TClearanceProfileList::getText(void) const
+{
+    string str;
+    for(int i=0; i<getCount(); i++) {
+        str += Items[i]->getText().str;
+        str += "\r\n";
+    }
+    return AnsiString(str);
+}
+
+//###########################################################################
+//TValidationRecord:
+//###########################################################################
+
+//build a clearance with the indicated values
+TEdgeClearance::TEdgeClearance(int t_Id, int t_IdA, bool t_isEA,
+                               double t_Dmin, double t_Dend) :
+    Id(t_Id), IdA(t_IdA), isEA(t_isEA), Dmin(t_Dmin), Dend(t_Dend)
+{
+}
+
+//---------------------------------------------------------------------------
+//TGestureRecord:
+
+//build a record of a gesture not simulated
+TGestureRecord::TGestureRecord(void) :
+    valid(false), Ids(), Edges()
+{
+}
+
+//determines if the gesture depends on some RP of a list
+bool TGestureRecord::dependsOn(const TVector<int>& t_Ids) const
+{
+    for(int i=0; i<t_Ids.getCount(); i++) {
+        int Id = t_Ids[i];
+        for(unsigned int j=0; j<Ids.size(); j++)
+            if(Ids[j] == Id)
+                return true;
+        for(unsigned int j=0; j<Edges.size(); j++)
+            if(!Edges[j].isEA && Edges[j].IdA==Id)
+                return true;
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------
+//TValidationRecord:
+
+//build an empty record
+TValidationRecord::TValidationRecord(void) :
+    Gestures(), Nsimulated(0)
+{
+}
+
+//empty the record
+void TValidationRecord::Clear(void)
+{
+    Gestures.clear();
+    Nsimulated = 0;
+}
+
+//sort a list of clearances by increasing Dmin
+static void sortEdges(vector<TEdgeClearance>& Edges)
+{
+    stable_sort(Edges.begin(), Edges.end(),
+                [](const TEdgeClearance& E1, const TEdgeClearance& E2) {
+        return E1.Dmin < E2.Dmin;
+    });
+}
+
+//search the clearance of a pair in a list
+//and returns the size of the list if not found
+static unsigned int searchEdge(const vector<TEdgeClearance>& Edges,
+                               int Id, int IdA, bool isEA)
+{
+    unsigned int i = 0;
+    while(i < Edges.size()) {
+        const TEdgeClearance& E = Edges[i];
+        if(E.Id==Id && E.IdA==IdA && E.isEA==isEA)
+            return i;
+        i++;
+    }
+    return i;
+}
+
+//read the clearances of a comment Dmin or Dend of a MI
+//in the format "min: <D>; with EAs: {(EA<IdA>, <D>), ...}; with RPs: {(RP<IdA>, <D>), ...}"
+static void readCommentEdges(vector<TEdgeClearance>& Edges, int Id,
+                             const string& comment, bool Dend)
+{
+    Edges.clear();
+    for(int k=0; k<2; k++) {
+        //search the list of adjacents
+        string label = (k == 0) ? "with EAs: {" : "with RPs: {";
+        size_t i = comment.find(label);
+        if(i == string::npos)
+            throw EImproperArgument("missing \""+label+"\" in comment \""+comment+"\"");
+        i += label.length();
+        size_t end = comment.find('}', i);
+        if(end == string::npos)
+            throw EImproperArgument("missing '}' in comment \""+comment+"\"");
+
+        //read the pairs (adjacent, D)
+        string prefix = (k == 0) ? "(EA" : "(RP";
+        while(i < end) {
+            i = comment.find(prefix, i);
+            if(i==string::npos || i>end)
+                break;
+            size_t comma = comment.find(',', i);
+            size_t close = comment.find(')', i);
+            if(comma==string::npos || close==string::npos || close<comma || close>end)
+                throw EImproperArgument("improper pair in comment \""+comment+"\"");
+            int IdA = strToInt(strTrim(comment.substr(i + 3, comma - i - 3)));
+            double D = strToFloat(strTrim(comment.substr(comma + 1, close - comma - 1)));
+            Edges.push_back(TEdgeClearance(Id, IdA, k==0, Dend ? DBL_MAX : D, Dend ? D : DBL_MAX));
+            i = close + 1;
+        }
+    }
+}
+
+//build the record from the comments (Dmin, Dend) of the MIs of a MP
+void TValidationRecord::setComments(const TMotionProgram& MP)
+{
+    try {
+        Clear();
+        Gestures.resize(MP.getCount());
+        for(int i=0; i<MP.getCount(); i++) {
+            const TMessageList *ML = MP.GetPointer(i);
+            TGestureRecord& GR = Gestures[i];
+            GR.valid = true;
+            for(int j=0; j<ML->getCount(); j++) {
+                const TMessageInstruction *MI = ML->GetPointer(j);
+                GR.Ids.push_back(MI->getId());
+                if(MI->getCommentDmin().length()<=0 || MI->getCommentDend().length()<=0) {
+                    GR.valid = false;
+                    continue;
+                }
+
+                //merge the Dmins and the Dends of the pairs of the RP
+                vector<TEdgeClearance> Dmins, Dends;
+                readCommentEdges(Dmins, MI->getId(), MI->getCommentDmin(), false);
+                readCommentEdges(Dends, MI->getId(), MI->getCommentDend(), true);
+                if(Dmins.size() != Dends.size())
+                    throw EImproperArgument("comments Dmin and Dend of the RP"+inttostr(MI->getId())+" should have the same pairs");
+                for(unsigned int k=0; k<Dmins.size(); k++) {
+                    if(Dmins[k].IdA!=Dends[k].IdA || Dmins[k].isEA!=Dends[k].isEA)
+                        throw EImproperArgument("comments Dmin and Dend of the RP"+inttostr(MI->getId())+" should have the same pairs");
+                    Dmins[k].Dend = Dends[k].Dend;
+                    GR.Edges.push_back(Dmins[k]);
+                }
+            }
+            if(GR.valid)
+                sortEdges(GR.Edges);
+            else
+                GR.Edges.clear();
+        }
+    }
+    catch(Exception& E) {
+        Clear();
+        E.Message.Insert(1, "setting record from comments: ");
+        throw;
+    }
+}
+
+//###########################################################################
+//TClearanceTracker:
+//###########################################################################
+
+//Clearance tracker of a pair (RP, adjacent) during a gesture.
+//Store the last calculated distance, so the distance in a later instant
+//can be limited by the swept-arc bound:
+//  D(t) >= Dlast - vmaxabs*(t - tlast).
+//The vmaxabs is the same upper top for the longitudinal velocity
+//used in calculateTf, so the bound for Tf is a lower bound of
+//the value that would be calculated.
+class TClearanceTracker {
+public:
+    //pair (RP, adjacent)
+    TRoboticPositioner *RP;
+    TExclusionArea *EAA; //adjacent EA or NULL
+    TRoboticPositioner *RPA; //adjacent RP or NULL
+    TAdjacentRP *ARP; //slot of the adjacent RP or NULL
+
+    //values (Dmin, Dend) of the slot of the adjacent in the RP
+    double *Dmin;
+    double *Dend;
+    //saved values (Dmin, Dend) of the slot
+    double Dmin0, Dend0;
+
+    //SPM of the arm of the RP and the barrier of the adjacent
+    double SPM1, SPM2;
+    //upper top for relative longitudinal velocity
+    double vmaxabs;
+
+    //flag indicating if the distance has been calculated
+    bool calculated;
+    //last calculated distance and its time
+    double Dlast, tlast;
+    //lower bounds for the distance and the free time
+    double Dlow, Tflow;
+
+    //attached clearance profile or NULL
+    TClearanceProfile *CP;
+
+    //build a tracker for a pair (RP, EA)
+    TClearanceTracker(TRoboticPositioner *t_RP, TAdjacentEA& AEA) :
+        RP(t_RP), EAA(AEA.EA), RPA(NULL), ARP(NULL),
+        Dmin(&AEA.Dmin), Dend(&AEA.Dend), Dmin0(DBL_MAX), Dend0(DBL_MAX),
+        SPM1(t_RP->getActuator()->getArm()->getSPM()), SPM2(AEA.EA->Barrier.getSPM()),
+        vmaxabs(t_RP->calculatevmaxabs()),
+        calculated(false), Dlast(DBL_MAX), tlast(0), Dlow(DBL_MAX), Tflow(DBL_MAX),
+        CP(NULL) {}
+    //build a tracker for a pair (RP, RP)
+    TClearanceTracker(TRoboticPositioner *t_RP, TAdjacentRP& t_ARP) :
+        RP(t_RP), EAA(NULL), RPA(t_ARP.RP), ARP(&t_ARP),
+        Dmin(&t_ARP.Dmin), Dend(&t_ARP.Dend), Dmin0(DBL_MAX), Dend0(DBL_MAX),
+        SPM1(t_RP->getActuator()->getArm()->getSPM()), SPM2(t_ARP.RP->getActuator()->getArm()->getSPM()),
+        vmaxabs(t_RP->calculatevmaxabs() + t_ARP.RP->calculatevmaxabs()),
+        calculated(false), Dlast(DBL_MAX), tlast(0), Dlow(DBL_MAX), Tflow(DBL_MAX),
+        CP(NULL) {}
+
+    //calculates the lower bounds (Dlow, Tflow) in the instant t
+    void calculateBounds(double t) {
+        if(vmaxabs != 0) {
+            //the margin ERR_NUM absorbs the numerical error of the distance
+            Dlow = Dlast - vmaxabs*(t - tlast) - ERR_NUM;
+            //same operations than in calculateTf, so that Tflow <= Tf
+            double Df = Dlow - SPM1 - SPM2;
+            Tflow = Df/vmaxabs;
+        } else {
+            //the distance remains constant
+            Dlow = Dlast;
+            Tflow = DBL_MAX;
+        }
+    }
+    //saves the values (Dmin, Dend) of the slot
+    void save(void) {
+        Dmin0 = *Dmin;
+        Dend0 = *Dend;
+    }
+    //restores the values (Dmin, Dend) of the slot
+    void restore(void) {
+        *Dmin = Dmin0;
+        *Dend = Dend0;
+    }
+    //resets the tracker and the values (Dmin, Dend) of the slot,
+    //and discards the samples of the attached clearance profile
+    void reset(void) {
+        *Dmin = DBL_MAX;
+        *Dend = DBL_MAX;
+        calculated = false;
+        Dlast = DBL_MAX;
+        tlast = 0;
+        Dlow = DBL_MAX;
+        Tflow = DBL_MAX;
+        if(CP != NULL) {
+            CP->t.clear();
+            CP->D.clear();
+        }
+    }
+    //stores the distance calculated in the instant t
+    void store(double t) {
+        calculated = true;
+        Dlast = *Dend;
+        tlast = t;
+        if(CP != NULL)
+            CP->addSample(t, Dlast);
+    }
+};
+
 //###########################################################################
 //TMotionProgramValidator:
 //###########################################################################
@@ -270,6 +711,42 @@ double TMotionProgramValidator::calculateTf(TRoboticPositioner *RP,
 
     return Tf; //return Tf
 }
+//calculates the time free of collission of a RP
+//and the RP of a slot of its list AdjacentRPs
+double TMotionProgramValidator::calculateTf(TRoboticPositioner *RP,
+                                            TAdjacentRP& ARP) const
+{
+    //CHECK THE PRECONDITIONS:
+
+    if(RP == NULL)
+        throw EImproperArgument("pointer RP should point to built robotic positioner");
+    if(ARP.RP == NULL)
+        throw EImproperArgument("adjacent RP ARP should has an attached RP");
+
+    //MAKE ACTIONS:
+
+    //calculates the distance between the contours,
+    //or get it from the edge if it has been calculated in this step
+    double D = RP->getActuator()->distanceMin(ARP);
+    //calcula la distancia libre de los brazos
+    double Df = D - RP->getActuator()->getArm()->getSPM() - ARP.RP->getActuator()->getArm()->getSPM();
+
+    //calculates an upper top for longitudinal velocity
+    double vmaxabs1 = RP->calculatevmaxabs();
+    double vmaxabs2 = ARP.RP->calculatevmaxabs();
+    double vmaxabs = vmaxabs1 + vmaxabs2;
+
+    //calculates Tf
+    double Tf;
+    if(vmaxabs != 0)
+        Tf = Df/vmaxabs;
+    else
+        Tf = DBL_MAX;
+
+    //Note that when vmaxabs == 0, the Tf is infinity, even when Df == 0.
+
+    return Tf; //return Tf
+}
 //calculates the minimun step time of a pair (RP, EA)
 double TMotionProgramValidator::calculateTmin(const TRoboticPositioner *RP,
                      const TExclusionArea *EAA) const
@@ -327,6 +804,8 @@ double TMotionProgramValidator::calculateTmin(const TRoboticPositioner *RP,
 //a RP with their adjacents
 double TMotionProgramValidator::calculateTfmin(TRoboticPositioner *RP) const
 {
+    PROFILE_SCOPE(pfCalculateTfmin);
+
     //check the precondition
     if(RP == NULL)
         throw EImproperArgument("pointer RP should point to built robotic positioner");
@@ -378,6 +857,8 @@ double TMotionProgramValidator::calculateTminmin(const TRoboticPositioner *RP) c
 //the RPs of a list
 double TMotionProgramValidator::calculateTfmin(const TRoboticPositionerList& RPL) const
 {
+    PROFILE_SCOPE(pfCalculateTfmin);
+
     //minimun time free of the RPs of the RPL
     double Tfmin = DBL_MAX; //initialize Tfmin with its maximun possible value
     bool notcollision = true; //initialize the collision indicator flag
@@ -417,10 +898,10 @@ double TMotionProgramValidator::calculateTfmin(const TRoboticPositionerList& RPL
         k = 0;
         while(k<RP->getActuator()->AdjacentRPs.getCount() && notcollision) {
             //point the indicated adjacent RP to facilitateits access
-            TRoboticPositioner *RPA = RP->getActuator()->AdjacentRPs[k].RP;
+            TAdjacentRP& ARP = RP->getActuator()->AdjacentRPs[k];
 
             //calculates the free time between the RP and its adjacent
-            double Tf = calculateTf(RP, RPA);
+            double Tf = calculateTf(RP, ARP);
 
             //if there is collision
             if(Tf < 0) {
@@ -518,6 +999,362 @@ double TMotionProgramValidator::calculateTminmin(const TRoboticPositionerList& R
     return Tminmin;
 }
 
+//invalidate the distances of the edges of the adjacency graph
+//of the RPs of a list
+void TMotionProgramValidator::invalidateEdges(const TRoboticPositionerList& RPL) const
+{
+    for(int i=0; i<RPL.getCount(); i++)
+        RPL[i]->getActuator()->AdjacentRPs.invalidateEdges();
+}
+
+//calculates the minimun time free of collission of
+//the pairs of a list of clearance trackers
+double TMotionProgramValidator::calculateTfmin(vector<TClearanceTracker>& CTs) const
+{
+    PROFILE_SCOPE(pfCalculateTfmin);
+
+    //The trackers of a cluster are built in the same order
+    //than the pairs are calculated in calculateTfmin(RPL),
+    //so the result is the same.
+
+    double Tfmin = DBL_MAX;
+    for(unsigned int i=0; i<CTs.size(); i++) {
+        TClearanceTracker *CT = &CTs[i];
+
+        //calculates the free time of the pair
+        double Tf;
+        if(CT->EAA != NULL)
+            Tf = calculateTf(CT->RP, CT->EAA);
+        else
+            Tf = calculateTf(CT->RP, *(CT->ARP));
+
+        //if there is collision
+        if(Tf < 0)
+            return Tf;
+        //actualize the minimun free time
+        if(Tf < Tfmin)
+            Tfmin = Tf;
+    }
+
+    return Tfmin;
+}
+
+//calculates the minimun time free of collission of
+//the pairs of a list of clearance trackers, by conservative advancement
+double TMotionProgramValidator::calculateTfminCA(vector<TClearanceTracker>& CTs,
+                                                 double t) const
+{
+    //SOLVE THE TRIVIAL CASE:
+
+    //if there are pairs without distance calculated
+    for(unsigned int i=0; i<CTs.size(); i++)
+        if(!CTs[i].calculated) {
+            //calculates the minimun free time in the usual way
+            double Tfmin = calculateTfmin(CTs);
+
+            //if there isn't collision, all distances has been calculated
+            if(Tfmin >= 0)
+                for(unsigned int j=0; j<CTs.size(); j++)
+                    CTs[j].store(t);
+
+            return Tfmin;
+        }
+
+    //CALCULATES ONLY THE NEEDED DISTANCES:
+
+    //calculates the lower bounds of all pairs
+    for(unsigned int i=0; i<CTs.size(); i++)
+        CTs[i].calculateBounds(t);
+
+    double Tfmin = DBL_MAX;
+    bool collision = false;
+
+    //In the first pass are calculated the distances that could reduce
+    //the Dmin of the pair, and in the second pass are calculated
+    //the distances that could reduce the Tfmin.
+    for(int pass=0; pass<2 && !collision; pass++) {
+        unsigned int i = 0;
+        while(i<CTs.size() && !collision) {
+            TClearanceTracker *CT = &CTs[i];
+
+            //determines if the distance must be calculated
+            bool needed;
+            if(pass == 0)
+                needed = CT->Dlow < *(CT->Dmin);
+            else
+                needed = CT->tlast!=t && CT->Tflow<Tfmin;
+
+            //calculates the free time of the pair
+            if(needed) {
+                CT->save();
+                double Tf;
+                if(CT->EAA != NULL)
+                    Tf = calculateTf(CT->RP, CT->EAA);
+                else
+                    Tf = calculateTf(CT->RP, *(CT->ARP));
+                CT->store(t);
+
+                if(Tf < 0)
+                    collision = true;
+                else if(Tf < Tfmin)
+                    Tfmin = Tf;
+            }
+
+            i++;
+        }
+    }
+
+    //Note that the pairs not calculated have Tf >= Tflow >= Tfmin,
+    //and D >= Dlow >= Dmin, so they have not influence in the result.
+
+    //if there is collision
+    if(collision) {
+        //restore the values (Dmin, Dend) calculated in this step
+        for(unsigned int i=0; i<CTs.size(); i++)
+            if(CTs[i].tlast == t)
+                CTs[i].restore();
+
+        //calculates the values (Dmin, Dend) in the same order
+        //than in calculateTfmin, which stops in the first collision
+        return calculateTfmin(CTs);
+    }
+
+    return Tfmin;
+}
+
+//simulate the programmed gesture for the RPs of a cluster,
+//with its own simulation times
+bool TMotionProgramValidator::validateGesture(TRoboticPositionerList& Cluster,
+                                              vector<TClearanceTracker>& CTs,
+                                              double& tcol, bool& colfin,
+                                              unsigned long long& steps,
+                                              unsigned long long& distances,
+                                              double Tlimit) const
+{
+    //Only are moved and checked the RPs of the cluster, and the RPs
+    //adjacent to the cluster which not are included in the MP
+    //remain stopped, so the cluster can be simulated concurrently
+    //with other clusters.
+
+    double Tfmin; //minimun free time
+
+    //initialize the statistics of the gesture
+    steps = 0;
+    unsigned long long distances0 = TActuator::getNdistances();
+
+    //calculates the minimun jump time of the cluster
+    //(it is constant during the gesture)
+    double Tmin = calculateTminmin(Cluster);
+
+    //get the time of displacement of the cluster
+    double Tdis = Cluster.getTdis();
+    //determines the time until which the gesture is simulated
+    bool limited = (Tlimit < Tdis);
+    double Tend = limited ? Tlimit : Tdis;
+    //initialize the simulation time
+    double t = 0;
+    //while has not reached the end
+    while(t < Tend) {
+        //move the rotors of the RPs to time t
+        Cluster.move(t);
+        invalidateEdges(Cluster);
+        steps++;
+
+        //calculates the minimun free time of the cluster
+        Tfmin = calculateTfminCA(CTs, t);
+
+        //Calculus of Tfmin pruduces update of (Dmin, Dend) of the RPs of the cluster.
+
+        //if there is collision
+        if(Tfmin < 0) {
+            tcol = t;
+            colfin = false;
+            distances = TActuator::getNdistances() - distances0;
+            return false;
+        }
+
+        //Note that collision is detected when Tfmin < 0, and not <=,
+        //becuase Tfmin can not be less zero.
+
+        //applies the minimun jump time of the cluster
+        if(Tfmin < Tmin)
+            Tfmin = Tmin;
+
+        //advance simulation
+        t += Tfmin;
+
+        //NOTE: numerical error accumulated in t is eclipsed by
+        //the additional margins of Tfmin. Tfmin has additional margins
+        //due to the trajectory of all points of the armis circular.
+
+    } //while(t < Tend);
+
+    //move the rotors of the RPs to final positions
+    //(or to the positions in the time limit)
+    if(limited)
+        Cluster.move(Tend);
+    else
+        Cluster.moveFin();
+    invalidateEdges(Cluster);
+    steps++;
+
+    //calculates the minimun free time
+    Tfmin = calculateTfmin(CTs);
+    distances = TActuator::getNdistances() - distances0;
+
+    //Calculus of Tfmin pruduces update of (Dmin, Dend) of the RPs of the cluster.
+
+    //if there is collision
+    if(Tfmin < 0) {
+        tcol = Tend;
+        colfin = !limited;
+        return false;
+    }
+
+    //add the final distances to the clearance profiles
+    for(unsigned int j=0; j<CTs.size(); j++)
+        if(CTs[j].CP != NULL)
+            CTs[j].store(Tend);
+
+    //indicates that the gesture avoid collisions in the cluster
+    tcol = Tend;
+    colfin = false;
+    return true;
+}
+
+//revalidate a gesture simulating only the pairs (RP, adjacent)
+//where the RP or the adjacent has been modified
+bool TMotionProgramValidator::revalidateGesture(TRoboticPositionerList& RPL,
+                                                TMessageList *ML,
+                                                TGestureRecord& GR,
+                                                const TVector<int>& Modified) const
+{
+    //The RPs not modified follow the same trajectories than in the record,
+    //so the pairs of RPs not modified avoid collisions and have
+    //the same clearances than in the record. Only the pairs where some
+    //of the RPs has been modified shall be simulated.
+
+    //segregate the RPs modified or adjacent to a modified RP
+    TRoboticPositionerList Sub;
+    for(int j=0; j<RPL.getCount(); j++) {
+        TRoboticPositioner *RP = RPL[j];
+        bool affected = Modified.Search(RP->getActuator()->getId()) < Modified.getCount();
+        for(int k=0; k<RP->getActuator()->AdjacentRPs.getCount() && !affected; k++)
+            if(Modified.Search(RP->getActuator()->AdjacentRPs[k].RP->getActuator()->getId()) < Modified.getCount())
+                affected = true;
+        if(affected)
+            Sub.Add(RP);
+    }
+
+    //reset the parameters (Dmin, Dend) of the segregated RPs
+    //and build the clearance trackers of the pairs with a modified RP
+    vector<TClearanceTracker> CTs;
+    for(int j=0; j<Sub.getCount(); j++) {
+        TRoboticPositioner *RP = Sub[j];
+        TActuator *A = RP->getActuator();
+        A->AdjacentEAs.setAllDmins(DBL_MAX);
+        A->AdjacentEAs.setAllDends(DBL_MAX);
+        A->AdjacentRPs.setAllDmins(DBL_MAX);
+        A->AdjacentRPs.setAllDends(DBL_MAX);
+
+        bool modified = Modified.Search(A->getId()) < Modified.getCount();
+        if(modified)
+            for(int k=0; k<A->AdjacentEAs.getCount(); k++)
+                CTs.push_back(TClearanceTracker(RP, A->AdjacentEAs[k]));
+        for(int k=0; k<A->AdjacentRPs.getCount(); k++) {
+            TAdjacentRP& ARP = A->AdjacentRPs[k];
+            if(modified || Modified.Search(ARP.RP->getActuator()->getId()) < Modified.getCount())
+                CTs.push_back(TClearanceTracker(RP, ARP));
+        }
+    }
+
+    //simulate the gesture for the segregated RPs
+    if(Sub.getCount() > 0) {
+        double tcol;
+        bool colfin;
+        unsigned long long steps, distances;
+        bool valid = validateGesture(Sub, CTs, tcol, colfin, steps, distances);
+        Nsteps += steps;
+        Ndistances += distances;
+
+        //if there is collision, return the RPs to the initial positions
+        if(!valid) {
+            Sub.moveSta();
+            invalidateEdges(Sub);
+            return false;
+        }
+    }
+
+    //move the other RPs to their final positions
+    RPL.moveFin();
+    invalidateEdges(RPL);
+
+    //take the clearances of the pairs not simulated from the record
+    for(int j=0; j<Sub.getCount(); j++) {
+        TActuator *A = Sub[j]->getActuator();
+        if(Modified.Search(A->getId()) < Modified.getCount())
+            continue;
+        for(int k=0; k<A->AdjacentEAs.getCount(); k++) {
+            TAdjacentEA& AEA = A->AdjacentEAs[k];
+            unsigned int l = searchEdge(GR.Edges, A->getId(), AEA.EA->getId(), true);
+            if(l < GR.Edges.size()) {
+                AEA.Dmin = GR.Edges[l].Dmin;
+                AEA.Dend = GR.Edges[l].Dend;
+            }
+        }
+        for(int k=0; k<A->AdjacentRPs.getCount(); k++) {
+            TAdjacentRP& ARP = A->AdjacentRPs[k];
+            int IdA = ARP.RP->getActuator()->getId();
+            if(Modified.Search(IdA) < Modified.getCount())
+                continue;
+            unsigned int l = searchEdge(GR.Edges, A->getId(), IdA, false);
+            if(l < GR.Edges.size()) {
+                ARP.Dmin = GR.Edges[l].Dmin;
+                ARP.Dend = GR.Edges[l].Dend;
+            }
+        }
+    }
+
+    //transcript the (Dmin, Dend) of the segregated RPs to corresponding MIs
+    for(int j=0; j<ML->getCount(); j++) {
+        TMessageInstruction *MI = ML->GetPointer(j);
+        int k = Sub.searchId(MI->getId());
+        if(k < Sub.getCount()) {
+            MI->setCommentDmin(Sub[k]->getDminsText().str);
+            MI->setCommentDend(Sub[k]->getDendsText().str);
+        }
+    }
+
+    //update the record with the clearances of the segregated RPs
+    GR.Ids.clear();
+    for(int j=0; j<ML->getCount(); j++)
+        GR.Ids.push_back(ML->GetPointer(j)->getId());
+    vector<TEdgeClearance> Edges;
+    for(unsigned int l=0; l<GR.Edges.size(); l++) {
+        const TEdgeClearance& E = GR.Edges[l];
+        if(find(GR.Ids.begin(), GR.Ids.end(), E.Id)!=GR.Ids.end() &&
+                Sub.searchId(E.Id)>=Sub.getCount())
+            Edges.push_back(E);
+    }
+    for(unsigned int j=0; j<GR.Ids.size(); j++) {
+        int Id = GR.Ids[j];
+        int k = Sub.searchId(Id);
+        if(k >= Sub.getCount())
+            continue;
+        TActuator *A = Sub[k]->getActuator();
+        for(int l=0; l<A->AdjacentEAs.getCount(); l++)
+            Edges.push_back(TEdgeClearance(Id, A->AdjacentEAs[l].EA->getId(), true,
+                                           A->AdjacentEAs[l].Dmin, A->AdjacentEAs[l].Dend));
+        for(int l=0; l<A->AdjacentRPs.getCount(); l++)
+            Edges.push_back(TEdgeClearance(Id, A->AdjacentRPs[l].RP->getActuator()->getId(), false,
+                                           A->AdjacentRPs[l].Dmin, A->AdjacentRPs[l].Dend));
+    }
+    sortEdges(Edges);
+    GR.Edges = Edges;
+
+    return true;
+}
+
 //---------------------------------------------------------------------------
 //BUILDING AND DESTROYING METHODS:
 
@@ -531,6 +1368,40 @@ TMotionProgramValidator::TMotionProgramValidator(TFiberMOSModel *t_FiberMOSModel
 
     //apunta los objetos externos
     FiberMOSModel = t_FiberMOSModel;
+    Overlay = NULL;
+
+    //inicializa las estadísticas
+    Nsteps = 0;
+    Ndistances = 0;
+}
+
+//attach a pose overlay to the validator, or detach it (NULL)
+void TMotionProgramValidator::setOverlay(TRoboticPositionerList *t_Overlay)
+{
+    //check the preconditions
+    if(t_Overlay != NULL)
+        for(int i=0; i<t_Overlay->getCount(); i++) {
+            TRoboticPositioner *RP = t_Overlay->Get(i);
+            int j = FiberMOSModel->RPL.searchId(RP->getActuator()->getId());
+            if(j >= FiberMOSModel->RPL.getCount())
+                throw EImproperArgument("each RP of the overlay should have the Id of a RP of the Fiber MOS Model");
+            if(FiberMOSModel->RPL[j] == RP)
+                throw EImproperArgument("the RPs of the overlay should not be in the Fiber MOS Model");
+            for(int k=0; k<RP->getActuator()->AdjacentRPs.getCount(); k++)
+                if(RP->getActuator()->AdjacentRPs[k].Edge != NULL)
+                    throw EImproperArgument("the adjacency edges of the RPs of the overlay should be NULL");
+        }
+
+    //attach the overlay
+    Overlay = t_Overlay;
+}
+
+//get the list of RPs whose status can be changed by the validator
+TRoboticPositionerList& TMotionProgramValidator::getPoseRPL(void) const
+{
+    if(Overlay != NULL)
+        return *Overlay;
+    return FiberMOSModel->RPL;
 }
 
 //---------------------------------------------------------------------------
@@ -557,6 +1428,10 @@ TMotionProgramValidator::TMotionProgramValidator(TFiberMOSModel *t_FiberMOSModel
 //Outputs:
 //  validateMotionProgram: flag indicating if the motion program
 //      avoid collisions.
+//  CPL: if not NULL, clearance profile of each pair (RP, adjacent)
+//      of the RPs included in the MP, for each gesture.
+//  VR: if not NULL, record of the validation of each gesture,
+//      for revalidate the MP after editing it.
 //Notes:
 //- The validation process of a MP consume a component of the SPM, even
 //  when the process is successfully passed. So if a MP pass the validation
@@ -565,13 +1440,82 @@ TMotionProgramValidator::TMotionProgramValidator(TFiberMOSModel *t_FiberMOSModel
 //- The validation method of a MP will be used during the generation process
 //  with the individual MP of each RP, and at the end of the process for
 //  validate the generated recovery program.
-bool TMotionProgramValidator::validateMotionProgram(TMotionProgram &MP) const
+//- The RPs included in the MP are segregated in clusters of RPs
+//  transitively adjacent, which can not affect each other. Each cluster
+//  is simulated in its own thread, with its own simulation times of
+//  the Variable Jumping Method, and the results are merged in the order
+//  of the clusters, so the result not depends on the number of threads.
+//- In each step only are calculated the distances of the pairs
+//  which can not be discarded by the swept-arc bound (conservative
+//  advancement).
+//- When the MP produces a collision, the comments Dmin of the RPs of
+//  other clusters include the samples until the end of their simulation,
+//  and all RPs are moved to the time of the first collision.
+//- When an overlay is attached, the RPs included in the MP are searched
+//  in the overlay, and the postconditions are referred to the RPs of
+//  the overlay instead of all RPs of the FMM.
+bool TMotionProgramValidator::validateMotionProgram(TMotionProgram &MP,
+                                                    TClearanceProfileList *CPL,
+                                                    TValidationRecord *VR) const
+{
+    return validateGestures(MP, CPL, VR, NULL);
+}
+
+//Revalidate a MP after excluding or editing the instructions of some RPs,
+//simulating only the gestures affected by the change.
+//Inputs:
+//  MP: motion program to be revalidated.
+//  VR: record of the last validation of the MP.
+//  Ids: identifiers of the RPs whose instructions has been excluded
+//      or modified since the last validation.
+//Outputs:
+//  revalidateMotionProgram: flag indicating if the motion program
+//      avoid collisions.
+//  VR: record updated with the gestures simulated.
+//Preconditions:
+//  The preconditions of validateMotionProgram.
+//  The RPs shall be in the same initial positions than
+//  in the last validation of the MP.
+//  The MP shall have the same number of gestures than
+//  in the last validation.
+//Postconditions:
+//  The postconditions of validateMotionProgram.
+//Notes:
+//- The positions of the RPs not modified during a gesture only depend
+//  on their own instructions, so when a gesture was valid and the modified
+//  RPs aren't programmed in the gesture, neither adjacent to a RP
+//  programmed in the gesture, the gesture remains valid. In this case
+//  the RPs are moved to the final positions without simulation,
+//  and the comments Dmin and Dend of the MIs of the gesture are kept.
+//- Excluding a RP from a pair (PP, DP) only affects to the gestures
+//  where the RP or some of its adjacents were programmed.
+bool TMotionProgramValidator::revalidateMotionProgram(TMotionProgram &MP,
+                                                      TValidationRecord &VR,
+                                                      const TVector<int>& Ids) const
+{
+    //check the precondition
+    if(int(VR.Gestures.size()) != MP.getCount())
+        throw EImproperArgument("the record VR should have a gesture for each gesture of the MP");
+
+    return validateGestures(MP, NULL, &VR, &Ids);
+}
+
+//---------------------------------------------------------------------------
+
+//validate the gestures of a MP
+bool TMotionProgramValidator::validateGestures(TMotionProgram &MP,
+                                               TClearanceProfileList *CPL,
+                                               TValidationRecord *VR,
+                                               const TVector<int> *Modified) const
 {
     //CHECK THE PRECONDITIONS:
 
+    //get the list of RPs whose status can be changed
+    TRoboticPositionerList& PoseRPL = getPoseRPL();
+
     //get the list of RPs included in the MP
     TRoboticPositionerList RPL;
-    getRPsIncludedInMP(RPL, MP, FiberMOSModel);
+    getRPsIncludedInMP(RPL, MP, PoseRPL);
 
     for(int i=0; i<RPL.getCount();  i++) {
         TRoboticPositioner *RP = RPL[i];
@@ -579,12 +1523,23 @@ bool TMotionProgramValidator::validateMotionProgram(TMotionProgram &MP) const
             throw EImproperCall("all RPs included in the MP, should be enabled the quantifiers of their rotors");
     }
 
+    //initialize the outputs
+    if(CPL != NULL)
+        CPL->Clear();
+    if(VR != NULL) {
+        if(Modified == NULL) {
+            VR->Clear();
+            VR->Gestures.resize(MP.getCount());
+        }
+        VR->Nsimulated = 0;
+    }
+
     //CONFIGURES ALL RPs OF THE Fiber MOS Model:
 
     //stack the initial status of the quantifiers of the rotors
-    FiberMOSModel->RPL.pushQuantifys();
+    PoseRPL.pushQuantifys();
     //disable the quantifiers
-    FiberMOSModel->RPL.setQuantifys(false, false);
+    PoseRPL.setQuantifys(false, false);
 
     //SOLVE THE TRIVIAL CASE:
 
@@ -592,26 +1547,67 @@ bool TMotionProgramValidator::validateMotionProgram(TMotionProgram &MP) const
     //in the RPs included in the MP
     bool collision = RPL.thereIsCollision();
     //solve the trivial case
-    if(collision)
+    if(collision) {
+        //none gesture has been simulated avoiding collisions
+        if(VR != NULL)
+            for(unsigned int i=0; i<VR->Gestures.size(); i++)
+                VR->Gestures[i].valid = false;
         //indicates that the motion program not avoid dynamic collision
         return false;
+    }
 
     //CHECK THE FOLLOWING STEPPING POSITIONS TO END:
 
+    //segregate the RPs included in the MP in clusters
+    //of RPs which can not affect each other
+    TPointersList<TRoboticPositionerList> Clusters;
+    segregateRPsInClusters(Clusters, RPL);
+
+    //determines the number of threads for simulate the clusters,
+    //so that each thread simulates two clusters at least
+    //(in a worker of other parallel loop the clusters are simulated in it)
+    int Nthreads = Workers::getNworkers(0, Clusters.getCount()/2);
+    //the threads are reused along the gestures of the MP
+    Workers::TWorkerPool Pool(Nthreads);
+
     //search a collision in each gesture
     for(int i=0; i<MP.getCount(); i++) {
         TMessageList *ML = MP.GetPointer(i);
 
         //program the gesture
-        FiberMOSModel->RPL.clearInstructions();
+        PoseRPL.clearInstructions();
         for(int j=0; j<ML->getCount(); j++) {
             const TMessageInstruction *MI = ML->GetPointer(j);
-            FiberMOSModel->RPL.setInstruction(MI->getId(), MI->Instruction);
+            PoseRPL.setInstruction(MI->getId(), MI->Instruction);
         }
 
-        //reset the parameter Dmin of all RPs of the FMM
-        for(int i=0; i<FiberMOSModel->RPL.getCount(); i++) {
-            TRoboticPositioner *RP = FiberMOSModel->RPL[i];
+        //if the gesture was valid, attempt reuse the record
+        if(Modified!=NULL && VR->Gestures[i].valid) {
+            //determines if the gesture depends on the modified RPs
+            bool depends = VR->Gestures[i].dependsOn(*Modified);
+            for(int j=0; j<ML->getCount() && !depends; j++)
+                if(Modified->Search(ML->GetPointer(j)->getId()) < Modified->getCount())
+                    depends = true;
+
+            //if the gesture not depends on the modified RPs,
+            //move the RPs to their final positions without simulation
+            if(!depends) {
+                RPL.moveFin();
+                invalidateEdges(RPL);
+                continue;
+            }
+
+            //else, simulate only the pairs of the modified RPs,
+            //and if they produce a collision, simulate the gesture completely
+            if(revalidateGesture(RPL, ML, VR->Gestures[i], *Modified)) {
+                VR->Nsimulated++;
+                continue;
+            }
+        }
+
+        //reset the parameter Dmin of all RPs of the FMM (or of the overlay)
+        for(int i=0; i<PoseRPL.getCount(); i++) {
+            TRoboticPositioner *RP = PoseRPL[i];
             //RP->Dmin = DBL_MAX;
             //RP->Dend = DBL_MAX;
             RP->getActuator()->AdjacentEAs.setAllDmins(DBL_MAX);
@@ -628,69 +1624,138 @@ bool TMotionProgramValidator::validateMotionProgram(TMotionProgram &MP) const
 
         //Note that only will be used the parameter Dmin
         //of the RPs included in the MP, but is convenient
-        //reset the parameter Dmin of all RPs of the FMM.
-
-        //EXECUTE THE GESTURE:
-
-        double Tfmin; //minimun free time
-
-        //get the time of displacement
-        double Tdis = FiberMOSModel->RPL.getTdis();
-        //initialize the simulation time
-        double t = 0;
-        //while has not reached the end
-        while(t < Tdis) {
-            //move the rotors of the RPs to time t
-            FiberMOSModel->RPL.move(t);
-
-            //calculates the minimun free time of the RPL
-            Tfmin = calculateTfmin(RPL);
-
-            //Calculus of Tfmin pruduces update of (Dmin, Dend) of the RPs of the RPL.
-
-            //if there is collision
-            if(Tfmin < 0) {
-                //transcript the Dmin of the RPs to corresponding MIs
-                //and reset them
-                for(int i=0; i<ML->getCount(); i++) {
-                    TMessageInstruction *MI = ML->GetPointer(i);
-                    int j = RPL.searchId(MI->getId());
-                    if(j >= RPL.getCount())
-                        throw EImpossibleError("lateral effect");
-                    TRoboticPositioner *RP = RPL[j];
-                    MI->setCommentDmin(RP->getDminsText().str);
-
-                    //For a single value, you can write:
-                    //  MI->setCommentDmin("Dmin = "+floattostr(RP->Dmin));
-                }
-                //indicates that the motion program not avoid dynamic collision
-                return false;
+        //reset the parameter Dmin of all RPs of the FMM (or of the overlay).
+
+        //build the clearance trackers of the pairs (RP, adjacent)
+        //of each cluster
+        vector<vector<TClearanceTracker> > CTs(Clusters.getCount());
+        for(int c=0; c<Clusters.getCount(); c++) {
+            const TRoboticPositionerList& Cluster = Clusters[c];
+            for(int j=0; j<Cluster.getCount(); j++) {
+                TRoboticPositioner *RP = Cluster[j];
+                for(int k=0; k<RP->getActuator()->AdjacentEAs.getCount(); k++)
+                    CTs[c].push_back(TClearanceTracker(RP, RP->getActuator()->AdjacentEAs[k]));
+                for(int k=0; k<RP->getActuator()->AdjacentRPs.getCount(); k++)
+                    CTs[c].push_back(TClearanceTracker(RP, RP->getActuator()->AdjacentRPs[k]));
             }
+        }
+        //attach a clearance profile to each tracker
+        if(CPL != NULL)
+            for(int c=0; c<Clusters.getCount(); c++)
+                for(unsigned int j=0; j<CTs[c].size(); j++) {
+                    TClearanceTracker *CT = &CTs[c][j];
+                    TClearanceProfile *CP;
+                    if(CT->EAA != NULL)
+                        CP = new TClearanceProfile(CT->RP->getActuator()->getId(),
+                                                   CT->EAA->getId(), true, i, CT->vmaxabs);
+                    else
+                        CP = new TClearanceProfile(CT->RP->getActuator()->getId(),
+                                                   CT->RPA->getActuator()->getId(), false, i, CT->vmaxabs);
+                    CPL->Add(CP);
+                    CT->CP = CP;
+                }
 
-            //Note that collision is detected when Tfmin < 0, and not <=,
-            //becuase Tfmin can not be less zero.
-
-            //calculates and applies the minimun jump time of the RPL
-            double Tmin = calculateTminmin(RPL);
-            if(Tfmin < Tmin)
-                Tfmin = Tmin;
-
-            //advance simulation
-            t += Tfmin;
-
-            //NOTE: numerical error accumulated in t is eclipsed by
-            //the additional margins of Tfmin. Tfmin has additional margins
-            //due to the trajectory of all points of the armis circular.
-
-        } //while(t < Tdis);
+        //EXECUTE THE GESTURE IN EACH CLUSTER:
+
+        //results of each cluster
+        //(vector<char> instead vector<bool>, for allow concurrent writting)
+        vector<char> valids(Clusters.getCount(), true);
+        vector<double> tcols(Clusters.getCount(), 0);
+        vector<char> colfins(Clusters.getCount(), false);
+        vector<unsigned long long> steps(Clusters.getCount(), 0);
+        vector<unsigned long long> distances(Clusters.getCount(), 0);
+
+        //distribute the clusters among the threads of the pool
+        //(without threads, simulate the clusters in this thread)
+        Pool.run(Clusters.getCount(), [&](int c) {
+            double tcol;
+            bool colfin;
+            valids[c] = validateGesture(Clusters[c], CTs[c], tcol, colfin,
+                                        steps[c], distances[c]);
+            tcols[c] = tcol;
+            colfins[c] = colfin;
+        });
+
+        //MERGE THE RESULTS OF THE CLUSTERS:
+
+        //accumulate the statistics of the clusters
+        for(int c=0; c<Clusters.getCount(); c++) {
+            Nsteps += steps[c];
+            Ndistances += distances[c];
+        }
 
-        //move the rotors of the RPs to final positions
-        FiberMOSModel->RPL.moveFin();
+        //search the first collision, and in case of tie,
+        //the collision of the first cluster
+        int first = Clusters.getCount();
+        for(int c=0; c<Clusters.getCount(); c++)
+            if(!valids[c] && (first>=Clusters.getCount() || tcols[c]<tcols[first]))
+                first = c;
+        collision = (first < Clusters.getCount());
+
+        //determines the time of displacement of the gesture
+        double Tend = 0;
+        for(int c=0; c<Clusters.getCount(); c++)
+            if(Clusters[c].getTdis() > Tend)
+                Tend = Clusters[c].getTdis();
+
+        //if there is collision, the clusters simulated beyond the time
+        //of the first collision shall be simulated again until that time,
+        //so that their (Dmin, Dend) and their clearance profiles
+        //not include distances calculated after the first collision,
+        //and their RPs remain in the positions of that time
+        if(collision) {
+            double Tlimit = tcols[first];
+            vector<int> Resimulated;
+            for(int c=0; c<Clusters.getCount(); c++)
+                if(c!=first && tcols[c]>Tlimit) {
+                    for(unsigned int j=0; j<CTs[c].size(); j++)
+                        CTs[c][j].reset();
+                    Resimulated.push_back(c);
+                }
 
-        //calculates the minimun free time
-        Tfmin = calculateTfmin(RPL);
+            Pool.run(int(Resimulated.size()), [&](int k) {
+                int c = Resimulated[k];
+                double tcol;
+                bool colfin;
+                validateGesture(Clusters[c], CTs[c], tcol, colfin,
+                                steps[c], distances[c], Tlimit);
+            });
+
+            //Note that in the new simulation a cluster can collide
+            //in the time limit (tie with the first collision), but
+            //the first collision has been already determined.
+
+            //accumulate the statistics of the new simulations
+            for(unsigned int k=0; k<Resimulated.size(); k++) {
+                Nsteps += steps[Resimulated[k]];
+                Ndistances += distances[Resimulated[k]];
+            }
+        }
 
-        //Calculus of Tfmin pruduces update of (Dmin, Dend) of the RPs of the RPL.
+        //record the clearances of the pairs of the RPs programmed
+        if(VR != NULL) {
+            TGestureRecord& GR = VR->Gestures[i];
+            GR.valid = !collision;
+            GR.Ids.clear();
+            GR.Edges.clear();
+            for(int j=0; j<ML->getCount(); j++)
+                GR.Ids.push_back(ML->GetPointer(j)->getId());
+            for(int c=0; c<Clusters.getCount(); c++)
+                for(unsigned int j=0; j<CTs[c].size(); j++) {
+                    const TClearanceTracker *CT = &CTs[c][j];
+                    int Id = CT->RP->getActuator()->getId();
+                    if(find(GR.Ids.begin(), GR.Ids.end(), Id) == GR.Ids.end())
+                        continue;
+                    if(CT->EAA != NULL)
+                        GR.Edges.push_back(TEdgeClearance(Id, CT->EAA->getId(), true,
+                                                          *(CT->Dmin), *(CT->Dend)));
+                    else
+                        GR.Edges.push_back(TEdgeClearance(Id, CT->RPA->getActuator()->getId(), false,
+                                                          *(CT->Dmin), *(CT->Dend)));
+                }
+            sortEdges(GR.Edges);
+            VR->Nsimulated++;
+        }
 
         //transcript the (Dmin, Dend) of the RPs to corresponding MIs
         //and reset them
@@ -701,7 +1766,11 @@ bool TMotionProgramValidator::validateMotionProgram(TMotionProgram &MP) const
                 throw EImpossibleError("lateral effect");
             TRoboticPositioner *RP = RPL[j];
             MI->setCommentDmin(RP->getDminsText().str);
-            MI->setCommentDend(RP->getDendsText().str);
+            //the values Dend only are transcripted when all RPs
+            //have reached their final positions, i.e. when the first
+            //collision is in the final positions of the longest cluster
+            if(!collision || (colfins[first] && tcols[first] >= Tend))
+                MI->setCommentDend(RP->getDendsText().str);
 
             //For a single value, you can write:
             //  MI->setCommentDmin("Dmin = "+floattostr(RP->Dmin));
@@ -709,16 +1778,22 @@ bool TMotionProgramValidator::validateMotionProgram(TMotionProgram &MP) const
         }
 
         //if there is collision
-        if(Tfmin < 0)
+        if(collision) {
+            //the following gestures has not been simulated from
+            //the current positions, so their records are obsolete
+            if(VR != NULL)
+                for(unsigned int k=i+1; k<VR->Gestures.size(); k++)
+                    VR->Gestures[k].valid = false;
             //indicates that the motion program not avoid dynamic collision
             return false;
+        }
 
         //Note that collision is detected when Tfmin < 0, and not <=,
         //becuase Tfmin can not be less zero.
     }
 
     //restore and discard the initial status of the quantifiers of the rotors
-    FiberMOSModel->RPL.restoreAndPopQuantifys();
+    PoseRPL.restoreAndPopQuantifys();
 
     //indicates that motion program avoid dynamic collision
     return true;
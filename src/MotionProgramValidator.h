@@ -45,6 +45,12 @@ namespace Positioning {
 void getRPsIncludedInMP(TRoboticPositionerList& RPL,
                         const TMotionProgram& MP,
                         const TFiberMOSModel *FMM);
+/// @brief Get the list of RPs included in a MP.
+/// @pre All message of instruction in the MP:
+/// - shall be addressed to an existent RP of the list Source.
+void getRPsIncludedInMP(TRoboticPositionerList& RPL,
+                        const TMotionProgram& MP,
+                        const TRoboticPositionerList& Source);
 
 /// @brief Get the list of RPs included in a pair of MPs.
 /// @pre All message of instruction in the MPs:
@@ -53,10 +59,150 @@ void getRPsIncludedInMPs(TRoboticPositionerList& RPL,
                      const TMotionProgram& MP1, const TMotionProgram& MP2,
                      const TFiberMOSModel *FMM);
 
+/// @brief Segregate the RPs of a list in clusters of RPs transitively adjacent.
+/// @brief Two RPs are adjacent when one of them is in the list AdjacentRPs
+/// of the other. The RPs of each cluster are in the same order than
+/// in the list RPL, and the clusters are sorted by its first RP.
+/// @param[out] Clusters: list of clusters (connected components
+/// of the adjacency graph restricted to the RPs of the list RPL).
+/// @param[in] RPL: list of RPs to segregate.
+void segregateRPsInClusters(TPointersList<TRoboticPositionerList>& Clusters,
+                            const TRoboticPositionerList& RPL);
+
+//###########################################################################
+//TClearanceProfile:
+//###########################################################################
+
+/// @brief A clearance profile is the sequence of distances between
+/// the contours of a RP and one of its adjacents (RP or EA), calculated
+/// during the validation of a gesture.
+/// @brief Between two samples the distance is limited by the swept-arc
+/// bound: D(t) >= D_i - vmaxabs*|t - t_i|.
+class TClearanceProfile {
+public:
+    /// Identifier of the RP.
+    int Id;
+    /// Identifier of the adjacent RP or EA.
+    int IdA;
+    /// Flag indicating if the adjacent is an EA.
+    bool isEA;
+    /// Index of the gesture in the MP.
+    int gesture;
+    /// Upper top for the relative longitudinal velocity (mm/ms).
+    double vmaxabs;
+    /// Time of each calculated distance (ms).
+    vector<double> t;
+    /// Calculated distances between the contours (mm).
+    vector<double> D;
+
+    /// Build a clearance profile with the indicated values.
+    TClearanceProfile(int Id=0, int IdA=0, bool isEA=false,
+                      int gesture=0, double vmaxabs=0);
+
+    /// Add a sample (t, D) to the profile.
+    void addSample(double t, double D);
+
+    /// Get the minimun calculated distance.
+    double getDmin(void) const;
+    /// Get the time of the minimun calculated distance.
+    double gettDmin(void) const;
+    /// @brief Get a lower bound for the distance in the instant t.
+    /// @return DBL_MAX if the profile is empty.
+    double getDlow(double t) const;
+
+    /// Get the profile in text format.
+    AnsiString getText(void) const;
+};
+
+/// @brief List of clearance profiles.
+class TClearanceProfileList : public TPointersList<TClearanceProfile> {
+public:
+    /// Build a list by default.
+    TClearanceProfileList(void);
+
+    /// @brief Search the profile of a pair of a gesture.
+    /// @return the position of the profile, or getCount() if not found.
+    int search(int gesture, int Id, int IdA, bool isEA) const;
+
+    /// Get the list in text format (one profile per line).
+    AnsiString getText(void) const;
+};
+
+//###########################################################################
+//TValidationRecord:
+//###########################################################################
+
+/// @brief Clearance of a pair (RP, adjacent) in a gesture.
+class TEdgeClearance {
+public:
+    /// Identifier of the RP.
+    int Id;
+    /// Identifier of the adjacent RP or EA.
+    int IdA;
+    /// Flag indicating if the adjacent is an EA.
+    bool isEA;
+    /// Minimun distance between the contours calculated in the gesture (mm).
+    double Dmin;
+    /// Distance between the contours in the final positions (mm).
+    double Dend;
+
+    /// Build a clearance with the indicated values.
+    TEdgeClearance(int Id, int IdA, bool isEA, double Dmin, double Dend);
+};
+
+/// @brief Record of the validation of a gesture of a MP.
+class TGestureRecord {
+public:
+    /// Flag indicating if the gesture has been simulated avoiding collisions.
+    bool valid;
+    /// Identifiers of the RPs programmed in the gesture.
+    vector<int> Ids;
+    /// @brief Clearances of the pairs (RP, adjacent) of the RPs programmed
+    /// in the gesture, sorted by increasing Dmin, so the first pairs
+    /// are the ones whose clearance has limited the gesture.
+    vector<TEdgeClearance> Edges;
+
+    /// Build a record of a gesture not simulated.
+    TGestureRecord(void);
+
+    /// @brief Determines if the gesture depends on some RP of a list:
+    /// if some RP of the list was programmed in the gesture,
+    /// or was adjacent to a RP programmed in the gesture.
+    bool dependsOn(const TVector<int>& Ids) const;
+};
+
+/// @brief Record of the validation of a MP, which allows revalidate it
+/// after excluding RPs, simulating only the gestures affected.
+class TValidationRecord {
+public:
+    /// Record of each gesture of the MP.
+    vector<TGestureRecord> Gestures;
+    /// Number of gestures simulated in the last validation.
+    int Nsimulated;
+
+    /// Build an empty record.
+    TValidationRecord(void);
+
+    /// Empty the record.
+    void Clear(void);
+
+    /// @brief Build the record from the comments (Dmin, Dend) of the MIs
+    /// of a MP, as transcribed by the validation.
+    /// @brief The gestures whose MIs haven't both comments are
+    /// recorded as not simulated.
+    /// @pre The comments shall come from a validation of the MP
+    /// where the gestures with both comments avoided collisions.
+    /// @exception EImproperArgument if some comment is not valid.
+    void setComments(const TMotionProgram& MP);
+};
+
 //###########################################################################
 //TMotionProgramValidator:
 //###########################################################################
 
+//predeclares classes to avoid loops
+class TClearanceTracker;
+
 /// @brief A Motion Program Validator (MPV) provide functions for validate
 /// MPs (Motion Programs).
 /// @brief Validation process use the Variable Jumping Method.
@@ -67,6 +213,19 @@ protected:
     //EXTERN-ATTACHED OBJECTS:
 
     TFiberMOSModel *FiberMOSModel;
+    TRoboticPositionerList *Overlay;
+
+    //STATISTICS:
+
+    /// number of simulation steps since the last reset of the statistics
+    mutable unsigned long long Nsteps;
+    /// number of distances calculated since the last reset of the statistics
+    mutable unsigned long long Ndistances;
+
+    /// @brief Get the list of RPs whose status (positions, quantifiers,
+    /// instructions and distances) can be changed by the validator:
+    /// the overlay if it is attached, or all RPs of the FMM in other case.
+    TRoboticPositionerList& getPoseRPL(void) const;
 
     //DEFINITION: minimun free distance between two barriers (Dmin)
     //is the distance between the barriers less the SPM of each:
@@ -84,6 +243,11 @@ protected:
     /// Calculates the time free of collission of two RPs.
     double calculateTf(TRoboticPositioner *RP,
                        const TRoboticPositioner *RPA) const;
+    /// @brief Calculates the time free of collission of a RP
+    /// and the RP of a slot of its list AdjacentRPs.
+    /// @brief The distance is calculated once per step for each edge
+    /// of the adjacency graph, and reused in the symmetric slot.
+    double calculateTf(TRoboticPositioner *RP, TAdjacentRP& ARP) const;
     /// Calculates the minimun step time of a pair (RP, EA).
     double calculateTmin(const TRoboticPositioner *RP,
                          const TExclusionArea *EAA) const;
@@ -105,6 +269,82 @@ protected:
     /// the RPs of a list.
     double calculateTminmin(const TRoboticPositionerList& RPL) const;
 
+    /// @brief Invalidate the distances of the edges of the adjacency graph
+    /// of the RPs of a list.
+    /// @brief Shall be invoked each time that the RPs are moved.
+    void invalidateEdges(const TRoboticPositionerList& RPL) const;
+
+    /// @brief Calculates the minimun time free of collission of
+    /// the pairs of a list of clearance trackers.
+    /// @brief The pairs are calculated in the order of the list,
+    /// until the first collision.
+    double calculateTfmin(vector<TClearanceTracker>& CTs) const;
+
+    /// @brief Calculates the minimun time free of collission of
+    /// the pairs of a list of clearance trackers, by conservative advancement.
+    /// @brief Only are calculated the distances of the pairs for which
+    /// the swept-arc bound can not garantee that they have not influence
+    /// in the result, neither in the Dmin of the adjacent items.
+    /// @param[in] t: time of the current step.
+    /// @param[in] CTs: clearance trackers of the pairs to calculate.
+    double calculateTfminCA(vector<TClearanceTracker>& CTs,
+                            double t) const;
+
+    /// @brief Simulate the programmed gesture for the RPs of a cluster,
+    /// with its own simulation times.
+    /// @param[in] Cluster: RPs transitively adjacent included in the MP.
+    /// @param[in] CTs: clearance trackers of the pairs of the cluster.
+    /// @param[out] tcol: time of the first collision.
+    /// @param[out] colfin: flag indicating if the collision has been
+    /// detected in the final positions.
+    /// @param[out] steps: number of simulated steps.
+    /// @param[out] distances: number of calculated distances.
+    /// @param[in] Tlimit: time until which the gesture is simulated.
+    /// @return true: if the gesture avoid collisions in the cluster.
+    /// @post If the gesture avoid collisions in the cluster, the RPs
+    /// of the cluster will be in their final positions, or in their
+    /// positions in Tlimit when Tlimit is less than the time of
+    /// displacement of the cluster.
+    bool validateGesture(TRoboticPositionerList& Cluster,
+                         vector<TClearanceTracker>& CTs,
+                         double& tcol, bool& colfin,
+                         unsigned long long& steps,
+                         unsigned long long& distances,
+                         double Tlimit=DBL_MAX) const;
+
+    /// @brief Revalidate a gesture simulating only the pairs (RP, adjacent)
+    /// where the RP or the adjacent has been modified.
+    /// @brief The other pairs of the RPs programmed in the gesture
+    /// take the clearances of the record of the gesture.
+    /// @param[in] RPL: RPs included in the MP.
+    /// @param[in] ML: programmed gesture.
+    /// @param[in,out] GR: record of the gesture, which will be updated.
+    /// @param[in] Modified: identifiers of the RPs modified.
+    /// @return true: if the pairs avoid collisions. In other case,
+    /// the RPs will be in their initial positions of the gesture.
+    /// @pre The gesture shall be programmed in the RPs.
+    /// @pre The record shall correspond to a valid gesture.
+    /// @post If the pairs avoid collisions, the RPs will be in their
+    /// final positions, and the MIs of the RPs simulated will have
+    /// updated their comments Dmin and Dend.
+    bool revalidateGesture(TRoboticPositionerList& RPL, TMessageList *ML,
+                           TGestureRecord& GR,
+                           const TVector<int>& Modified) const;
+
+    /// @brief Validate the gestures of a MP.
+    /// @param[out] CPL: if not NULL, clearance profiles of the gestures.
+    /// @param[in,out] VR: if not NULL, record of the validation.
+    /// @param[in] Modified: if not NULL, identifiers of the RPs modified
+    /// since the record was made. Then only are simulated the gestures
+    /// which depends on the modified RPs, or which were not valid,
+    /// and the other gestures are reused from the record. In the gestures
+    /// which depends on the modified RPs, first only are simulated
+    /// the pairs of the modified RPs, and only if they produce a collision
+    /// the gesture is simulated completely.
+    bool validateGestures(TMotionProgram &MP, TClearanceProfileList *CPL,
+                          TValidationRecord *VR,
+                          const TVector<int> *Modified) const;
+
 public:
     //EXTERN-ATTACHED OBJECTS:
 
@@ -112,6 +352,32 @@ public:
     TFiberMOSModel *getFiberMOSModel(void) const {
         return FiberMOSModel;}
 
+    /// @brief Get the extern attached overlay or NULL.
+    TRoboticPositionerList *getOverlay(void) const {return Overlay;}
+    /// @brief Attach a pose overlay to the validator, or detach it (NULL).
+    /// @brief The overlay is a list of private clones of RPs of the FMM,
+    /// which replace the RPs of the FMM with the same Id in the MPs.
+    /// While an overlay is attached, the validator only changes the status
+    /// of the RPs of the overlay, and the RPs of the FMM are only read,
+    /// so several validators with different overlays can work
+    /// concurrently on the same FMM.
+    /// @pre Each RP of the overlay shall have the Id of a RP of the FMM,
+    /// and the RPs of the overlay shall not be in the FMM.
+    /// @pre The RPs included in the MPs to validate shall be in the overlay,
+    /// and the adjacency edges of the RPs of the overlay shall be NULL.
+    void setOverlay(TRoboticPositionerList *Overlay);
+
+    //STATISTICS:
+
+    /// @brief Get the number of simulation steps of the validations
+    /// since the last reset of the statistics.
+    unsigned long long getNsteps(void) const {return Nsteps;}
+    /// @brief Get the number of distances between barriers calculated
+    /// in the validations since the last reset of the statistics.
+    unsigned long long getNdistances(void) const {return Ndistances;}
+    /// Reset the statistics of the validations.
+    void resetStatistics(void) {Nsteps = 0; Ndistances = 0;}
+
     //BUILDING AND DESTROYING METHODS:
 
     /// @brief Built a validator of motion programs
@@ -142,7 +408,53 @@ public:
     /// @note The validation method of a MP will be used during the generation process
     /// with the individual MP of each RP, and at the end of the process for
     /// validate the generated recovery program.
-    bool validateMotionProgram(TMotionProgram &MP) const;
+    /// @note The RPs included in the MP are segregated in clusters of RPs
+    /// transitively adjacent, which can not affect each other. Each cluster
+    /// is simulated in its own thread, with its own simulation times of
+    /// the Variable Jumping Method, and the results are merged in the order
+    /// of the clusters, so the result not depends on the number of threads.
+    /// In each step only are calculated the distances of the pairs which
+    /// can not be discarded by the swept-arc bound.
+    /// @note When the MP produces a collision, the comments Dmin of
+    /// the RPs of other clusters include the samples until the end of
+    /// their simulation, and all RPs are moved to the time of the first
+    /// collision.
+    /// @note When an overlay is attached, the RPs included in the MP are
+    /// searched in the overlay, and the postconditions are referred to
+    /// the RPs of the overlay instead of all RPs of the FMM.
+    /// @param[out] CPL: if not NULL, will contains the clearance profile
+    /// of each pair (RP, adjacent) of the RPs included in the MP.
+    /// @param[out] VR: if not NULL, will contains the record of
+    /// the validation, for revalidate the MP after editing it.
+    bool validateMotionProgram(TMotionProgram &MP,
+                               TClearanceProfileList *CPL=NULL,
+                               TValidationRecord *VR=NULL) const;
+
+    /// @brief Revalidate a MP after excluding or editing the instructions
+    /// of some RPs, simulating only the gestures affected by the change.
+    /// @param[in] MP: motion program to be revalidated.
+    /// @param[in,out] VR: record of the last validation of the MP,
+    /// which will be updated with the gestures simulated.
+    /// @param[in] Ids: identifiers of the RPs whose instructions
+    /// has been excluded or modified since the last validation.
+    /// @return true: if the motion program avoid collisions.
+    /// @pre The preconditions of validateMotionProgram.
+    /// @pre The RPs shall be in the same initial positions
+    /// than in the last validation of the MP.
+    /// @pre The MP shall have the same number of gestures
+    /// than in the last validation.
+    /// @post The postconditions of validateMotionProgram.
+    /// @note A gesture is simulated again when some modified RP
+    /// was or is programmed in the gesture, or was adjacent to a RP
+    /// programmed in the gesture, or when the gesture was not valid.
+    /// The other gestures only move the RPs to their final positions,
+    /// because the movement of their RPs and of their adjacents
+    /// has not changed, and keep the comments Dmin and Dend of their MIs.
+    /// @note In the gestures simulated again, only are simulated the pairs
+    /// (RP, adjacent) where some of them is modified, while they avoid
+    /// collisions, and the other pairs take the clearances of the record.
+    bool revalidateMotionProgram(TMotionProgram &MP, TValidationRecord &VR,
+                                 const TVector<int>& Ids) const;
 
     //Validation of a MP can end of two ways:
     //- If the MP not produce a dynamic collision, being all RPs
@@ -0,0 +1,235 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file Profiler.cpp
+/// @brief counters of calls and time of the hot paths
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "Profiler.h"
+#include "Exceptions.h"
+
+#include <jsoncpp/json/json.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+//namespace for profiling
+namespace Profiling {
+
+//---------------------------------------------------------------------------
+
+//names of the profiled functions
+static const char *profiledFunctionNames[pfCount] = {
+    "TContourFigureList::distanceMin",
+    "TActuator::distanceMin",
+    "TArm::calculateImage",
+    "TRoboticPositionerList::move",
+    "TMotionProgramValidator::calculateTfmin",
+    "TMotionProgramGenerator::motionProgramsAreValid",
+    "TMotionProgramGenerator::searchSolution"
+};
+
+//get the name of a profiled function
+const char *profiledFunctionName(TProfiledFunction f)
+{
+    //check the precondition
+    if(f<0 || pfCount<=f)
+        throw EImproperArgument("profiled function f should be in [0, pfCount)");
+
+    return profiledFunctionNames[f];
+}
+
+//build the counters initialized to zero
+TProfileCounters::TProfileCounters(void)
+{
+    clear();
+}
+
+//set the counters to zero
+void TProfileCounters::clear(void)
+{
+    for(int f=0; f<pfCount; f++) {
+        Ncalls[f] = 0;
+        time[f] = 0;
+    }
+    Nthreads = 0;
+}
+
+//indicates if the counters are updated by the profiled functions
+bool profileIsEnabled(void)
+{
+#ifdef FMPT_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+//---------------------------------------------------------------------------
+//COUNTERS OF THE THREADS:
+
+//Each thread updates only its own counters, so that the profiled functions
+//don't need synchronization. The counters are atomic with relaxed order,
+//only for can be read from other thread without data races.
+//When a thread finishes, its counters are accumulated in the registry.
+
+class TThreadCounters;
+
+//registry of the counters of the threads
+class TProfileRegistry {
+public:
+    //mutex for access to the registry
+    std::mutex m;
+    //counters of the threads alive
+    std::vector<TThreadCounters*> Alive;
+    //counters accumulated of the threads finished
+    TProfileCounters Finished;
+};
+
+//get the registry, building it the first time
+static TProfileRegistry& getRegistry(void)
+{
+    static TProfileRegistry R;
+    return R;
+}
+
+//counters of a thread
+class TThreadCounters {
+public:
+    std::atomic<unsigned long long> Ncalls[pfCount];
+    std::atomic<unsigned long long> time[pfCount];
+
+    //set the counters to zero
+    void clear(void) {
+        for(int f=0; f<pfCount; f++) {
+            Ncalls[f].store(0, std::memory_order_relaxed);
+            time[f].store(0, std::memory_order_relaxed);
+        }
+    }
+    //add the counters to a counters set
+    //returning true if there is some call
+    bool addTo(TProfileCounters& PC) const {
+        bool used = false;
+        for(int f=0; f<pfCount; f++) {
+            unsigned long long N = Ncalls[f].load(std::memory_order_relaxed);
+            PC.Ncalls[f] += N;
+            PC.time[f] += time[f].load(std::memory_order_relaxed);
+            if(N > 0)
+                used = true;
+        }
+        return used;
+    }
+
+    //build the counters and register them
+    TThreadCounters(void) {
+        clear();
+        TProfileRegistry& R = getRegistry();
+        std::lock_guard<std::mutex> lock(R.m);
+        R.Alive.push_back(this);
+    }
+    //accumulate the counters in the registry and unregister them
+    ~TThreadCounters() {
+        TProfileRegistry& R = getRegistry();
+        std::lock_guard<std::mutex> lock(R.m);
+        if(addTo(R.Finished))
+            R.Finished.Nthreads++;
+        for(unsigned int i=0; i<R.Alive.size(); i++)
+            if(R.Alive[i] == this) {
+                R.Alive.erase(R.Alive.begin() + i);
+                break;
+            }
+    }
+};
+
+//counters of the current thread
+static thread_local TThreadCounters threadCounters;
+
+//add a call and its time to the counters of the current thread
+void addProfileSample(TProfiledFunction f, unsigned long long t)
+{
+    TThreadCounters& TC = threadCounters;
+    TC.Ncalls[f].store(TC.Ncalls[f].load(std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+    TC.time[f].store(TC.time[f].load(std::memory_order_relaxed) + t,
+                     std::memory_order_relaxed);
+}
+
+//---------------------------------------------------------------------------
+//AGGREGATION OF THE COUNTERS:
+
+//get the counters aggregated of all threads,
+//including the threads which has finished
+void getProfile(TProfileCounters& PC)
+{
+    TProfileRegistry& R = getRegistry();
+    std::lock_guard<std::mutex> lock(R.m);
+
+    PC = R.Finished;
+    for(unsigned int i=0; i<R.Alive.size(); i++)
+        if(R.Alive[i]->addTo(PC))
+            PC.Nthreads++;
+}
+
+//set to zero the counters of all threads
+void resetProfile(void)
+{
+    TProfileRegistry& R = getRegistry();
+    std::lock_guard<std::mutex> lock(R.m);
+
+    R.Finished.clear();
+    for(unsigned int i=0; i<R.Alive.size(); i++)
+        R.Alive[i]->clear();
+}
+
+//get the aggregated counters in JSON format
+void getProfileText(std::string& str)
+{
+    TProfileCounters PC;
+    getProfile(PC);
+
+    Json::Value root;
+    root["enabled"] = profileIsEnabled();
+    root["threads"] = PC.Nthreads;
+
+    Json::Value functions(Json::arrayValue);
+    for(int f=0; f<pfCount; f++) {
+        Json::Value function;
+        function["name"] = profiledFunctionNames[f];
+        function["calls"] = Json::UInt64(PC.Ncalls[f]);
+        function["time_ns"] = Json::UInt64(PC.time[f]);
+        if(PC.Ncalls[f] > 0)
+            function["mean_ns"] = double(PC.time[f])/double(PC.Ncalls[f]);
+        else
+            function["mean_ns"] = 0.0;
+        functions.append(function);
+    }
+    root["functions"] = functions;
+
+    Json::StyledWriter writer;
+    str = writer.write(root);
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Profiling
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,131 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file Profiler.h
+/// @brief counters of calls and time of the hot paths
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <string>
+
+//---------------------------------------------------------------------------
+
+//The counters are only updated when the library is compiled with
+//the macro FMPT_PROFILE defined (configure --enable-profile).
+//Otherwise the macro PROFILE_SCOPE expands to nothing,
+//so that the profiled functions have not any overhead.
+
+//namespace for profiling
+namespace Profiling {
+
+//---------------------------------------------------------------------------
+
+//identifiers of the profiled functions
+typedef enum {
+    pfContourFigureListDistanceMin,     //TContourFigureList::distanceMin
+    pfActuatorDistanceMin,              //TActuator::distanceMin
+    pfArmCalculateImage,                //TArm::calculateImage
+    pfRoboticPositionerListMove,        //TRoboticPositionerList::move
+    pfCalculateTfmin,                   //TMotionProgramValidator::calculateTfmin
+    pfMotionProgramsAreValid,           //TMotionProgramGenerator::motionProgramsAreValid
+    pfSearchSolution,                   //TMotionProgramGenerator::searchSolution
+    pfCount                             //number of profiled functions
+} TProfiledFunction;
+
+//get the name of a profiled function
+const char *profiledFunctionName(TProfiledFunction f);
+
+//counters of the profiled functions
+//The time is inclusive: it includes the time
+//of the profiled functions called by the function.
+class TProfileCounters {
+public:
+    //number of calls of each profiled function
+    unsigned long long Ncalls[pfCount];
+    //time spent in each profiled function (in nanoseconds)
+    unsigned long long time[pfCount];
+
+    //number of threads which have updated the counters
+    unsigned int Nthreads;
+
+    //build the counters initialized to zero
+    TProfileCounters(void);
+
+    //set the counters to zero
+    void clear(void);
+};
+
+//indicates if the counters are updated by the profiled functions
+bool profileIsEnabled(void);
+
+//add a call and its time to the counters of the current thread
+void addProfileSample(TProfiledFunction f, unsigned long long time);
+
+//get the counters aggregated of all threads,
+//including the threads which has finished
+void getProfile(TProfileCounters& PC);
+//set to zero the counters of all threads
+//The method should be called when the only thread
+//updating the counters is the current thread.
+void resetProfile(void);
+
+//get the aggregated counters in JSON format
+void getProfileText(std::string& str);
+
+//---------------------------------------------------------------------------
+//TProfileTimer
+//---------------------------------------------------------------------------
+
+//timer which add a call of a profiled function
+//and the time from its building to its destruction,
+//to the counters of the current thread
+class TProfileTimer {
+    //profiled function
+    TProfiledFunction p_f;
+    //instant of the building
+    std::chrono::steady_clock::time_point p_t0;
+
+public:
+    //start the timer
+    explicit TProfileTimer(TProfiledFunction f) :
+        p_f(f), p_t0(std::chrono::steady_clock::now()) {;}
+    //stop the timer and update the counters
+    ~TProfileTimer() {
+        std::chrono::nanoseconds dt = std::chrono::steady_clock::now() - p_t0;
+        addProfileSample(p_f, (unsigned long long)dt.count());
+    }
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Profiling
+
+//profile the rest of the scope as a call of the function f
+#ifdef FMPT_PROFILE
+#define PROFILE_SCOPE(f) Profiling::TProfileTimer profile_timer(Profiling::f)
+#else
+#define PROFILE_SCOPE(f)
+#endif
+
+//---------------------------------------------------------------------------
+#endif // PROFILER_H
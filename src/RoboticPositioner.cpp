@@ -27,6 +27,7 @@
 #include "TextFile.h"
 
 #include <algorithm> //std::min, std::max
+#include <mutex> //mutex, lock_guard
 
 //---------------------------------------------------------------------------
 
@@ -286,6 +287,8 @@ TFaultType StrToFaultType(const AnsiString& S)
 
 //lista de objetos construidos
 TItemsList<TRoboticPositioner*> TRoboticPositioner::Builts;
+//mutex for access to the list of built objects from several threads
+static mutex Builts_mutex;
 
 //---------------------------------------------------------------------------
 //PROPIEDADES DE SEGURIDAD:
@@ -926,6 +929,7 @@ TRoboticPositioner::TRoboticPositioner(void) :
     CMF.setLabel("CMF");
 
     //añade el posicionador a la lista de contruidos
+    lock_guard<mutex> lock(Builts_mutex);
     Builts.Add(this);
 }
 //build a RP with the indicated values
@@ -958,6 +962,7 @@ TRoboticPositioner::TRoboticPositioner(int Id, TDoublePoint P0,
     CMF.setLabel("CMF");
 
     //añade el posicionador a la lista de contruidos
+    lock_guard<mutex> lock(Builts_mutex);
     Builts.Add(this);
 }
 
@@ -1030,6 +1035,7 @@ TRoboticPositioner::TRoboticPositioner(const TRoboticPositioner *RP)
     clone(RP);
 
     //añade el posicionador a la lista de contruidos
+    lock_guard<mutex> lock(Builts_mutex);
     Builts.Add(this);
 }
 
@@ -1058,6 +1064,8 @@ void TRoboticPositioner::apply(const TRoboticPositioner *RP)
 //if the RP isn't in Built throw EImproperCall
 TRoboticPositioner::~TRoboticPositioner()
 {
+    lock_guard<mutex> lock(Builts_mutex);
+
     //debe haber algún objeto para destruir
     if(Builts.getCount() < 1)
         throw EImproperCall("there isn't an object to destroy");
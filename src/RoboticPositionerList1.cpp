@@ -29,6 +29,8 @@
 #include "TextFile.h"
 #include "Vector.h"
 
+#include <vector>
+
 //---------------------------------------------------------------------------
 
 using namespace Strings;
@@ -526,6 +528,8 @@ void TRoboticPositionerList1::Clone(const TRoboticPositionerList1 *RPL)
 
     //initialize this list
     Destroy();
+    //the edges are built in the assimilation of the clon
+    AdjacencyEdges.Clear();
     //clona los posicionadores de la lista
     for(int i=0; i<RPL->getCount(); i++) {
         TRoboticPositioner *RP = RPL->Get(i);
@@ -757,6 +761,58 @@ void TRoboticPositionerList1::Destroy(double rmax)
 
 //MÉTODOS DE BÚSQUEDA DE POSICIONADORES:
 
+//update the index of positions of the RPs
+void TRoboticPositionerList1::updateIndex(void)
+{
+    Index.Ids.clear();
+    Index.RPs.clear();
+    Index.Actuators.clear();
+
+    //short lists are not indexed
+    if(getCount() <= MIN_COUNT_INDEXED) {
+        Index.Count = -1;
+        return;
+    }
+
+    //build the index with the first position of each key
+    Index.Ids.reserve(getCount());
+    Index.RPs.reserve(getCount());
+    Index.Actuators.reserve(getCount());
+    for(int i=0; i<getCount(); i++) {
+        TRoboticPositioner *RP = Items[i];
+        Index.Ids.insert(make_pair(RP->getActuator()->getId(), i));
+        Index.RPs.insert(make_pair(RP, i));
+        Index.Actuators.insert(make_pair(RP->getActuator(), i));
+    }
+    Index.Count = getCount();
+    Index.IdsVersion = TActuator::getIdsVersion();
+}
+
+//add a RP to the list
+void TRoboticPositionerList1::Add(TRoboticPositioner *const &RP)
+{
+    //check the precondition
+    if(RP == NULL)
+        throw EImproperArgument("pointer RP should point to built robotic positioner");
+
+    //if the index is up to date, add the position of the RP
+    //(only if the keys are not in the index, which keeps the first position)
+    if(indexIdsIsUpdated()) {
+        TItemsList<TRoboticPositioner*>::Add(RP);
+        int i = getCount() - 1;
+        Index.Ids.insert(make_pair(RP->getActuator()->getId(), i));
+        Index.RPs.insert(make_pair(RP, i));
+        Index.Actuators.insert(make_pair(RP->getActuator(), i));
+        Index.Count = getCount();
+    }
+    //else, rebuild the index when the list is long enough
+    else {
+        TItemsList<TRoboticPositioner*>::Add(RP);
+        if(getCount() > MIN_COUNT_INDEXED)
+            updateIndex();
+    }
+}
+
 //busca un posicionador en la lista
 int TRoboticPositionerList1::search(const TRoboticPositioner *RP) const
 {
@@ -764,6 +820,16 @@ int TRoboticPositionerList1::search(const TRoboticPositioner *RP) const
     if(RP == NULL)
         throw EImproperArgument("pointer RP should point to built robotic positioner");
 
+    //search the position in the index
+    if(indexIsUpdated()) {
+        unordered_map<const TRoboticPositioner*, int>::const_iterator it = Index.RPs.find(RP);
+        //if the RP is not in the index, it is not in the list
+        if(it == Index.RPs.end())
+            return getCount();
+        if(Items[it->second] == RP)
+            return it->second;
+    }
+
     //mientras queden posiciones en la lista y
     //el puntero no apunte al mismo posicionador
     int i = 0;
@@ -778,6 +844,16 @@ int TRoboticPositionerList1::search(const TActuator *A) const
     if(A == NULL)
         throw EImproperArgument("pointer A should point to built actuator");
 
+    //search the position in the index
+    if(indexIsUpdated()) {
+        unordered_map<const TActuator*, int>::const_iterator it = Index.Actuators.find(A);
+        //if the actuator is not in the index, it is not in the list
+        if(it == Index.Actuators.end())
+            return getCount();
+        if(Items[it->second]->getActuator() == A)
+            return it->second;
+    }
+
     //mientras queden posiciones en la lista y
     //el puntero no apunte al mismo actuador
     int i = 0;
@@ -793,12 +869,32 @@ int TRoboticPositionerList1::searchId(int Id) const
     if(Id < 1)
         throw EImproperArgument("RP identifier number Id should be upper zero");
 
+    //search the position in the index
+    if(indexIdsIsUpdated()) {
+        unordered_map<int, int>::const_iterator it = Index.Ids.find(Id);
+        //if the Id is not in the index, it is not in the list
+        if(it == Index.Ids.end())
+            return getCount();
+        if(Items[it->second]->getActuator()->getId() == Id)
+            return it->second;
+    }
+
     int i = 0;
     while(i<getCount() && Items[i]->getActuator()->getId()!=Id)
         i++;
 
     return i;
 }
+//busca el primer posicionador igual al indicado según Compare
+//(por defecto, el primero con el mismo identificador)
+int TRoboticPositionerList1::Search(TRoboticPositioner *const &RP) const
+{
+    //if the comparison is by Id, search the Id through the index
+    if(Compare==TRoboticPositioner::compareIds && RP!=NULL && RP->getActuator()->getId()>=1)
+        return searchId(RP->getActuator()->getId());
+
+    return TItemsList<TRoboticPositioner*>::Search(RP);
+}
 //devuelve el puntero al primer posicionador
 //con el identificador indicado
 const TRoboticPositioner *TRoboticPositionerList1::searchIdPointer(int Id) const
@@ -918,6 +1014,14 @@ void TRoboticPositionerList1::setAllDisabled(bool Disabled)
         RP->Disabled = Disabled;
     }
 }
+//set the capacity of the image caches of the arms of all RPs
+void TRoboticPositionerList1::setAllImageCacheCapacities(unsigned int Capacity)
+{
+    for(int i=0; i<getCount(); i++) {
+        TRoboticPositioner *RP = Items[i];
+        RP->getActuator()->getArm()->ImageCache.setCapacity(Capacity);
+    }
+}
 
 //--------------------------------------------------------------------------
 //MÉTODOS DE ASIMILACIÓN:
@@ -950,53 +1054,115 @@ void TRoboticPositionerList1::calculateSPMcomponents(void)
 //de cada posicionador como para invadir su dominio de maniobra
 void TRoboticPositionerList1::determineAdjacents(const TExclusionAreaList& EAL)
 {
+    //update the grids for search the candidates
+    updateAdjacencyGrids(EAL);
+
     //por cada posicionador de la lista
+    for(int i=0; i<getCount(); i++)
+        //determina sus EAs y RPs adyacentes
+        determineAdjacents(i, EAL, AdjacencyRPG, AdjacencyEAG);
+
+    //build the edges of the adjacency graph
+    buildAdjacencyEdges();
+}
+//update the grids of the circles which contain the RPs
+//and the EAs of the list EAL, with their security margins,
+//for search the candidates to be adjacent
+void TRoboticPositionerList1::updateAdjacencyGrids(const TExclusionAreaList& EAL)
+{
+    //get the circles of the RPs
+    std::vector<TDoublePoint> Centers(getCount());
+    std::vector<double> Radii(getCount());
+    double rmax = 0;
     for(int i=0; i<getCount(); i++) {
-        //apunta el posicionador indicado para facilitar su acceso
-        TRoboticPositioner *RPi = Items[i];
-
-        //inicializa la lista de EAs adyacentes
-        RPi->getActuator()->AdjacentEAs.Clear();
-        //inicializa la lista de RPs adyacentes
-        RPi->getActuator()->AdjacentRPs.Clear();
-
-        //para cada una de las EAs
-        for(int j=0; j<EAL.getCount(); j++) {
-            //apunta el EA indicada para facilitar su acceso
-            TExclusionArea *EAj = EAL[j];
-            //si están lo bastante cerca como para colisionar
-            if(Mod(RPi->getActuator()->getP0() - EAj->Barrier.getP0()) <
-                    (RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() +
-                     EAj->Barrier.getr_max() + EAj->Barrier.getSPM()) + ERR_NUM) {
-                //añade el EA a la lista de EAs adyacentes
-                RPi->getActuator()->AdjacentEAs.Add(new TAdjacentEA(EAj));
-            }
-        }
-        //para cada uno de los RPs previos al indicado
-        for(int j=0; j<i; j++) {
-            //apunta el RP indicado para facilitar su acceso
-            TRoboticPositioner *RPj = Items[j];
-            //si están lo bastante cerca como para colisionar
-            if(Mod(RPi->getActuator()->getP0() - RPj->getActuator()->getP0()) <
-                    (RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() +
-                     RPj->getActuator()->getr_max() + RPj->getActuator()->getSPMall_a()) + ERR_NUM) {
-                //añade el RP a la lista de RPs adyacentes
-                //añade una distancia mínima para el RP adyacente
-                RPi->getActuator()->AdjacentRPs.Add(new TAdjacentRP(RPj));
-            }
+        TActuator *A = Items[i]->getActuator();
+        Centers[i] = A->getP0();
+        Radii[i] = A->getr_max() + A->getSPMall_a();
+        if(Radii[i] > rmax)
+            rmax = Radii[i];
+    }
+
+    //update the grid of the RPs, so that the candidates
+    //to be adjacent to a RP are in the nine nearest cells
+    AdjacencyRPG.update(Centers, Radii, 2*rmax + ERR_NUM);
+
+    //get the circles of the EAs
+    Centers.resize(EAL.getCount());
+    Radii.resize(EAL.getCount());
+    for(int j=0; j<EAL.getCount(); j++) {
+        const TExclusionArea *EA = EAL[j];
+        Centers[j] = EA->Barrier.getP0();
+        Radii[j] = EA->Barrier.getr_max() + EA->Barrier.getSPM();
+    }
+
+    //update the grid of the EAs
+    AdjacencyEAG.update(Centers, Radii, 2*rmax + ERR_NUM);
+}
+//search the RPs whose circles of adjacency are closer than r
+//to a point, in increasing order of position
+void TRoboticPositionerList1::searchAdjacencyCandidates(std::vector<int>& indices,
+                                                        TDoublePoint P, double r) const
+{
+    //if the grid contains all RPs of the list, search in the grid
+    if(AdjacencyRPG.getCount() == getCount()) {
+        AdjacencyRPG.searchRange(indices, P, r);
+        return;
+    }
+
+    //else, search in the list
+    indices.clear();
+    for(int i=0; i<getCount(); i++) {
+        TActuator *A = Items[i]->getActuator();
+        if(Mod(A->getP0() - P) < r + A->getr_max() + A->getSPMall_a())
+            indices.push_back(i);
+    }
+}
+//determine the EAs and the RPs adjacents to the indicated RP
+//without build the edges of the adjacency graph
+void TRoboticPositionerList1::determineAdjacents(int i, const TExclusionAreaList& EAL,
+                                                 const TSpatialGrid& RPG, const TSpatialGrid& EAG)
+{
+    //apunta el posicionador indicado para facilitar su acceso
+    TRoboticPositioner *RPi = Items[i];
+
+    //inicializa la lista de EAs adyacentes
+    RPi->getActuator()->AdjacentEAs.Clear();
+    //inicializa la lista de RPs adyacentes
+    RPi->getActuator()->AdjacentRPs.Clear();
+
+    //search the candidates in the grids, with a margin upper than ERR_NUM
+    //for absorb the numerical error, in the same order of the lists
+    double r = RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() + 2*ERR_NUM;
+    std::vector<int> candidates;
+
+    //para cada una de las EAs candidatas
+    EAG.searchRange(candidates, RPi->getActuator()->getP0(), r);
+    for(unsigned int k=0; k<candidates.size(); k++) {
+        //apunta el EA indicada para facilitar su acceso
+        TExclusionArea *EAj = EAL[candidates[k]];
+        //si están lo bastante cerca como para colisionar
+        if(Mod(RPi->getActuator()->getP0() - EAj->Barrier.getP0()) <
+                (RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() +
+                 EAj->Barrier.getr_max() + EAj->Barrier.getSPM()) + ERR_NUM) {
+            //añade el EA a la lista de EAs adyacentes
+            RPi->getActuator()->AdjacentEAs.Add(new TAdjacentEA(EAj));
         }
-        //para cada uno de los RPs posteriores al indicado
-        for(int j=i+1; j<getCount(); j++) {
-            //apunta el RP indicado para facilitar su acceso
-            TRoboticPositioner *RPj = Items[j];
-            //si están lo bastante cerca como para colisionar
-            if(Mod(RPi->getActuator()->getP0() - RPj->getActuator()->getP0()) <
-                    (RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() +
-                     RPj->getActuator()->getr_max() + RPj->getActuator()->getSPMall_a())) {
-                //añade el RP a la lista de RPs adyacentes
-                //añade una distancia mínima para el RP adyacente
-                RPi->getActuator()->AdjacentRPs.Add(new TAdjacentRP(RPj));
-            }
+    }
+    //para cada uno de los RPs candidatos
+    RPG.searchRange(candidates, RPi->getActuator()->getP0(), r);
+    for(unsigned int k=0; k<candidates.size(); k++) {
+        int j = candidates[k];
+        //apunta el RP indicado para facilitar su acceso
+        TRoboticPositioner *RPj = Items[j];
+        //si están lo bastante cerca como para colisionar,
+        //con margen de error solo para los RPs previos al indicado
+        double D = Mod(RPi->getActuator()->getP0() - RPj->getActuator()->getP0());
+        double Dmin = RPi->getActuator()->getr_max() + RPi->getActuator()->getSPMall_a() +
+                RPj->getActuator()->getr_max() + RPj->getActuator()->getSPMall_a();
+        if((j<i && D<Dmin+ERR_NUM) || (j>i && D<Dmin)) {
+            //añade el RP a la lista de RPs adyacentes
+            //añade una distancia mínima para el RP adyacente
+            RPi->getActuator()->AdjacentRPs.Add(new TAdjacentRP(RPj));
         }
     }
 }
@@ -1069,48 +1235,164 @@ void TRoboticPositionerList1::sortAdjacents(void)
     //ADVERTENCIA: al ser una clase local el depurador no reconocerá
     //las propiedades de los pares.
 
+    //por cada posicionador de la lista
+    for(int i=0; i<getCount(); i++)
+        //ordena su lista de RPs adyacentes
+        sortAdjacents(Items[i]);
+
+    //the slots has been rebuilt, so the edges shall be linked again
+    buildAdjacencyEdges();
+}
+//sort the list of RPs adjacents to a RP
+//without build the edges of the adjacency graph
+void TRoboticPositionerList1::sortAdjacents(TRoboticPositioner *RP)
+{
+    TRoboticPositioner *RPA;
     TPairTD<TRoboticPositioner> *P;
     TPointersList<TPairTD<TRoboticPositioner> > LP(6, TPairTD<TRoboticPositioner>::Comparex,
                                                    NULL, NULL, TPairTD<TRoboticPositioner>::Printx);
 
-    //por cada posicionador de la lista
-    for(int i=0; i<getCount(); i++) {
-        //apunta el posicionador indicado para facilitar su acceso
-        RP = Items[i];
+    //por cada posicionador adyacente
+    for(int j=0; j<RP->getActuator()->AdjacentRPs.getCount(); j++) {
+        //apunta el posicionador adyacente indicado para facilitar su acceso
+        RPA = RP->getActuator()->AdjacentRPs[j].RP;
+
+        //construye el par (RPA, theta)
+        //con theta en [0, 2*M_PI)
+        P = new TPairTD<TRoboticPositioner>(RPA);
+        TDoublePoint V = RPA->getActuator()->getP0() - RP->getActuator()->getP0();
+        if(Mod(V) != 0)
+            P->x = ArgPos(V);
+        else
+            P->x = 0;
 
-        //vacia la lista de punteros a pares
-        LP.Clear();
+        //ADVERTENCIA: un posicionador adyacente puede estar
+        //ubicado en el mismo lugar que el de referencia.
 
-        //por cada posicionador adyacente
-        for(int j=0; j<RP->getActuator()->AdjacentRPs.getCount(); j++) {
-            //apunta el posicionador adyacente indicado para facilitar su acceso
-            RPA = RP->getActuator()->AdjacentRPs[j].RP;
+        //añade el par a la lista
+        LP.Add(P);
+    }
 
-            //construye el par (RPA, theta)
-            //con theta en [0, 2*M_PI)
-            P = new TPairTD<TRoboticPositioner>(RPA);
-            TDoublePoint V = RPA->getActuator()->getP0() - RP->getActuator()->getP0();
-            if(Mod(V) != 0)
-                P->x = ArgPos(V);
-            else
-                P->x = 0;
+    //ordena la lista de posicionadores de menor a mayor ángulo
+    if(LP.getCount() > 1)
+        LP.SortInc(0, LP.getCount()-1);
+
+    //transcribe la lista
+    RP->getActuator()->AdjacentRPs.Clear();
+    for(int j=0; j<LP.getCount(); j++)
+        RP->getActuator()->AdjacentRPs.Add(new TAdjacentRP(LP[j].P));
+}
 
-            //ADVERTENCIA: un posicionador adyacente puede estar
-            //ubicado en el mismo lugar que el de referencia.
+//determine again the adjacents of the given RPs and the adjacents of
+//the RPs which were adjacent or become adjacent to some of them
+void TRoboticPositionerList1::updateAdjacents(TItemsList<TRoboticPositioner*>& Affected,
+                                              const TItemsList<TRoboticPositioner*>& Changed,
+                                              const TExclusionAreaList& EAL)
+{
+    //check the preconditions
+    std::vector<int> changed(Changed.getCount());
+    for(int k=0; k<Changed.getCount(); k++) {
+        changed[k] = search(Changed[k]);
+        if(changed[k] >= getCount())
+            throw EImproperArgument("all changed RPs should be in the list");
+    }
+
+    //MAKE ACTIONS:
+
+    //mark the affected RPs:
+    //  the changed RPs;
+    //  the RPs adjacent to a changed RP before the change;
+    //  the RPs with a changed RP in their list of adjacents;
+    //  the RPs near enough to a changed RP to be adjacent after the change.
+    updateAdjacencyGrids(EAL);
+    std::vector<bool> affected(getCount(), false);
+    std::vector<int> candidates;
+    for(int k=0; k<int(changed.size()); k++) {
+        int i = changed[k];
+        affected[i] = true;
+        TActuator *Ai = Items[i]->getActuator();
+        for(int j=0; j<Ai->AdjacentRPs.getCount(); j++)
+            affected[search(Ai->AdjacentRPs[j].RP)] = true;
+
+        //the margin includes both directions of adjacency
+        AdjacencyRPG.searchRange(candidates, Ai->getP0(), Ai->getr_max() + Ai->getSPMall_a() + 2*ERR_NUM);
+        for(unsigned int l=0; l<candidates.size(); l++)
+            affected[candidates[l]] = true;
+    }
+    for(int j=0; j<getCount(); j++) {
+        if(affected[j])
+            continue;
+
+        TActuator *Aj = Items[j]->getActuator();
+        for(int l=0; l<Aj->AdjacentRPs.getCount() && !affected[j]; l++)
+            for(int k=0; k<int(changed.size()); k++)
+                if(Aj->AdjacentRPs[l].RP == Items[changed[k]]) {
+                    affected[j] = true;
+                    break;
+                }
+    }
 
-            //añade el par a la lista
-            LP.Add(P);
+    //The lists of the RPs not affected not contain changed RPs before
+    //neither after the change, so they are the same.
+
+    //determine and sort the adjacents of the affected RPs
+    Affected.Clear();
+    for(int i=0; i<getCount(); i++)
+        if(affected[i]) {
+            determineAdjacents(i, EAL, AdjacencyRPG, AdjacencyEAG);
+            sortAdjacents(Items[i]);
+            Affected.Add(Items[i]);
         }
 
-        //ordena la lista de posicionadores de menor a mayor ángulo
-        if(LP.getCount() > 1)
-            LP.SortInc(0, LP.getCount()-1);
+    //the slots has been rebuilt, so the edges shall be linked again
+    buildAdjacencyEdges();
+}
+
 
-        //transcribe la lista
-        RP->getActuator()->AdjacentRPs.Clear();
-        for(int j=0; j<LP.getCount(); j++)
-            RP->getActuator()->AdjacentRPs.Add(new TAdjacentRP(LP[j].P));
+//build the edges of the adjacency graph and link them
+//to the slots of the lists AdjacentRPs
+void TRoboticPositionerList1::buildAdjacencyEdges(void)
+{
+    //initialize the graph
+    clearAdjacencyEdges();
+
+    //for each slot of each RP of the list
+    for(int i=0; i<getCount(); i++) {
+        TRoboticPositioner *RP = Items[i];
+        for(int j=0; j<RP->getActuator()->AdjacentRPs.getCount(); j++) {
+            TAdjacentRP *ARP = &(RP->getActuator()->AdjacentRPs[j]);
+
+            //if the slot is already linked, pass to the next slot
+            if(ARP->Edge != NULL)
+                continue;
+
+            //build the edge and link it to the slot
+            TAdjacencyEdge *E = new TAdjacencyEdge(RP, ARP->RP);
+            AdjacencyEdges.Add(E);
+            ARP->Edge = E;
+
+            //link the edge to the symmetric slot, if there is one
+            TAdjacentRPList& AdjacentRPs = ARP->RP->getActuator()->AdjacentRPs;
+            for(int k=0; k<AdjacentRPs.getCount(); k++)
+                if(AdjacentRPs[k].RP == RP) {
+                    AdjacentRPs[k].Edge = E;
+                    break;
+                }
+
+            //Note that the adjacency of a pair of RPs can be asymmetric,
+            //due to the margin ERR_NUM in determineAdjacents.
+        }
+    }
+}
+//unlink the slots of the lists AdjacentRPs and destroy the edges
+void TRoboticPositionerList1::clearAdjacencyEdges(void)
+{
+    for(int i=0; i<getCount(); i++) {
+        TRoboticPositioner *RP = Items[i];
+        for(int j=0; j<RP->getActuator()->AdjacentRPs.getCount(); j++)
+            RP->getActuator()->AdjacentRPs[j].Edge = NULL;
     }
+    AdjacencyEdges.Clear();
 }
 
 //para cada posicionador de la lista calcula:
@@ -1218,6 +1500,34 @@ void TRoboticPositionerList1::assimilate(const TExclusionAreaList& EAL)
     assimilateSizing(EAL);
 }
 
+//assimilate the changes of the given RPs executing:
+//      calculateSPMcomponents() of the given RPs;
+//      updateAdjacents(Affected, Changed, EAL);
+//      calculateSafeParameters() of the affected RPs;
+//      calculateSizingParameters();
+//      calculateAreaParameters();
+void TRoboticPositionerList1::assimilate(const TExclusionAreaList& EAL,
+                                         const TItemsList<TRoboticPositioner*>& Changed)
+{
+    //calculates (SPMrec, SPMsta, SPMdyn) and assigns the SPMoff
+    for(int k=0; k<Changed.getCount(); k++) {
+        Changed[k]->calculateSPMcomponents();
+        Changed[k]->setSPMoff(getPAem(), getPem());
+    }
+
+    //determine the adjacents of the affected RPs
+    TItemsList<TRoboticPositioner*> Affected;
+    updateAdjacents(Affected, Changed, EAL);
+
+    //the safe parameters depends on the adjacents,
+    //so only the affected RPs shall be recalculated
+    for(int i=0; i<Affected.getCount(); i++)
+        Affected[i]->getActuator()->calculateSafeParameters();
+
+    calculateSizingParameters();
+    calculateAreaParameters();
+}
+
 //MÉTODOS DE LECTURA CONJUNTA:
 
 //get the PPA list in steps
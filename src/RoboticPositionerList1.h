@@ -29,6 +29,9 @@
 #include "PointersList.h"
 #include "PairPositionAngles.h"
 #include "MotionProgram.h"
+#include "SpatialGrid.h"
+
+#include <unordered_map>
 
 //---------------------------------------------------------------------------
 
@@ -38,11 +41,68 @@ using namespace Positioning;
 //namespace for models
 namespace Models {
 
+//---------------------------------------------------------------------------
+//class RP index
+//---------------------------------------------------------------------------
+
+//index of the positions of the RPs of a list,
+//by Id, by RP and by actuator
+class TRoboticPositionerIndex {
+public:
+    std::unordered_map<int, int> Ids;
+    std::unordered_map<const TRoboticPositioner*, int> RPs;
+    std::unordered_map<const TActuator*, int> Actuators;
+
+    //number of RPs of the list when the index was updated,
+    //or -1 if the list is not indexed
+    int Count;
+    //number of changes of the identifiers of the actuators
+    //when the index was updated
+    unsigned int IdsVersion;
+
+    //build an empty index
+    TRoboticPositionerIndex(void) : Ids(), RPs(), Actuators(),
+        Count(-1), IdsVersion(0) {}
+};
+
 //---------------------------------------------------------------------------
 //class RP list
 //---------------------------------------------------------------------------
 
 class TRoboticPositionerList1 : public TItemsList<TRoboticPositioner*> {
+    //INDEX OF POSITIONS:
+
+    //index of the positions of the RPs of the list
+    //The index is updated by the methods which add or delete RPs,
+    //and it is only read by the search methods, so that it can be read
+    //concurrently. When the index is up to date, a RP not found
+    //in the index is not in the list.
+    //Each position got from the index is checked in the list, so that
+    //a list reordered by the inherited methods (SortInc, Invert, etc)
+    //only falls back to the linear search.
+    //The index of Ids is out of date when some actuator changes its Id,
+    //and the index is out of date when the number of RPs has been changed
+    //by the inherited methods. In both cases the search is linear
+    //until the index is updated.
+    //Short lists are not indexed, because the linear search is faster.
+    static const int MIN_COUNT_INDEXED = 16;
+    TRoboticPositionerIndex Index;
+
+    //determines if the index of RPs and actuators is up to date
+    bool indexIsUpdated(void) const {return Index.Count == getCount();}
+    //determines if the index of Ids is up to date
+    bool indexIdsIsUpdated(void) const {
+        return indexIsUpdated() && Index.IdsVersion == TActuator::getIdsVersion();}
+
+    //GRIDS OF ADJACENCY:
+
+    //grids of the circles which contain the RPs and the barriers
+    //of the EAs, with their security margins
+    //The grids are kept between determinations of adjacents,
+    //and they are rebuilt only when some circle changes,
+    //so that reload an instance with the same RPs reuses them.
+    TSpatialGrid AdjacencyRPG, AdjacencyEAG;
+
 protected:
     //TOLERANCES:
 
@@ -278,9 +338,51 @@ public:
 
     //METHODS TO ADD OR DELETE RPs:
 
-    //Inherited methods:
-    //  Add(TRoboticPositioner *RP): dd a RP to the list.
-    //  Delete(int i): delete a RP of the list without destroy it.
+    //The following methods mask the inherited methods which modify
+    //the list, for update the index of positions.
+    //The RPs shall not be replaced through the inherited methods
+    //without change the number of RPs, or the index will be
+    //out of date without notice. In that case updateIndex shall
+    //be invoked.
+
+    //update the index of positions of the RPs
+    void updateIndex(void);
+
+    //redimensiona la lista
+    void setCount(int N) {
+        TItemsList<TRoboticPositioner*>::setCount(N); updateIndex();}
+    //lectura del elemento indicado en listas no constantes
+    //(the RPs shall be replaced through Set)
+    TRoboticPositioner *const &Get(int i) {
+        return TItemsList<TRoboticPositioner*>::Get(i);}
+    TRoboticPositioner *const &Get(int i) const {
+        return TItemsList<TRoboticPositioner*>::Get(i);}
+    TRoboticPositioner *const &operator[](int i) {
+        return TItemsList<TRoboticPositioner*>::operator[](i);}
+    TRoboticPositioner *const &operator[](int i) const {
+        return TItemsList<TRoboticPositioner*>::operator[](i);}
+    //escribe el elemento indicado
+    void Set(int i, TRoboticPositioner *const &RP) {
+        TItemsList<TRoboticPositioner*>::Set(i, RP); updateIndex();}
+    //add a RP to the list
+    void Add(TRoboticPositioner *const &RP);
+    //add the RPs of other list
+    void Add(TItemsList<TRoboticPositioner*>& L) {
+        TItemsList<TRoboticPositioner*>::Add(L); updateIndex();}
+    //insert a RP in the indicated position
+    void InsertFirst(TRoboticPositioner *&RP) {
+        TItemsList<TRoboticPositioner*>::InsertFirst(RP); updateIndex();}
+    void Insert(int i, TRoboticPositioner *const &RP) {
+        TItemsList<TRoboticPositioner*>::Insert(i, RP); updateIndex();}
+    //delete a RP of the list without destroy it
+    void Delete(int i) {
+        TItemsList<TRoboticPositioner*>::Delete(i); updateIndex();}
+    //delete all RPs of the list without destroy them
+    void Clear(void) {
+        TItemsList<TRoboticPositioner*>::Clear(); updateIndex();}
+    //copy the pointers of other list
+    void Copy(const TItemsList<TRoboticPositioner*>& L) {
+        TItemsList<TRoboticPositioner*>::Copy(L); updateIndex();}
 
     //search and delete a RP of the list
     //return the position where the RP was found
@@ -331,6 +433,14 @@ public:
     int search(const TActuator *A) const;
     //busca el primer posicionador con el identificador indicado
     int searchId(int Id) const;
+    //busca el primer posicionador igual al indicado según Compare
+    //(por defecto, el primero con el mismo identificador)
+    int Search(TRoboticPositioner *const &RP) const;
+
+    //The search methods are resolved in constant time through the index
+    //of positions, also when the RP is not in the list.
+    //When the list contains repeated RPs and it has been reordered,
+    //the position got from the index could not be the first.
     //devuelve el puntero al primer posicionador
     //con el identificador indicado
     const TRoboticPositioner *searchIdPointer(int Id) const;
@@ -360,6 +470,44 @@ public:
 
     //set value to all disabling swithches
     void setAllDisabled(bool);
+    //set the capacity of the image caches of the arms of all RPs
+    //(0 for disable them)
+    void setAllImageCacheCapacities(unsigned int);
+
+    //------------------------------------------------------------------
+    //ADJACENCY GRAPH:
+
+    //edges of the adjacency graph of the RPs of the list
+    //Each edge is shared by the two symmetric slots of the pair
+    //(RP1, RP2) in the lists AdjacentRPs, and permits calculate
+    //the distance between them once per simulation step.
+    //The edges are built in determineAdjacents and sortAdjacents.
+    TAdjacencyEdgeList AdjacencyEdges;
+
+    //build the edges of the adjacency graph and link them
+    //to the slots of the lists AdjacentRPs
+    void buildAdjacencyEdges(void);
+    //unlink the slots of the lists AdjacentRPs and destroy the edges
+    void clearAdjacencyEdges(void);
+
+    //update the grids of the circles which contain the RPs
+    //and the EAs of the list EAL, with their security margins,
+    //for search the candidates to be adjacent
+    void updateAdjacencyGrids(const TExclusionAreaList& EAL);
+    //search the RPs whose circles of adjacency are closer than r
+    //to a point, in increasing order of position:
+    //  Mod(P0 - P) < r + r_max + SPMall_a
+    //The grid of the last determination of adjacents is used
+    //when it contains all RPs of the list.
+    void searchAdjacencyCandidates(std::vector<int>& indices,
+                                   TDoublePoint P, double r) const;
+    //determine the EAs and the RPs adjacents to the indicated RP
+    //without build the edges of the adjacency graph
+    void determineAdjacents(int i, const TExclusionAreaList& EAL,
+                            const TSpatialGrid& RPG, const TSpatialGrid& EAG);
+    //sort the list of RPs adjacents to a RP
+    //without build the edges of the adjacency graph
+    void sortAdjacents(TRoboticPositioner *RP);
 
     //------------------------------------------------------------------
     //ASSIMILATION METHODS:
@@ -382,6 +530,18 @@ public:
     //sentido levógiro empezando por el más próximo a 0
     void sortAdjacents(void);
 
+    //determine again the adjacents of the given RPs and the adjacents of
+    //the RPs which were adjacent or become adjacent to some of them,
+    //keeping the other lists of adjacents, so that the result is the same
+    //than determineAdjacents followed by sortAdjacents
+    //The list Affected is overwritten with the RPs whose adjacents
+    //have been determined again, in the order of the list.
+    //All given RPs shall be in the list, and only them shall be changed
+    //since the last assimilation.
+    void updateAdjacents(TItemsList<TRoboticPositioner*>& Affected,
+                         const TItemsList<TRoboticPositioner*>& Changed,
+                         const TExclusionAreaList& EAL);
+
     //El método DetermineAdjacents() y los sucesivos
     //deberán ser invocados toda vez que se añadan o borren posicionadores,
     //o se modifique algún parámetro de posicionamiento o dimensionamiento,
@@ -436,6 +596,17 @@ public:
     //  assimilateSizing();
     void assimilate(const TExclusionAreaList& EAL);
 
+    //assimilate the changes of the given RPs executing:
+    //  calculateSPMcomponents() of the given RPs;
+    //  updateAdjacents(Affected, Changed, EAL);
+    //  calculateSafeParameters() of the affected RPs;
+    //  calculateSizingParameters();
+    //  calculateAreaParameters();
+    //All given RPs shall be in the list, and only them shall be changed
+    //since the last assimilation.
+    void assimilate(const TExclusionAreaList& EAL,
+                    const TItemsList<TRoboticPositioner*>& Changed);
+
     //------------------------------------------------------------------
     //METHODS FOR JOINTLY READING:
 
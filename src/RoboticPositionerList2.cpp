@@ -701,6 +701,8 @@ void TRoboticPositionerList2::copyMap(const TRoboticPositionerList2 *RPL)
     //clona la matriz de listas de punteros a posicionador
     copyCells(RPL);
     p_J = RPL->getJ();
+    //copy the grid of domains
+    p_Domains = RPL->p_Domains;
 
     //asigna las propiedades derivadas
     p_qx = RPL->getqx();
@@ -889,6 +891,20 @@ void TRoboticPositionerList2::map(void)
 
     TRoboticPositioner *RP;
 
+    //update the grid of domains, with cells of the size of the domains,
+    //so that each search by a point visits around four cells
+    //(the grid is kept when the domains have not changed)
+    std::vector<TDoublePoint> Centers(getCount());
+    std::vector<double> Radii(getCount());
+    double r3max = 0;
+    for(int k=0; k<getCount(); k++) {
+        Centers[k] = Items[k]->getActuator()->getP0();
+        Radii[k] = Items[k]->getActuator()->getL03max();
+        if(Radii[k] > r3max)
+            r3max = Radii[k];
+    }
+    p_Domains.update(Centers, Radii, 2*r3max + ERR_NUM);
+
     //por cada posicionador de la lista
     for(int k=0; k<getCount(); k++) {
         //apunta el posicionador para facilitar su acceso
@@ -1016,6 +1032,15 @@ void TRoboticPositionerList2::assimilate(const TExclusionAreaList& EAL)
     assimilateSizing(EAL);
     generateMap();
 }
+//assimilates the changes of the given RPs executing:
+//      TRoboticPositionerList1::assimilate(EAL, Changed);
+//      generateMap();
+void TRoboticPositionerList2::assimilate(const TExclusionAreaList& EAL,
+                                         const TItemsList<TRoboticPositioner*>& Changed)
+{
+    TRoboticPositionerList1::assimilate(EAL, Changed);
+    generateMap();
+}
 
 //assimilates all RPs of the RPL to a given RP
 void TRoboticPositionerList2::apply(const TRoboticPositioner *RP, const TExclusionAreaList& EAL)
@@ -1027,6 +1052,8 @@ void TRoboticPositionerList2::apply(const TRoboticPositioner *RP, const TExclusi
     //for all RPs copy all properties of the RP Instance except (P0, Id, Id1, Id2)
     for(int i=0; i<getCount(); i++)
         Items[i]->apply(RP);
+    //apply assigns the Ids of the RPs again
+    updateIndex();
 
     assimilate(EAL);
 }
@@ -1109,6 +1136,39 @@ void TRoboticPositionerList2::searchPositioners(TItemsList<TRoboticPositioner*>
     }
 }
 
+//search the RPs whose circle containing the domain of P3
+//is closer than r to a point, in the order of the list
+void TRoboticPositionerList2::searchPositioners(TItemsList<TRoboticPositioner*> &RPs,
+                                                TDoublePoint P, double r)
+{
+    //check the precondition
+    if(p_Domains.getCount() != getCount())
+        throw EImproperCall("the RPs of the list should be mapped");
+
+    std::vector<int> indices;
+    p_Domains.searchRange(indices, P, r);
+
+    RPs.Clear();
+    for(unsigned int k=0; k<indices.size(); k++)
+        RPs.Add(Items[indices[k]]);
+}
+//search the k RPs whose centers P0 are nearest to a point,
+//in increasing order of distance
+void TRoboticPositionerList2::searchNearestPositioners(TItemsList<TRoboticPositioner*> &RPs,
+                                                       TDoublePoint P, int k)
+{
+    //check the precondition
+    if(p_Domains.getCount() != getCount())
+        throw EImproperCall("the RPs of the list should be mapped");
+
+    std::vector<int> indices;
+    p_Domains.searchNearest(indices, P, k);
+
+    RPs.Clear();
+    for(unsigned int l=0; l<indices.size(); l++)
+        RPs.Add(Items[indices[l]]);
+}
+
 //---------------------------------------------------------------------------
 
 } //namespace Models
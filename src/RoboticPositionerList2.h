@@ -51,6 +51,12 @@ protected:
 
     int p_J;
 
+    //GRID OF DOMAINS:
+
+    //grid of the circles which contain the domains of P3 of the RPs,
+    //indexed by the position of the RPs in the list
+    TSpatialGrid p_Domains;
+
     //DERIVED PARAMETERS:
 
     double p_qx;
@@ -236,6 +242,11 @@ public:
     //      assimilateSizing(EAL);
     //      generateMap();
     void assimilate(const TExclusionAreaList& EAL);
+    //assimilates the changes of the given RPs executing:
+    //      TRoboticPositionerList1::assimilate(EAL, Changed);
+    //      generateMap();
+    void assimilate(const TExclusionAreaList& EAL,
+                    const TItemsList<TRoboticPositioner*>& Changed);
 
     //assimilates all RPs of the RPL to a given RP
     void apply(const TRoboticPositioner*, const TExclusionAreaList&);
@@ -259,6 +270,17 @@ public:
     //search the RPs whose scope is a point
     void searchPositioners(TItemsList<TRoboticPositioner*> &RPs,
                            TDoublePoint P);
+    //search the RPs whose circle containing the domain of P3
+    //is closer than r to a point, in the order of the list
+    void searchPositioners(TItemsList<TRoboticPositioner*> &RPs,
+                           TDoublePoint P, double r);
+    //search the k RPs whose centers P0 are nearest to a point,
+    //in increasing order of distance
+    void searchNearestPositioners(TItemsList<TRoboticPositioner*> &RPs,
+                                  TDoublePoint P, int k);
+
+    //WARNING: the searchs by the map shall be made
+    //after map the RPs, and before modify the list.
 };
 
 //How to use the class TRoboticPositionerList2:
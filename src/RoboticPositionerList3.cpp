@@ -24,6 +24,7 @@
 
 #include "RoboticPositionerList3.h"
 #include "Strings.h"
+#include "Profiler.h"
 
 //#include <QTimer>
 
@@ -711,6 +712,8 @@ void TRoboticPositionerList::invertTime(void)
 //por las funciones de movimiento en el instante t
 void TRoboticPositionerList::move(double t)
 {
+    PROFILE_SCOPE(pfRoboticPositionerListMove);
+
         //por cada RP de la lista
         for(int i=0; i<getCount(); i++)
                 //mueve el RP a su posición correspondiente al instante t
@@ -0,0 +1,229 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file SpatialGrid.cpp
+/// @brief uniform grid of circles for range and nearest queries
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "SpatialGrid.h"
+#include "Exceptions.h"
+
+#include <algorithm> //std::sort, std::partial_sort
+#include <cmath> //floor
+#include <cstdlib> //abs
+#include <utility> //std::pair
+
+//---------------------------------------------------------------------------
+
+//espacio de nombres de clases y funciones matemáticas
+namespace Mathematics {
+
+//---------------------------------------------------------------------------
+//TSpatialGrid
+//---------------------------------------------------------------------------
+
+//get the row or column of the cell which contains a coordinate
+int TSpatialGrid::index(double x) const
+{
+    return (int)floor(x/p_q);
+}
+
+//build an empty grid
+TSpatialGrid::TSpatialGrid(void) :
+    p_q(1), p_rmax(0), p_Cells(),
+    p_imin(0), p_imax(-1), p_jmin(0), p_jmax(-1)
+{
+}
+
+//build the grid of the given circles with cells of side q
+void TSpatialGrid::build(const std::vector<TDoublePoint>& Centers,
+                         const std::vector<double>& Radii, double q)
+{
+    //check the preconditions
+    if(Centers.size() != Radii.size())
+        throw EImproperArgument("Centers and Radii should have the same size");
+    for(unsigned int k=0; k<Radii.size(); k++)
+        if(Radii[k] < 0)
+            throw EImproperArgument("all radii should be nonnegative");
+    if(q <= 0)
+        throw EImproperArgument("side of the cells q should be upper zero");
+
+    //initialize the grid
+    clear();
+    p_q = q;
+    p_Centers = Centers;
+    p_Radii = Radii;
+
+    //put each circle in the cell which contains its center
+    for(int k=0; k<getCount(); k++) {
+        int i = index(p_Centers[k].y);
+        int j = index(p_Centers[k].x);
+        p_Cells[key(i, j)].push_back(k);
+
+        //update the interval of occupied cells
+        if(k == 0) {
+            p_imin = p_imax = i;
+            p_jmin = p_jmax = j;
+        } else {
+            p_imin = std::min(p_imin, i);
+            p_imax = std::max(p_imax, i);
+            p_jmin = std::min(p_jmin, j);
+            p_jmax = std::max(p_jmax, j);
+        }
+
+        //update the maximum radius
+        if(p_Radii[k] > p_rmax)
+            p_rmax = p_Radii[k];
+    }
+}
+//rebuild the grid only if the given circles or the side of the cells
+//are not the ones of the grid, and indicates if it has been rebuilt
+bool TSpatialGrid::update(const std::vector<TDoublePoint>& Centers,
+                          const std::vector<double>& Radii, double q)
+{
+    //if the grid contains the same circles, keep it
+    if(q==p_q && Centers.size()==p_Centers.size() && Radii==p_Radii) {
+        unsigned int k = 0;
+        while(k<Centers.size() && Centers[k]==p_Centers[k])
+            k++;
+        if(k >= Centers.size())
+            return false;
+    }
+
+    //build the grid of the given circles
+    build(Centers, Radii, q);
+    return true;
+}
+//remove all circles of the grid
+void TSpatialGrid::clear(void)
+{
+    p_rmax = 0;
+    p_Centers.clear();
+    p_Radii.clear();
+    p_Cells.clear();
+    p_imin = 0;
+    p_imax = -1;
+    p_jmin = 0;
+    p_jmax = -1;
+}
+
+//search the circles that are closer than r to a point:
+//  Mod(Centers[k] - P) < r + Radii[k]
+void TSpatialGrid::searchRange(std::vector<int>& indices, TDoublePoint P, double r) const
+{
+    indices.clear();
+
+    //a circle can be found only in the cells which
+    //intersect the square circumscribed to the circle (P, r + rmax)
+    double R = r + p_rmax;
+    if(getCount() <= 0 || R < 0)
+        return;
+    int imin = std::max(p_imin, index(P.y - R));
+    int imax = std::min(p_imax, index(P.y + R));
+    int jmin = std::max(p_jmin, index(P.x - R));
+    int jmax = std::min(p_jmax, index(P.x + R));
+
+    //for each cell of the interval
+    for(int i=imin; i<=imax; i++)
+        for(int j=jmin; j<=jmax; j++) {
+            std::unordered_map<long long, std::vector<int> >::const_iterator it = p_Cells.find(key(i, j));
+            if(it == p_Cells.end())
+                continue;
+
+            //add the circles closer than r to the point
+            const std::vector<int>& cell = it->second;
+            for(unsigned int l=0; l<cell.size(); l++) {
+                int k = cell[l];
+                if(Mod(p_Centers[k] - P) < r + p_Radii[k])
+                    indices.push_back(k);
+            }
+        }
+
+    //sort the positions as in a linear search
+    std::sort(indices.begin(), indices.end());
+}
+
+//search the k circles whose centers are nearest to a point,
+//in increasing order of distance (and position for equal distances)
+void TSpatialGrid::searchNearest(std::vector<int>& indices, TDoublePoint P, int k) const
+{
+    //check the precondition
+    if(k < 0)
+        throw EImproperArgument("number of circles k should be nonnegative");
+
+    indices.clear();
+    if(k == 0 || getCount() <= 0)
+        return;
+    if(k > getCount())
+        k = getCount();
+
+    //cell of the point and rings of cells around it
+    //which can contain some circle
+    int i0 = index(P.y);
+    int j0 = index(P.x);
+    int dmin = std::max(std::max(p_imin - i0, i0 - p_imax),
+                        std::max(p_jmin - j0, j0 - p_jmax));
+    if(dmin < 0)
+        dmin = 0;
+    int dmax = std::max(std::max(abs(p_imin - i0), abs(p_imax - i0)),
+                        std::max(abs(p_jmin - j0), abs(p_jmax - j0)));
+
+    //candidates (distance, position) found in the visited rings
+    std::vector<std::pair<double, int> > candidates;
+
+    //for each ring of cells around the cell of the point
+    for(int d=dmin; d<=dmax; d++) {
+        for(int i=std::max(p_imin, i0-d); i<=std::min(p_imax, i0+d); i++) {
+            //the sides of the ring have two cells per row
+            int step = (abs(i - i0) == d) ? 1 : 2*d;
+            for(int j=j0-d; j<=j0+d; j+=step) {
+                if(j<p_jmin || p_jmax<j)
+                    continue;
+                std::unordered_map<long long, std::vector<int> >::const_iterator it = p_Cells.find(key(i, j));
+                if(it == p_Cells.end())
+                    continue;
+                const std::vector<int>& cell = it->second;
+                for(unsigned int l=0; l<cell.size(); l++)
+                    candidates.push_back(std::pair<double, int>(Mod(p_Centers[cell[l]] - P), cell[l]));
+            }
+        }
+
+        //The circles out of the visited rings are
+        //at a distance from the point not lower than d*q,
+        //so the search can finish when there are k candidates closer.
+        if(int(candidates.size()) >= k) {
+            std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+            candidates.resize(k);
+            if(candidates[k-1].first < d*p_q)
+                break;
+        }
+    }
+
+    //transcribe the positions
+    std::sort(candidates.begin(), candidates.end());
+    for(int l=0; l<int(candidates.size()) && l<k; l++)
+        indices.push_back(candidates[l].second);
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Mathematics
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,116 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file SpatialGrid.h
+/// @brief uniform grid of circles for range and nearest queries
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "Vectors.h"
+
+#include <vector>
+#include <unordered_map>
+
+//---------------------------------------------------------------------------
+
+//espacio de nombres de clases y funciones matemáticas
+namespace Mathematics {
+
+//---------------------------------------------------------------------------
+//TSpatialGrid
+//---------------------------------------------------------------------------
+
+//uniform grid of circles (center, radius) indexed by position
+//Each circle is stored in the cell which contains its center,
+//and the cells are hashed, so that only the occupied cells take memory.
+//The queries return the positions of the circles in increasing order,
+//so that the result of a search by the grid is the same
+//than the result of a linear search.
+class TSpatialGrid {
+    //side of the cells
+    double p_q;
+    //maximum radius of the circles
+    double p_rmax;
+
+    //circles of the grid
+    std::vector<TDoublePoint> p_Centers;
+    std::vector<double> p_Radii;
+
+    //positions of the circles of each occupied cell
+    std::unordered_map<long long, std::vector<int> > p_Cells;
+    //interval of the occupied cells
+    int p_imin, p_imax, p_jmin, p_jmax;
+
+    //get the key of the cell (i, j)
+    //(the shift is made in unsigned, because shift a negative value is undefined)
+    static long long key(int i, int j) {
+        return (long long)((unsigned long long)(unsigned int)i<<32 | (unsigned int)j);
+    }
+    //get the row or column of the cell which contains a coordinate
+    int index(double x) const;
+
+public:
+    //side of the cells
+    double getq(void) const {return p_q;}
+    //number of circles of the grid
+    int getCount(void) const {return int(p_Centers.size());}
+
+    //build an empty grid
+    TSpatialGrid(void);
+
+    //build the grid of the given circles with cells of side q
+    //Centers and Radii shall have the same size,
+    //the radii shall be nonnegative and q shall be upper zero.
+    void build(const std::vector<TDoublePoint>& Centers,
+               const std::vector<double>& Radii, double q);
+    //rebuild the grid only if the given circles or the side of the cells
+    //are not the ones of the grid, and indicates if it has been rebuilt
+    //So a grid kept between two assimilations of the same instance
+    //is not rebuilt.
+    bool update(const std::vector<TDoublePoint>& Centers,
+                const std::vector<double>& Radii, double q);
+    //remove all circles of the grid
+    void clear(void);
+
+    //search the circles that are closer than r to a point:
+    //  Mod(Centers[k] - P) < r + Radii[k]
+    void searchRange(std::vector<int>& indices, TDoublePoint P, double r) const;
+    //search the k circles whose centers are nearest to a point,
+    //in increasing order of distance (and position for equal distances)
+    void searchNearest(std::vector<int>& indices, TDoublePoint P, int k) const;
+};
+
+//ADVICE: for determine the pairs of circles closer than a margin,
+//side of the cells shall be about twice the maximum radius,
+//so that each query visits around nine cells.
+
+//The grid indexes circles only. The arms are not indexed, because
+//they move in each step of the simulation and the candidates to collide
+//are already given by the adjacency graph. The grid is built in
+//a single thread, because it is linear in the number of circles.
+
+//---------------------------------------------------------------------------
+
+} //namespace Mathematics
+
+//---------------------------------------------------------------------------
+#endif // SPATIALGRID_H
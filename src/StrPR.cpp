@@ -2367,7 +2367,8 @@ void ReadVector (TStringList *SL, const AnsiString &S, char c1, char c2)
 //translate from time_t to string in format en_EN
 string strfromtime_t(time_t t, string format)
 {
-    tm lt = *localtime(&t);
+    tm lt;
+    localtime_r(&t, &lt);
 
     char buffer[32];
     strftime(buffer, 32, format.c_str(), &lt);
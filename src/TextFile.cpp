@@ -149,6 +149,44 @@ void TTextFile::Read(string& S)
     }
 }
 
+//lee todo el contenido del archivo en bloques, insertando '\r'
+//delante de cada '\n' que no esté precedido de '\r'
+//(equivale a Read seguido de reemplazar "\r\r\n" por "\r\n")
+void TTextFile::ReadCRLF(string& S)
+{
+    //debe haber un archivo abierto
+    if(!IsOpen)
+        throw EImproperCall("file should be open");
+
+    //reserva espacio para el contenido del archivo, si se puede determinar
+    S = "";
+    long pos = ftell(f);
+    if(pos>=0 && fseek(f, 0, SEEK_END)==0) {
+        long size = ftell(f);
+        if(size > pos)
+            S.reserve(size_t(size - pos) + size_t(size - pos)/32);
+        fseek(f, pos, SEEK_SET);
+    }
+
+    //lee los bloques y traduce los finales de línea
+    char buffer[65536];
+    size_t n;
+    while((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+        size_t first = 0;
+        for(size_t i=0; i<n; i++)
+            if(buffer[i] == '\n') {
+                S.append(buffer + first, i - first);
+                if(S.length()<=0 || S[S.length()-1]!='\r')
+                    S += '\r';
+                first = i;
+            }
+        S.append(buffer + first, n - first);
+    }
+
+    if(ferror(f))
+        throw ECantComplete(AnsiString("can't read file: ")+FileName);
+}
+
 //escribe todo el contenido del archivo
 //si no puede realizar la operación lanza una excepción
 void TTextFile::Print(const string& S)
@@ -340,10 +378,8 @@ void strReadFromFileWithComments(string& str, const string& filename)
         //abre el archivo para lectura
         TF.Open(filename.c_str(), (char*)"r");
 
-        //lee el archivo en la cadena
-        TF.Read(str);
-        //reemplaza las cadenas "\r\r\n" por cadenas "\r\n"
-        strreplace(str, "\r\r\n", "\r\n");
+        //lee el archivo en la cadena con los finales de línea "\r\n"
+        TF.ReadCRLF(str);
 
         //cierra el archivo
         TF.Close();
@@ -367,10 +403,8 @@ void strReadFromFile(string& str, const string& filename)
         //abre el archivo para lectura
         TF.Open(filename.c_str(), (char*)"r");
 
-        //lee el archivo en la cadena
-        TF.Read(str);
-        //reemplaza las cadenas "\r\r\n" por cadenas "\r\n"
-        strreplace(str, "\r\r\n", "\r\n");
+        //lee el archivo en la cadena con los finales de línea "\r\n"
+        TF.ReadCRLF(str);
         //borra los comentarios
         strClearComments(str);
 
@@ -84,6 +84,10 @@ public:
     //lee todo el contenido del archivo
     //si no puede realizar la operación lanza una excepción ECantComplete
     void Read(string& S);
+    //lee todo el contenido del archivo en bloques, insertando '\r'
+    //delante de cada '\n' que no esté precedido de '\r'
+    //(equivale a Read seguido de reemplazar "\r\r\n" por "\r\n")
+    void ReadCRLF(string& S);
 
     //escribe todo el contenido del archivo
     //si no puede realizar la operación lanza una excepción ECantComplete
@@ -692,6 +692,19 @@ bool isfile(const string& path)
 
     return false;
 }
+//determine if a path correspond to a existing directory
+bool isdir(const string& path)
+{
+    //read the attributes of the path
+    struct stat sb;
+    int result = stat(path.c_str(), &sb);
+
+    //chack that has read the attributes
+    if(result != 0)
+        return false;
+
+    return S_ISDIR(sb.st_mode);
+}
 
 //extract the filename without extension
 string stem(string path)
@@ -264,6 +264,8 @@ void ForceDirectories(const AnsiString&);
 void splitpath(string& parent_path, string& filename, const string& path);
 //determine if a path correspond to a existing file
 bool isfile(const string& path);
+//determine if a path correspond to a existing directory
+bool isdir(const string& path);
 
 //extract the filename without extension
 string stem(string path);
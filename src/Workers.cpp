@@ -0,0 +1,164 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file Workers.cpp
+/// @brief number of worker threads of the parallel loops
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "Workers.h"
+
+//---------------------------------------------------------------------------
+
+//namespace for worker threads
+namespace Workers {
+
+//---------------------------------------------------------------------------
+
+//indicates if the current thread is a worker of a parallel loop
+static thread_local bool worker_thread = false;
+
+//indicates if the current thread is a worker of a parallel loop
+bool isWorker(void)
+{
+    return worker_thread;
+}
+//mark or unmark the current thread as worker of a parallel loop
+void setWorker(bool worker)
+{
+    worker_thread = worker;
+}
+
+//get the number of threads for distribute N tasks
+int getNworkers(unsigned int Nthreads, int N)
+{
+    //the nested loops are executed sequentially
+    if(worker_thread)
+        return 1;
+
+    int Nworkers = int(Nthreads);
+    if(Nworkers <= 0)
+        Nworkers = int(std::thread::hardware_concurrency());
+    if(Nworkers > N)
+        Nworkers = N;
+    if(Nworkers < 1)
+        Nworkers = 1;
+
+    return Nworkers;
+}
+
+//---------------------------------------------------------------------------
+//TWorkerPool:
+
+//build a pool of Nthreads threads
+TWorkerPool::TWorkerPool(int Nthreads) :
+    task(NULL), Ntasks(0), next(0), done(0), generation(0), stopping(false)
+{
+    //with a thread the loops are executed in the calling thread
+    if(Nthreads <= 1)
+        return;
+
+    for(int w=0; w<Nthreads; w++)
+        threads.push_back(std::thread(&TWorkerPool::work, this));
+}
+//finish and join the threads of the pool
+TWorkerPool::~TWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv_start.notify_all();
+    for(unsigned int w=0; w<threads.size(); w++)
+        threads[w].join();
+}
+
+//loop executed by each thread of the pool
+void TWorkerPool::work(void)
+{
+    setWorker(true);
+
+    unsigned int seen = 0;
+    std::unique_lock<std::mutex> lock(mtx);
+    while(true) {
+        //wait a new loop or the finalization of the pool
+        cv_start.wait(lock, [&]() {return stopping || generation != seen;});
+        if(stopping)
+            return;
+        seen = generation;
+
+        //execute the iterations of the loop which remain
+        while(next < Ntasks) {
+            int k = next++;
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                (*task)(k);
+            }
+            catch(...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if(error)
+                errors[k] = error;
+            if(++done == Ntasks)
+                cv_done.notify_all();
+        }
+    }
+
+    //Note that a thread which wakes up late can find the loop finished
+    //(next == Ntasks), in which case it does not access to the task.
+}
+
+//execute task(k) for k in [0, N) distributed among the threads
+void TWorkerPool::run(int N, const std::function<void(int)>& t_task)
+{
+    //without threads, execute the loop in the calling thread
+    if(threads.empty() || N <= 1) {
+        for(int k=0; k<N; k++)
+            t_task(k);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mtx);
+    task = &t_task;
+    Ntasks = N;
+    next = 0;
+    done = 0;
+    errors.assign(N, std::exception_ptr());
+    generation++;
+    cv_start.notify_all();
+
+    //wait until all iterations have been executed
+    cv_done.wait(lock, [&]() {return done == Ntasks;});
+    task = NULL;
+    Ntasks = 0;
+    next = 0;
+
+    //rethrow the exception of the first iteration which has failed
+    for(int k=0; k<N; k++)
+        if(errors[k])
+            std::rethrow_exception(errors[k]);
+}
+
+//---------------------------------------------------------------------------
+
+} //namespace Workers
+
+//---------------------------------------------------------------------------
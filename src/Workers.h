@@ -0,0 +1,117 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file Workers.h
+/// @brief number of worker threads of the parallel loops
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+//---------------------------------------------------------------------------
+
+//The parallel loops of the library (validation of clusters,
+//search of recovery programs, stable positions, batch of FMOSA files)
+//can be nested. For avoid the oversubscription of the processor,
+//only the outermost loop distributes its tasks among threads,
+//and the loops executed by a worker thread run sequentially.
+
+//namespace for worker threads
+namespace Workers {
+
+//---------------------------------------------------------------------------
+
+//indicates if the current thread is a worker of a parallel loop
+bool isWorker(void);
+//mark or unmark the current thread as worker of a parallel loop
+void setWorker(bool worker);
+
+//get the number of threads for distribute N tasks:
+//  Nthreads: number of threads requested (0 for the number of cores);
+//  N: number of tasks to distribute.
+//Returns 1 when the current thread is a worker of a parallel loop,
+//so that the nested loops are executed sequentially.
+int getNworkers(unsigned int Nthreads, int N);
+
+//---------------------------------------------------------------------------
+
+//Pool of worker threads reused along several parallel loops,
+//for avoid create and join the threads in each loop.
+//The threads of the pool are marked as workers, so the loops
+//executed by the tasks run sequentially.
+class TWorkerPool {
+    //threads of the pool
+    std::vector<std::thread> threads;
+
+    //synchronization of the loop in execution
+    std::mutex mtx;
+    std::condition_variable cv_start;
+    std::condition_variable cv_done;
+
+    //task of the loop in execution, its number of iterations,
+    //the next iteration to execute and the number of executed iterations
+    const std::function<void(int)> *task;
+    int Ntasks;
+    int next;
+    int done;
+    //exceptions throwed by each iteration
+    std::vector<std::exception_ptr> errors;
+    //number of the loop in execution
+    unsigned int generation;
+    //flag indicating that the threads should finish
+    bool stopping;
+
+    //loop executed by each thread of the pool
+    void work(void);
+
+public:
+    //build a pool of Nthreads threads
+    //(with Nthreads <= 1 the loops are executed in the calling thread)
+    TWorkerPool(int Nthreads);
+    //finish and join the threads of the pool
+    ~TWorkerPool();
+
+    //get the number of threads of the pool
+    int getNthreads(void) const {return int(threads.size());}
+
+    //execute task(k) for k in [0, N) distributed among the threads,
+    //and wait until all iterations have been executed
+    //If some iterations throw an exception, rethrow the exception
+    //of the first of them.
+    void run(int N, const std::function<void(int)>& task);
+
+    //a pool can not be copied
+    TWorkerPool(const TWorkerPool&) = delete;
+    TWorkerPool& operator=(const TWorkerPool&) = delete;
+};
+
+//---------------------------------------------------------------------------
+
+} //namespace Workers
+
+//---------------------------------------------------------------------------
+#endif // WORKERS_H
@@ -177,6 +177,7 @@ TAdjacentRP::TAdjacentRP(TRoboticPositioner *t_RP, double t_Dmin, double t_Dend)
     RP = t_RP;
     Dmin = t_Dmin;
     Dend = t_Dend;
+    Edge = NULL;
 }
 //clone an item
 void TAdjacentRP::Clone(TAdjacentRP& ARP)
@@ -184,6 +185,9 @@ void TAdjacentRP::Clone(TAdjacentRP& ARP)
     RP = ARP.RP;
     Dmin = ARP.Dmin;
     Dend = ARP.Dend;
+    //the edge belongs to the graph of the source list,
+    //so the clon shall be linked by buildAdjacencyEdges
+    Edge = NULL;
 }
 //build a clon of an item
 TAdjacentRP::TAdjacentRP(TAdjacentRP *&ARP)
@@ -195,6 +199,9 @@ TAdjacentRP::TAdjacentRP(TAdjacentRP *&ARP)
     RP = ARP->RP;
     Dmin = ARP->Dmin;
     Dend = ARP->Dend;
+    //the edge belongs to the graph of the source list,
+    //so the clon shall be linked by buildAdjacencyEdges
+    Edge = NULL;
 }
 
 //compare the Id of the RP of two adjacent RPs
@@ -301,6 +308,66 @@ void TAdjacentRPList::setAllDends(double Dend)
         Items[i]->Dend = Dend;
 }
 
+//invalidate the distance of the edges of all items
+void TAdjacentRPList::invalidateEdges(void)
+{
+    for(int i=0; i<getCount(); i++) {
+        TAdjacencyEdge *E = Items[i]->Edge;
+        if(E != NULL)
+            E->calculated = false;
+    }
+}
+
+//---------------------------------------------------------------------------
+//TAdjacencyEdge
+//---------------------------------------------------------------------------
+
+//build an item with the indicated values
+TAdjacencyEdge::TAdjacencyEdge(TRoboticPositioner *t_RP1, TRoboticPositioner *t_RP2)
+{
+    RP1 = t_RP1;
+    RP2 = t_RP2;
+    D = DBL_MAX;
+    calculated = false;
+}
+//clone an item
+void TAdjacencyEdge::Clone(TAdjacencyEdge& E)
+{
+    RP1 = E.RP1;
+    RP2 = E.RP2;
+    D = E.D;
+    calculated = E.calculated;
+}
+//build a clon of an item
+TAdjacencyEdge::TAdjacencyEdge(TAdjacencyEdge *&E)
+{
+    //check the precondition
+    if(E == NULL)
+        throw EImproperArgument("pointer E should point to built adjacency edge");
+
+    RP1 = E->RP1;
+    RP2 = E->RP2;
+    D = E->D;
+    calculated = E->calculated;
+}
+
+//---------------------------------------------------------------------------
+//TAdjacencyEdgeList
+//---------------------------------------------------------------------------
+
+//build a list by default
+TAdjacencyEdgeList::TAdjacencyEdgeList(void) :
+    TPointersList<TAdjacencyEdge>(300)
+{
+}
+
+//invalidate the distance of all edges
+void TAdjacencyEdgeList::invalidateAll(void)
+{
+    for(int i=0; i<getCount(); i++)
+        Items[i]->calculated = false;
+}
+
 //---------------------------------------------------------------------------
 
 } //namespace Models
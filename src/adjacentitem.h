@@ -103,6 +103,7 @@ public:
 
 //predeclares classes to avoid loops
 class TRoboticPositioner;
+class TAdjacencyEdge;
 
 //class cluster (RP, Dmin, Dend)
 class TAdjacentRP {
@@ -116,13 +117,19 @@ public:
     //distance in the final posicion
     //default value: DBL_MAX
     double Dend;
+    //attached-extern edge of the adjacency graph
+    //shared with the symmetric slot of the adjacent RP
+    //default value: NULL
+    TAdjacencyEdge *Edge;
 
     //build an item with the indicated values
     TAdjacentRP(TRoboticPositioner *t_RP=NULL,
                 double t_Dmin=DBL_MAX, double t_Dend=DBL_MAX);
     //clone an item
+    //the clon is unlinked from the adjacency graph (Edge = NULL)
     void Clone(TAdjacentRP&);
     //build a clon of an item
+    //the clon is unlinked from the adjacency graph (Edge = NULL)
     TAdjacentRP(TAdjacentRP*&);
 
     //compare the Id of the RP of two adjacent RPs
@@ -158,8 +165,53 @@ public:
     void setAllDmins(double Dmin);
     //set a same value to all Dends
     void setAllDends(double Dend);
+
+    //invalidate the distance of the edges of all items
+    void invalidateEdges(void);
 };
 
+//---------------------------------------------------------------------------
+//TAdjacencyEdge
+//---------------------------------------------------------------------------
+
+//class edge (RP1, RP2, D) of the adjacency graph of RPs
+//The edge is shared by the two symmetric slots (TAdjacentRP) of the pair,
+//so the distance between the RPs can be calculated once per step
+//and written in both slots.
+class TAdjacencyEdge {
+public:
+    //attached-extern RPs
+    //default value: NULL
+    TRoboticPositioner *RP1;
+    TRoboticPositioner *RP2;
+    //distance between the RPs in the current positions
+    //default value: DBL_MAX
+    double D;
+    //flag indicating if D has been calculated in the current positions
+    //default value: false
+    bool calculated;
+
+    //build an item with the indicated values
+    TAdjacencyEdge(TRoboticPositioner *t_RP1=NULL, TRoboticPositioner *t_RP2=NULL);
+    //clone an item
+    void Clone(TAdjacencyEdge&);
+    //build a clon of an item
+    TAdjacencyEdge(TAdjacencyEdge*&);
+};
+
+//---------------------------------------------------------------------------
+//TAdjacencyEdgeList
+//---------------------------------------------------------------------------
+
+//class list of edges of the adjacency graph
+class TAdjacencyEdgeList : public TPointersList<TAdjacencyEdge> {
+public:
+    //build a list by default
+    TAdjacencyEdgeList(void);
+
+    //invalidate the distance of all edges
+    void invalidateAll(void);
+};
 
 //---------------------------------------------------------------------------
 
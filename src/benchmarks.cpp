@@ -0,0 +1,754 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+/// @file benchmarks.cpp
+/// @brief main program of the benchmarks of the FMPT (fmpt_bench)
+/// @author Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+//includes for generic
+#include "globalconsts.h"
+#include "Strings.h"
+#include "TextFile.h"
+#include "Geometry.h" //distanceSegmentSegment
+//includes for calculus
+#include "MotionProgramGenerator.h"
+#include "OutputsPairPPDP.h" //Outputs
+#include "FileMethods.h"
+#include "CollisionFreeSampler.h"
+
+#include <clocale> //setlocale, LC_ALL
+#include <iostream> //std::cout
+#include <ctime> //clock, CLOCKS_PER_SEC
+#include <config.h> //PACKAGE_VERSION
+#include <chrono> //std::chrono::steady_clock
+#include <algorithm> //std::sort
+#include <cmath> //ceil
+
+using namespace Strings;
+using namespace Models;
+using namespace Positioning;
+
+//---------------------------------------------------------------------------
+//GENERAL FUNCTIONS:
+
+//indicates if the events should be printed in the standard output,
+//besides in the log file
+bool echo = true;
+
+//print a text line in the standard output and in the log file
+void append(const string& str, const char *log_path)
+{
+    string str_aux = str;
+    str_aux += "\r\n";
+
+    if(echo)
+        std::cout << str_aux;
+
+    char mode[] = "a";
+    TTextFile TF(log_path, mode);
+    TF.Print(str_aux.c_str());
+    TF.Close();
+}
+
+//gets a string containing the help
+string help(void)
+{
+    string str;
+
+    str = "$ fmpt_bench help";
+    str += "\r\n    Print this help.";
+    str += "\r\n";
+    str += "\r\n$ fmpt_bench testStepCost <outputs_path>";
+    str += "\r\n    Measure the time of validation of a pair (PP, DP), with and without";
+    str += "\r\n    the edges of the adjacency graph, which permit calculate the distance";
+    str += "\r\n    of each pair of adjacent RPs once per simulation step.";
+    str += "\r\n    <outputs_path>: absolute or relative path to file type outputs (format MEG).";
+    str += "\r\n";
+    str += "\r\n$ fmpt_bench testDistanceKernels";
+    str += "\r\n    Measure the time of calculation of the distances between the segments";
+    str += "\r\n    of the arm contours of each pair of adjacent RPs, pair to pair and";
+    str += "\r\n    in batch, in random positions of the RPs.";
+    str += "\r\n";
+    str += "\r\n$ fmpt_bench benchmarkGenerators <Nconfigs> [<seed>]";
+    str += "\r\n    Measure the time of generatePairPPDP, validateMotionProgram, revalidateMotionProgram";
+    str += "\r\n    (after excluding a RP of the DP) and generateParkProg in <Nconfigs> random";
+    str += "\r\n    configurations without collisions, reproducibles from the <seed> (1 by default),";
+    str += "\r\n    and print the percentiles of the times, the steps simulated and the distances";
+    str += "\r\n    calculated in the validations of each run.";
+    str += "\r\n    The table of runs is saved in the file 'benchmarkGenerators.txt'.";
+    str += "\r\n";
+    str += "\r\n$ fmpt_bench testCollisionFreeSampler <Nconfigs> [<seed>]";
+    str += "\r\n    Measure the time of randomization without collision of the RPs in <Nconfigs>";
+    str += "\r\n    configurations from the <seed> (1 by default), RP by RP and by classes";
+    str += "\r\n    of a coloring of the adjacency graph, and check that there isn't collisions.";
+    str += "\r\n    The randomization by classes fails in a configuration when some RP collides";
+    str += "\r\n    with its placed adjacents in 1000 draws, and the failed configurations are counted.";
+
+    return str;
+}
+
+//---------------------------------------------------------------------------
+//BENCHMARKS:
+
+//Measure the time of validation of a pair (PP, DP), with and without
+//the edges of the adjacency graph.
+void testStepCost(TFiberMOSModel& FMM, string& outputs_path, string& log_path)
+{
+    try {
+        //LOAD SETTINGS FROM FILES:
+
+        //load the Outputs structure from a file
+        string str;
+        OutputsPairPPDP outputs;
+        try {
+            strReadFromFile(str, outputs_path);
+            outputs.setText(str);
+
+        } catch(Exception& E) {
+            E.Message.Insert(1, "reading file type outputs: ");
+            throw;
+        }
+        append("Structure outputs loaded from file '"+outputs_path+"'.", log_path.c_str());
+
+        //MAKE ACTIONS:
+
+        //count the slots of RPs and the edges of the adjacency graph
+        int slots = 0;
+        for(int i=0; i<FMM.RPL.getCount(); i++)
+            slots += FMM.RPL[i]->getActuator()->AdjacentRPs.getCount();
+        FMM.RPL.buildAdjacencyEdges();
+        append("\r\nRPs: "+inttostr(FMM.RPL.getCount()), log_path.c_str());
+        append("Slots of adjacent RPs: "+inttostr(slots), log_path.c_str());
+        append("Edges of the adjacency graph: "+inttostr(FMM.RPL.AdjacencyEdges.getCount()), log_path.c_str());
+
+        //built a MPV attached to the FMM
+        TMotionProgramValidator MPV(&FMM);
+
+        //number of validations of the pair for each mode
+        const int N = 10;
+
+        //captures the initial positions
+        FMM.RPL.pushPositions();
+
+        //measure the time of validation in each mode
+        double T[2];
+        for(int mode=0; mode<2; mode++) {
+            if(mode == 0)
+                FMM.RPL.clearAdjacencyEdges();
+            else
+                FMM.RPL.buildAdjacencyEdges();
+
+            clock_t c1 = clock();
+            for(int i=0; i<N; i++) {
+                FMM.RPL.restorePositions();
+                FMM.RPL.setPurpose(pValPP);
+                if(!MPV.validateMotionProgram(outputs.PP))
+                    throw EImproperArgument("the PP should be valid");
+                FMM.RPL.setPurpose(pValDP);
+                if(!MPV.validateMotionProgram(outputs.DP))
+                    throw EImproperArgument("the DP should be valid");
+            }
+            clock_t c2 = clock();
+            T[mode] = double(c2 - c1)/CLOCKS_PER_SEC/N;
+        }
+
+        //restore the initial positions
+        FMM.RPL.restoreAndPopPositions();
+
+        //print the result
+        append("\r\nTime of validation of the pair (PP, DP) (mean of "+inttostr(N)+" validations):", log_path.c_str());
+        append("    without edges: "+floattostr(T[0])+" s", log_path.c_str());
+        append("    with edges:    "+floattostr(T[1])+" s", log_path.c_str());
+        if(T[1] > 0)
+            append("    ratio:         "+floattostr(T[0]/T[1]), log_path.c_str());
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "testing step cost: ");
+        throw;
+    }
+}
+
+//Measure the time of calculation of the distances between the segments
+//of the arm contours of each pair of adjacent RPs, pair to pair and in batch.
+void testDistanceKernels(TFiberMOSModel& FMM, string& log_path)
+{
+    try {
+        //MAKE ACTIONS:
+
+        //number of random configurations of the RPs
+        const int Nconf = 100;
+        //number of repetitions of the calculation for each configuration
+        const int Nrep = 10;
+
+        //captures the initial positions
+        FMM.RPL.pushPositions();
+
+        double T[2] = {0, 0};
+        int pairs = 0;
+        int batches = 0;
+        for(int k=0; k<Nconf; k++) {
+            FMM.RPL.randomizeP3();
+
+            for(int i=0; i<FMM.RPL.getCount(); i++) {
+                TRoboticPositioner *RP = FMM.RPL[i];
+                const TContourFigureList& C = RP->getActuator()->getArm()->getContour();
+
+                for(int j=0; j<RP->getActuator()->AdjacentRPs.getCount(); j++) {
+                    TRoboticPositioner *RPA = RP->getActuator()->AdjacentRPs[j].RP;
+                    const TContourFigureList& Co = RPA->getActuator()->getArm()->getContour();
+                    if(!C.flatIsUpdated() || !Co.flatIsUpdated())
+                        throw EImpossibleError("the flat representation of the arm contours should be updated");
+
+                    //calculates the minimum distance between segments pair to pair
+                    double dmin[2] = {DBL_MAX, DBL_MAX};
+                    clock_t c1 = clock();
+                    for(int r=0; r<Nrep; r++)
+                        for(unsigned int l=0; l<C.Flat.size(); l++) {
+                            const TFlatFigure& FF = C.Flat[l];
+                            if(FF.type != cftSegment)
+                                continue;
+                            for(unsigned int m=0; m<Co.Flat.size(); m++) {
+                                const TFlatFigure& FFo = Co.Flat[m];
+                                if(FFo.type != cftSegment)
+                                    continue;
+                                double d = distanceSegmentSegment(FF.Pa, FF.Pb, FFo.Pa, FFo.Pb);
+                                if(d < dmin[0])
+                                    dmin[0] = d;
+                                if(r == 0)
+                                    pairs++;
+                            }
+                        }
+
+                    //calculates the minimum distance between segments in batch
+                    clock_t c2 = clock();
+                    for(int r=0; r<Nrep; r++)
+                        for(unsigned int l=0; l<C.Flat.size(); l++) {
+                            const TFlatFigure& FF = C.Flat[l];
+                            if(FF.type != cftSegment)
+                                continue;
+                            double d = Co.Segments.distanceMin(FF.Pa, FF.Pb);
+                            if(d < dmin[1])
+                                dmin[1] = d;
+                            if(r == 0)
+                                batches++;
+                        }
+                    clock_t c3 = clock();
+
+                    T[0] += double(c2 - c1)/CLOCKS_PER_SEC;
+                    T[1] += double(c3 - c2)/CLOCKS_PER_SEC;
+
+                    //both ways should get the same distance
+                    if(dmin[0] != dmin[1])
+                        throw EImpossibleError("the distance in batch should be equal to the distance pair to pair");
+                }
+            }
+        }
+
+        //restore the initial positions
+        FMM.RPL.restoreAndPopPositions();
+
+        //print the result
+        append("Pairs of segments: "+inttostr(pairs*Nrep), log_path.c_str());
+        append("Batches of segments: "+inttostr(batches*Nrep), log_path.c_str());
+        append("Lanes of the batches: "+inttostr(distanceBatchLanes()), log_path.c_str());
+        append("\r\nTime of calculation of the distances between segments:", log_path.c_str());
+        append("    pair to pair: "+floattostr(T[0])+" s", log_path.c_str());
+        append("    in batch:     "+floattostr(T[1])+" s", log_path.c_str());
+        if(T[1] > 0)
+            append("    ratio:        "+floattostr(T[0]/T[1]), log_path.c_str());
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "testing distance kernels: ");
+        throw;
+    }
+}
+
+//Get the percentile p of a list of values sorted in ascending order
+//(nearest-rank method).
+static double percentile(const vector<double>& sorted, double p)
+{
+    if(sorted.size() <= 0)
+        return 0;
+    int i = int(ceil(p/100*sorted.size())) - 1;
+    if(i < 0)
+        i = 0;
+    return sorted[i];
+}
+
+//Print in the log the distribution of a list of values of several runs,
+//with the indicated number of decimals.
+static void appendDistribution(const string& label, vector<double> values, int decimals,
+                               const string& log_path)
+{
+    if(values.size() <= 0) {
+        append(label+"none run", log_path.c_str());
+        return;
+    }
+    sort(values.begin(), values.end());
+    double sum = 0;
+    for(unsigned int i=0; i<values.size(); i++)
+        sum += values[i];
+    append(label+"mean "+floattostr_fixed(sum/values.size(), decimals)+
+           ", p50 "+floattostr_fixed(percentile(values, 50), decimals)+
+           ", p90 "+floattostr_fixed(percentile(values, 90), decimals)+
+           ", p99 "+floattostr_fixed(percentile(values, 99), decimals)+
+           ", max "+floattostr_fixed(values[values.size() - 1], decimals), log_path.c_str());
+}
+
+//Measure the throughput of the generators in Nconfigs random configurations
+//reproducible from a seed. For each configuration are timed:
+//  generatePairPPDP, from projection points randomized without collision;
+//  validateMotionProgram, of the DP generated (if the pair is valid);
+//  revalidateMotionProgram, of the DP after excluding a RP (if the DP
+//      is valid), simulating only the gestures affected;
+//  generateParkProg, from positions randomized without collision.
+void benchmarkGenerators(TFiberMOSModel& FMM, int Nconfigs, unsigned int seed, string& log_path)
+{
+    try {
+        //CHECK THE PRECONDITIONS:
+
+        if(Nconfigs <= 0)
+            throw EImproperArgument("number of configurations Nconfigs should be upper zero");
+
+        if(FMM.RPL.thereIsSomeNullPointer())
+            throw EImproperCall("RP null pointer in the FMM");
+
+        if(FMM.RPL.thereIsSomeRepeatedPointer())
+            throw EImproperCall("RP repeated pointer in the FMM");
+
+        //MAKE ACTIONS:
+
+        //build a clone of the FMM for restore its state before each run
+        TFiberMOSModel FMM_initial(&FMM);
+
+        //results of each run
+        //  0: generatePairPPDP; 1: validateMotionProgram;
+        //  2: revalidateMotionProgram; 3: generateParkProg
+        const char *names[4] = {"generatePairPPDP", "validateMotionProgram",
+                                "revalidateMotionProgram", "generateParkProg"};
+        vector<double> times[4], steps[4], distances[4];
+        int valids[4] = {0, 0, 0, 0};
+
+        //table of runs
+        string str = "config\tseed\tfunction\tvalid\ttime (s)\tsteps\tdistances";
+
+        append("Benchmarking the generators in "+inttostr(Nconfigs)+" configurations from seed "+inttostr(int(seed))+"...", log_path.c_str());
+        bool echo_ = echo;
+        echo = false;
+        for(int k=0; k<Nconfigs; k++) {
+            unsigned int seed_k = seed + (unsigned int)k;
+            try {
+                //the configuration k only depends on its seed
+                srand(seed_k);
+
+                //GENERATE A PAIR (PP, DP):
+
+                //randomize the projection points of all RPs avoiding collisions
+                //and move the RPs to their observing positions
+                FMM.restoreState(FMM_initial);
+                TMotionProgramGenerator MPG(&FMM);
+                for(int i=0; i<FMM.RPL.getCount(); i++)
+                    if(FMM.RPL[i]->getOperative())
+                        MPG.AddAllocation(i);
+                FMM.RPL.setPurpose(pGenPairPPDP);
+                MPG.RandomizeWithoutCollision();
+                MPG.MoveToTargetP3();
+                TRoboticPositionerList Outsiders;
+                FMM.RPL.segregateEnabledOutsiders(Outsiders);
+
+                bool PPvalid = false;
+                bool DPvalid = false;
+                TRoboticPositionerList Collided;
+                TRoboticPositionerList Obstructed;
+                TMotionProgram PP;
+                TMotionProgram DP;
+                MPG.resetStatistics();
+                chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+                MPG.generatePairPPDP(PPvalid, DPvalid, Collided, Obstructed, PP, DP, Outsiders);
+                chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+                bool valid[4];
+                double dt[4];
+                unsigned long long Nsteps[4], Ndistances[4];
+                valid[0] = PPvalid && DPvalid;
+                dt[0] = chrono::duration<double>(t1 - t0).count();
+                Nsteps[0] = MPG.getNsteps();
+                Ndistances[0] = MPG.getNdistances();
+
+                //VALIDATE THE DP:
+
+                //here the RPs are in their observing positions with the quantifiers enabled
+                //when the pair (PP, DP) is valid
+                bool validated = valid[0];
+                TValidationRecord VR;
+                TPairPositionAnglesList OPL;
+                if(validated) {
+                    FMM.RPL.setPurpose(pValDP);
+                    FMM.RPL.getPositions(OPL);
+                    MPG.resetStatistics();
+                    t0 = chrono::steady_clock::now();
+                    valid[1] = MPG.validateMotionProgram(DP, NULL, &VR);
+                    t1 = chrono::steady_clock::now();
+                    dt[1] = chrono::duration<double>(t1 - t0).count();
+                    Nsteps[1] = MPG.getNsteps();
+                    Ndistances[1] = MPG.getNdistances();
+                }
+
+                //REVALIDATE THE DP EXCLUDING A RP:
+
+                //exclude a RP included in the DP, as when the pair is regenerated,
+                //and revalidate the DP from the observing positions
+                TVector<int> Excluded;
+                if(validated && valid[1])
+                    DP.getAllIncludedIds(Excluded);
+                bool revalidated = Excluded.getCount() > 0;
+                if(revalidated) {
+                    int Id = Excluded[int(seed_k % (unsigned int)Excluded.getCount())];
+                    Excluded.Clear();
+                    Excluded.Add(Id);
+                    DP.excludeRP(Id);
+                    FMM.RPL.setPositions(OPL);
+                    MPG.resetStatistics();
+                    t0 = chrono::steady_clock::now();
+                    valid[2] = MPG.revalidateMotionProgram(DP, VR, Excluded);
+                    t1 = chrono::steady_clock::now();
+                    dt[2] = chrono::duration<double>(t1 - t0).count();
+                    Nsteps[2] = MPG.getNsteps();
+                    Ndistances[2] = MPG.getNdistances();
+                }
+
+                //GENERATE A PARKING PROGRAM:
+
+                //randomize the positions of the RPs avoiding collisions
+                FMM.restoreState(FMM_initial);
+                FMM.RPL.setPurpose(pGenParPro);
+                FMM.RPL.randomizeWithoutCollision();
+                Outsiders.Clear();
+                FMM.RPL.segregateEnabledOutsiders(Outsiders);
+
+                TMotionProgramGenerator MPG2(&FMM);
+                Collided.Clear();
+                Obstructed.Clear();
+                TMotionProgram ParkProg;
+                t0 = chrono::steady_clock::now();
+                valid[3] = MPG2.generateParkProg(Collided, Obstructed, ParkProg, Outsiders);
+                t1 = chrono::steady_clock::now();
+                dt[3] = chrono::duration<double>(t1 - t0).count();
+                Nsteps[3] = MPG2.getNsteps();
+                Ndistances[3] = MPG2.getNdistances();
+
+                //ACCUMULATE THE RESULTS:
+
+                for(int f=0; f<4; f++) {
+                    if((f==1 && !validated) || (f==2 && !revalidated))
+                        continue;
+                    times[f].push_back(dt[f]);
+                    steps[f].push_back(double(Nsteps[f]));
+                    distances[f].push_back(double(Ndistances[f]));
+                    if(valid[f])
+                        valids[f]++;
+                    str += "\r\n"+inttostr(k)+"\t"+inttostr(int(seed_k))+"\t"+string(names[f])+"\t"+(valid[f] ? "1" : "0");
+                    str += "\t"+floattostr_fixed(dt[f], 6)+"\t"+floattostr_fixed(double(Nsteps[f]), 0)+"\t"+floattostr_fixed(double(Ndistances[f]), 0);
+                }
+            }
+            catch(Exception& E) {
+                echo = echo_;
+                E.Message.Insert(1, "in configuration "+inttostr(k)+" (seed "+inttostr(int(seed_k))+"): ");
+                throw;
+            }
+        }
+        echo = echo_;
+
+        //restore the initial state of the FMM
+        FMM.restoreState(FMM_initial);
+
+        //save the table of runs
+        string output_path = "benchmarkGenerators.txt";
+        strWriteToFile(output_path, str);
+        append("Table of runs saved in file '"+output_path+"'.", log_path.c_str());
+
+        //print the result
+        for(int f=0; f<4; f++) {
+            append("\r\n"+string(names[f])+": "+inttostr(int(times[f].size()))+" runs, "+inttostr(valids[f])+" valid", log_path.c_str());
+            appendDistribution("    time (s):  ", times[f], 4, log_path);
+            appendDistribution("    steps:     ", steps[f], 0, log_path);
+            appendDistribution("    distances: ", distances[f], 0, log_path);
+        }
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "benchmarking generators: ");
+        throw;
+    }
+}
+
+//Measure the time of randomization without collision of the RPs
+//in Nconfigs configurations, RP by RP and by classes of a coloring
+//of the adjacency graph, and check that there isn't collisions.
+void testCollisionFreeSampler(TFiberMOSModel& FMM, int Nconfigs, unsigned int seed, string& log_path)
+{
+    try {
+        //CHECK THE PRECONDITIONS:
+
+        if(Nconfigs <= 0)
+            throw EImproperArgument("number of configurations Nconfigs should be upper zero");
+
+        if(FMM.RPL.thereIsSomeNullPointer())
+            throw EImproperCall("RP null pointer in the FMM");
+
+        if(FMM.RPL.thereIsSomeRepeatedPointer())
+            throw EImproperCall("RP repeated pointer in the FMM");
+
+        //MAKE ACTIONS:
+
+        //build a clone of the FMM for restore its state at the end
+        TFiberMOSModel FMM_initial(&FMM);
+        FMM.RPL.setPurpose(pGenParPro);
+
+        //build the sampler
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        TCollisionFreeSampler CFS(&FMM.RPL);
+        chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+        append("Sampler built in "+floattostr_fixed(chrono::duration<double>(t1 - t0).count(), 4)+
+               " s, with "+inttostr(FMM.RPL.getCount())+" RPs in "+inttostr(CFS.getNcolors())+" classes.", log_path.c_str());
+
+        //randomize the configurations RP by RP
+        append("Randomizing "+inttostr(Nconfigs)+" configurations from seed "+inttostr(int(seed))+"...", log_path.c_str());
+        double time_RPs = 0;
+        int collided_RPs = 0;
+        for(int k=0; k<Nconfigs; k++) {
+            srand(seed + (unsigned int)k);
+            t0 = chrono::steady_clock::now();
+            FMM.RPL.randomizeWithoutCollision();
+            t1 = chrono::steady_clock::now();
+            time_RPs += chrono::duration<double>(t1 - t0).count();
+            if(FMM.RPL.thereIsCollision())
+                collided_RPs++;
+        }
+
+        //randomize the configurations by classes
+        const int Nmax = 1000;
+        double time_classes = 0;
+        int failed_classes = 0;
+        int collided_classes = 0;
+        for(int k=0; k<Nconfigs; k++) {
+            t0 = chrono::steady_clock::now();
+            bool ok = CFS.randomizeWithoutCollision(seed + (unsigned int)k, Nmax);
+            t1 = chrono::steady_clock::now();
+            time_classes += chrono::duration<double>(t1 - t0).count();
+            if(!ok)
+                failed_classes++;
+            else if(FMM.RPL.thereIsCollision())
+                collided_classes++;
+        }
+
+        //restore the initial state of the FMM
+        FMM.restoreState(FMM_initial);
+
+        //print the result
+        append("RP by RP:   "+floattostr_fixed(1000*time_RPs/Nconfigs, 4)+" ms per configuration, "+
+               inttostr(collided_RPs)+" configurations with collisions.", log_path.c_str());
+        append("By classes: "+floattostr_fixed(1000*time_classes/Nconfigs, 4)+" ms per configuration, "+
+               inttostr(failed_classes)+" configurations failed, "+
+               inttostr(collided_classes)+" configurations with collisions.", log_path.c_str());
+        if(failed_classes > 0)
+            append("A configuration fails when some RP collides with its placed adjacents in "+
+                   inttostr(Nmax)+" draws, and the RPs are left in their last draws.", log_path.c_str());
+        if(collided_RPs>0 || collided_classes>0)
+            throw EImpossibleError("there are configurations with collisions");
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "testing the collision free sampler: ");
+        throw;
+    }
+}
+
+//---------------------------------------------------------------------------
+//MAIN:
+
+//load the instance of the Fiber MOS Model from the directory of the
+//installation or, if not possible, from the directory of the compilation
+//(the same directories than the program fmpt_saa)
+void loadInstance(TFiberMOSModel& FMM, string& log_path)
+{
+    string FMM_dir1 = DATADIR;
+    FMM_dir1 += "/Models/MEGARA_FiberMOSModel_Instance";
+    string FMM_dir2 = getCurrentDir()+"/../data/Models/MEGARA_FiberMOSModel_Instance";
+    string dirs[2] = {FMM_dir1, FMM_dir2};
+
+    for(int i=0; i<2; i++) {
+        try {
+            append("\r\nLoading FMM Instance from directory '"+dirs[i]+"'.", log_path.c_str());
+            readInstanceFromDir(FMM, dirs[i]);
+            append("FMM Instance loaded.", log_path.c_str());
+            return;
+        }
+        catch(ECantComplete& E) {
+            append("Cant't complete action: "+E.Message.str, log_path.c_str());
+        }
+        catch(EImproperFileLoadedValue& E) {
+            append("Improper file loaded value: "+E.Message.str, log_path.c_str());
+        }
+        catch(Exception& E) {
+            E.Message.Insert(1, "loading instance: ");
+            throw;
+        }
+    }
+
+    throw EImproperCall("the Fiber MOS Model Instance can't be loaded");
+}
+
+int main(int argc, char *argv[])
+{
+    //configurates the locale information
+    setlocale(LC_ALL, "C");
+
+    //if the program is run without a known command
+    //print the help and finish the program
+    string command;
+    if(argc > 1)
+        command = string(argv[1]);
+    if(command != "testStepCost" &&
+            command != "testDistanceKernels" &&
+            command != "benchmarkGenerators" &&
+            command != "testCollisionFreeSampler") {
+        if(argc <= 1)
+            cout << "Missing command." << endl;
+        else if(command != "help")
+            cout << "Unknowledge command: "+command << endl;
+        cout << endl;
+        cout << help() << endl;
+        cout << endl;
+        return 0;
+    }
+
+    string log_path = "fmpt_bench.log";
+
+    try {
+        //initalize the log file
+        char mode[] = "w";
+        TTextFile TF(log_path.c_str(), mode);
+        TF.Close();
+
+        //indicates that the program is running
+        append("FMPT benchmarks "+string(PACKAGE_VERSION)+" are running...", log_path.c_str());
+
+        //print the arguments with you have called the program
+        append("\r\nArguments with you have called the program:", log_path.c_str());
+        for(int i=0; i<argc; i++)
+            append("    argv["+inttostr(i)+"]: "+string(argv[i]), log_path.c_str());
+
+        //load the FMM Instance
+        TFiberMOSModel FMM;
+        loadInstance(FMM, log_path);
+
+        //print a blank line for improve legibility
+        append("", log_path.c_str());
+
+        //execute the command
+        if(command == "testStepCost") {
+            //check the precondition
+            if(argc != 3)
+                throw EImproperArgument("command testStepCost should have 1 arguments: <outputs_path>");
+
+            //built a path from arg 1
+            string outputs_path(argv[2]);
+
+            //execute the test
+            testStepCost(FMM, outputs_path, log_path);
+        }
+        else if(command == "testDistanceKernels") {
+            //check the precondition
+            if(argc != 2)
+                throw EImproperArgument("command testDistanceKernels should have 0 arguments");
+
+            //execute the test
+            testDistanceKernels(FMM, log_path);
+        }
+        else if(command == "benchmarkGenerators") {
+            //check the precondition
+            if(argc!=3 && argc!=4)
+                throw EImproperArgument("command benchmarkGenerators should have 1 or 2 arguments: <Nconfigs> [<seed>]");
+
+            //get the number of configurations and the seed
+            int Nconfigs;
+            try {
+                Nconfigs = strToInt(argv[2]);
+            } catch(Exception& E) {
+                E.Message.Insert(1, "reading argument Nconfigs: ");
+                throw;
+            }
+            int seed = 1;
+            if(argc == 4) {
+                try {
+                    seed = strToInt(argv[3]);
+                } catch(Exception& E) {
+                    E.Message.Insert(1, "reading argument seed: ");
+                    throw;
+                }
+                if(seed < 0)
+                    throw EImproperArgument("seed should be nonnegative");
+            }
+
+            //execute the benchmark
+            benchmarkGenerators(FMM, Nconfigs, (unsigned int)seed, log_path);
+        }
+        else if(command == "testCollisionFreeSampler") {
+            //check the precondition
+            if(argc!=3 && argc!=4)
+                throw EImproperArgument("command testCollisionFreeSampler should have 1 or 2 arguments: <Nconfigs> [<seed>]");
+
+            //get the number of configurations and the seed
+            int Nconfigs;
+            try {
+                Nconfigs = strToInt(argv[2]);
+            } catch(Exception& E) {
+                E.Message.Insert(1, "reading argument Nconfigs: ");
+                throw;
+            }
+            int seed = 1;
+            if(argc == 4) {
+                try {
+                    seed = strToInt(argv[3]);
+                } catch(Exception& E) {
+                    E.Message.Insert(1, "reading argument seed: ");
+                    throw;
+                }
+                if(seed < 0)
+                    throw EImproperArgument("seed should be nonnegative");
+            }
+
+            //execute the test
+            testCollisionFreeSampler(FMM, Nconfigs, (unsigned int)seed, log_path);
+        }
+    }
+    catch(Exception &E) {
+        //indicates that has happened an exception
+        //and show the message of the exception
+        append("ERROR: "+E.Message.str, log_path.c_str());
+        return 1;
+    }
+    catch(...) {
+        //indicates that has happened an unknown exception
+        append("ERROR: unknown exception", log_path.c_str());
+        return 2;
+    }
+
+    //indicates that the program has been executed without error
+    return 0;
+}
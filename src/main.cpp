@@ -36,11 +36,20 @@
 #include "OutputsParkProg.h" //ParkProg
 #include "FileMethods.h"
 #include "roboticpositionertuner.h"
+#include "Profiler.h"
+#include "ClearanceTrace.h"
+#include "Workers.h"
 
 #include <clocale> //setlocale, LC_ALL
 #include <iostream> //std::cout, ios::fixed
 #include <stdio.h> //getchar
 #include <config.h> //PACKAGE_VERSION
+#include <thread> //std::thread
+#include <atomic> //std::atomic
+#include <chrono> //std::chrono::steady_clock
+#include <algorithm> //std::sort
+#include <fstream> //std::ifstream
+#include <exception> //std::exception
 
 //#include "tests/testFileMethods_copia.h"
 
@@ -51,13 +60,18 @@ using namespace Positioning;
 //---------------------------------------------------------------------------
 //GENERAL FUNCTIONS:
 
+//indicates if the events should be printed in the standard output,
+//besides in the log file
+bool echo = true;
+
 //print a text line in the standard output and in the log file
 void append(const string& str, const char *log_path)
 {
     string str_aux = str;
     str_aux += "\r\n";
 
-    std::cout << str_aux;
+    if(echo)
+        std::cout << str_aux;
 
     char mode[] = "a";
     TTextFile TF(log_path, mode);
@@ -68,8 +82,10 @@ void append(const string& str, const char *log_path)
 //print a text line in the standard output and in the log file
 void append_without_endl(const string& str, const char *log_path)
 {
-    std::cout << str;
-    std::cout.flush();
+    if(echo) {
+        std::cout << str;
+        std::cout.flush();
+    }
 
     char mode[] = "a";
     TTextFile TF(log_path, mode);
@@ -126,6 +142,20 @@ string help(void)
     str += "\r\n            the content of the input file type FMOSA,";
     str += "\r\n        Where <filename> is the name of the input file.";
     str += "\r\n";
+    str += "\r\n$ fmpt_saa generatePairPPDP_batch <FMOSA_dir | manifest_path> <Nworkers>";
+    str += "\r\n    Generate pairs (PP, DP) offline for a batch of files type FMOSA, processing them concurrently.";
+    str += "\r\n    <FMOSA_dir>: path to a directory containing the input files type FMOSA.";
+    str += "\r\n    <manifest_path>: path to a text file containing a path to an input file type FMOSA per line.";
+    str += "\r\n        Relative paths are relative to the directory of the manifest.";
+    str += "\r\n    <Nworkers>: number of workers, each of which has its own clone of the Fiber MOS Model.";
+    str += "\r\n        If it is zero, it will be taken the number of hardware threads.";
+    str += "\r\n    This command generates the same files than generatePairPPDP_offline for each input file,";
+    str += "\r\n    and the events of each input file are written in the file fmpt_saa_<stem>.log,";
+    str += "\r\n    where <stem> is the name of the input file without extension.";
+    str += "\r\n    The input files should have different stems.";
+    str += "\r\n    At the end, a summary table with the time and the validity of each pair is printed.";
+    str += "\r\n    The optional arguments of generatePairPPDP_offline can be added after <Nworkers>.";
+    str += "\r\n";
     str += "\r\nOnly offline generation function use files type FMOSA.";
     str += "\r\nIn the file type FMOSA:";
     str += "\r\n    The following parameters could be empty: Name, Mag, Pr, Bid and Comment.";
@@ -309,6 +339,23 @@ string help_others(void)
     str += "\r\n    Determine the minimun distance for each RP, with each of their adjacents,";
     str += "\r\n    when one of each pair is in the origin position.";
     str += "\r\n";
+    str += "\r\n$ fmpt_saa writeInstanceCache";
+    str += "\r\n    Write the binary cache of the Fiber MOS Model instance in the directory";
+    str += "\r\n    from where it was loaded. The following executions will load the instance";
+    str += "\r\n    from the cache, while the text files of the instance are not modified.";
+    str += "\r\n";
+    str += "\r\n$ fmpt_saa server";
+    str += "\r\n    Load the Fiber MOS Model instance once and serve jobs from the standard input.";
+    str += "\r\n    Each job is a line containing a command and its arguments, as in the command line.";
+    str += "\r\n    Only can be served the commands valuesSPM_EA, valuesSPM_RP, generateParkProg_offline,";
+    str += "\r\n    generatePairPPDP_offline, checkPairPPDP, validatePairPPDP, queryClearanceTrace";
+    str += "\r\n    and regeneratePairPPDP.";
+    str += "\r\n    The argument <FMOSA_path> can be '-', and then the FMOSA is read from the following";
+    str += "\r\n    lines until a line containing only a dot.";
+    str += "\r\n    The events of each job are printed between the lines \"BEGIN JOB <n>\" and";
+    str += "\r\n    \"END JOB <n> <OK | ERROR>\". The state of the Fiber MOS Model is restored";
+    str += "\r\n    before each job. Type 'quit' or close the standard input for finish.";
+    str += "\r\n";
     str += "\r\n$ fmpt_saa applyPCL <PCL_path>";
     str += "\r\n    Apply a positioner center list to the Fiber MOS Model instance.";
     str += "\r\n    The new added RPs are built by default.";
@@ -379,10 +426,19 @@ string help_others(void)
     str += "\r\n    Determine if all RPs included in the pair (PP, DP), are enabled.";
     str += "\r\n    The instance of the Fiber MOS Model will not be written.";
     str += "\r\n";
-    str += "\r\n$ fmpt_saa validatePairPPDP <outputs_path>";
+    str += "\r\n$ fmpt_saa validatePairPPDP <outputs_path> [trace]";
     str += "\r\n    Check if a pair (PP, DP) avoid collisions, when it is executed starting from the origin.";
     str += "\r\n    <outputs_path>: absolute or relative path to file type outputs,";
     str += "\r\n    containing the pair (PP, DP).";
+    str += "\r\n    [trace]: if is indicated, the clearance traces of the validations of the PP and";
+    str += "\r\n    the DP will be saved in binary files 'PairPPDP_PP-trace_from_<filename>.bin'";
+    str += "\r\n    and 'PairPPDP_DP-trace_from_<filename>.bin', including when they aren't valid.";
+    str += "\r\n";
+    str += "\r\n$ fmpt_saa queryClearanceTrace <trace_path> <Id> <IdA> [EA]";
+    str += "\r\n    Print the closest approach of the RP <Id> with the RP <IdA> (or the EA <IdA>";
+    str += "\r\n    when EA is indicated) in a clearance trace, and the gesture and the time when";
+    str += "\r\n    it happened. The closest approach is the minimun distance between the contours";
+    str += "\r\n    calculated during the validation, without simulate the MP again.";
     str += "\r\n";
     str += "\r\n$ fmpt_saa regeneratePairPPDP <PP_path> <DP_path> <FMOSA_path> [RPids]";
     str += "\r\n    Attempt regenerate a pair (PP, DP) in limited sense.";
@@ -394,7 +450,15 @@ string help_others(void)
     str += "\r\n    <DP_path>: absolute or relative path to file containing the DP.";
     str += "\r\n    <FMOSA_path>: absolute or relative path to file type FMOSA.";
     str += "\r\n    [RPids]: optional identifier list of RPs to be disabled.";
+    str += "\r\n    When RPs are excluded, the regenerated pair is validated again. If the files";
+    str += "\r\n    with the Dmin and the Dend of each MP are next to the MP (replacing '-MCS_from_'";
+    str += "\r\n    by '-Dmin_from_' and '-Dend_from_' in its name), only the gestures affected";
+    str += "\r\n    by the excluded RPs are simulated again.";
     str += "\r\n    The instance of the Fiber MOS Model will not be written in permant memory.";
+    str += "\r\n";
+    str += "\r\nWhen fmpt_saa is compiled with the counters enabled (configure --enable-profile),";
+    str += "\r\nafter each command the calls and time of the hot paths are written in JSON format";
+    str += "\r\nin the file 'fmpt_saa_profile.json' (or 'fmpt_saa_profile_job<n>.json' in server mode).";
 
     //Other diserable functionalities:
     //  - Determine the RPs included in a MP.
@@ -679,12 +743,14 @@ void applyPCL(TFiberMOSModel& FMM, string& path, string& log_path)
         //MAKE THE OPERATIONS:
 
         //assimilates the list in the Fiber MOS Model
+        TItemsList<TRoboticPositioner*> Changed;
         for(int i=0; i<PCL.getCount(); i++) {
             TPositionerCenter PC = PCL[i];
             int j = FMM.RPL.searchId(PC.Id);
             if(j < FMM.RPL.getCount()) {
                 TRoboticPositioner *RP = FMM.RPL[j];
                 RP->getActuator()->setP0(TDoublePoint(PC.x0, PC.y0));
+                Changed.Add(RP);
             } else {
                 int Id = FMM.RPL.searchFirstFreeId(1);
                 TDoublePoint P0;
@@ -692,9 +758,10 @@ void applyPCL(TFiberMOSModel& FMM, string& path, string& log_path)
                 P0.y = PC.y0;
                 TRoboticPositioner *RP = new TRoboticPositioner(Id, P0);
                 FMM.RPL.Add(RP);
+                Changed.Add(RP);
             }
         }
-        FMM.assimilate();
+        FMM.assimilate(Changed);
         append("Positioner Center List applied to the Fiber MOS Model.", log_path.c_str());
 
     } catch(Exception& E) {
@@ -991,7 +1058,10 @@ void applyTuning(TFiberMOSModel& FMM, const string& tuning_path, string& log_pat
         append("    theta_O3o: "+RP->getActuator()->gettheta_O3oText().str+" rad", log_path.c_str());
 
         //assimilate the new parameters
-        FMM.assimilate();
+        //only the adjacency of the tuned RP and its neighbours can change
+        TItemsList<TRoboticPositioner*> Changed;
+        Changed.Add(RP);
+        FMM.assimilate(Changed);
         append("\r\nNew tuning parameters assimilated.", log_path.c_str());
     }
     catch(Exception& E) {
@@ -2243,6 +2313,317 @@ bool generatePairPPDP_offline(TFiberMOSModel& FMM, const string& input_path, con
     }
 }
 
+//Get the options of generatePairPPDP_offline from the arguments of the command line.
+//Inputs:
+//  argc, argv: the arguments of the command line
+//  first: index of the first optional argument
+//Outputs:
+//  save...: indicates if the corresponding file should be saved
+void getSaveOptionsPairPPDP(bool& saveOPL, bool& saveOPL_S0, bool& saveOPL_S1,
+                            bool& saveIPL, bool& saveDispCorners1, bool& saveDispCorners2,
+                            bool& savePP_Dmin, bool& savePP_Dend, bool& saveDP_Dmin, bool& saveDP_Dend,
+                            bool& savePP_FMPT, bool& saveDP_FMPT, bool& savePP_MCS, bool& saveDP_MCS,
+                            bool& saveMCS, bool& save_outputs, bool& save_other_outputs,
+                            //-------------------------------------------------------------------------------------------------
+                            int argc, char *argv[], int first)
+{
+    bool saveAll=false;
+    saveOPL=false, saveOPL_S0=false, saveOPL_S1=false;
+    saveIPL=false, saveDispCorners1=false, saveDispCorners2=false;
+    savePP_Dmin=false, savePP_Dend=false, saveDP_Dmin=false, saveDP_Dend=false;
+    savePP_FMPT=false, saveDP_FMPT=false, savePP_MCS=false, saveDP_MCS=false;
+    saveMCS=false, save_outputs=false, save_other_outputs=false;
+    for(int i=first; i<argc; i++) {
+        string argument(argv[i]);
+        //------------------------------------
+        if(argument == "all")
+            saveAll = true;
+        //------------------------------------
+        else if(argument == "OPL")
+            saveOPL = true;
+        else if(argument == "OPL-S0")
+            saveOPL_S0 = true;
+        else if(argument == "OPL-S1")
+            saveOPL_S1 = true;
+        //------------------------------------
+        else if(argument == "IPL")
+            saveIPL = true;
+        else if(argument == "DispCorners1")
+            saveDispCorners1 = true;
+        else if(argument == "DispCorners2")
+            saveDispCorners2 = true;
+        //------------------------------------
+        else if(argument == "PP-Dmin")
+            savePP_Dmin = true;
+        else if(argument == "PP-Dend")
+            savePP_Dend = true;
+        else if(argument == "DP-Dmin")
+            saveDP_Dmin = true;
+        else if(argument == "DP-Dend")
+            saveDP_Dend = true;
+        //------------------------------------
+        else if(argument == "PP-FMPT")
+            savePP_FMPT = true;
+        else if(argument == "DP-FMPT")
+            saveDP_FMPT = true;
+        else if(argument == "PP-MCS")
+            savePP_MCS = true;
+        else if(argument == "DP-MCS")
+            saveDP_MCS = true;
+        //------------------------------------
+        else if(argument == "MCS")
+            saveMCS = true;
+        else if(argument == "outputs")
+            save_outputs = true;
+        else if(argument == "other-outputs")
+            save_other_outputs = true;
+        //------------------------------------
+        else
+            throw EImproperArgument("unknown argument: "+argument);
+    }
+
+    if(saveAll) {
+        saveOPL=true, saveOPL_S0=true, saveOPL_S1=true;
+        saveIPL=true, saveDispCorners1=true, saveDispCorners2=true;
+        savePP_Dmin=true, savePP_Dend=true, saveDP_Dmin=true, saveDP_Dend=true;
+        savePP_FMPT=true, saveDP_FMPT=true, savePP_MCS=true, saveDP_MCS=true;
+        saveMCS=true, save_outputs=true, save_other_outputs=true;
+    }
+}
+
+//Get the paths of the files type FMOSA of a batch.
+//Inputs:
+//  path: path to a directory containing the files type FMOSA,
+//      or path to a manifest file containing a path to a file type FMOSA per line
+//      (empty lines and text from '#' to the end of the line are ignored)
+//Outputs:
+//  input_paths: the absolute paths of the files type FMOSA,
+//      sorted by name in the case of a directory,
+//      and in the order of the manifest in the case of a manifest
+void getBatchPaths(vector<string>& input_paths, const string& path)
+{
+    try {
+        input_paths.clear();
+
+        //complete the relative path, if any
+        string path_ = path;
+        if(path_.length()>0 && path_[0] != '/')
+            path_.insert(0, getCurrentDir()+"/");
+
+        //if the path is a directory, take all regular files of the directory
+        if(isdir(path_)) {
+            TStringList Names;
+            ReadDir(&Names, AnsiString(path_));
+            for(int i=0; i<Names.getCount(); i++) {
+                string name = Names.Strings[i].str;
+                if(name.length()<=0 || name[0]=='.')
+                    continue;
+                string input_path = path_+"/"+name;
+                if(!isdir(input_path))
+                    input_paths.push_back(input_path);
+            }
+            sort(input_paths.begin(), input_paths.end());
+        }
+        //else, the path is a manifest
+        else {
+            string str;
+            strReadFromFile(str, path_);
+            string dir, filename;
+            splitpath(dir, filename, path_);
+
+            unsigned int i = 0;
+            while(i < str.length()) {
+                //read the line
+                string line;
+                while(i<str.length() && str[i]!='\n')
+                    line += str[i++];
+                i++;
+
+                //add the path, if any, removing the comments
+                size_t j = line.find('#');
+                if(j != string::npos)
+                    line.erase(j);
+                line = strTrim(line);
+                if(line.length() <= 0)
+                    continue;
+                if(line[0] != '/')
+                    line.insert(0, dir+"/");
+                input_paths.push_back(line);
+            }
+        }
+
+        if(input_paths.size() <= 0)
+            throw EImproperArgument("there aren't files type FMOSA in '"+path+"'");
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "getting the paths of the batch: ");
+        throw;
+    }
+}
+
+//Generate pairs (PP, DP) offline for a batch of files type FMOSA.
+//Inputs:
+//  FMM: the Fiber MOS Model
+//  input_paths: paths of the input files type FMOSA
+//  Nworkers: number of workers (if zero, the number of hardware threads)
+//  output_dir: path to the output dir where save the output files
+//  log_path: file name of the log file where anotate the summary
+//  save...: the same options of generatePairPPDP_offline
+//Outputs:
+//  generatePairPPDP_batch: number of suitable pairs (PP, DP)
+//Each worker has its own clone of the FMM, whose state is restored from
+//the FMM before process each input file, so the output files and the events
+//of each input file are the same as in generatePairPPDP_offline.
+//The events of each input file are written in the file
+//output_dir/fmpt_saa_<stem>.log, instead of the log file,
+//so the input files shall have different stems.
+int generatePairPPDP_batch(TFiberMOSModel& FMM, const vector<string>& input_paths, int Nworkers,
+                           const string& output_dir, const string& log_path,
+                           //-------------------------------------------------------------------------------------------------
+                           bool saveOPL, bool saveOPL_S0, bool saveOPL_S1,
+                           bool saveIPL, bool saveDispCorners1, bool saveDispCorners2,
+                           bool savePP_Dmin, bool savePP_Dend, bool saveDP_Dmin, bool saveDP_Dend,
+                           bool savePP_FMPT, bool saveDP_FMPT, bool savePP_MCS, bool saveDP_MCS,
+                           bool saveMCS, bool saveOutputs, bool saveOtherOutputs)
+{
+    //check the preconditions
+    if(Nworkers < 0)
+        throw EImproperArgument("number of workers Nworkers should be nonnegative");
+
+    int N = int(input_paths.size());
+
+    //get the stems of the names of the input files
+    vector<string> stems(N);
+    for(int i=0; i<N; i++) {
+        string dir, filename;
+        splitpath(dir, filename, input_paths[i]);
+        stems[i] = stem(filename);
+    }
+
+    //the log file and the output files of each input file are named
+    //from the name of the input file, so the stems shall be different
+    vector<string> sorted_stems(stems);
+    sort(sorted_stems.begin(), sorted_stems.end());
+    vector<string>::iterator it = adjacent_find(sorted_stems.begin(), sorted_stems.end());
+    if(it != sorted_stems.end())
+        throw EImproperArgument("input files should have different names, but there are several files named \""+*it+"\"");
+
+    //determines the number of workers
+    //(the parallel loops of each worker are executed sequentially,
+    //so there are not more threads than workers)
+    Nworkers = Workers::getNworkers(Nworkers, N);
+
+    //build the paths of the log files of each input file
+    vector<string> log_paths(N);
+    for(int i=0; i<N; i++)
+        log_paths[i] = output_dir+"/fmpt_saa_"+stems[i]+".log";
+
+    //build a clone of the FMM for each worker
+    append("Building "+inttostr(Nworkers)+" clones of the FMM...", log_path.c_str());
+    vector<TFiberMOSModel*> clones;
+    try {
+        for(int w=0; w<Nworkers; w++) {
+            clones.push_back(new TFiberMOSModel(&FMM));
+            clones.back()->assimilate();
+        }
+    }
+    catch(...) {
+        for(unsigned int w=0; w<clones.size(); w++)
+            delete clones[w];
+        throw;
+    }
+
+    //results of each input file
+    vector<int> suitables(N, 0);
+    vector<string> errors(N);
+    vector<double> dts(N, 0);
+
+    //process the input files
+    append("Generating "+inttostr(N)+" pairs (PP, DP) with "+inttostr(Nworkers)+" workers...", log_path.c_str());
+    atomic<int> next(0);
+    auto work = [&](TFiberMOSModel *FMM_) {
+        int i;
+        while((i = next++) < N) {
+            chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+            try {
+                //initialize the log file of the input file
+                char mode[] = "w";
+                TTextFile TF(log_paths[i].c_str(), mode);
+                TF.Close();
+
+                //restore the state of the clone and generate the pair (PP, DP)
+                FMM_->restoreState(FMM);
+                suitables[i] = generatePairPPDP_offline(*FMM_, input_paths[i], output_dir, log_paths[i],
+                                                        //------------------------------------------------------------
+                                                        saveOPL, saveOPL_S0, saveOPL_S1,
+                                                        saveIPL, saveDispCorners1, saveDispCorners2,
+                                                        savePP_Dmin, savePP_Dend, saveDP_Dmin, saveDP_Dend,
+                                                        savePP_FMPT, saveDP_FMPT, savePP_MCS, saveDP_MCS,
+                                                        saveMCS, saveOutputs, saveOtherOutputs);
+            }
+            catch(Exception& E) {
+                errors[i] = E.Message.str;
+            }
+            catch(...) {
+                errors[i] = "unknown exception";
+            }
+            chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+            dts[i] = chrono::duration<double>(t1 - t0).count();
+        }
+    };
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    echo = false;
+    if(Nworkers <= 1)
+        work(clones[0]);
+    else {
+        vector<thread> workers;
+        for(int w=0; w<Nworkers; w++)
+            workers.push_back(thread([&](TFiberMOSModel *FMM_) {
+                Workers::setWorker(true);
+                work(FMM_);
+            }, clones[w]));
+        for(unsigned int w=0; w<workers.size(); w++)
+            workers[w].join();
+    }
+    echo = true;
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    //destroy the clones
+    for(unsigned int w=0; w<clones.size(); w++)
+        delete clones[w];
+
+    //write the errors in the log files of the input files
+    echo = false;
+    for(int i=0; i<N; i++)
+        if(errors[i].length() > 0)
+            append("ERROR: "+errors[i], log_paths[i].c_str());
+    echo = true;
+
+    //print the summary table
+    int Nsuitables = 0;
+    append("", log_path.c_str());
+    append("FMOSA\ttime (s)\tvalidity\tlog", log_path.c_str());
+    for(int i=0; i<N; i++) {
+        string dir, filename;
+        splitpath(dir, filename, input_paths[i]);
+        string validity;
+        if(errors[i].length() > 0)
+            validity = "error: "+errors[i];
+        else if(suitables[i]) {
+            validity = "suitable";
+            Nsuitables++;
+        }
+        else
+            validity = "not suitable";
+        append(filename+"\t"+floattostr_fixed(dts[i], 3)+"\t"+validity+"\t"+log_paths[i], log_path.c_str());
+    }
+    append("", log_path.c_str());
+    append("Suitable pairs (PP, DP): "+inttostr(Nsuitables)+" of "+inttostr(N)+".", log_path.c_str());
+    append("Total time: "+floattostr_fixed(chrono::duration<double>(t1 - t0).count(), 3)+" s.", log_path.c_str());
+
+    return Nsuitables;
+}
+
 //Test the function generatePairPPDP_offline.
 void test_generatePairPPDP_offline(TFiberMOSModel& FMM, string& log_path)
 {
@@ -2741,9 +3122,23 @@ void checkPairPPDP(TFiberMOSModel& FMM, string& PP_path, string& DP_path, string
     }
 }
 
+//save the clearance trace of a validation in a binary file
+void saveClearanceTrace(const TClearanceProfileList& CPL, const string& output_path,
+                        string& log_path)
+{
+    TClearanceTrace CT;
+    CT.build(CPL);
+    CT.writeToFile(output_path);
+    append("Clearance trace ("+inttostr(CT.getCount())+" profiles, "+
+           inttostr(int(CT.getBytes().length()))+" bytes) saved in file '"+output_path+"'.", log_path.c_str());
+}
+
 //Check if a pair (PP, DP) avoid collisions,
 //wehn it is executed starting from the origin.
-void validatePairPPDP(TFiberMOSModel& FMM, string& outputs_path, string output_dir, string& log_path)
+//When trace is true, the clearance traces of the validations
+//are saved in binary files, including when the MP is not valid.
+void validatePairPPDP(TFiberMOSModel& FMM, string& outputs_path, string output_dir, string& log_path,
+                      bool trace=false)
 {
     try {
         //LOAD SETTINGS FROM FILES:
@@ -2780,7 +3175,12 @@ void validatePairPPDP(TFiberMOSModel& FMM, string& outputs_path, string output_d
         //configure the SPM of all RPs for validate the PP and validate it
         FMM.RPL.setPurpose(pValPP);
         append("FMM configured for validate a PP. (Purpose = ValPP).", log_path.c_str());
-        bool PPvalid = MPV.validateMotionProgram(outputs.PP);
+        TClearanceProfileList CPL;
+        bool PPvalid = MPV.validateMotionProgram(outputs.PP, trace ? &CPL : NULL);
+
+        //save the clearance trace of the PP, if any
+        if(trace)
+            saveClearanceTrace(CPL, output_dir+"/PairPPDP_PP-trace_from_"+filename+".bin", log_path);
 
         //initalize the flags for indicate the validity of the DP
         bool DPvalid = false;
@@ -2846,7 +3246,11 @@ void validatePairPPDP(TFiberMOSModel& FMM, string& outputs_path, string output_d
             //configure the SPM for validate the PP and validate it
             FMM.RPL.setPurpose(pValDP);
             append("FMM configured for validate a DP. (Purpose = ValDP).", log_path.c_str());
-            DPvalid = MPV.validateMotionProgram(outputs.DP);
+            DPvalid = MPV.validateMotionProgram(outputs.DP, trace ? &CPL : NULL);
+
+            //save the clearance trace of the DP, if any
+            if(trace)
+                saveClearanceTrace(CPL, output_dir+"/PairPPDP_DP-trace_from_"+filename+".bin", log_path);
 
             //SAVE THE OUTPUTS AND PRINT THE CORRESPONDING MESSAGES:
 
@@ -2993,6 +3397,56 @@ void validatePairPPDP(TFiberMOSModel& FMM, string& outputs_path, string output_d
 
 //Attempt regenerate a pair (PP, DP).
 //The instance of the Fiber MOS Model will not be written.
+//Read the record of the validation of a MP in format MCS,
+//from the files MP-Dmin and MP-Dend saved next to it.
+//The files are searched replacing "-MCS_from_" by "-Dmin_from_"
+//and "-Dend_from_" in the name of the file of the MP.
+//Returns false if the files don't exist.
+bool readValidationRecord(TValidationRecord& VR, TMotionProgram& MP,
+                          const string& MP_path, const string& log_path)
+{
+    //build the paths of the files MP-Dmin and MP-Dend
+    string dir, filename;
+    splitpath(dir, filename, MP_path);
+    size_t i = filename.rfind("-MCS_from_");
+    if(i == string::npos)
+        return false;
+    string Dmin_path = dir+"/"+filename.substr(0, i)+"-Dmin_from_"+filename.substr(i + 10);
+    string Dend_path = dir+"/"+filename.substr(0, i)+"-Dend_from_"+filename.substr(i + 10);
+    if(!ifstream(Dmin_path.c_str()) || !ifstream(Dend_path.c_str()))
+        return false;
+
+    //set the comments of the MIs and build the record from them
+    string str;
+    strReadFromFileWithComments(str, Dmin_path);
+    MP.setDminMCStext(str);
+    strReadFromFileWithComments(str, Dend_path);
+    MP.setDendMCStext(str);
+    VR.setComments(MP);
+    append("Record of the validation read from files '"+Dmin_path+"' and '"+Dend_path+"'.", log_path.c_str());
+    return true;
+}
+
+//revalidate a MP after excluding RPs, simulating only the gestures
+//affected by the excluded RPs when there is a record of its validation
+bool revalidateExcluding(TMotionProgramValidator& MPV, TMotionProgram& MP,
+                         TValidationRecord& VR, bool recorded,
+                         const TVector<int>& Excluded, const string& MP_label,
+                         const string& log_path)
+{
+    bool valid;
+    if(recorded) {
+        valid = MPV.revalidateMotionProgram(MP, VR, Excluded);
+        append("The regenerated "+MP_label+" has been revalidated simulating "+
+               inttostr(VR.Nsimulated)+" of "+inttostr(int(VR.Gestures.size()))+" gestures.", log_path.c_str());
+    }
+    else {
+        valid = MPV.validateMotionProgram(MP);
+        append("The regenerated "+MP_label+" has been validated simulating all gestures.", log_path.c_str());
+    }
+    return valid;
+}
+
 void regeneratePairPPDP_offline(TFiberMOSModel& FMM, string& PP_path, string& DP_path, string& FMOSA_path, string& log_path)
 {
     try {
@@ -3084,10 +3538,30 @@ void regeneratePairPPDP_offline(TFiberMOSModel& FMM, string& PP_path, string& DP
 
         //The OPL is useful to get the DP in the interface format.
 
+        //read the records of the validations of the pair (PP, DP), if any
+        TValidationRecord PP_VR, DP_VR;
+        bool PP_recorded = readValidationRecord(PP_VR, PP, PP_path, log_path);
+        bool DP_recorded = readValidationRecord(DP_VR, DP, DP_path, log_path);
+
         //attempt regenerate the pair (PP, DP)
         TVector<int> Excluded;
         bool regenerated = MPG.attemptRegenerate(Excluded, PP, DP);
 
+        //revalidate the regenerated pair (PP, DP) from the initial positions,
+        //simulating only the gestures affected by the excluded RPs
+        if(regenerated && Excluded.getCount() > 0) {
+            FMM.RPL.setPositions(IPL);
+            FMM.RPL.setPurpose(pValPP);
+            regenerated = revalidateExcluding(MPG, PP, PP_VR, PP_recorded, Excluded, "PP", log_path);
+            if(regenerated) {
+                FMM.RPL.setPurpose(pValDP);
+                regenerated = revalidateExcluding(MPG, DP, DP_VR, DP_recorded, Excluded, "DP", log_path);
+            }
+            if(!regenerated)
+                FMM.RPL.restoreAndPopQuantifys();
+            FMM.RPL.setPositions(OPL);
+        }
+
         string output_path;
 
         //print the result
@@ -3107,6 +3581,27 @@ void regeneratePairPPDP_offline(TFiberMOSModel& FMM, string& PP_path, string& DP
             output_path = "PairPPDP_regenerated-DP-MCS_from_"+filename;
             strWriteToFile(output_path, aux + "\r\n" + str);
             append("Regenerated DP in format MCS saved in file '"+output_path+"'.", log_path.c_str());
+
+            //save the comments (Dmin, Dend) of the regenerated pair (PP, DP),
+            //which allow revalidate it without simulate all gestures
+            if(Excluded.getCount() > 0) {
+                PP.getDminMCStext(str, "pos", PP_Bid);
+                output_path = "PairPPDP_regenerated-PP-Dmin_from_"+filename;
+                strWriteToFile(output_path, str);
+                append("Regenerated PP-Dmin saved in file '"+output_path+"'.", log_path.c_str());
+                PP.getDendMCStext(str, "pos", PP_Bid);
+                output_path = "PairPPDP_regenerated-PP-Dend_from_"+filename;
+                strWriteToFile(output_path, str);
+                append("Regenerated PP-Dend saved in file '"+output_path+"'.", log_path.c_str());
+                DP.getDminMCStext(str, "depos", DP_Bid);
+                output_path = "PairPPDP_regenerated-DP-Dmin_from_"+filename;
+                strWriteToFile(output_path, str);
+                append("Regenerated DP-Dmin saved in file '"+output_path+"'.", log_path.c_str());
+                DP.getDendMCStext(str, "depos", DP_Bid);
+                output_path = "PairPPDP_regenerated-DP-Dend_from_"+filename;
+                strWriteToFile(output_path, str);
+                append("Regenerated DP-Dend saved in file '"+output_path+"'.", log_path.c_str());
+            }
         }
         else
             append("The pair (PP, DP) can not be regenerated.", log_path.c_str());
@@ -3117,6 +3612,755 @@ void regeneratePairPPDP_offline(TFiberMOSModel& FMM, string& PP_path, string& DP
     }
 }
 
+//execute a command on a loaded Fiber MOS Model
+//and write the events in the log file
+void executeCommand(TFiberMOSModel& FMM, const string& FMM_dir,
+                    int argc, char *argv[], string& log_path)
+{
+    //build a command string
+    string command(argv[1]);
+
+    //-------------------------------------------------------------------
+    if(command == "valuesSPM_EA") {
+        //check the precondition
+        if(argc != 3)
+            throw EImproperArgument("command valuesSPM_EA sould have 1 arguments: <Id>");
+
+        //built a string from arg 1 (<Id>)
+        string str(argv[2]);
+
+        //convert the argument to int
+        int Id = strToInt(str);
+
+        //search the EA
+        int i = FMM.EAL.searchId(Id);
+        if(i >= FMM.EAL.getCount())
+            throw EImpossibleError("there isn't a EA with Id = "+inttostr(Id)+": ");
+        TExclusionArea *EA = FMM.EAL[i];
+
+        //print the SPM values
+        append("The EA"+EA->getIdText().str+" has been found in the FMM, and their SPM values are:", log_path.c_str());
+        append(StrIndent(EA->getSecurityText()).str, log_path.c_str());
+        append("\r\nFor learn about the calculus of SPM values, see the file: '/usr/local/share/megara-fmpt/Models/Calculus_of_SPM.txt'", log_path.c_str());
+    }
+    else if(command == "valuesSPM_RP") {
+        //check the precondition
+        if(argc != 3)
+            throw EImproperArgument("command valuesSPM_RP sould have 1 arguments: <Id>");
+
+        //built a string from arg 1 (<Id>)
+        string str(argv[2]);
+
+        //convert the argument to int
+        int Id = strToInt(str);
+
+        //search the RP
+        int i = FMM.RPL.searchId(Id);
+        if(i >= FMM.RPL.getCount())
+            throw EImpossibleError("there isn't a RP with Id = "+inttostr(Id)+": ");
+        TRoboticPositioner *RP = FMM.RPL[i];
+
+        //print the SPM values
+        append("The RP"+RP->getActuator()->getIdText().str+" has been found in the FMM, and their SPM values are:", log_path.c_str());
+        append(StrIndent(RP->getActuator()->getSecurityText()).str, log_path.c_str());
+        append("\r\nFor learn about the calculus of SPM values, see the file: '/usr/local/share/megara-fmpt/Models/Calculus_of_SPM.txt'", log_path.c_str());
+    }
+    else if(command == "testRadialMotion") {
+        //check the precondition
+        if(argc != 2)
+            throw EImproperArgument("command testRadialMotion should have 0 arguments");
+
+        //execute the test
+        testRadialMotion(FMM, log_path);
+    }
+    else if(command == "testDistanceMin") {
+        //check the precondition
+        if(argc != 2)
+            throw EImproperArgument("command testDistanceMin should have 0 arguments");
+
+        //execute the test
+        testDistanceMin(FMM, log_path);
+    }
+    else if(command == "writeInstanceCache") {
+        //check the precondition
+        if(argc != 2)
+            throw EImproperArgument("command writeInstanceCache should have 0 arguments");
+
+        //write the binary cache of the instance of the Fiber MOS Model where was loaded
+        writeInstanceCacheToDir(FMM_dir, FMM);
+        append("Fiber MOS Model instance cache saved in directory '"+FMM_dir+"'.", log_path.c_str());
+    }
+    //-------------------------------------------------------------------
+    else if(command == "applyPCL") {
+        //check the precondition
+        if(argc != 3)
+            throw EImproperArgument("command applyPCL sould have 1 arguments: <PCL_path>");
+
+        //built a path from arg 1
+        string PCL_path(argv[2]);
+
+        //make a rutinary check
+        if(PCL_path.length() <= 0)
+            throw EImpossibleError("lateral effect");
+
+        //complete the relative path, if any
+        if(PCL_path[0] != '/')
+            PCL_path.insert(0, getCurrentDir()+"/");
+
+        //apply the positioner center list to the Fiber MOS Model Instance
+        applyPCL(FMM, PCL_path, log_path);
+
+        //save the instance of the Fiber MOS Model from where was loaded
+        writeInstanceToDir(FMM_dir, FMM);
+        append("Fiber MOS Model instance saved in directory '"+FMM_dir+"'.", log_path.c_str());
+    }
+    else if(command == "applyRPI") {
+        //check the precondition
+        if(argc != 3)
+            throw EImproperArgument("command applyRPI sould have 1 arguments: <RPI_dir>");
+
+        //built a path from arg 1
+        string RPI_dir(argv[2]);
+
+        //make a rutinary check
+        if(RPI_dir.length() <= 0)
+            throw EImpossibleError("lateral effect");
+
+        //complete the relative path, if any
+        if(RPI_dir[0] != '/')
+            RPI_dir.insert(0, getCurrentDir()+"/");
+
+        //apply the RP Instance for all RPs of the Fiber MOS Model Instance
+        applyRPI(FMM, RPI_dir, log_path);
+
+        //save the instance of the Fiber MOS Model from where was loaded
+        writeInstanceToDir(FMM_dir, FMM);
+        append("Fiber MOS Model instance saved in directory '"+FMM_dir+"'.", log_path.c_str());
+    }
+    else if(command == "evaluateErrors") {
+        //check the precondition
+        if(argc != 3)
+            throw EImproperArgument("command evaluateErrors sould have 1 arguments: <measures_path>");
+
+        //built a path from arg 1
+        string measures_path(argv[2]);
+
+        //make a rutinary check
+        if(measures_path.length() <= 0)
+            throw EImpossibleError("lateral effect");
+
+        //complete the relative path, if any
+        if(measures_path[0] != '/')
+            measures_path.insert(0, getCurrentDir()+"/");
+
+        //call the function
+        evaluateErrors(FMM, measures_path, ".", log_path);
+    }
+    else if(command == "tuneRP") {
+        //check the precondition
+        if(argc != 5)
+            throw EImproperArgument("command tuneRP sould have 3 arguments: <measures_path> <errors_path> <positions>");
+
+        //built a path from args 1 and 2
+        string measures_path(argv[2]);
+        string errors_path(argv[3]);
+
+        //make a rutinary check
+        if(measures_path.length() <= 0)
+            throw EImpossibleError("lateral effect");
+        if(errors_path.length() <= 0)
+            throw EImpossibleError("lateral effect");
+
+        //complete the relative paths, if any
+        if(measures_path[0] != '/')
+            measures_path.insert(0, getCurrentDir()+"/");
+        if(errors_path[0] != '/')
+            errors_path.insert(0, getCurrentDir()+"/");
+
+        int positions;
+        try {
+            //convert to int the arg 3
+            string positions_str(argv[4]);
+            positions = strToInt(positions_str);
+        }
+        catch(Exception& E) {
+            E.Message.Insert(1, "number of positions (positions) should be an integer upper zero");
+            throw;
+        }
+
+        //call the function
+        tuneRP(FMM, measures_path, errors_path, positions, ".", log_path);
+    }
+    else if(command == "applyTuning") {
+        //check the precondition
+        if(argc != 3)
+            throw EImproperArgument("command applyTuning sould have 1 arguments: <tuning_path>");
+
+        //built a path from arg 1
+        string tuning_path(argv[2]);
+
+        //make a rutinary check
+        if(tuning_path.length() <= 0)
+            throw EImpossibleError("lateral effect");
+
+        //complete the relative path, if any
+        if(tuning_path[0] != '/')
+            tuning_path.insert(0, getCurrentDir()+"/");
+
+        //call the function
+        applyTuning(FMM, tuning_path, log_path);
+
+        //save the instance of the Fiber MOS Model from where was loaded
+        writeInstanceToDir(FMM_dir, FMM);
+        append("Fiber MOS Model instance saved in directory '"+FMM_dir+"'.", log_path.c_str());
+    }
+    else if(command == "PPA_to_CC-S0") {
+        //check the precondition
+        if(argc != 3)
+            throw EImproperArgument("command PPA_to_CC-S0 sould have 1 arguments: <PPAL_path>");
+
+        //built a path from arg 1
+        string PPAL_path(argv[2]);
+
+        //make a rutinary check
+        if(PPAL_path.length() <= 0)
+            throw EImpossibleError("lateral effect");
+
+        //complete the relative path, if any
+        if(PPAL_path[0] != '/')
+            PPAL_path.insert(0, getCurrentDir()+"/");
+
+        //call the function
+        PPA_to_CC_S0(FMM, PPAL_path, ".", log_path);
+    }
+    //-------------------------------------------------------------------
+    else if(command == "generateParkProg_offline") {
+        //check the precondition
+        if(argc < 3)
+            throw EImproperArgument("command generateParkProg_offline sould have almost 1 argument: <FMOSA_path>");
+
+        //build a string for the argument 1
+        string arg1(argv[2]);
+
+        //argument 1 can be:
+        //  command help ("help")
+        //  <FMOSA_path>
+
+        //make a rutinary check
+        if(arg1.length() <= 0)
+            throw EImpossibleError("lateral effect");
+
+        //reacts according the comands without log file
+        if(arg1 == "help") {
+            //print the help
+            cout << help_generateParkProg_offline() << endl;
+            cout << endl;
+            //indicates that the program has been executed without error
+            return;
+        }
+
+        //complete the relative path, if any
+        if(arg1[0] != '/')
+            arg1.insert(0, getCurrentDir()+"/");
+
+        bool saveAll=false;
+        bool saveSPL=false, saveFPL=false;
+        bool saveDmin=false, saveDend=false;
+        bool saveDispCorners1=false, saveDispCorners2=false;
+        bool saveFMPT=false, saveMCS=false;
+        bool saveOutputs=false, saveOtherOutputs=false;
+        for(int i=3; i<argc; i++) {
+            string argument(argv[i]);
+            //------------------------------------
+            if(argument == "all")
+                saveAll = true;
+            //------------------------------------
+            else if(argument == "SPL")
+                saveSPL = true;
+            else if(argument == "FPL")
+                saveFPL = true;
+            //------------------------------------
+            else if(argument == "Dmin")
+                saveDmin = true;
+            else if(argument == "Dend")
+                saveDend = true;
+            else if(argument == "DispCorners1")
+                saveDispCorners1 = true;
+            else if(argument == "DispCorners2")
+                saveDispCorners2 = true;
+            //------------------------------------
+            else if(argument == "FMPT")
+                saveFMPT = true;
+            else if(argument == "MCS")
+                saveMCS = true;
+            else if(argument == "outputs")
+                saveOutputs = true;
+            else if(argument == "other-outputs")
+                saveOtherOutputs = true;
+            //------------------------------------
+            else
+                throw EImproperArgument("unknown argument: "+argument);
+        }
+
+        if(saveAll) {
+            saveSPL=true, saveFPL=true;
+            saveDmin=true, saveDend=true;
+            saveDispCorners1=true, saveDispCorners2=true;
+            saveFMPT=true, saveMCS=true;
+            saveOutputs=true, saveOtherOutputs=true;
+        }
+
+        //generate a DP from a path and write the events in the log file
+        generateParkProg_offline(FMM, arg1, ".", log_path,
+                                 //--------------------------------------------
+                                 saveSPL, saveFPL,
+                                 saveDmin, saveDend,
+                                 saveDispCorners1, saveDispCorners2,
+                                 saveFMPT, saveMCS,
+                                 saveOutputs, saveOtherOutputs);
+    }
+    else if(command == "test_generateParkProg_offline") {
+        //check the precondition
+        if(argc != 2)
+            throw EImproperArgument("command test_generateParkProg_offline should have 0 arguments");
+
+        //execute the test
+        test_generateParkProg_offline(FMM, log_path);
+    }
+    else if(command == "test_generateParkProg_online") {
+        //check the precondition
+        if(argc != 2)
+            throw EImproperArgument("command test_generateParkProg_online should have 0 arguments");
+
+        //execute the test
+        test_generateParkProg_online(FMM, log_path);
+    }
+    else if(command == "generatePairPPDP_offline") {
+        //check the precondition
+        if(argc < 3)
+            throw EImproperArgument("command generatePairPPDP_offline sould have almost 1 argument: <FMOSA_path>");
+
+        //build a string for the argument 1
+        string arg1(argv[2]);
+
+        //argument 1 can be:
+        //  command help ("help")
+        //  <FMOSA_path>
+
+        //make a rutinary check
+        if(arg1.length() <= 0)
+            throw EImpossibleError("lateral effect");
+
+        //reacts according the comands without log file
+        if(arg1 == "help") {
+            //print the help
+            cout << help_generatePairPPDP_offline() << endl;
+            cout << endl;
+            //indicates that the program has been executed without error
+            return;
+        }
+
+        //complete the relative path, if any
+        if(arg1[0] != '/')
+            arg1.insert(0, getCurrentDir()+"/");
+
+        bool saveOPL, saveOPL_S0, saveOPL_S1;
+        bool saveIPL, saveDispCorners1, saveDispCorners2;
+        bool savePP_Dmin, savePP_Dend, saveDP_Dmin, saveDP_Dend;
+        bool savePP_FMPT, saveDP_FMPT, savePP_MCS, saveDP_MCS;
+        bool saveMCS, save_outputs, save_other_outputs;
+        getSaveOptionsPairPPDP(saveOPL, saveOPL_S0, saveOPL_S1,
+                               saveIPL, saveDispCorners1, saveDispCorners2,
+                               savePP_Dmin, savePP_Dend, saveDP_Dmin, saveDP_Dend,
+                               savePP_FMPT, saveDP_FMPT, savePP_MCS, saveDP_MCS,
+                               saveMCS, save_outputs, save_other_outputs,
+                               //------------------------------------------------------------
+                               argc, argv, 3);
+
+        //generate a pair (PP, DP) from a path and write the events in the log file
+        generatePairPPDP_offline(FMM, arg1, ".", log_path,
+                                 //------------------------------------------------------------
+                                 saveOPL, saveOPL_S0, saveOPL_S1,
+                                 saveIPL, saveDispCorners1, saveDispCorners2,
+                                 savePP_Dmin, savePP_Dend, saveDP_Dmin, saveDP_Dend,
+                                 savePP_FMPT, saveDP_FMPT, savePP_MCS, saveDP_MCS,
+                                 saveMCS, save_outputs, save_other_outputs);
+    }
+    else if(command == "generatePairPPDP_batch") {
+        //check the precondition
+        if(argc < 4)
+            throw EImproperArgument("command generatePairPPDP_batch sould have almost 2 arguments: <FMOSA_dir | manifest_path> <Nworkers>");
+
+        //get the paths of the input files
+        vector<string> input_paths;
+        getBatchPaths(input_paths, string(argv[2]));
+
+        //get the number of workers
+        int Nworkers = strToInt(string(argv[3]));
+
+        //get the options
+        bool saveOPL, saveOPL_S0, saveOPL_S1;
+        bool saveIPL, saveDispCorners1, saveDispCorners2;
+        bool savePP_Dmin, savePP_Dend, saveDP_Dmin, saveDP_Dend;
+        bool savePP_FMPT, saveDP_FMPT, savePP_MCS, saveDP_MCS;
+        bool saveMCS, save_outputs, save_other_outputs;
+        getSaveOptionsPairPPDP(saveOPL, saveOPL_S0, saveOPL_S1,
+                               saveIPL, saveDispCorners1, saveDispCorners2,
+                               savePP_Dmin, savePP_Dend, saveDP_Dmin, saveDP_Dend,
+                               savePP_FMPT, saveDP_FMPT, savePP_MCS, saveDP_MCS,
+                               saveMCS, save_outputs, save_other_outputs,
+                               //------------------------------------------------------------
+                               argc, argv, 4);
+
+        //generate the pairs (PP, DP) and write the summary in the log file
+        generatePairPPDP_batch(FMM, input_paths, Nworkers, ".", log_path,
+                               //------------------------------------------------------------
+                               saveOPL, saveOPL_S0, saveOPL_S1,
+                               saveIPL, saveDispCorners1, saveDispCorners2,
+                               savePP_Dmin, savePP_Dend, saveDP_Dmin, saveDP_Dend,
+                               savePP_FMPT, saveDP_FMPT, savePP_MCS, saveDP_MCS,
+                               saveMCS, save_outputs, save_other_outputs);
+    }
+    else if(command == "test_generatePairPPDP_offline") {
+        //check the precondition
+        if(argc != 2)
+            throw EImproperArgument("command test_generatePairPPDP_offline should have 0 arguments");
+
+        //execute the test
+        test_generatePairPPDP_offline(FMM, log_path);
+    }
+    else if(command == "test_generatePairPPDP_online") {
+        //check the precondition
+        if(argc != 2)
+            throw EImproperArgument("command test_generatePairPPDP_online should have 0 arguments");
+
+        //execute the test
+        test_generatePairPPDP_online(FMM, log_path);
+    }
+    //-------------------------------------------------------------------
+    else if(command == "checkPairPPDP") {
+        //check the precondition
+        if(argc!=4 && argc!=5)
+            throw EImproperArgument("command checkPairPPDP sould have 2 or 3 arguments: <PP_path> <DP_path> [RPids]");
+
+        //built a path from arg 1
+        string PP_path(argv[2]);
+        //built a path from arg 2
+        string DP_path(argv[3]);
+
+        //make a rutinary check
+        if(PP_path.length()<=0 || DP_path.length()<=0)
+            throw EImpossibleError("lateral effect");
+
+        //complete the relative path, if any
+        if(PP_path[0] != '/')
+            PP_path.insert(0, getCurrentDir()+"/");
+        if(DP_path[0] != '/')
+            DP_path.insert(0, getCurrentDir()+"/");
+
+        //if has been specified a RP list, disable it
+        if(argc == 5) {
+            //translate from text to identifier list
+            TVector<int> Ids(92);
+            string str(argv[4]);
+            Ids.setText(str);
+
+            //check the precondition
+            for(int i=0; i<Ids.getCount(); i++) {
+                int Id = Ids[i];
+                int j = FMM.RPL.searchId(Id);
+                if(j >= FMM.RPL.getCount())
+                    throw EImproperArgument("RP not fount in the Fiber MOS Model: "+inttostr(Id));
+            }
+
+            //disble the RPs
+            for(int i=0; i<Ids.getCount(); i++) {
+                int Id = Ids[i];
+                int j = FMM.RPL.searchId(Id);
+                if(j >= FMM.RPL.getCount())
+                    throw EImpossibleError("lateral effect");
+                TRoboticPositioner *RP = FMM.RPL[j];
+                RP->Disabled = true;
+            }
+            append("Identifiers of the disabled RPs: "+Ids.getText().str, log_path.c_str());
+        }
+
+        //check a pair (PP, DP) from a path and write the events in the log file
+        checkPairPPDP(FMM, PP_path, DP_path, log_path);
+    }
+    else if(command == "validatePairPPDP") {
+        //check the precondition
+        if(argc!=3 && argc!=4)
+            throw EImproperArgument("command validatePairPPDP sould have 1 or 2 arguments: <outputs_path> [trace]");
+
+        //determines if the clearance traces shall be saved
+        bool trace = false;
+        if(argc == 4) {
+            if(string(argv[3]) != "trace")
+                throw EImproperArgument("second argument of command validatePairPPDP should be \"trace\"");
+            trace = true;
+        }
+
+        //built a path from arg 1
+        string outputs_path(argv[2]);
+
+        //make a rutinary check
+        if(outputs_path.length() <= 0)
+            throw EImpossibleError("lateral effect");
+
+        //complete the relative path, if any
+        if(outputs_path[0] != '/')
+            outputs_path.insert(0, getCurrentDir()+"/");
+
+        //validates a pair (PP, DP) from a path and write the events in the log file
+        validatePairPPDP(FMM, outputs_path, ".", log_path, trace);
+    }
+    else if(command == "queryClearanceTrace") {
+        //check the precondition
+        if(argc!=5 && argc!=6)
+            throw EImproperArgument("command queryClearanceTrace sould have 3 or 4 arguments: <trace_path> <Id> <IdA> [EA]");
+
+        //built a path from arg 1
+        string trace_path(argv[2]);
+
+        //convert the identifiers
+        int Id = strToInt(string(argv[3]));
+        int IdA = strToInt(string(argv[4]));
+        bool isEA = false;
+        if(argc == 6) {
+            if(string(argv[5]) != "EA")
+                throw EImproperArgument("fourth argument of command queryClearanceTrace should be \"EA\"");
+            isEA = true;
+        }
+
+        //read the trace
+        TClearanceTrace CT;
+        CT.readFromFile(trace_path);
+        append("Clearance trace loaded from file '"+trace_path+"'.", log_path.c_str());
+
+        //search the closest approach of the pair and print it
+        string pair = "RP"+inttostr(Id)+(isEA ? " with EA" : " with RP")+inttostr(IdA);
+        TClosestApproach CA;
+        if(!CT.getClosestApproach(CA, Id, IdA, isEA))
+            append("The pair "+pair+" isn't in the clearance trace.", log_path.c_str());
+        else
+            append("Closest approach of the pair "+pair+": D = "+floattostr(CA.D)+
+                   " mm, in the gesture "+inttostr(CA.gesture)+
+                   " at t = "+floattostr(CA.t)+" ms.", log_path.c_str());
+    }
+    else if(command == "regeneratePairPPDP") {
+        //check the precondition
+        if(argc!=5 && argc!=6)
+            throw EImproperArgument("command regeneratePairPPDP sould have 3 or 4 arguments: <PP_path> <DP_path> <FMOSA_path> [RPids]");
+
+        //built a path from arg 1
+        string PP_path(argv[2]);
+        //built a path from arg 2
+        string DP_path(argv[3]);
+        //built a path from arg 3
+        string FMOSA_path(argv[4]);
+
+        //make a rutinary check
+        if(PP_path.length()<=0 || DP_path.length()<=0 || FMOSA_path.length()<=0)
+            throw EImpossibleError("lateral effect");
+
+        //complete the relative path, if any
+        if(PP_path[0] != '/')
+            PP_path.insert(0, getCurrentDir()+"/");
+        if(DP_path[0] != '/')
+            DP_path.insert(0, getCurrentDir()+"/");
+        if(FMOSA_path[0] != '/')
+            FMOSA_path.insert(0, getCurrentDir()+"/");
+
+        //if has been specified a RP list, disable it
+        if(argc == 6) {
+            //translate from text to identifier list
+            TVector<int> Ids(92);
+            string str(argv[5]);
+            Ids.setText(str);
+
+            //check the precondition
+            for(int i=0; i<Ids.getCount(); i++) {
+                int Id = Ids[i];
+                int j = FMM.RPL.searchId(Id);
+                if(j >= FMM.RPL.getCount())
+                    throw EImproperArgument("RP not fount in the Fiber MOS Model: "+inttostr(Id));
+            }
+
+            //disble the RPs
+            for(int i=0; i<Ids.getCount(); i++) {
+                int Id = Ids[i];
+                int j = FMM.RPL.searchId(Id);
+                if(j >= FMM.RPL.getCount())
+                    throw EImpossibleError("lateral effect");
+                TRoboticPositioner *RP = FMM.RPL[j];
+                RP->Disabled = true;
+            }
+            append("Identifiers of the disabled RPs: "+Ids.getText().str, log_path.c_str());
+        }
+
+        //validates a pair (PP, DP) from a path and write the events in the log file
+        regeneratePairPPDP_offline(FMM, PP_path, DP_path, FMOSA_path, log_path);
+    }
+    //-------------------------------------------------------------------
+    else {
+        throw EImpossibleError("lateral effect");
+    }
+}
+
+//write the profile of the last command in a file, when
+//the program has been compiled with the counters enabled
+void writeProfile(const string& profile_path, const string& log_path)
+{
+    if(!Profiling::profileIsEnabled())
+        return;
+
+    try {
+        string str;
+        Profiling::getProfileText(str);
+        strWriteToFile(profile_path, str);
+        append("Profile saved in file '"+profile_path+"'.", log_path.c_str());
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "writing profile: ");
+        throw;
+    }
+}
+
+//split a line of a job in arguments separated by spaces,
+//where an argument containing spaces can be enclosed between double quotes
+void splitJobLine(vector<string>& args, const string& line)
+{
+    args.clear();
+    unsigned int i = 0;
+    while(i < line.length()) {
+        //travel the separators
+        while(i<line.length() && (line[i]==' ' || line[i]=='\t'))
+            i++;
+        if(i >= line.length())
+            break;
+
+        //read the argument
+        string arg;
+        if(line[i] == '"') {
+            i++;
+            while(i<line.length() && line[i]!='"')
+                arg += line[i++];
+            if(i >= line.length())
+                throw EImproperArgument("missing closing double quote in line: "+line);
+            i++;
+        }
+        else
+            while(i<line.length() && line[i]!=' ' && line[i]!='\t')
+                arg += line[i++];
+        args.push_back(arg);
+    }
+}
+
+//serve the jobs read from the standard input on a loaded Fiber MOS Model
+//Each job is a line containing a command and its arguments, as in the
+//command line. The events of each job are written in the standard output
+//between the lines "BEGIN JOB <n>" and "END JOB <n> <OK | ERROR>".
+//The argument <FMOSA_path> can be '-', and then the FMOSA is read from
+//the following lines, until a line containing only a dot.
+//The state of the FMM is restored before each job, so the jobs are
+//independent of each other.
+void serveJobs(TFiberMOSModel& FMM, const string& FMM_dir, string& log_path)
+{
+    //build a clone of the FMM for restore its state before each job
+    TFiberMOSModel FMM_initial(&FMM);
+
+    append("Serving jobs from the standard input. Type 'quit' for finish.", log_path.c_str());
+
+    string line;
+    int n = 0;
+    while(getline(cin, line)) {
+        //remove the end of line of files with format DOS
+        if(line.length()>0 && line[line.length()-1]=='\r')
+            line.erase(line.length()-1);
+
+        //split the line, skipping the empty lines and the comments
+        vector<string> args;
+        bool ok = true;
+        try {
+            splitJobLine(args, line);
+        }
+        catch(Exception& E) {
+            append("ERROR: "+E.Message.str, log_path.c_str());
+            continue;
+        }
+        if(args.size()<=0 || args[0][0]=='#')
+            continue;
+        if(args[0] == "quit")
+            break;
+
+        n++;
+        append("BEGIN JOB "+inttostr(n), log_path.c_str());
+        append("Job: "+line, log_path.c_str());
+
+        try {
+            const string& command = args[0];
+
+            //read the FMOSA from the following lines, if any
+            if(args.size()>=2 && args[1]=="-" &&
+                    (command=="generatePairPPDP_offline" || command=="generateParkProg_offline")) {
+                string str, FMOSA_line;
+                while(getline(cin, FMOSA_line)) {
+                    if(FMOSA_line.length()>0 && FMOSA_line[FMOSA_line.length()-1]=='\r')
+                        FMOSA_line.erase(FMOSA_line.length()-1);
+                    if(FMOSA_line == ".")
+                        break;
+                    str += FMOSA_line+"\r\n";
+                }
+                args[1] = "FMOSA_job"+inttostr(n)+".txt";
+                strWriteToFile(args[1], str);
+                append("FMOSA of the job saved in file '"+args[1]+"'.", log_path.c_str());
+            }
+
+            //only the commands which don't modify the instance can be served
+            if(command != "valuesSPM_EA" &&
+                    command != "valuesSPM_RP" &&
+                    command != "generateParkProg_offline" &&
+                    command != "generatePairPPDP_offline" &&
+                    command != "checkPairPPDP" &&
+                    command != "validatePairPPDP" &&
+                    command != "queryClearanceTrace" &&
+                    command != "regeneratePairPPDP")
+                throw EImproperArgument("command "+command+" can't be served");
+
+            //build the arguments as in the command line
+            vector<char*> argv;
+            argv.push_back((char*)"fmpt_saa");
+            for(unsigned int i=0; i<args.size(); i++)
+                argv.push_back((char*)args[i].c_str());
+
+            //restore the state of the FMM and execute the command
+            FMM.restoreState(FMM_initial);
+            Profiling::resetProfile();
+            executeCommand(FMM, FMM_dir, int(argv.size()), argv.data(), log_path);
+            writeProfile("fmpt_saa_profile_job"+inttostr(n)+".json", log_path);
+        }
+        catch(Exception& E) {
+            append("ERROR: "+E.Message.str, log_path.c_str());
+            ok = false;
+        }
+        catch(std::exception& E) {
+            append("ERROR: "+string(E.what()), log_path.c_str());
+            ok = false;
+        }
+        catch(...) {
+            append("ERROR: unknown exception", log_path.c_str());
+            ok = false;
+        }
+
+        //the job is closed also when it has failed,
+        //so the following jobs can be served
+        append("END JOB "+inttostr(n)+(ok ? " OK" : " ERROR"), log_path.c_str());
+    }
+
+    append("Served jobs: "+inttostr(n), log_path.c_str());
+}
+
 //---------------------------------------------------------------------------------
 //MAIN FUNCTION:
 //---------------------------------------------------------------------------------
@@ -3158,6 +4402,12 @@ void getArguments(int& argc, char* argv[], const string& command)
     else if(command == "testDistanceMin") {
         argc = 2;
     }
+    else if(command == "writeInstanceCache") {
+        argc = 2;
+    }
+    else if(command == "server") {
+        argc = 2;
+    }
     else if(command == "applyPCL") {
         argc = 3;
         string *arg2 = new string(getCurrentDir()+"/../megarafmpt/data/Models/positionerCenters_theoretical_100RPs.txt");
@@ -3216,6 +4466,15 @@ void getArguments(int& argc, char* argv[], const string& command)
         string *arg3 = new string("all");
         argv[3] = (char*)arg3->c_str();
     }
+    else if(command == "generatePairPPDP_batch") {
+        argc = 5;
+        string *arg2 = new string("/home/user/ejemplo2");
+        argv[2] = (char*)arg2->c_str();
+        string *arg3 = new string("0");
+        argv[3] = (char*)arg3->c_str();
+        string *arg4 = new string("all");
+        argv[4] = (char*)arg4->c_str();
+    }
     else if(command == "test_generatePairPPDP_offline") {
         argc = 2;
     }
@@ -3237,6 +4496,15 @@ void getArguments(int& argc, char* argv[], const string& command)
         string *arg2 = new string(getCurrentDir()+"../../pruebas_choque/margin_3p50/PairPPDP_outputs_from_megara_5p0e5_x1.txt");
         argv[2] = (char*)arg2->c_str();
     }
+    else if(command == "queryClearanceTrace") {
+        argc = 5;
+        string *arg2 = new string(getCurrentDir()+"/PairPPDP_PP-trace_from_megara-cb0.txt.bin");
+        argv[2] = (char*)arg2->c_str();
+        string *arg3 = new string("1");
+        argv[3] = (char*)arg3->c_str();
+        string *arg4 = new string("2");
+        argv[4] = (char*)arg4->c_str();
+    }
     else if(command == "regeneratePairPPDP") {
         argc = 6;
         string *arg2 = new string(getCurrentDir()+"/PairPPDP_PP-MCS_from_megara-cb_90sources.txt");
@@ -3352,6 +4620,8 @@ int main(int argc, char *argv[])
     //  "valuesSPM_RP"
     //  "testRadialMotion"
     //  "testDistanceMin"
+    //  "writeInstanceCache"
+    //  "server"
     //  "applyPCL"
     //  "applyRPI"
     //  "evaluateErrors"
@@ -3359,10 +4629,12 @@ int main(int argc, char *argv[])
     //  "applyTuning"
     //  "PPA_to_CC-S0"
     //  "generatePairPPDP_offline"
+    //  "generatePairPPDP_batch"
     //  "test_generatePairPPDP_offline"
     //  "test_generatePairPPDP_online"
     //  "checkPairPPDP"
     //  "validatePairPPDP"
+    //  "queryClearanceTrace"
     //  "regeneratePairPPDP"
     //  "generateParkProg_offline"
     //  "test_generateParkProg_offline"
@@ -3446,6 +4718,8 @@ int main(int argc, char *argv[])
                 command != "valuesSPM_RP" &&
                 command != "testRadialMotion" &&
                 command != "testDistanceMin" &&
+                command != "writeInstanceCache" &&
+                command != "server" &&
                 command != "applyPCL" &&
                 command != "applyRPI" &&
                 command != "evaluateErrors" &&
@@ -3458,10 +4732,12 @@ int main(int argc, char *argv[])
                 command != "test_generateParkProg_online" &&
                 //-------------------------------------------
                 command != "generatePairPPDP_offline" &&
+                command != "generatePairPPDP_batch" &&
                 command != "test_generatePairPPDP_offline" &&
                 command != "test_generatePairPPDP_online" &&
                 command != "checkPairPPDP" &&
                 command != "validatePairPPDP" &&
+                command != "queryClearanceTrace" &&
                 command != "regeneratePairPPDP") {
             //-------------------------------------------
             //indicates that happened
@@ -3584,556 +4860,19 @@ int main(int argc, char *argv[])
         //print a blank line for improve legibility
         append("", log_path.c_str());
 
-        //-------------------------------------------------------------------
-        if(command == "valuesSPM_EA") {
-            //check the precondition
-            if(argc != 3)
-                throw EImproperArgument("command valuesSPM_EA sould have 1 arguments: <Id>");
-
-            //built a string from arg 1 (<Id>)
-            string str(argv[2]);
-
-            //convert the argument to int
-            int Id = strToInt(str);
-
-            //search the EA
-            int i = FMM.EAL.searchId(Id);
-            if(i >= FMM.EAL.getCount())
-                throw EImpossibleError("there isn't a EA with Id = "+inttostr(Id)+": ");
-            TExclusionArea *EA = FMM.EAL[i];
-
-            //print the SPM values
-            append("The EA"+EA->getIdText().str+" has been found in the FMM, and their SPM values are:", log_path.c_str());
-            append(StrIndent(EA->getSecurityText()).str, log_path.c_str());
-            append("\r\nFor learn about the calculus of SPM values, see the file: '/usr/local/share/megara-fmpt/Models/Calculus_of_SPM.txt'", log_path.c_str());
-        }
-        else if(command == "valuesSPM_RP") {
-            //check the precondition
-            if(argc != 3)
-                throw EImproperArgument("command valuesSPM_RP sould have 1 arguments: <Id>");
-
-            //built a string from arg 1 (<Id>)
-            string str(argv[2]);
-
-            //convert the argument to int
-            int Id = strToInt(str);
-
-            //search the RP
-            int i = FMM.RPL.searchId(Id);
-            if(i >= FMM.RPL.getCount())
-                throw EImpossibleError("there isn't a RP with Id = "+inttostr(Id)+": ");
-            TRoboticPositioner *RP = FMM.RPL[i];
-
-            //print the SPM values
-            append("The RP"+RP->getActuator()->getIdText().str+" has been found in the FMM, and their SPM values are:", log_path.c_str());
-            append(StrIndent(RP->getActuator()->getSecurityText()).str, log_path.c_str());
-            append("\r\nFor learn about the calculus of SPM values, see the file: '/usr/local/share/megara-fmpt/Models/Calculus_of_SPM.txt'", log_path.c_str());
-        }
-        else if(command == "testRadialMotion") {
+        //execute the command, or serve the jobs of the standard input
+        if(command == "server") {
             //check the precondition
             if(argc != 2)
-                throw EImproperArgument("command testRadialMotion should have 0 arguments");
+                throw EImproperArgument("command server should have 0 arguments");
 
-            //execute the test
-            testRadialMotion(FMM, log_path);
+            serveJobs(FMM, FMM_dir, log_path);
         }
-        else if(command == "testDistanceMin") {
-            //check the precondition
-            if(argc != 2)
-                throw EImproperArgument("command testDistanceMin should have 0 arguments");
-
-            //execute the test
-            testDistanceMin(FMM, log_path);
-        }
-        //-------------------------------------------------------------------
-        else if(command == "applyPCL") {
-            //check the precondition
-            if(argc != 3)
-                throw EImproperArgument("command applyPCL sould have 1 arguments: <PCL_path>");
-
-            //built a path from arg 1
-            string PCL_path(argv[2]);
-
-            //make a rutinary check
-            if(PCL_path.length() <= 0)
-                throw EImpossibleError("lateral effect");
-
-            //complete the relative path, if any
-            if(PCL_path[0] != '/')
-                PCL_path.insert(0, getCurrentDir()+"/");
-
-            //apply the positioner center list to the Fiber MOS Model Instance
-            applyPCL(FMM, PCL_path, log_path);
-
-            //save the instance of the Fiber MOS Model from where was loaded
-            writeInstanceToDir(FMM_dir, FMM);
-            append("Fiber MOS Model instance saved in directory '"+FMM_dir+"'.", log_path.c_str());
-        }
-        else if(command == "applyRPI") {
-            //check the precondition
-            if(argc != 3)
-                throw EImproperArgument("command applyRPI sould have 1 arguments: <RPI_dir>");
-
-            //built a path from arg 1
-            string RPI_dir(argv[2]);
-
-            //make a rutinary check
-            if(RPI_dir.length() <= 0)
-                throw EImpossibleError("lateral effect");
-
-            //complete the relative path, if any
-            if(RPI_dir[0] != '/')
-                RPI_dir.insert(0, getCurrentDir()+"/");
-
-            //apply the RP Instance for all RPs of the Fiber MOS Model Instance
-            applyRPI(FMM, RPI_dir, log_path);
-
-            //save the instance of the Fiber MOS Model from where was loaded
-            writeInstanceToDir(FMM_dir, FMM);
-            append("Fiber MOS Model instance saved in directory '"+FMM_dir+"'.", log_path.c_str());
-        }
-        else if(command == "evaluateErrors") {
-            //check the precondition
-            if(argc != 3)
-                throw EImproperArgument("command evaluateErrors sould have 1 arguments: <measures_path>");
-
-            //built a path from arg 1
-            string measures_path(argv[2]);
-
-            //make a rutinary check
-            if(measures_path.length() <= 0)
-                throw EImpossibleError("lateral effect");
-
-            //complete the relative path, if any
-            if(measures_path[0] != '/')
-                measures_path.insert(0, getCurrentDir()+"/");
-
-            //call the function
-            evaluateErrors(FMM, measures_path, ".", log_path);
-        }
-        else if(command == "tuneRP") {
-            //check the precondition
-            if(argc != 5)
-                throw EImproperArgument("command tuneRP sould have 3 arguments: <measures_path> <errors_path> <positions>");
-
-            //built a path from args 1 and 2
-            string measures_path(argv[2]);
-            string errors_path(argv[3]);
-
-            //make a rutinary check
-            if(measures_path.length() <= 0)
-                throw EImpossibleError("lateral effect");
-            if(errors_path.length() <= 0)
-                throw EImpossibleError("lateral effect");
-
-            //complete the relative paths, if any
-            if(measures_path[0] != '/')
-                measures_path.insert(0, getCurrentDir()+"/");
-            if(errors_path[0] != '/')
-                errors_path.insert(0, getCurrentDir()+"/");
-
-            int positions;
-            try {
-                //convert to int the arg 3
-                string positions_str(argv[4]);
-                positions = strToInt(positions_str);
-            }
-            catch(Exception& E) {
-                E.Message.Insert(1, "number of positions (positions) should be an integer upper zero");
-                throw;
-            }
-
-            //call the function
-            tuneRP(FMM, measures_path, errors_path, positions, ".", log_path);
-        }
-        else if(command == "applyTuning") {
-            //check the precondition
-            if(argc != 3)
-                throw EImproperArgument("command applyTuning sould have 1 arguments: <tuning_path>");
-
-            //built a path from arg 1
-            string tuning_path(argv[2]);
-
-            //make a rutinary check
-            if(tuning_path.length() <= 0)
-                throw EImpossibleError("lateral effect");
-
-            //complete the relative path, if any
-            if(tuning_path[0] != '/')
-                tuning_path.insert(0, getCurrentDir()+"/");
-
-            //call the function
-            applyTuning(FMM, tuning_path, log_path);
-
-            //save the instance of the Fiber MOS Model from where was loaded
-            writeInstanceToDir(FMM_dir, FMM);
-            append("Fiber MOS Model instance saved in directory '"+FMM_dir+"'.", log_path.c_str());
-        }
-        else if(command == "PPA_to_CC-S0") {
-            //check the precondition
-            if(argc != 3)
-                throw EImproperArgument("command PPA_to_CC-S0 sould have 1 arguments: <PPAL_path>");
-
-            //built a path from arg 1
-            string PPAL_path(argv[2]);
-
-            //make a rutinary check
-            if(PPAL_path.length() <= 0)
-                throw EImpossibleError("lateral effect");
-
-            //complete the relative path, if any
-            if(PPAL_path[0] != '/')
-                PPAL_path.insert(0, getCurrentDir()+"/");
-
-            //call the function
-            PPA_to_CC_S0(FMM, PPAL_path, ".", log_path);
-        }
-        //-------------------------------------------------------------------
-        else if(command == "generateParkProg_offline") {
-            //check the precondition
-            if(argc < 3)
-                throw EImproperArgument("command generateParkProg_offline sould have almost 1 argument: <FMOSA_path>");
-
-            //build a string for the argument 1
-            string arg1(argv[2]);
-
-            //argument 1 can be:
-            //  command help ("help")
-            //  <FMOSA_path>
-
-            //make a rutinary check
-            if(arg1.length() <= 0)
-                throw EImpossibleError("lateral effect");
-
-            //reacts according the comands without log file
-            if(arg1 == "help") {
-                //print the help
-                cout << help_generateParkProg_offline() << endl;
-                cout << endl;
-                //indicates that the program has been executed without error
-                return 0;
-            }
-
-            //complete the relative path, if any
-            if(arg1[0] != '/')
-                arg1.insert(0, getCurrentDir()+"/");
-
-            bool saveAll=false;
-            bool saveSPL=false, saveFPL=false;
-            bool saveDmin=false, saveDend=false;
-            bool saveDispCorners1=false, saveDispCorners2=false;
-            bool saveFMPT=false, saveMCS=false;
-            bool saveOutputs=false, saveOtherOutputs=false;
-            for(int i=3; i<argc; i++) {
-                string argument(argv[i]);
-                //------------------------------------
-                if(argument == "all")
-                    saveAll = true;
-                //------------------------------------
-                else if(argument == "SPL")
-                    saveSPL = true;
-                else if(argument == "FPL")
-                    saveFPL = true;
-                //------------------------------------
-                else if(argument == "Dmin")
-                    saveDmin = true;
-                else if(argument == "Dend")
-                    saveDend = true;
-                else if(argument == "DispCorners1")
-                    saveDispCorners1 = true;
-                else if(argument == "DispCorners2")
-                    saveDispCorners2 = true;
-                //------------------------------------
-                else if(argument == "FMPT")
-                    saveFMPT = true;
-                else if(argument == "MCS")
-                    saveMCS = true;
-                else if(argument == "outputs")
-                    saveOutputs = true;
-                else if(argument == "other-outputs")
-                    saveOtherOutputs = true;
-                //------------------------------------
-                else
-                    throw EImproperArgument("unknown argument: "+argument);
-            }
-
-            if(saveAll) {
-                saveSPL=true, saveFPL=true;
-                saveDmin=true, saveDend=true;
-                saveDispCorners1=true, saveDispCorners2=true;
-                saveFMPT=true, saveMCS=true;
-                saveOutputs=true, saveOtherOutputs=true;
-            }
-
-            //generate a DP from a path and write the events in the log file
-            generateParkProg_offline(FMM, arg1, ".", log_path,
-                                     //--------------------------------------------
-                                     saveSPL, saveFPL,
-                                     saveDmin, saveDend,
-                                     saveDispCorners1, saveDispCorners2,
-                                     saveFMPT, saveMCS,
-                                     saveOutputs, saveOtherOutputs);
-        }
-        else if(command == "test_generateParkProg_offline") {
-            //check the precondition
-            if(argc != 2)
-                throw EImproperArgument("command test_generateParkProg_offline should have 0 arguments");
-
-            //execute the test
-            test_generateParkProg_offline(FMM, log_path);
-        }
-        else if(command == "test_generateParkProg_online") {
-            //check the precondition
-            if(argc != 2)
-                throw EImproperArgument("command test_generateParkProg_online should have 0 arguments");
-
-            //execute the test
-            test_generateParkProg_online(FMM, log_path);
-        }
-        else if(command == "generatePairPPDP_offline") {
-            //check the precondition
-            if(argc < 3)
-                throw EImproperArgument("command generatePairPPDP_offline sould have almost 1 argument: <FMOSA_path>");
-
-            //build a string for the argument 1
-            string arg1(argv[2]);
-
-            //argument 1 can be:
-            //  command help ("help")
-            //  <FMOSA_path>
-
-            //make a rutinary check
-            if(arg1.length() <= 0)
-                throw EImpossibleError("lateral effect");
-
-            //reacts according the comands without log file
-            if(arg1 == "help") {
-                //print the help
-                cout << help_generatePairPPDP_offline() << endl;
-                cout << endl;
-                //indicates that the program has been executed without error
-                return 0;
-            }
-
-            //complete the relative path, if any
-            if(arg1[0] != '/')
-                arg1.insert(0, getCurrentDir()+"/");
-
-            bool saveAll=false;
-            bool saveOPL=false, saveOPL_S0=false, saveOPL_S1=false;
-            bool saveIPL=false, saveDispCorners1=false, saveDispCorners2=false;
-            bool savePP_Dmin=false, savePP_Dend=false, saveDP_Dmin=false, saveDP_Dend=false;
-            bool savePP_FMPT=false, saveDP_FMPT=false, savePP_MCS=false, saveDP_MCS=false;
-            bool saveMCS=false, save_outputs=false, save_other_outputs=false;
-            for(int i=3; i<argc; i++) {
-                string argument(argv[i]);
-                //------------------------------------
-                if(argument == "all")
-                    saveAll = true;
-                //------------------------------------
-                else if(argument == "OPL")
-                    saveOPL = true;
-                else if(argument == "OPL-S0")
-                    saveOPL_S0 = true;
-                else if(argument == "OPL-S1")
-                    saveOPL_S1 = true;
-                //------------------------------------
-                else if(argument == "IPL")
-                    saveIPL = true;
-                else if(argument == "DispCorners1")
-                    saveDispCorners1 = true;
-                else if(argument == "DispCorners2")
-                    saveDispCorners2 = true;
-                //------------------------------------
-                else if(argument == "PP-Dmin")
-                    savePP_Dmin = true;
-                else if(argument == "PP-Dend")
-                    savePP_Dend = true;
-                else if(argument == "DP-Dmin")
-                    saveDP_Dmin = true;
-                else if(argument == "DP-Dend")
-                    saveDP_Dend = true;
-                //------------------------------------
-                else if(argument == "PP-FMPT")
-                    savePP_FMPT = true;
-                else if(argument == "DP-FMPT")
-                    saveDP_FMPT = true;
-                else if(argument == "PP-MCS")
-                    savePP_MCS = true;
-                else if(argument == "DP-MCS")
-                    saveDP_MCS = true;
-                //------------------------------------
-                else if(argument == "MCS")
-                    saveMCS = true;
-                else if(argument == "outputs")
-                    save_outputs = true;
-                else if(argument == "other-outputs")
-                    save_other_outputs = true;
-                //------------------------------------
-                else
-                    throw EImproperArgument("unknown argument: "+argument);
-            }
-
-            if(saveAll) {
-                saveOPL=true, saveOPL_S0=true, saveOPL_S1=true;
-                saveIPL=true, saveDispCorners1=true, saveDispCorners2=true;
-                savePP_Dmin=true, savePP_Dend=true, saveDP_Dmin=true, saveDP_Dend=true;
-                savePP_FMPT=true, saveDP_FMPT=true, savePP_MCS=true, saveDP_MCS=true;
-                saveMCS=true, save_outputs=true, save_other_outputs=true;
-            }
-
-            //generate a pair (PP, DP) from a path and write the events in the log file
-            generatePairPPDP_offline(FMM, arg1, ".", log_path,
-                                     //------------------------------------------------------------
-                                     saveOPL, saveOPL_S0, saveOPL_S1,
-                                     saveIPL, saveDispCorners1, saveDispCorners2,
-                                     savePP_Dmin, savePP_Dend, saveDP_Dmin, saveDP_Dend,
-                                     savePP_FMPT, saveDP_FMPT, savePP_MCS, saveDP_MCS,
-                                     saveMCS, save_outputs, save_other_outputs);
-        }
-        else if(command == "test_generatePairPPDP_offline") {
-            //check the precondition
-            if(argc != 2)
-                throw EImproperArgument("command test_generatePairPPDP_offline should have 0 arguments");
-
-            //execute the test
-            test_generatePairPPDP_offline(FMM, log_path);
-        }
-        else if(command == "test_generatePairPPDP_online") {
-            //check the precondition
-            if(argc != 2)
-                throw EImproperArgument("command test_generatePairPPDP_online should have 0 arguments");
-
-            //execute the test
-            test_generatePairPPDP_online(FMM, log_path);
-        }
-        //-------------------------------------------------------------------
-        else if(command == "checkPairPPDP") {
-            //check the precondition
-            if(argc!=4 && argc!=5)
-                throw EImproperArgument("command checkPairPPDP sould have 2 or 3 arguments: <PP_path> <DP_path> [RPids]");
-
-            //built a path from arg 1
-            string PP_path(argv[2]);
-            //built a path from arg 2
-            string DP_path(argv[3]);
-
-            //make a rutinary check
-            if(PP_path.length()<=0 || DP_path.length()<=0)
-                throw EImpossibleError("lateral effect");
-
-            //complete the relative path, if any
-            if(PP_path[0] != '/')
-                PP_path.insert(0, getCurrentDir()+"/");
-            if(DP_path[0] != '/')
-                DP_path.insert(0, getCurrentDir()+"/");
-
-            //if has been specified a RP list, disable it
-            if(argc == 5) {
-                //translate from text to identifier list
-                TVector<int> Ids(92);
-                string str(argv[4]);
-                Ids.setText(str);
-
-                //check the precondition
-                for(int i=0; i<Ids.getCount(); i++) {
-                    int Id = Ids[i];
-                    int j = FMM.RPL.searchId(Id);
-                    if(j >= FMM.RPL.getCount())
-                        throw EImproperArgument("RP not fount in the Fiber MOS Model: "+inttostr(Id));
-                }
-
-                //disble the RPs
-                for(int i=0; i<Ids.getCount(); i++) {
-                    int Id = Ids[i];
-                    int j = FMM.RPL.searchId(Id);
-                    if(j >= FMM.RPL.getCount())
-                        throw EImpossibleError("lateral effect");
-                    TRoboticPositioner *RP = FMM.RPL[j];
-                    RP->Disabled = true;
-                }
-                append("Identifiers of the disabled RPs: "+Ids.getText().str, log_path.c_str());
-            }
-
-            //check a pair (PP, DP) from a path and write the events in the log file
-            checkPairPPDP(FMM, PP_path, DP_path, log_path);
-        }
-        else if(command == "validatePairPPDP") {
-            //check the precondition
-            if(argc != 3)
-                throw EImproperArgument("command validatePairPPDP sould have 1 arguments: <outputs_path>");
-
-            //built a path from arg 1
-            string outputs_path(argv[2]);
-
-            //make a rutinary check
-            if(outputs_path.length() <= 0)
-                throw EImpossibleError("lateral effect");
-
-            //complete the relative path, if any
-            if(outputs_path[0] != '/')
-                outputs_path.insert(0, getCurrentDir()+"/");
-
-            //validates a pair (PP, DP) from a path and write the events in the log file
-            validatePairPPDP(FMM, outputs_path, ".", log_path);
-        }
-        else if(command == "regeneratePairPPDP") {
-            //check the precondition
-            if(argc!=5 && argc!=6)
-                throw EImproperArgument("command regeneratePairPPDP sould have 3 or 4 arguments: <PP_path> <DP_path> <FMOSA_path> [RPids]");
-
-            //built a path from arg 1
-            string PP_path(argv[2]);
-            //built a path from arg 2
-            string DP_path(argv[3]);
-            //built a path from arg 3
-            string FMOSA_path(argv[4]);
-
-            //make a rutinary check
-            if(PP_path.length()<=0 || DP_path.length()<=0 || FMOSA_path.length()<=0)
-                throw EImpossibleError("lateral effect");
-
-            //complete the relative path, if any
-            if(PP_path[0] != '/')
-                PP_path.insert(0, getCurrentDir()+"/");
-            if(DP_path[0] != '/')
-                DP_path.insert(0, getCurrentDir()+"/");
-            if(FMOSA_path[0] != '/')
-                FMOSA_path.insert(0, getCurrentDir()+"/");
-
-            //if has been specified a RP list, disable it
-            if(argc == 6) {
-                //translate from text to identifier list
-                TVector<int> Ids(92);
-                string str(argv[5]);
-                Ids.setText(str);
-
-                //check the precondition
-                for(int i=0; i<Ids.getCount(); i++) {
-                    int Id = Ids[i];
-                    int j = FMM.RPL.searchId(Id);
-                    if(j >= FMM.RPL.getCount())
-                        throw EImproperArgument("RP not fount in the Fiber MOS Model: "+inttostr(Id));
-                }
-
-                //disble the RPs
-                for(int i=0; i<Ids.getCount(); i++) {
-                    int Id = Ids[i];
-                    int j = FMM.RPL.searchId(Id);
-                    if(j >= FMM.RPL.getCount())
-                        throw EImpossibleError("lateral effect");
-                    TRoboticPositioner *RP = FMM.RPL[j];
-                    RP->Disabled = true;
-                }
-                append("Identifiers of the disabled RPs: "+Ids.getText().str, log_path.c_str());
-            }
-
-            //validates a pair (PP, DP) from a path and write the events in the log file
-            regeneratePairPPDP_offline(FMM, PP_path, DP_path, FMOSA_path, log_path);
-        }
-        //-------------------------------------------------------------------
         else {
-            throw EImpossibleError("lateral effect");
+            //the profile only includes the execution of the command
+            Profiling::resetProfile();
+            executeCommand(FMM, FMM_dir, argc, argv, log_path);
+            writeProfile("fmpt_saa_profile.json", log_path);
         }
     }
     catch(Exception &E) {
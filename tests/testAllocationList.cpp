@@ -407,3 +407,60 @@ void TestAllocationList::test_()
     CPPUNIT_ASSERT(true);
 }
 
+void TestAllocationList::test_MoveToTargetP3_Nthreads()
+{
+    //move the RPs to their projection points with one and with several threads
+    double p_1s[2][2], p___3s[2][2];
+    for(int i=0; i<2; i++) {
+        //build a RP list
+        TRoboticPositionerList RPL;
+        TRoboticPositioner RP2(2, TDoublePoint(-60.3, 87.035553));
+        TRoboticPositioner RP4(4, TDoublePoint(-40.2, 87.035553));
+        RPL.Add(&RP2);
+        RPL.Add(&RP4);
+        TExclusionAreaList EAL;
+        RPL.assimilate(EAL);
+
+        //build a allocation list, attached to a RP list
+        TAllocationList AL(&RPL);
+        AL.Nthreads = (i == 0) ? 1 : 4;
+        AL.Add(new TAllocation(&RP2, -51.296480, 82.217116));
+        AL.Add(new TAllocation(&RP4, -37.372467, 92.504659));
+
+        //move the RPs to the more closer stable positions
+        //getting the computing times
+        TVector<double> times;
+        AL.MoveToTargetP3(times);
+
+        //check that there is a nonnegative time for each allocation
+        if(times.getCount() != AL.getCount() || times[0] < 0 || times[1] < 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //get the positions
+        for(int j=0; j<2; j++) {
+            p_1s[i][j] = RPL[j]->getActuator()->getp_1();
+            p___3s[i][j] = RPL[j]->getActuator()->getArm()->getp___3();
+        }
+
+        //check that the positions are the ones reached by MoveToPP
+        for(int j=0; j<2; j++) {
+            AL[j]->MoveToPP();
+            if(RPL[j]->getActuator()->getp_1() != p_1s[i][j] ||
+                    RPL[j]->getActuator()->getArm()->getp___3() != p___3s[i][j]) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+    }
+
+    //check that the result not depends on the number of threads
+    for(int j=0; j<2; j++)
+        if(p_1s[0][j] != p_1s[1][j] || p___3s[0][j] != p___3s[1][j]) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -35,6 +35,7 @@ class TestAllocationList : public CppUnit::TestFixture
 
     //add test methods
     CPPUNIT_TEST(test_);
+    CPPUNIT_TEST(test_MoveToTargetP3_Nthreads);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -47,6 +48,7 @@ public:
 
     //test methods
     void test_();
+    void test_MoveToTargetP3_Nthreads();
 };
 
 #endif // TEST_AllocationList_H
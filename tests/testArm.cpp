@@ -390,3 +390,94 @@ void TestArm::test_()
     CPPUNIT_ASSERT(true);
 }
 
+void TestArm::test_ImageCache()
+{
+    try {
+        //build an arm with the image cache and other without it
+        TArm A1(TDoublePoint(-5.8025, 0), 0);
+        TArm A2(TDoublePoint(-5.8025, 0), 0);
+        A1.ImageCache.setCapacity(256);
+        if(A2.ImageCache.getCapacity() != 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        unsigned int Reserved = TArmImageCache::getReserved();
+
+        //move both arms to the same positions, visiting each one several times
+        double p___3s[] = {0, 100, 2000, 100, 0, 35, 2000, 35, 100};
+        for(int i=0; i<9; i++) {
+            if(i == 5) {
+                //change the position of the arms
+                A1.set(TDoublePoint(1, 2), 0.5);
+                A2.set(TDoublePoint(1, 2), 0.5);
+            }
+            A1.setp___3(p___3s[i]);
+            A2.setp___3(p___3s[i]);
+
+            //the restored image should be identical to the calculated image
+            const TContourFigureList& C1 = A1.getContour();
+            const TContourFigureList& C2 = A2.getContour();
+            if(A1.getP2() != A2.getP2() || A1.getP3() != A2.getP3() ||
+                    A1.getV() != A2.getV() || C1 != C2 ||
+                    !C1.flatIsUpdated() || C1.Flat.size() != C2.Flat.size() ||
+                    C1.Bounds.R != C2.Bounds.R ||
+                    C1.Segments.xa != C2.Segments.xa) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(unsigned int j=0; j<C1.Flat.size(); j++)
+                if(C1.Flat[j].Pa != C2.Flat[j].Pa || C1.Flat[j].Pb != C2.Flat[j].Pb ||
+                        C1.Flat[j].Bounds.R != C2.Flat[j].Bounds.R) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+        }
+
+        //some positions should have been restored from the cache
+        if(A1.ImageCache.Hits == 0 || A2.ImageCache.Lookups != 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the table of the cache should be reserved from the global budget
+        if(TArmImageCache::getReserved() != Reserved + 256) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //changing the template should empty the cache
+        A1.setL13(A1.getL13());
+        if(A1.ImageCache.Hits != 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //a cache whose table does not fit in the budget
+        //should not store images
+        unsigned int Budget = TArmImageCache::getBudget();
+        TArmImageCache::setBudget(TArmImageCache::getReserved() + 100);
+        A2.ImageCache.setCapacity(256);
+        A2.setp___3(100);
+        A2.setp___3(0);
+        A2.setp___3(100);
+        TArmImageCache::setBudget(Budget);
+        if(A2.ImageCache.Hits != 0 || A2.ImageCache.Lookups == 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //disabling the cache should return its table to the budget
+        A1.ImageCache.setCapacity(0);
+        A2.ImageCache.setCapacity(0);
+        if(TArmImageCache::getReserved() != Reserved) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
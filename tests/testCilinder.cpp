@@ -30,6 +30,7 @@
 #include <vector>
 //#include <stdlib.h>
 #include <limits> //std::numeric_limits
+#include <cfloat> //DBL_MAX
 
 #include "../src/Cilinder.h"
 
@@ -531,3 +532,47 @@ void TestCilinder::test_()
     CPPUNIT_ASSERT(true);
 }
 
+void TestCilinder::test_getNearestStablePosition()
+{
+    for(int i=0; i<100; i++) {
+        //select a random position in the domain of the rotors
+        double theta_1 = C->gettheta_1min() +
+                (C->gettheta_1max() - C->gettheta_1min())*rand()/RAND_MAX;
+        double theta___3 = C->getArm()->gettheta___3min() +
+                (C->getArm()->gettheta___3max() - C->getArm()->gettheta___3min())*rand()/RAND_MAX;
+
+        //get the nearest stable position
+        double theta_1bak = C->gettheta_1();
+        double theta___3bak = C->getArm()->gettheta___3();
+        double p_1nsp, p___3nsp;
+        double R = C->getNearestStablePosition(p_1nsp, p___3nsp, theta_1, theta___3);
+
+        //check that the rotors has not been moved
+        if(C->gettheta_1() != theta_1bak || C->getArm()->gettheta___3() != theta___3bak) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //skip the case where the position is out of the use interval
+        if(R == DBL_MAX)
+            continue;
+
+        //calculate the point P3 by moving the rotors
+        C->setQuantify_(false);
+        C->getArm()->setQuantify___(false);
+        C->setAnglesRadians(theta_1, theta___3);
+        TDoublePoint P = C->getArm()->getP3();
+        C->setQuantify_(true);
+        C->getArm()->setQuantify___(true);
+        C->setAnglesSteps(p_1nsp, p___3nsp);
+        double R_ = Mod(C->getArm()->getP3() - P);
+
+        //check that the distance is the same
+        if(R != R_) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -39,6 +39,7 @@ class TestCilinder : public CppUnit::TestFixture
 
     //add test methods
     CPPUNIT_TEST(test_);
+    CPPUNIT_TEST(test_getNearestStablePosition);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -54,6 +55,7 @@ public:
 
     //test methods
     void test_();
+    void test_getNearestStablePosition();
 };
 
 #endif // FMPT_TESTCILINDER_H
@@ -0,0 +1,200 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//---------------------------------------------------------------------------
+//File: testClearanceTrace.cpp
+//Content: test for the module ClearanceTrace
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testClearanceTrace.h"
+#include "../src/ClearanceTrace.h"
+#include "../src/Exceptions.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <math.h>
+
+using namespace Positioning;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestClearanceTrace);
+
+//overide setUp(), init data, etc
+void TestClearanceTrace::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestClearanceTrace::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+//build a profile with a minimun distance Dmin in the instant tmin
+static TClearanceProfile *newProfile(int Id, int IdA, bool isEA, int gesture,
+                                     double tmin, double Dmin)
+{
+    TClearanceProfile *CP = new TClearanceProfile(Id, IdA, isEA, gesture, 0.5);
+    for(int k=0; k<=100; k++) {
+        double t = k*12.345;
+        CP->addSample(t, Dmin + 1e-5*(t - tmin)*(t - tmin));
+    }
+    return CP;
+}
+
+//build a list of profiles where the pair (1, 2) is in both directions
+//in the gesture 0, and only in the direction (2, 1) in the gesture 1
+static void buildProfiles(TClearanceProfileList& CPL)
+{
+    CPL.Clear();
+    CPL.Add(newProfile(1, 2, false, 0, 506.145, 4.5));
+    CPL.Add(newProfile(2, 1, false, 0, 506.145, 4.5));
+    CPL.Add(newProfile(1, 3, true, 0, 123.45, 7.25));
+    CPL.Add(newProfile(2, 1, false, 1, 864.15, 3.75));
+}
+
+void TestClearanceTrace::test_build()
+{
+    try {
+        TClearanceProfileList CPL;
+        buildProfiles(CPL);
+        TClearanceTrace CT;
+        CT.build(CPL);
+
+        //the profile (2, 1) of the gesture 0 shall be discarded
+        if(CT.getCount() != 3) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the decoded profiles shall be equal to the original profiles
+        //less the precision of float32
+        TClearanceProfileList CPL_;
+        CT.getProfiles(CPL_);
+        int map[3] = {0, 2, 3};
+        for(int i=0; i<CPL_.getCount(); i++) {
+            const TClearanceProfile& CP = CPL[map[i]];
+            const TClearanceProfile& CP_ = CPL_[i];
+            if(CP_.Id!=CP.Id || CP_.IdA!=CP.IdA || CP_.isEA!=CP.isEA ||
+                    CP_.gesture!=CP.gesture || CP_.vmaxabs!=CP.vmaxabs ||
+                    CP_.D.size()!=CP.D.size()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(unsigned int k=0; k<CP.D.size(); k++)
+                if(fabs(CP_.t[k] - CP.t[k]) > 1e-3 || fabs(CP_.D[k] - CP.D[k]) > 1e-5) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestClearanceTrace::test_getClosestApproach()
+{
+    try {
+        TClearanceProfileList CPL;
+        buildProfiles(CPL);
+        TClearanceTrace CT;
+        CT.build(CPL);
+
+        //the order of the pair of RPs shall be indifferent
+        TClosestApproach CA1, CA2;
+        if(!CT.getClosestApproach(CA1, 1, 2) || !CT.getClosestApproach(CA2, 2, 1)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        if(CA1.gesture!=1 || CA2.gesture!=1 || CA1.t!=CA2.t || CA1.D!=CA2.D ||
+                fabs(CA1.t - 864.15) > 1e-3 || fabs(CA1.D - 3.75) > 1e-5) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the pairs with EAs shall not be reversed
+        TClosestApproach CA;
+        if(!CT.getClosestApproach(CA, 1, 3, true) || CA.gesture!=0 ||
+                fabs(CA.t - 123.45) > 1e-3 || fabs(CA.D - 7.25) > 1e-5) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        if(CT.getClosestApproach(CA, 3, 1, true) || CT.getClosestApproach(CA, 1, 3) ||
+                CA.gesture!=-1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestClearanceTrace::test_setBytes()
+{
+    try {
+        TClearanceProfileList CPL;
+        buildProfiles(CPL);
+        TClearanceTrace CT;
+        CT.build(CPL);
+        string bytes = CT.getBytes();
+
+        //a copy of the encoded trace shall be decoded equally
+        TClearanceTrace CT_;
+        CT_.setBytes(bytes);
+        if(CT_.getCount() != CT.getCount()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //a truncated trace shall be rejected and shall leave the trace empty
+        try {
+            CT_.setBytes(bytes.substr(0, bytes.length() - 1));
+            CPPUNIT_ASSERT(false);
+            return;
+        } catch(EImproperFileLoadedValue&) {
+        }
+        if(CT_.getCount() != 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //a trace without the magic number shall be rejected
+        bytes[0] = 'X';
+        try {
+            CT_.setBytes(bytes);
+            CPPUNIT_ASSERT(false);
+            return;
+        } catch(EImproperFileLoadedValue&) {
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+//---------------------------------------------------------------------------
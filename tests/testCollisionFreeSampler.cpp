@@ -0,0 +1,139 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//---------------------------------------------------------------------------
+//File: testCollisionFreeSampler.cpp
+//Content: test for the module CollisionFreeSampler
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testCollisionFreeSampler.h"
+#include "../src/CollisionFreeSampler.h"
+#include "../src/FileMethods.h"
+#include "../src/Exceptions.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <vector>
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCollisionFreeSampler);
+
+//overide setUp(), init data, etc
+void TestCollisionFreeSampler::setUp() {
+    try {
+        //load the FMM Instance
+        string dir_FMM = "../data/Models/MEGARA_FiberMOSModel_Instance";
+        //string dir_FMM = "../megarafmpt/data/Models/MEGARA_FiberMOSModel_Instance"; //Qt only
+        readInstanceFromDir(FMM, dir_FMM);
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "loading instance: ");
+        throw;
+    }
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestCollisionFreeSampler::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+//get the positions of the rotors of the RPs
+static void getPositions(std::vector<double>& positions, const TRoboticPositionerList& RPL)
+{
+    positions.clear();
+    for(int i=0; i<RPL.getCount(); i++) {
+        positions.push_back(RPL[i]->getActuator()->getp_1());
+        positions.push_back(RPL[i]->getActuator()->getArm()->getp___3());
+    }
+}
+
+void TestCollisionFreeSampler::test_build()
+{
+    try {
+        TCollisionFreeSampler CFS(&FMM.RPL);
+
+        //the adjacent RPs shall have different colors
+        for(int i=0; i<FMM.RPL.getCount(); i++) {
+            TActuator *A = FMM.RPL[i]->getActuator();
+            for(int k=0; k<A->AdjacentRPs.getCount(); k++) {
+                int j = FMM.RPL.search(A->AdjacentRPs[k].RP);
+                if(j<FMM.RPL.getCount() && CFS.getColor(i)==CFS.getColor(j)) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+            }
+        }
+
+        //the coloring shall have few colors
+        if(CFS.getNcolors()<2 || 7<CFS.getNcolors()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestCollisionFreeSampler::test_randomizeWithoutCollision()
+{
+    try {
+        FMM.RPL.setPurpose(pGenParPro);
+        TCollisionFreeSampler CFS(&FMM.RPL);
+
+        //the configurations shall be free of collisions
+        for(unsigned long long seed=1; seed<=20; seed++) {
+            if(!CFS.randomizeWithoutCollision(seed)) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            if(FMM.RPL.thereIsCollision()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+
+        //the configuration shall depend only on the seed
+        std::vector<double> positions1, positions2, positions3;
+        CFS.Nthreads = 1;
+        CFS.randomizeWithoutCollision(7);
+        getPositions(positions1, FMM.RPL);
+        CFS.Nthreads = 3;
+        CFS.randomizeWithoutCollision(7);
+        getPositions(positions2, FMM.RPL);
+        CFS.randomizeWithoutCollision(8);
+        getPositions(positions3, FMM.RPL);
+        if(positions1!=positions2 || positions1==positions3) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+//---------------------------------------------------------------------------
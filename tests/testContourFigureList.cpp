@@ -29,6 +29,9 @@
 #include <iostream>
 #include <limits.h> //INT_MAX
 #include <float.h> //DBL_MAX
+#include <math.h> //M_PI
+
+using namespace Models;
 
 //---------------------------------------------------------------------------
 
@@ -49,4 +52,158 @@ void TestContourFigureList::test_()
 {
     CPPUNIT_ASSERT(true);
 }
+void TestContourFigureList::test_distanceMin()
+{
+    try {
+        //build a square of side 2 centered in the origin
+        TContourFigureList A;
+        A.Add(new TSegment(-1, -1, 1, -1));
+        A.Add(new TSegment(1, -1, 1, 1));
+        A.Add(new TSegment(1, 1, -1, 1));
+        A.Add(new TSegment(-1, 1, -1, -1));
+        //build a semicircle of radio 1 centered in the origin
+        TContourFigureList B;
+        B.Add(new TSegment(0, -1, 0, 1));
+        B.Add(new TArc(0, -1, 0, 1, 0, 0, 1));
+
+        //get the contours in several positions,
+        //with and without flat representation
+        TContourFigureList Aw, Bw, Aw_, Bw_;
+        Aw.Copy(A);
+        Bw.Copy(B);
+        for(int i=0; i<16; i++) {
+            double theta = i*M_PI/8;
+            TDoublePoint V(1 + i*0.5, (i%3)*0.7);
+            A.getRotatedAndTranslated(Aw, 0, TDoublePoint(0, 0));
+            B.getRotatedAndTranslated(Bw, theta, V);
+            if(!Aw.flatIsUpdated() || !Bw.flatIsUpdated()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            Aw_.Copy(Aw);
+            Bw_.Copy(Bw);
+            Aw_.invalidateFlat();
+            Bw_.invalidateFlat();
+
+            //the results shall be the same with and without flat representation
+            if(Aw.distanceMin(Bw) != Aw_.distanceMin(Bw_) ||
+                    Bw.distanceMin(Aw) != Bw_.distanceMin(Aw_)) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(int j=0; j<8; j++) {
+                double SPM = j*0.5;
+                if(Aw.collides(Bw, SPM) != Aw_.collides(Bw_, SPM)) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+            }
+        }
+
+        //destroy the figures
+        Destroy(A);
+        Destroy(B);
+        Destroy(Aw);
+        Destroy(Bw);
+        Destroy(Aw_);
+        Destroy(Bw_);
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+void TestContourFigureList::test_invalidateFlat()
+{
+    try {
+        //build a square of side 2 centered in the origin
+        TContourFigureList A;
+        A.Add(new TSegment(-1, -1, 1, -1));
+        A.Add(new TSegment(1, -1, 1, 1));
+        A.Add(new TSegment(1, 1, -1, 1));
+        A.Add(new TSegment(-1, 1, -1, -1));
+        //build a segment to the right of the square
+        TContourFigureList B;
+        B.Add(new TSegment(3, -1, 3, 1));
 
+        //get the square with the flat representation updated
+        TContourFigureList Aw;
+        Aw.Copy(A);
+        A.getRotatedAndTranslated(Aw, 0, TDoublePoint(0, 0));
+        if(!Aw.flatIsUpdated() || Aw.distanceMin(B) != 2) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //replacing a figure without change the number of figures
+        //shall invalidate the flat representation
+        TContourFigure *F = Aw[1];
+        Aw.Set(1, new TSegment(2, -1, 2, 1));
+        delete F;
+        if(Aw.flatIsUpdated() || Aw.distanceMin(B) != 1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //deleting and adding a figure shall invalidate
+        //the flat representation
+        Aw.updateFlat();
+        F = Aw[1];
+        Aw.Delete(1);
+        delete F;
+        Aw.Add(new TSegment(2.5, -1, 2.5, 1));
+        if(Aw.flatIsUpdated() || Aw.distanceMin(B) != 0.5) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //editing a figure in place shall invalidate
+        //the flat representation
+        Aw.updateFlat();
+        Aw[3]->setPa(TDoublePoint(2.75, -1));
+        Aw[3]->setPb(TDoublePoint(2.75, 1));
+        if(Aw.flatIsUpdated() || Aw.distanceMin(B) != 0.25) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        Aw.updateFlat();
+        F = Aw.Get(3);
+        F->translate(TDoublePoint(-0.75, 0));
+        if(Aw.flatIsUpdated() || Aw.distanceMin(B) != 1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        Aw.updateFlat();
+        if(!Aw.flatIsUpdated() || Aw.distanceMin(B) != 1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //clearing the list, also through the inherited methods,
+        //shall invalidate the flat representation
+        Aw.updateFlat();
+        Destroy(Aw);
+        if(Aw.flatIsUpdated()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        Aw.updateFlat();
+        Aw.Clear();
+        if(Aw.flatIsUpdated()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //destroy the figures
+        Destroy(A);
+        Destroy(B);
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
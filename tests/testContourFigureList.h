@@ -35,6 +35,8 @@ class TestContourFigureList : public CppUnit::TestFixture
 
     //add test methods
     CPPUNIT_TEST(test_);
+    CPPUNIT_TEST(test_distanceMin);
+    CPPUNIT_TEST(test_invalidateFlat);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -47,6 +49,8 @@ public:
 
     //test methods
     void test_();
+    void test_distanceMin();
+    void test_invalidateFlat();
 };
 
 #endif // TEST_ContourFigureList_H
@@ -24,11 +24,17 @@
 
 #include "testFMOSA.h"
 #include "../src/FMOSA.h"
+#include "../src/Strings.h"
+#include "../src/StrPR.h"
+#include "../src/TextFile.h"
 //#include "cppunit_assert_emulator.h" //Qt only.
 
 #include <iostream>
 #include <limits.h> //INT_MAX
 #include <float.h> //DBL_MAX
+#include <algorithm> //transform
+#include <chrono>
+#include <cstdio> //remove
 
 //---------------------------------------------------------------------------
 
@@ -43,6 +49,257 @@ void TestFMOSA::setUp() {
 void TestFMOSA::tearDown() {
 }
 
+//---------------------------------------------------------------------------
+//FORMER PARSER:
+
+//The former implementation of TFMOSA::setTableText, which divides
+//the string in lines and fields before translate the values,
+//is kept here as reference of the single pass implementation.
+
+//read the OB section in tampon variables
+static void readOBText(int& _Id, double& _Ra, double& _Dec, double& _Pos,
+                       const string& str)
+{
+    try {
+        //decompose the row in fields
+        TStrings Strings;
+        StrSplit(Strings, str, '|');
+
+        //check the number of fields
+        if(Strings.getCount() != 4)
+            throw EImproperArgument("should have 4 fields separated by '|': \"<Id> | <Ra> | <Dec> | <Pos>\"");
+
+        //trims Id property
+        try {
+            int aux = strToInt(Strings[0].str);
+            if(aux < 0)
+                throw EImproperArgument("value for block identifier Id shouldbe nonnegative");
+            _Id = (unsigned int)aux;
+        } catch(Exception& E) {
+            E.Message.Insert(1, "reading Id: ");
+            throw;
+        }
+
+        //translate the (RA, Dec) properties
+        try {
+            _Ra = strToFloat(Strings[1].str);
+        } catch(Exception& E) {
+            E.Message.Insert(1, "reading Ra: ");
+            throw;
+        }
+        try {
+            _Dec = strToFloat(Strings[2].str);
+        } catch(Exception& E) {
+            E.Message.Insert(1, "reading Dec: ");
+            throw;
+        }
+
+        //translate Pos property (if it is not empty)
+        try {
+            _Pos = strToFloat(Strings[3].str);
+        } catch(Exception& E) {
+            E.Message.Insert(1, "reading Pos: ");
+            throw;
+        }
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "reading OB section: ");
+        throw;
+    }
+}
+
+//set a FMOSA in text format dividing it in lines and fields
+static void setTableTextByLines(TFMOSA& FMOSA, unsigned int& Bid, const string& str)
+{
+    int i; //index to rows
+
+    try {
+        //divide the string str in lines
+        TStrings Strings;
+        StrDivideInLines(Strings, str);
+
+        //--------------------------------------------------------------
+
+        //initialize the index to the first line
+        i = 0;
+
+        //check if there are more lines
+        if(i >= Strings.getCount())
+            throw EImproperArgument("label @@SOB@@ not found");
+
+        //--------------------------------------------------------------
+
+        //discard the empty lines and read the comments
+        TFMOSA t_FMOSA;
+        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0)) {
+            if(strFirstNonseparatorChar(Strings[i].str)=='#')
+                t_FMOSA.comments.Add(StrTrim(Strings[i]));
+            i++;
+        }
+
+        //delete the header of the OB
+        try {
+            string str = t_FMOSA.comments[t_FMOSA.comments.getCount() - 1].str;
+            transform(str.begin(), str.end(), str.begin(), (int (*)(int))tolower);
+            unsigned int i = 0;
+            strTravelSeparatorsIfAny(str, i);
+            strTravelLabel("#", str, i);
+            strTravelSeparatorsIfAny(str, i);
+            strTravelLabel("id", str, i);
+            strTravelSeparatorsIfAny(str, i);
+            strTravelLabel("|", str, i);
+            strTravelSeparatorsIfAny(str, i);
+            strTravelLabel("ra", str, i);
+            strTravelSeparatorsIfAny(str, i);
+            strTravelLabel("|", str, i);
+            strTravelSeparatorsIfAny(str, i);
+            strTravelLabel("dec", str, i);
+            strTravelSeparatorsIfAny(str, i);
+            strTravelLabel("|", str, i);
+            strTravelSeparatorsIfAny(str, i);
+            strTravelLabel("pos", str, i);
+            t_FMOSA.comments.setCount(t_FMOSA.comments.getCount() - 1);
+        }
+        catch(...) {
+            //do nothing
+        }
+
+        //check if there are more lines
+        if(i >= Strings.getCount())
+            throw EImproperArgument("label @@SOB@@ not found");
+
+        //check if actual line contains the label @@SOB@@
+        if(StrTrim(Strings[i]) != AnsiString("@@SOB@@"))
+            throw EImproperArgument("label @@SOB@@ not found");
+
+        //discard the label @@SOB@@
+        i++;
+
+        //discard the coments and empty lines
+        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
+            i++;
+
+        //check if there are more lines
+        if(i >= Strings.getCount())
+            throw EImproperArgument("OB parameters not found: <Id> | <Ra> | <Dec> | <Pos>");
+
+        //read the OB section in tampon variables
+        int t_Id;
+        readOBText(t_Id, t_FMOSA.Ra, t_FMOSA.Dec, t_FMOSA.Pos, Strings[i].str);
+
+        //contabilize the readed line
+        i++;
+
+        //discard the coments and empty lines
+        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
+            i++;
+
+        //check if there are more lines
+        if(i >= Strings.getCount())
+            throw EImproperArgument("label @@EOB@@ not found");
+
+        //check if actual line contains the label @@EOB@@
+        if(StrTrim(Strings[i]) != AnsiString("@@EOB@@"))
+            throw EImproperArgument("label @@EOB@@ not found");
+
+        //discard the label @@EOB@@
+        i++;
+
+        //check if there are more lines
+        if(i >= Strings.getCount())
+            throw EImproperArgument("label @@SOS@@ not found");
+
+        //--------------------------------------------------------------
+
+        //discard the coments and empty lines
+        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i]).Length()<=0))
+            i++;
+
+        //check if there are more lines
+        if(i >= Strings.getCount())
+            throw EImproperArgument("label @@SOS@@ not found");
+
+        //check if actual line contains the label @@SOS@@
+        if(StrTrim(Strings[i]) != AnsiString("@@SOS@@"))
+            throw EImproperArgument("label @@SOS@@ not found");
+
+        //discard the label @@SOS@@
+        i++;
+
+        //discard the coments and empty lines
+        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
+            i++;
+
+        //check if there are more lines
+        if(i >= Strings.getCount())
+            throw EImproperArgument("OS parameters not found: \"<Name> | <RA> | <Dec> | <Mag> | <Type> | <Pr> | <Bid> | <Pid> | <X(mm)> | <Y(mm)> | | <Angle(deg)> | <Enabled> | <Comment>\"");
+
+        //read all lines (using a tampon variable) until the close label @@EOS@
+        try {
+            while(i<Strings.getCount() && StrTrim(Strings[i])!=AnsiString("@@EOS@@")) {
+                TObservingSource *OS = new TObservingSource();
+                t_FMOSA.Add(OS);
+                OS->setText(Strings[i].str);
+
+                //check the precondition
+                if(OS->Type != ptUNKNOWN)
+                    if(OS->Bid != (unsigned int)t_Id)
+                        throw EImproperArgument("all Bid should be equal to Id");
+
+                i++;
+            }
+        }
+        catch(Exception& E) {
+            E.Message.Insert(1, "setting OS section: ");
+            throw;
+        }
+
+        //discard the coments and empty lines
+        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i].str).Length()<=0))
+            i++;
+
+        //check if there are more lines
+        if(i >= Strings.getCount())
+            throw EImproperArgument("label @@EOS@@ not found");
+
+        //check if actual line contains the label @@EOS@@
+        if(StrTrim(Strings[i]) != AnsiString("@@EOS@@"))
+            throw EImproperArgument("label @@EOS@@ not found");
+
+        //discard the label @@EOS@@
+        i++;
+
+        //discard the coments and empty lines
+        while(i<Strings.getCount() && (strFirstNonseparatorChar(Strings[i].str)=='#' || StrTrim(Strings[i]).Length()<=0))
+            i++;
+
+        //look for unexpected text
+        if(i < Strings.getCount())
+            throw EImproperArgument("only should to be OB and OS block");
+
+        //--------------------------------------------------------------
+
+        //set the tampons variables
+        t_FMOSA.Id = (unsigned int)t_Id;
+        FMOSA = t_FMOSA;
+
+        //REMEMBER: not define the operator= may produce erased of attributes. E.i:
+        //  FMOSA = t_FMOSA;
+        //When TFMOSA::operator= is not defined, is called the function TPointersList<>::operator=,
+        //but properties of the FMOSA also will be assigned.
+
+        //set the last valid setted string
+        FMOSA.str_original = str;
+
+        //return the Bid value
+        Bid = FMOSA.Id;
+    }
+    catch(Exception& E) {
+        E.Message.Insert(1, "setting FMOSA in text format in row "+inttostr(i+1)+": ");
+        throw;
+    }
+}
+
 //---------------------------------------------------------------------------
 
 void TestFMOSA::test_()
@@ -159,3 +416,210 @@ void TestFMOSA::test_()
     CPPUNIT_ASSERT(true);
 }
 
+void TestFMOSA::test_setTableText()
+{
+    //build a string with the content of a FMOSA file
+    string str;
+    str = "# Title: test";
+    str += "\r\n";
+    str += "\r\n# Id| Ra\t | Dec\t      | Pos";
+    str += "\r\n@@SOB@@";
+    str += "\r\n  3 | 15.027879| 45.000422| -0.060858";
+    str += "\r\n@@EOB@@";
+    str += "\r\n#      Name         |    RA   |    Dec  | Mag |     Type       |Pr|Bid|Pid| X(mm)  | Y(mm)  | Angle(deg) | Enabled| Comment";
+    str += "\r\n@@SOS@@";
+    str += "\r\ns:751     |15.027787|45.017925|20.67|SOURCE   |6 |3  |1  |-0.137909 |51.932865 |0.5   |1    |foo comment  ";
+    str += "\r\n          |15.003376|45.028110|     |UNKNOWN  |  |   |2  |-51.296480|82.217116 |0     |0    |";
+    str += "\r\ns:397     |15.039336|45.029960|1.8e1|REFERENCE|0 |3  |3  |24.11823  |-8.76e+1  |-1.25 |True |";
+    str += "\r\nblank     |+15      |45.      |18.02|BLANK    |+2|3  |4  |0         |0         |360   |false |x";
+
+    //add synthetic sources
+    for(int i=5; i<=1000; i++) {
+        str += "\r\ns:"+inttostr(i)+" |"+floattostr(15 + i*1e-4)+"|"+floattostr(45 - i*1e-4)+"|"+floattostr(18 + (i%7)*0.25);
+        str += "|SOURCE|"+inttostr(i%10)+"|3|"+inttostr(i)+"|"+floattostr(i*0.0173 - 8)+"|"+floattostr(8 - i*0.0191);
+        str += "|"+floattostr(i*0.37)+"|"+inttostr(i%2)+"|";
+    }
+    str += "\r\n@@EOS@@";
+    str += "\r\n";
+
+    //set the string with both parsers
+    TFMOSA FMOSA1, FMOSA2;
+    unsigned int Bid1, Bid2;
+    try {
+        setTableTextByLines(FMOSA1, Bid1, str);
+        FMOSA2.setTableText(Bid2, str);
+    }
+    catch(Exception& E) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check that both FMOSAs are equal
+    if(Bid1!=3 || Bid2!=3 || FMOSA1.Id!=FMOSA2.Id || FMOSA1.Ra!=FMOSA2.Ra ||
+            FMOSA1.Dec!=FMOSA2.Dec || FMOSA1.Pos!=FMOSA2.Pos ||
+            FMOSA1.str_original!=FMOSA2.str_original) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    if(FMOSA1.comments.getCount()!=1 || FMOSA2.comments.getCount()!=1 ||
+            FMOSA1.comments[0]!=FMOSA2.comments[0]) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    if(FMOSA1.getCount()!=1000 || FMOSA2.getCount()!=1000) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    for(int i=0; i<FMOSA1.getCount(); i++)
+        if(FMOSA1[i] != FMOSA2[i] ||
+                FMOSA1[i].Name != FMOSA2[i].Name ||
+                FMOSA1[i].Comment != FMOSA2[i].Comment ||
+                FMOSA1[i].Angle != FMOSA2[i].Angle) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    //check some values
+    TObservingSource *OS = FMOSA2.GetPointer(2);
+    if(OS->Mag!=18 || OS->Type!=ptREFERENCE || OS->Y!=-87.6 || OS->Enabled!=true) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    OS = FMOSA2.GetPointer(1);
+    if(OS->there_is_Mag || OS->there_is_Pr || OS->there_is_Bid || OS->Comment!="") {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //an error should indicate the row and the column
+    string str_error = str;
+    size_t i = str_error.find("|45.028110|");
+    str_error.replace(i, 11, "|45.0281x0|");
+    try {
+        FMOSA2.setTableText(Bid2, str_error);
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    catch(Exception& E) {
+        if(E.Message.str.find("in row 10, column 22: ") == string::npos) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+    //the FMOSA should not be modified
+    if(FMOSA2.getCount() != 1000) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //a missing label should be detected
+    str_error = str;
+    str_error.replace(str_error.find("@@SOB@@"), 7, "@@SOX@@");
+    try {
+        FMOSA2.setTableText(Bid2, str_error);
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    catch(Exception& E) {
+        if(E.Message.str.find("in row 4, column 1: label @@SOB@@ not found") == string::npos) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestFMOSA::test_setTableTextLarge()
+{
+    //number of OSs of the synthetic FMOSA
+    const int Nsources = 5000;
+    //number of repetitions of the reading
+    const int Nrep = 5;
+
+    //build a synthetic FMOSA, with an OS allocated to each RP
+    //of a hive of 1000 RPs and the other OSs not allocated
+    const int NRPs = 1000;
+    string str = "# Title: synthetic FMOSA";
+    str += "\r\n# Description: "+inttostr(Nsources)+" observing sources";
+    str += "\r\n# Id| Ra\t | Dec\t      | Pos";
+    str += "\r\n@@SOB@@";
+    str += "\r\n1 |15.027879 |45.000422 |0.060858";
+    str += "\r\n@@EOB@@";
+    str += "\r\n#      Name         |    RA   |    Dec  | Mag |     Type       |Pr|Bid|Pid| X(mm)  | Y(mm)  | Angle(deg) | Enabled| Comment";
+    str += "\r\n@@SOS@@";
+    for(int k=0; k<Nsources; k++) {
+        double x = (k%NRPs)%40*20.1 - 400 + (k%13)*0.37;
+        double y = (k%NRPs)/40*17.4 - 200 - (k%11)*0.41;
+        str += "\r\ns:"+inttostr(k)+" |"+floattostr_fixed(15 + x*1e-4, 6)+" |"+floattostr_fixed(45 + y*1e-4, 6);
+        if(k < NRPs) {
+            str += " |"+floattostr_fixed(16 + (k%23)*0.25, 2)+" |SOURCE |"+inttostr(k%10)+" |1";
+            str += " |"+inttostr(k + 1)+" |"+floattostr_fixed(x, 6)+" |"+floattostr_fixed(y, 6);
+            str += " |"+floattostr_fixed((k*37)%360 + 0.5, 6)+" |"+inttostr(k%2)+" |";
+        } else {
+            str += " | |UNKNOWN | | |"+inttostr(k%NRPs + 1)+" |"+floattostr_fixed(x, 6)+" |"+floattostr_fixed(y, 6);
+            str += " |0 |0 |";
+        }
+    }
+    str += "\r\n@@EOS@@";
+
+    //write the FMOSA in a file
+    string path = "FMOSA_synthetic.txt";
+    strWriteToFile(path, str);
+
+    TFMOSA FMOSA1, FMOSA2;
+    string str1, str2;
+    unsigned int Bid1, Bid2;
+    double T1, T2;
+    try {
+        //read the FMOSA with the former parser
+        auto t1 = std::chrono::steady_clock::now();
+        for(int r=0; r<Nrep; r++) {
+            TTextFile TF(path.c_str(), (char*)"r");
+            TF.Read(str1);
+            TF.Close();
+            strreplace(str1, "\r\r\n", "\r\n");
+            setTableTextByLines(FMOSA1, Bid1, str1);
+        }
+
+        //read the FMOSA with the single pass parser
+        auto t2 = std::chrono::steady_clock::now();
+        for(int r=0; r<Nrep; r++) {
+            strReadFromFileWithComments(str2, path);
+            FMOSA2.setTableText(Bid2, str2);
+        }
+        auto t3 = std::chrono::steady_clock::now();
+
+        T1 = std::chrono::duration<double>(t2 - t1).count()/Nrep;
+        T2 = std::chrono::duration<double>(t3 - t2).count()/Nrep;
+    }
+    catch(Exception& E) {
+        remove(path.c_str());
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    remove(path.c_str());
+
+    //both ways should get the same FMOSA
+    if(str1!=str2 || Bid1!=1 || Bid2!=1 || FMOSA1.getCount()!=Nsources || FMOSA2.getCount()!=Nsources ||
+            FMOSA1.comments.getCount()!=FMOSA2.comments.getCount()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    for(int i=0; i<FMOSA1.getCount(); i++)
+        if(FMOSA1[i] != FMOSA2[i] ||
+                FMOSA1[i].Name != FMOSA2[i].Name ||
+                FMOSA1[i].Comment != FMOSA2[i].Comment ||
+                FMOSA1[i].Angle != FMOSA2[i].Angle) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    //print the times of reading
+    cout << endl << "Time of reading of a FMOSA file with " << Nsources << " OSs ("
+         << str.length() << " bytes, average of " << Nrep << " readings):" << endl;
+    cout << "    by lines:    " << T1 << " s" << endl;
+    cout << "    single pass: " << T2 << " s" << endl;
+
+    CPPUNIT_ASSERT(true);
+}
@@ -32,6 +32,7 @@
 #include <limits> //std::numeric_limits
 
 #include "../src/FiberMOSModel.h"
+#include "../src/FileMethods.h"
 
 //using namespace Mathematics;
 using namespace Lists;
@@ -70,3 +71,148 @@ void TestFiberMOSModel::test_()
     CPPUNIT_ASSERT(true);
 }
 
+
+void TestFiberMOSModel::test_assimilate_Changed()
+{
+    try {
+        //load two instances of the Fiber MOS Model
+        TFiberMOSModel FMM1, FMM2;
+        readInstanceFromDir(FMM1, "../data/Models/MEGARA_FiberMOSModel_Instance");
+        readInstanceFromDir(FMM2, "../data/Models/MEGARA_FiberMOSModel_Instance");
+
+        //change the RPs of both instances in the same way,
+        //so that the adjacents of some RPs change
+        TItemsList<TRoboticPositioner*> Changed;
+        int indices[] = {0, 17, 45, 46, 90};
+        for(int k=0; k<5; k++) {
+            int i = indices[k];
+            FMM1.RPL[i]->getActuator()->setP0(FMM1.RPL[i]->getActuator()->getP0() + TDoublePoint(11.0, -4.0));
+            FMM2.RPL[i]->getActuator()->setP0(FMM2.RPL[i]->getActuator()->getP0() + TDoublePoint(11.0, -4.0));
+            Changed.Add(FMM2.RPL[i]);
+        }
+
+        //assimilate the changes fully and incrementally
+        FMM1.assimilate();
+        FMM2.assimilate(Changed);
+
+        //check that the adjacency and the safe parameters are the same
+        for(int i=0; i<FMM1.RPL.getCount(); i++) {
+            TActuator *A1 = FMM1.RPL[i]->getActuator();
+            TActuator *A2 = FMM2.RPL[i]->getActuator();
+            if(A1->AdjacentRPs.getIdText() != A2->AdjacentRPs.getIdText() ||
+                    A1->AdjacentEAs.getIdText() != A2->AdjacentEAs.getIdText() ||
+                    A1->getr_min() != A2->getr_min() || A1->getr_saf() != A2->getr_saf() ||
+                    A1->gettheta___3saf() != A2->gettheta___3saf()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(int j=0; j<A2->AdjacentRPs.getCount(); j++) {
+                TAdjacencyEdge *E = A2->AdjacentRPs[j].Edge;
+                if(E == NULL || (E->RP1 != FMM2.RPL[i] && E->RP2 != FMM2.RPL[i])) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+            }
+        }
+        for(int i=0; i<FMM1.EAL.getCount(); i++) {
+            TExclusionArea *EA1 = FMM1.EAL[i];
+            TExclusionArea *EA2 = FMM2.EAL[i];
+            if(EA1->AdjacentRPs.getCount() != EA2->AdjacentRPs.getCount()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(int j=0; j<EA1->AdjacentRPs.getCount(); j++)
+                if(EA1->AdjacentRPs[j]->getActuator()->getId() != EA2->AdjacentRPs[j]->getActuator()->getId()) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+        }
+        if(FMM1.RPL.getLO3max() != FMM2.RPL.getLO3max()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestFiberMOSModel::test_restoreState()
+{
+    try {
+        //load an instance of the Fiber MOS Model and build a clone
+        TFiberMOSModel FMM;
+        readInstanceFromDir(FMM, "../data/Models/MEGARA_FiberMOSModel_Instance");
+        TFiberMOSModel FMM_initial(&FMM);
+
+        //change the state of some RPs
+        int indices[] = {0, 17, 45, 46, 90};
+        for(int k=0; k<5; k++) {
+            TRoboticPositioner *RP = FMM.RPL[indices[k]];
+            RP->getActuator()->settheta_1(RP->getActuator()->gettheta_1() + 1);
+            RP->getActuator()->setPurpose(pValDP);
+            RP->Disabled = !RP->Disabled;
+        }
+
+        //restore the state
+        FMM.restoreState(FMM_initial);
+
+        //check that the state is the initial state
+        //and that the adjacents point to the RPs and EAs of the FMM
+        for(int i=0; i<FMM.RPL.getCount(); i++) {
+            TRoboticPositioner *RP = FMM.RPL[i];
+            TRoboticPositioner *RP_ = FMM_initial.RPL[i];
+            TActuator *A = RP->getActuator();
+            TActuator *A_ = RP_->getActuator();
+            if(A->gettheta_1() != A_->gettheta_1() ||
+                    A->getArm()->gettheta___3() != A_->getArm()->gettheta___3() ||
+                    A->getPurpose() != A_->getPurpose() ||
+                    RP->Disabled != RP_->Disabled ||
+                    A->AdjacentRPs.getIdText() != A_->AdjacentRPs.getIdText() ||
+                    A->AdjacentEAs.getIdText() != A_->AdjacentEAs.getIdText()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            for(int j=0; j<A->AdjacentRPs.getCount(); j++) {
+                int k = 0;
+                while(k<FMM.RPL.getCount() && FMM.RPL[k]!=A->AdjacentRPs[j].RP)
+                    k++;
+                if(k >= FMM.RPL.getCount()) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+            }
+            for(int j=0; j<A->AdjacentEAs.getCount(); j++) {
+                int k = 0;
+                while(k<FMM.EAL.getCount() && FMM.EAL[k]!=A->AdjacentEAs[j].EA)
+                    k++;
+                if(k >= FMM.EAL.getCount()) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+            }
+        }
+        if(FMM.thereIsCollision() != FMM_initial.thereIsCollision()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //a FMM with other RPs can't be used for restore the state
+        TFiberMOSModel FMM_empty;
+        try {
+            FMM.restoreState(FMM_empty);
+            CPPUNIT_ASSERT(false);
+            return;
+        } catch(EImproperArgument&) {
+        }
+
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
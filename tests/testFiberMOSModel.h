@@ -35,6 +35,8 @@ class TestFiberMOSModel : public CppUnit::TestFixture
 
     //add test methods
     CPPUNIT_TEST(test_);
+    CPPUNIT_TEST(test_assimilate_Changed);
+    CPPUNIT_TEST(test_restoreState);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -47,6 +49,8 @@ public:
 
     //test methods
     void test_();
+    void test_assimilate_Changed();
+    void test_restoreState();
 };
 
 #endif // FMPT_TESTFIBERMOSMODEL_H
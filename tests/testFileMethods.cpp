@@ -1013,3 +1013,124 @@ void TestFileMethods::test_readInstanceFromDir_FMM()
 
     CPPUNIT_ASSERT(true);
 }
+
+void TestFileMethods::test_readInstanceFromCache_FMM()
+{
+    //read an original instance of a FMM from a directory
+    TFiberMOSModel FMM;
+    string dir = "../data/Models/MEGARA_FiberMOSModel_Instance";
+    ///string dir = "../megara-fmpt/data/Models/MEGARA_FiberMOSModel_Instance"; //Qt only
+    readInstanceFromDir(FMM, dir);
+
+    //write the instance of the FMM in a temporal directory without cache
+    string dir_ = "../data/MEGARA_FiberMOSModel_Instance_cache_temporal";
+    ///string dir_ = "../megara-fmpt/data/MEGARA_FiberMOSModel_Instance_cache_temporal"; //Qt only
+    writeInstanceToDir(dir_, FMM);
+    string cache_path = dir_+"/InstanceCache.bin";
+    remove(cache_path.c_str());
+
+    //without cache the instance can't be read from the cache
+    TFiberMOSModel FMM_;
+    if(readInstanceFromCache(FMM_, dir_) || FMM_.RPL.getCount() != 0) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //read the instance from the text files and write the cache
+    //with the function to test
+    TFiberMOSModel FMM_text;
+    readInstanceFromDir(FMM_text, dir_);
+    writeInstanceCacheToDir(dir_, FMM_text);
+
+    //read the instance from the cache with the function to test
+    if(!readInstanceFromCache(FMM_, dir_)) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //--------------------------------------------------------------
+
+    //compare the instances
+    if(FMM_.getInstanceText() != FMM_text.getInstanceText() ||
+            FMM_.EAL.getCount() != FMM_text.EAL.getCount() ||
+            FMM_.RPL.getCount() != FMM_text.RPL.getCount()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    for(int i=0; i<FMM_.EAL.getCount(); i++) {
+        TExclusionArea *EA = FMM_.EAL[i];
+        TExclusionArea *EA_text = FMM_text.EAL[i];
+
+        if(EA->getOriginsRowText() != EA_text->getOriginsRowText() ||
+                EA->getContour_Text() != EA_text->getContour_Text() ||
+                EA->getInstanceText() != EA_text->getInstanceText() ||
+                EA->AdjacentRPs.getCount() != EA_text->AdjacentRPs.getCount()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(int j=0; j<EA->AdjacentRPs.getCount(); j++)
+            if(EA->AdjacentRPs[j]->getActuator()->getId() != EA_text->AdjacentRPs[j]->getActuator()->getId()) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+    }
+    for(int i=0; i<FMM_.RPL.getCount(); i++) {
+        TRoboticPositioner *RP = FMM_.RPL[i];
+        TRoboticPositioner *RP_text = FMM_text.RPL[i];
+        TActuator *A = RP->getActuator();
+        TActuator *A_text = RP_text->getActuator();
+
+        if(A->getOriginsRowText() != A_text->getOriginsRowText() ||
+                RP->getContour____Text() != RP_text->getContour____Text() ||
+                RP->getContour_Text() != RP_text->getContour_Text() ||
+                RP->getF1Text() != RP_text->getF1Text() ||
+                RP->getF2Text() != RP_text->getF2Text() ||
+                RP->getInstanceText() != RP_text->getInstanceText()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the positions and the assimilated values shall be identical
+        if(A->gettheta_1() != A_text->gettheta_1() ||
+                A->getArm()->gettheta___3() != A_text->getArm()->gettheta___3() ||
+                A->getArm()->getP3() != A_text->getArm()->getP3() ||
+                A->getr_min() != A_text->getr_min() ||
+                A->getr_saf() != A_text->getr_saf() ||
+                A->getSPMall_a() != A_text->getSPMall_a() ||
+                A->AdjacentRPs.getIdText() != A_text->AdjacentRPs.getIdText() ||
+                A->AdjacentEAs.getIdText() != A_text->AdjacentEAs.getIdText()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+
+    //--------------------------------------------------------------
+
+    //modify a text file of the instance
+    string str;
+    strReadFromFile(str, dir_+"/Instance.txt");
+    strWriteToFile(dir_+"/Instance.txt", str+"\r\n");
+
+    //the cache is stale, so the instance can't be read from the cache,
+    //and the FMM shall not be modified
+    TFiberMOSModel FMM_stale;
+    if(readInstanceFromCache(FMM_stale, dir_) || FMM_stale.RPL.getCount() != 0) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //but the instance can be read from the text files
+    readInstanceFromDir(FMM_stale, dir_);
+    if(FMM_stale.RPL.getCount() != FMM_text.RPL.getCount()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //restore the temporal directory
+    strWriteToFile(dir_+"/Instance.txt", str);
+    remove(cache_path.c_str());
+
+    //--------------------------------------------------------------
+
+    CPPUNIT_ASSERT(true);
+}
@@ -816,3 +816,64 @@ void TestGeometry::test_()
 
     CPPUNIT_ASSERT(true);
 }
+
+void TestGeometry::test_distanceSegmentSegments()
+{
+    //the batched distances should be bit to bit equal than the distances
+    //calculated pair to pair, including a segment reduced to a point,
+    //parallel, collinear and intersecting segments, and a number of
+    //segments which is not multiple of the lanes
+    const unsigned int N = 103;
+    double xa[N], ya[N], xb[N], yb[N], D[N];
+
+    for(int k=0; k<100; k++) {
+        TDoublePoint Pa(RandomUniform(-10., 10.), RandomUniform(-10., 10.));
+        TDoublePoint Pb(RandomUniform(-10., 10.), RandomUniform(-10., 10.));
+        if(k == 0)
+            Pb = Pa;
+
+        for(unsigned int j=0; j<N; j++) {
+            xa[j] = RandomUniform(-10., 10.);
+            ya[j] = RandomUniform(-10., 10.);
+            xb[j] = RandomUniform(-10., 10.);
+            yb[j] = RandomUniform(-10., 10.);
+        }
+        //segment reduced to a point
+        xb[0] = xa[0];
+        yb[0] = ya[0];
+        //parallel segment
+        xa[1] = Pa.x + 1;
+        ya[1] = Pa.y;
+        xb[1] = Pb.x + 1;
+        yb[1] = Pb.y;
+        //collinear segment
+        xa[2] = Pa.x + 2*(Pb.x - Pa.x);
+        ya[2] = Pa.y + 2*(Pb.y - Pa.y);
+        xb[2] = Pa.x + 3*(Pb.x - Pa.x);
+        yb[2] = Pa.y + 3*(Pb.y - Pa.y);
+        //intersecting segment
+        xa[3] = Pa.x;
+        ya[3] = Pb.y;
+        xb[3] = Pb.x;
+        yb[3] = Pa.y;
+        //the same segment
+        xa[4] = Pa.x;
+        ya[4] = Pa.y;
+        xb[4] = Pb.x;
+        yb[4] = Pb.y;
+
+        distanceSegmentSegments(D, Pa, Pb, xa, ya, xb, yb, N);
+
+        for(unsigned int j=0; j<N; j++) {
+            double d = distanceSegmentSegment(Pa, Pb,
+                                              TDoublePoint(xa[j], ya[j]),
+                                              TDoublePoint(xb[j], yb[j]));
+            if(D[j] != d) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+    }
+
+    CPPUNIT_ASSERT(true);
+}
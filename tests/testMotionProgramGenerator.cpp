@@ -189,6 +189,55 @@ void TestMotionProgramGenerator::test_generateParkProg()
 
     CPPUNIT_ASSERT(true);
 }
+void TestMotionProgramGenerator::test_generatePairPPDP_Nthreads()
+{
+    //generate the pair (PP, DP) with one and with several threads
+    string PPtext[2], DPtext[2];
+    for(int i=0; i<2; i++) {
+        //build a simple FMM
+        TFiberMOSModel FMM;
+        FMM.RPL.Add(new TRoboticPositioner(2, TDoublePoint(-60.3, 87.035553)));
+        FMM.RPL.Add(new TRoboticPositioner(4, TDoublePoint(-40.2, 87.035553)));
+        FMM.assimilate();
+
+        //set an allocation for each RP
+        TMotionProgramGenerator MPG(&FMM);
+        MPG.Nthreads = (i == 0) ? 1 : 4;
+        MPG.Add(new TAllocation(FMM.RPL[0], -60.3, 97.035553));
+        MPG.Add(new TAllocation(FMM.RPL[1], -40.2, 77.035553));
+
+        //move the RPs to the more closer stable position to the allocated projection points
+        MPG.MoveToTargetP3();
+
+        //segregates the operative outsider RPs
+        TRoboticPositionerList Outsiders;
+        FMM.RPL.segregateOperativeOutsiders(Outsiders);
+
+        //generate the pair (PP, DP)
+        bool PPvalid, DPvalid;
+        TRoboticPositionerList Collided;
+        TRoboticPositionerList Obstructed;
+        TMotionProgram PP, DP;
+        MPG.generatePairPPDP(PPvalid, DPvalid, Collided, Obstructed, PP, DP, Outsiders);
+
+        //check that the generated MPs are valid
+        if(!PPvalid || !DPvalid) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        PPtext[i] = PP.getText().str;
+        DPtext[i] = DP.getText().str;
+    }
+
+    //check that the result not depends on the number of threads
+    if(PPtext[0] != PPtext[1] || DPtext[0] != DPtext[1]) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
 /*void TestMotionProgramGenerator::test_generatePairPPDP_online()
 {
     //build a simple FMM
@@ -36,6 +36,7 @@ class TestMotionProgramGenerator : public CppUnit::TestFixture
     //add test methods
     CPPUNIT_TEST(test_generatePairPPDP);
     CPPUNIT_TEST(test_generateParkProg);
+    CPPUNIT_TEST(test_generatePairPPDP_Nthreads);
     //CPPUNIT_TEST(test_generatePairPPDP_online);
     //CPPUNIT_TEST(test_generateParkProg_online);
 
@@ -51,6 +52,7 @@ public:
     //test methods
     void test_generatePairPPDP();
     void test_generateParkProg();
+    void test_generatePairPPDP_Nthreads();
     void test_generatePairPPDP_online();
     void test_generateParkProg_online();
 };
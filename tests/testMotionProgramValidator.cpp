@@ -138,3 +138,618 @@ void TestMotionProgramValidator::test_checkPairPPDP()
 
     CPPUNIT_ASSERT(true);
 }
+void TestMotionProgramValidator::test_ClearanceProfile()
+{
+    try {
+        //build a profile of a pair (RP1, RP2) with vmaxabs = 0.5 mm/ms
+        TClearanceProfile CP(1, 2, false, 0, 0.5);
+        if(CP.getDmin()!=DBL_MAX || CP.getDlow(0)!=DBL_MAX) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //add the samples
+        CP.addSample(0, 10);
+        CP.addSample(4, 6);
+        CP.addSample(10, 8);
+
+        //check the minimun distance and its time
+        if(CP.getDmin()!=6 || CP.gettDmin()!=4) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        //check the lower bound in a sample and between two samples
+        if(CP.getDlow(4)!=6 || CP.getDlow(7)!=4.5) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //check the search in a list
+        TClearanceProfileList CPL;
+        CPL.Add(new TClearanceProfile(1, 2, false, 0, 0.5));
+        CPL.Add(new TClearanceProfile(1, 3, true, 0, 0.5));
+        if(CPL.search(0, 1, 3, true)!=1 || CPL.search(1, 1, 2, false)!=CPL.getCount()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+void TestMotionProgramValidator::test_segregateRPsInClusters()
+{
+    try {
+        //segregate all RPs of the FMM
+        TRoboticPositionerList RPL;
+        for(int i=0; i<FMM.RPL.getCount(); i++)
+            RPL.Add(FMM.RPL[i]);
+        TPointersList<TRoboticPositionerList> Clusters;
+        segregateRPsInClusters(Clusters, RPL);
+
+        //each RP shall be in a cluster, with all its adjacents
+        int count = 0;
+        for(int i=0; i<Clusters.getCount(); i++) {
+            const TRoboticPositionerList& Cluster = Clusters[i];
+            count += Cluster.getCount();
+            for(int j=0; j<Cluster.getCount(); j++) {
+                TRoboticPositioner *RP = Cluster[j];
+                for(int k=0; k<RP->getActuator()->AdjacentRPs.getCount(); k++)
+                    if(Cluster.Search(RP->getActuator()->AdjacentRPs[k].RP) >= Cluster.getCount()) {
+                        CPPUNIT_ASSERT(false);
+                        return;
+                    }
+            }
+        }
+        if(count != RPL.getCount()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //segregate three RPs not adjacent between them
+        RPL.Clear();
+        RPL.Add(FMM.RPL[FMM.RPL.searchId(1)]);
+        RPL.Add(FMM.RPL[FMM.RPL.searchId(50)]);
+        RPL.Add(FMM.RPL[FMM.RPL.searchId(100)]);
+        segregateRPsInClusters(Clusters, RPL);
+        if(Clusters.getCount() != 3) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(int i=0; i<Clusters.getCount(); i++)
+            if(Clusters[i].getCount()!=1 || Clusters[i][0]!=RPL[i]) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+void TestMotionProgramValidator::test_Overlay()
+{
+    try {
+        //point the RP1 of the FMM and save their position
+        TRoboticPositioner *RP = FMM.RPL[FMM.RPL.searchId(1)];
+        RP->getActuator()->enableQuantification();
+        double p_1 = RP->getActuator()->getp_1();
+
+        //build a clon of the RP1 (without edges), in other position
+        TRoboticPositioner *RP_ = new TRoboticPositioner(RP);
+        RP_->getActuator()->setp_1(p_1 + 1000);
+
+        //build a MP for move the clon to the origin
+        TMotionProgram MP;
+        TMessageList *ML = new TMessageList();
+        TMessageInstruction *MI = new TMessageInstruction();
+        MI->setId(1);
+        RP_->getInstructionToGoToTheOrigin(MI->Instruction);
+        ML->Add(MI);
+        MP.Add(ML);
+        TMotionProgram MP_;
+        MP_.Clone(MP);
+
+        //validate the MP in the overlay
+        TRoboticPositionerList Overlay;
+        Overlay.Add(RP_);
+        MPV.setOverlay(&Overlay);
+        bool valid_ = MPV.validateMotionProgram(MP_);
+        MPV.setOverlay(NULL);
+        double p_1_ = RP_->getActuator()->getp_1();
+        delete RP_;
+
+        //the RP of the FMM shall not be moved
+        if(RP->getActuator()->getp_1() != p_1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //validate the MP in the FMM, from the same position
+        RP->getActuator()->setp_1(p_1 + 1000);
+        bool valid = MPV.validateMotionProgram(MP);
+        double p_1end = RP->getActuator()->getp_1();
+        RP->getActuator()->setp_1(p_1);
+
+        //the results shall be the same
+        if(valid!=valid_ || p_1end!=p_1_ || MP.getText().str!=MP_.getText().str) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+void TestMotionProgramValidator::test_statistics()
+{
+    try {
+        //point the RP1 of the FMM and save their position
+        TRoboticPositioner *RP = FMM.RPL[FMM.RPL.searchId(1)];
+        RP->getActuator()->enableQuantification();
+        double p_1 = RP->getActuator()->getp_1();
+
+        //build a MP for move the RP1 to the origin from other position
+        RP->getActuator()->setp_1(p_1 + 1000);
+        TMotionProgram MP;
+        TMessageList *ML = new TMessageList();
+        TMessageInstruction *MI = new TMessageInstruction();
+        MI->setId(1);
+        RP->getInstructionToGoToTheOrigin(MI->Instruction);
+        ML->Add(MI);
+        MP.Add(ML);
+
+        //validate the MP from the reseted statistics
+        MPV.resetStatistics();
+        if(MPV.getNsteps()!=0 || MPV.getNdistances()!=0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        MPV.validateMotionProgram(MP);
+        unsigned long long Nsteps = MPV.getNsteps();
+        unsigned long long Ndistances = MPV.getNdistances();
+
+        //validate the MP again from the same position
+        RP->getActuator()->setp_1(p_1 + 1000);
+        MPV.resetStatistics();
+        MPV.validateMotionProgram(MP);
+        RP->getActuator()->setp_1(p_1);
+
+        //the gesture shall have steps and distances, and the same in both validations
+        if(Nsteps<1 || Ndistances<1 ||
+                MPV.getNsteps()!=Nsteps || MPV.getNdistances()!=Ndistances) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the distances reused from the edges shall not be counted
+        TAdjacentRP& ARP = RP->getActuator()->AdjacentRPs[0];
+        if(ARP.Edge == NULL) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        ARP.Edge->calculated = false;
+        Ndistances = TActuator::getNdistances();
+        RP->getActuator()->distanceMin(ARP);
+        RP->getActuator()->distanceMin(ARP);
+        if(TActuator::getNdistances() != Ndistances + 1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+void TestMotionProgramValidator::test_revalidateMotionProgram()
+{
+    try {
+        //point the RPs 1 and 100 of the FMM and save their positions
+        TRoboticPositioner *RP1 = FMM.RPL[FMM.RPL.searchId(1)];
+        TRoboticPositioner *RP100 = FMM.RPL[FMM.RPL.searchId(100)];
+        RP1->getActuator()->enableQuantification();
+        RP100->getActuator()->enableQuantification();
+        double p_1_1 = RP1->getActuator()->getp_1();
+        double p_1_100 = RP100->getActuator()->getp_1();
+
+        //build a MP for move the RP1 to the origin in the first gesture,
+        //and the RP100 to the origin in the second gesture
+        RP1->getActuator()->setp_1(p_1_1 + 1000);
+        RP100->getActuator()->setp_1(p_1_100 + 1000);
+        TMotionProgram MP;
+        TMessageList *ML = new TMessageList();
+        TMessageInstruction *MI = new TMessageInstruction();
+        MI->setId(1);
+        RP1->getInstructionToGoToTheOrigin(MI->Instruction);
+        ML->Add(MI);
+        MP.Add(ML);
+        ML = new TMessageList();
+        MI = new TMessageInstruction();
+        MI->setId(100);
+        RP100->getInstructionToGoToTheOrigin(MI->Instruction);
+        ML->Add(MI);
+        MP.Add(ML);
+
+        //validate the MP recording the validation
+        TValidationRecord VR;
+        bool valid = MPV.validateMotionProgram(MP, NULL, &VR);
+        if(!valid || VR.Gestures.size()!=2 || VR.Nsimulated!=2) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the record shall contains the RP and its pairs sorted by Dmin
+        const TGestureRecord& GR = VR.Gestures[0];
+        if(!GR.valid || GR.Ids.size()!=1 || GR.Ids[0]!=1 || GR.Edges.size()<1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(unsigned int i=0; i<GR.Edges.size(); i++)
+            if(GR.Edges[i].Id!=1 || (i>0 && GR.Edges[i].Dmin<GR.Edges[i-1].Dmin)) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+
+        //the first gesture shall depend on the RP1 and its adjacents,
+        //and the second gesture shall not depend on the RP1
+        TVector<int> Ids;
+        Ids.Add(RP1->getActuator()->AdjacentRPs[0].RP->getActuator()->getId());
+        if(!GR.dependsOn(Ids)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        Ids.Clear();
+        Ids.Add(1);
+        if(!GR.dependsOn(Ids) || VR.Gestures[1].dependsOn(Ids)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //exclude the RP1 and revalidate the MP from the same positions
+        RP1->getActuator()->setp_1(p_1_1 + 1000);
+        RP100->getActuator()->setp_1(p_1_100 + 1000);
+        MP.excludeRP(1);
+        bool revalid = MPV.revalidateMotionProgram(MP, VR, Ids);
+        double p_1end_1 = RP1->getActuator()->getp_1();
+        double p_1end_100 = RP100->getActuator()->getp_1();
+
+        //only the first gesture shall be simulated
+        if(!revalid || VR.Nsimulated!=1 || !VR.Gestures[0].valid ||
+                VR.Gestures[0].Ids.size()!=0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //validate the edited MP from the same positions
+        RP1->getActuator()->setp_1(p_1_1 + 1000);
+        RP100->getActuator()->setp_1(p_1_100 + 1000);
+        valid = MPV.validateMotionProgram(MP);
+
+        //the results shall be the same
+        if(valid!=revalid || RP1->getActuator()->getp_1()!=p_1end_1 ||
+                RP100->getActuator()->getp_1()!=p_1end_100) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //restore the positions
+        RP1->getActuator()->setp_1(p_1_1);
+        RP100->getActuator()->setp_1(p_1_100);
+
+        //the record shall have a gesture for each gesture of the MP
+        MP.Add(new TMessageList());
+        try {
+            MPV.revalidateMotionProgram(MP, VR, Ids);
+            CPPUNIT_ASSERT(false);
+            return;
+        } catch(EImproperArgument&) {
+        }
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestMotionProgramValidator::test_revalidateAfterCollision()
+{
+    try {
+        //point the RPs 1 and 100 of the FMM and save their positions
+        TRoboticPositioner *RP1 = FMM.RPL[FMM.RPL.searchId(1)];
+        TRoboticPositioner *RP100 = FMM.RPL[FMM.RPL.searchId(100)];
+        RP1->getActuator()->enableQuantification();
+        RP100->getActuator()->enableQuantification();
+        double p_1_1 = RP1->getActuator()->getp_1();
+        double p___3_1 = RP1->getActuator()->getArm()->getp___3();
+        double p_1_100 = RP100->getActuator()->getp_1();
+
+        //search a position of the RP1 where it collides with its adjacents
+        TInstruction Collide;
+        double p___3max = floor(RP1->getActuator()->getArm()->getp___3max());
+        double p_1min = ceil(RP1->getActuator()->getp_1min());
+        double p_1max = floor(RP1->getActuator()->getp_1max());
+        for(int k=0; k<=36 && Collide.getName()!="MM"; k++) {
+            double p_1 = floor(p_1min + k*(p_1max - p_1min)/36);
+            RP1->getActuator()->setp_1(p_1);
+            RP1->getActuator()->getArm()->setp___3(p___3max);
+            if(RP1->getActuator()->thereIsCollisionWithAdjacent()) {
+                Collide.setName("MM");
+                Collide.Args.setCount(2);
+                Collide.Args[0] = p_1;
+                Collide.Args[1] = p___3max;
+            }
+        }
+        RP1->getActuator()->setp_1(p_1_1);
+        RP1->getActuator()->getArm()->setp___3(p___3_1);
+        if(Collide.getName() != "MM") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //build a MP for move the RP1 to the origin in the first gesture,
+        //and the RP100 to the origin in the second gesture
+        RP1->getActuator()->setp_1(p_1_1 + 1000);
+        RP100->getActuator()->setp_1(p_1_100 + 1000);
+        TMotionProgram MP;
+        TMessageList *ML = new TMessageList();
+        TMessageInstruction *MI1 = new TMessageInstruction();
+        MI1->setId(1);
+        RP1->getInstructionToGoToTheOrigin(MI1->Instruction);
+        TInstruction Origin = MI1->Instruction;
+        ML->Add(MI1);
+        MP.Add(ML);
+        ML = new TMessageList();
+        TMessageInstruction *MI = new TMessageInstruction();
+        MI->setId(100);
+        RP100->getInstructionToGoToTheOrigin(MI->Instruction);
+        ML->Add(MI);
+        MP.Add(ML);
+
+        //validate the MP recording the validation
+        TValidationRecord VR;
+        if(!MPV.validateMotionProgram(MP, NULL, &VR)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //make the RP1 collide in the first gesture and revalidate the MP
+        TVector<int> Ids;
+        Ids.Add(1);
+        MI1->Instruction = Collide;
+        RP1->getActuator()->setp_1(p_1_1 + 1000);
+        RP100->getActuator()->setp_1(p_1_100 + 1000);
+        if(MPV.revalidateMotionProgram(MP, VR, Ids)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        FMM.RPL.restoreAndPopQuantifys();
+
+        //the record of the second gesture shall be discarded
+        if(VR.Gestures[0].valid || VR.Gestures[1].valid) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //restore the first gesture and revalidate the MP again,
+        //indicating only the last modified RP
+        MI1->Instruction = Origin;
+        RP1->getActuator()->setp_1(p_1_1 + 1000);
+        RP100->getActuator()->setp_1(p_1_100 + 1000);
+        bool revalid = MPV.revalidateMotionProgram(MP, VR, Ids);
+        double p_1end_1 = RP1->getActuator()->getp_1();
+        double p_1end_100 = RP100->getActuator()->getp_1();
+
+        //both gestures shall be simulated
+        if(!revalid || VR.Nsimulated!=2 || !VR.Gestures[0].valid || !VR.Gestures[1].valid) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //validate the MP from the same positions
+        RP1->getActuator()->setp_1(p_1_1 + 1000);
+        RP100->getActuator()->setp_1(p_1_100 + 1000);
+        bool valid = MPV.validateMotionProgram(MP);
+
+        //the results shall be the same
+        if(valid!=revalid || RP1->getActuator()->getp_1()!=p_1end_1 ||
+                RP100->getActuator()->getp_1()!=p_1end_100) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //restore the positions
+        RP1->getActuator()->setp_1(p_1_1);
+        RP100->getActuator()->setp_1(p_1_100);
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestMotionProgramValidator::test_clustersAfterCollision()
+{
+    try {
+        //point the RPs 1 and 100 of the FMM and save their positions
+        TRoboticPositioner *RP1 = FMM.RPL[FMM.RPL.searchId(1)];
+        TRoboticPositioner *RP100 = FMM.RPL[FMM.RPL.searchId(100)];
+        double p_1_1 = RP1->getActuator()->getp_1();
+        double p___3_1 = RP1->getActuator()->getArm()->getp___3();
+        double p_1_100 = RP100->getActuator()->getp_1();
+
+        //search a position of the RP1 where it collides with its adjacents
+        TInstruction Collide;
+        double p___3max = floor(RP1->getActuator()->getArm()->getp___3max());
+        double p_1min = ceil(RP1->getActuator()->getp_1min());
+        double p_1max = floor(RP1->getActuator()->getp_1max());
+        for(int k=0; k<=36 && Collide.getName()!="MM"; k++) {
+            double p_1 = floor(p_1min + k*(p_1max - p_1min)/36);
+            RP1->getActuator()->setp_1(p_1);
+            RP1->getActuator()->getArm()->setp___3(p___3max);
+            if(RP1->getActuator()->thereIsCollisionWithAdjacent()) {
+                Collide.setName("MM");
+                Collide.Args.setCount(2);
+                Collide.Args[0] = p_1;
+                Collide.Args[1] = p___3max;
+            }
+        }
+        RP1->getActuator()->setp_1(p_1_1);
+        RP1->getActuator()->getArm()->setp___3(p___3_1);
+        if(Collide.getName() != "MM") {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //build a MP of a gesture, where the RP1 collides
+        //and the RP100 (in other cluster) moves far
+        RP100->getActuator()->setp_1(p_1min);
+        TMotionProgram MP;
+        TMessageList *ML = new TMessageList();
+        TMessageInstruction *MI = new TMessageInstruction();
+        MI->setId(1);
+        MI->Instruction = Collide;
+        ML->Add(MI);
+        MI = new TMessageInstruction();
+        MI->setId(100);
+        MI->Instruction.setName("M1");
+        MI->Instruction.Args.setCount(1);
+        MI->Instruction.Args[0] = p_1max;
+        ML->Add(MI);
+        MP.Add(ML);
+
+        //validate the MP recording the clearance profiles
+        TClearanceProfileList CPL;
+        if(MPV.validateMotionProgram(MP, &CPL)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        double p_1end_100 = RP100->getActuator()->getp_1();
+
+        //determines the time of the last sample of each RP
+        double tlast_1 = -1, tlast_100 = -1;
+        for(int i=0; i<CPL.getCount(); i++) {
+            const TClearanceProfile& CP = CPL[i];
+            for(unsigned int j=0; j<CP.t.size(); j++) {
+                if(CP.Id==1 && CP.t[j]>tlast_1)
+                    tlast_1 = CP.t[j];
+                if(CP.Id==100 && CP.t[j]>tlast_100)
+                    tlast_100 = CP.t[j];
+            }
+        }
+
+        //the RP100 shall not be simulated beyond the first collision,
+        //and shall remain in its position in the time of the collision
+        if(tlast_1<0 || tlast_100<0 || tlast_100>tlast_1 || p_1end_100>=p_1max) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //restore the positions
+        RP1->getActuator()->setp_1(p_1_1);
+        RP1->getActuator()->getArm()->setp___3(p___3_1);
+        RP100->getActuator()->setp_1(p_1_100);
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestMotionProgramValidator::test_setComments()
+{
+    try {
+        //point the RP 1 of the FMM and save its position
+        TRoboticPositioner *RP1 = FMM.RPL[FMM.RPL.searchId(1)];
+        RP1->getActuator()->enableQuantification();
+        double p_1_1 = RP1->getActuator()->getp_1();
+
+        //build a MP for move the RP1 to the origin
+        RP1->getActuator()->setp_1(p_1_1 + 1000);
+        TMotionProgram MP;
+        TMessageList *ML = new TMessageList();
+        TMessageInstruction *MI = new TMessageInstruction();
+        MI->setId(1);
+        RP1->getInstructionToGoToTheOrigin(MI->Instruction);
+        ML->Add(MI);
+        MP.Add(ML);
+
+        //validate the MP recording the validation
+        TValidationRecord VR;
+        bool valid = MPV.validateMotionProgram(MP, NULL, &VR);
+        RP1->getActuator()->setp_1(p_1_1);
+        if(!valid) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //copy the comments (Dmin, Dend) to a MP without comments
+        string Dmins, Dends;
+        MP.getDminMCStext(Dmins, "pos", 0);
+        MP.getDendMCStext(Dends, "pos", 0);
+        TMotionProgram MP_;
+        ML = new TMessageList();
+        MI = new TMessageInstruction();
+        MI->setId(1);
+        MI->Instruction = MP[0][0].Instruction;
+        ML->Add(MI);
+        MP_.Add(ML);
+        TValidationRecord VR_;
+        VR_.setComments(MP_);
+        if(VR_.Gestures.size()!=1 || VR_.Gestures[0].valid) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        MP_.setDminMCStext(Dmins);
+        MP_.setDendMCStext(Dends);
+
+        //the record built from the comments shall be equal to the record
+        VR_.setComments(MP_);
+        if(VR_.Gestures.size()!=1 || !VR_.Gestures[0].valid ||
+                VR_.Gestures[0].Ids!=VR.Gestures[0].Ids ||
+                VR_.Gestures[0].Edges.size()!=VR.Gestures[0].Edges.size()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(unsigned int i=0; i<VR.Gestures[0].Edges.size(); i++) {
+            const TEdgeClearance& E = VR.Gestures[0].Edges[i];
+            const TEdgeClearance& E_ = VR_.Gestures[0].Edges[i];
+            if(E_.Id!=E.Id || E_.IdA!=E.IdA || E_.isEA!=E.isEA ||
+                    fabs(E_.Dmin - E.Dmin) > 1e-9 || fabs(E_.Dend - E.Dend) > 1e-9) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+
+        //the comments of other MP shall be rejected
+        MP_.Add(new TMessageList());
+        try {
+            MP_.setDminMCStext(Dmins);
+            CPPUNIT_ASSERT(false);
+            return;
+        } catch(EImproperArgument&) {
+        }
+    }
+    catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -40,6 +40,14 @@ class TestMotionProgramValidator : public CppUnit::TestFixture
     //add test methods
     CPPUNIT_TEST(test_validateMotionProgram);
     CPPUNIT_TEST(test_checkPairPPDP);
+    CPPUNIT_TEST(test_ClearanceProfile);
+    CPPUNIT_TEST(test_segregateRPsInClusters);
+    CPPUNIT_TEST(test_Overlay);
+    CPPUNIT_TEST(test_statistics);
+    CPPUNIT_TEST(test_revalidateMotionProgram);
+    CPPUNIT_TEST(test_revalidateAfterCollision);
+    CPPUNIT_TEST(test_clustersAfterCollision);
+    CPPUNIT_TEST(test_setComments);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -63,6 +71,14 @@ public:
 
     void test_validateMotionProgram();
     void test_checkPairPPDP();
+    void test_ClearanceProfile();
+    void test_segregateRPsInClusters();
+    void test_Overlay();
+    void test_statistics();
+    void test_revalidateMotionProgram();
+    void test_revalidateAfterCollision();
+    void test_clustersAfterCollision();
+    void test_setComments();
 };
 
 #endif // TEST_MotionProgramValidator_H
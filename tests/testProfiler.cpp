@@ -0,0 +1,168 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//---------------------------------------------------------------------------
+//File: testProfiler.cpp
+//Content: test for the module Profiler
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testProfiler.h"
+#include "../src/Profiler.h"
+#include "../src/Exceptions.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <jsoncpp/json/json.h>
+#include <thread>
+#include <vector>
+
+using namespace Profiling;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestProfiler);
+
+//overide setUp(), init data, etc
+void TestProfiler::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestProfiler::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+//add N samples of each profiled function, with time 1 ns
+static void addSamples(unsigned int N)
+{
+    for(unsigned int i=0; i<N; i++)
+        for(int f=0; f<pfCount; f++)
+            addProfileSample(TProfiledFunction(f), 1);
+}
+
+void TestProfiler::test_getProfile()
+{
+    try {
+        resetProfile();
+
+        //add samples from the current thread and from other threads,
+        //some of which has finished before aggregate the counters
+        addSamples(10);
+        std::vector<std::thread> threads;
+        for(unsigned int i=0; i<4; i++)
+            threads.push_back(std::thread(addSamples, 100));
+        for(unsigned int i=0; i<threads.size(); i++)
+            threads[i].join();
+
+        TProfileCounters PC;
+        getProfile(PC);
+        for(int f=0; f<pfCount; f++) {
+            if(PC.Ncalls[f] != 410) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            if(PC.time[f] != 410) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+        if(PC.Nthreads != 5) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //after reset, the counters of all threads should be zero
+        resetProfile();
+        getProfile(PC);
+        for(int f=0; f<pfCount; f++)
+            if(PC.Ncalls[f]!=0 || PC.time[f]!=0) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        if(PC.Nthreads != 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the timer should add a call to the counters
+        {
+            TProfileTimer T(pfSearchSolution);
+        }
+        getProfile(PC);
+        if(PC.Ncalls[pfSearchSolution] != 1 || PC.Ncalls[pfCalculateTfmin] != 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestProfiler::test_getProfileText()
+{
+    try {
+        resetProfile();
+        addSamples(3);
+
+        std::string str;
+        getProfileText(str);
+
+        Json::Value root;
+        Json::Reader reader;
+        if(!reader.parse(str, root)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        if(root["enabled"].asBool() != profileIsEnabled()) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        const Json::Value& functions = root["functions"];
+        if(functions.size() != (unsigned int)pfCount) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(int f=0; f<pfCount; f++) {
+            if(functions[f]["name"].asString() != profiledFunctionName(TProfiledFunction(f))) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            if(functions[f]["calls"].asUInt64() != 3) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+            if(functions[f]["mean_ns"].asDouble() != 1) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+        resetProfile();
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+//---------------------------------------------------------------------------
@@ -24,6 +24,7 @@
 
 #include "testRoboticPositionerList1.h"
 #include "../src/RoboticPositionerList1.h"
+#include "../src/ExclusionAreaList.h"
 //#include "cppunit_assert_emulator.h" //Qt only.
 
 #include <iostream>
@@ -50,3 +51,132 @@ void TestRoboticPositionerList1::test_()
     CPPUNIT_ASSERT(true);
 }
 
+//search linearly the first RP with the indicated Id
+static int searchIdLinearly(const TRoboticPositionerList1& RPL, int Id)
+{
+    int i = 0;
+    while(i<RPL.getCount() && RPL[i]->getActuator()->getId()!=Id)
+        i++;
+    return i;
+}
+
+void TestRoboticPositionerList1::test_search()
+{
+    //build a list with enough RPs to be indexed
+    TRoboticPositionerList1 RPL;
+    for(int i=0; i<40; i++)
+        RPL.Add(new TRoboticPositioner(i+1, TDoublePoint(i*100, 0)));
+
+    //for several modifications of the list
+    TRoboticPositioner *RP_ = new TRoboticPositioner(100, TDoublePoint(0, 100));
+    for(int m=0; m<8; m++) {
+        switch(m) {
+        case 1: delete RPL[3]; RPL.Delete(3); break; //delete a RP
+        case 2: RPL.Insert(0, RP_); break; //insert a RP in the first position
+        case 3: RP_->getActuator()->setId(200); break; //change the Id of a RP
+        case 4: { //swap two RPs
+            TRoboticPositioner *aux = RPL[1];
+            RPL.Set(1, RPL[2]);
+            RPL.Set(2, aux);
+            break;
+        }
+        case 5: RPL.Invert(); break; //reorder the RPs by an inherited method
+        case 6: RPL.updateIndex(); break; //update the index after reorder
+        case 7: RPL.Add(new TRoboticPositioner(300, TDoublePoint(0, 200))); break; //add a RP
+        }
+
+        //check the search methods for the Ids in and out of the list
+        for(int Id=1; Id<=200; Id++) {
+            int i = searchIdLinearly(RPL, Id);
+            if(RPL.searchId(Id) != i) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+        for(int i=0; i<RPL.getCount(); i++) {
+            TRoboticPositioner *RP = RPL[i];
+            if(RPL.search(RP) != i || RPL.search(RP->getActuator()) != i || RPL.Search(RP) != i) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+    }
+
+    //check that a RP out of the list is not found
+    TRoboticPositioner RP(1000, TDoublePoint(0, -100));
+    if(RPL.search(&RP) != RPL.getCount() || RPL.Search(&RP) != RPL.getCount()) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //check the search of free Ids through the index
+    if(RPL.searchFirstFreeId(1) != 4 || RPL.searchFirstFreeId(41) != 41 ||
+            RPL.searchFirstFreeId(200) != 201) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    RPL.Destroy();
+    CPPUNIT_ASSERT(true);
+}
+
+void TestRoboticPositionerList1::test_Edges()
+{
+    //build a list of adjacent RPs
+    TRoboticPositionerList1 RPL;
+    RPL.Add(new TRoboticPositioner(1, TDoublePoint(-60.3, 87.035553)));
+    RPL.Add(new TRoboticPositioner(2, TDoublePoint(-40.2, 87.035553)));
+    RPL.Add(new TRoboticPositioner(3, TDoublePoint(-50.25, 104.44)));
+    TExclusionAreaList EAL;
+    RPL.assimilate(EAL);
+
+    //check that each slot shares its edge with its symmetric slot
+    for(int i=0; i<RPL.getCount(); i++) {
+        TRoboticPositioner *RP = RPL[i];
+        TAdjacentRPList& AdjacentRPs = RP->getActuator()->AdjacentRPs;
+        if(AdjacentRPs.getCount() <= 0) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(int j=0; j<AdjacentRPs.getCount(); j++) {
+            TAdjacentRPList& AdjacentRPsA = AdjacentRPs[j].RP->getActuator()->AdjacentRPs;
+            int k = 0;
+            while(k<AdjacentRPsA.getCount() && AdjacentRPsA[k].RP!=RP)
+                k++;
+            if(k>=AdjacentRPsA.getCount() || AdjacentRPs[j].Edge==NULL ||
+                    AdjacentRPsA[k].Edge!=AdjacentRPs[j].Edge) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+    }
+
+    //check that a clon of a RP is unlinked from the graph
+    TRoboticPositioner *RP_ = new TRoboticPositioner(RPL[0]);
+    for(int j=0; j<RP_->getActuator()->AdjacentRPs.getCount(); j++)
+        if(RP_->getActuator()->AdjacentRPs[j].Edge != NULL) {
+            delete RP_;
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    delete RP_;
+
+    //check that a clon of the list has its own edges
+    TRoboticPositionerList1 RPL_;
+    RPL_.Clone(&RPL);
+    RPL_.assimilate(EAL);
+    for(int i=0; i<RPL_.getCount(); i++) {
+        TAdjacentRPList& AdjacentRPs = RPL_[i]->getActuator()->AdjacentRPs;
+        for(int j=0; j<AdjacentRPs.getCount(); j++) {
+            TAdjacencyEdge *E = AdjacentRPs[j].Edge;
+            if(E==NULL || (E->RP1!=RPL_[i] && E->RP2!=RPL_[i])) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+    }
+
+    RPL_.Destroy();
+    RPL.Destroy();
+    CPPUNIT_ASSERT(true);
+}
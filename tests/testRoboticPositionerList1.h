@@ -35,6 +35,8 @@ class TestRoboticPositionerList1 : public CppUnit::TestFixture
 
     //add test methods
     CPPUNIT_TEST(test_);
+    CPPUNIT_TEST(test_search);
+    CPPUNIT_TEST(test_Edges);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -47,6 +49,8 @@ public:
 
     //test methods
     void test_();
+    void test_search();
+    void test_Edges();
 };
 
 #endif // TEST_RoboticPositionerList1_H
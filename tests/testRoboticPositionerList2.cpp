@@ -24,6 +24,7 @@
 
 #include "testRoboticPositionerList2.h"
 #include "../src/RoboticPositionerList2.h"
+#include "../src/ExclusionAreaList.h"
 //#include "cppunit_assert_emulator.h" //Qt only.
 
 #include <iostream>
@@ -50,3 +51,33 @@ void TestRoboticPositionerList2::test_()
     CPPUNIT_ASSERT(true);
 }
 
+
+void TestRoboticPositionerList2::test_searchNearestPositioners()
+{
+    //build a list of RPs and map them
+    TRoboticPositionerList2 RPL;
+    RPL.Add(new TRoboticPositioner(1, TDoublePoint(-60.3, 87.035553)));
+    RPL.Add(new TRoboticPositioner(2, TDoublePoint(-40.2, 87.035553)));
+    RPL.Add(new TRoboticPositioner(3, TDoublePoint(-50.25, 104.44)));
+    RPL.Add(new TRoboticPositioner(4, TDoublePoint(100, 0)));
+    TExclusionAreaList EAL;
+    RPL.assimilate(EAL);
+
+    //search the nearest RPs to a point
+    TItemsList<TRoboticPositioner*> RPs;
+    RPL.searchNearestPositioners(RPs, TDoublePoint(-41, 88), 2);
+    if(RPs.getCount() != 2 || RPs[0] != RPL[1] || RPs[1] != RPL[2]) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //search the RPs whose domain can contain a point
+    RPL.searchPositioners(RPs, TDoublePoint(-50.25, 92.84), 1);
+    if(RPs.getCount() != 3 || RPs[0] != RPL[0] || RPs[1] != RPL[1] || RPs[2] != RPL[2]) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    RPL.Destroy();
+    CPPUNIT_ASSERT(true);
+}
@@ -35,6 +35,7 @@ class TestRoboticPositionerList2 : public CppUnit::TestFixture
 
     //add test methods
     CPPUNIT_TEST(test_);
+    CPPUNIT_TEST(test_searchNearestPositioners);
 
     //finish the process
     CPPUNIT_TEST_SUITE_END();
@@ -47,6 +48,7 @@ public:
 
     //test methods
     void test_();
+    void test_searchNearestPositioners();
 };
 
 #endif // TEST_RoboticPositionerList2_H
@@ -0,0 +1,194 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//---------------------------------------------------------------------------
+//---------------------------------------------------------------------------
+//File: testSpatialGrid.cpp
+//Content: test for the module SpatialGrid
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testSpatialGrid.h"
+#include "../src/SpatialGrid.h"
+#include "../src/Exceptions.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <algorithm> //std::sort
+#include <cstdlib> //rand, srand
+#include <utility> //std::pair
+
+using namespace Mathematics;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSpatialGrid);
+
+//overide setUp(), init data, etc
+void TestSpatialGrid::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestSpatialGrid::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+//get a random number in [xmin, xmax]
+static double randomIn(double xmin, double xmax)
+{
+    return xmin + (xmax - xmin)*double(rand())/double(RAND_MAX);
+}
+
+void TestSpatialGrid::test_searchRange()
+{
+    srand(1);
+
+    //for several sets of random circles
+    for(int n=0; n<100; n++) {
+        std::vector<TDoublePoint> Centers(n);
+        std::vector<double> Radii(n);
+        for(int k=0; k<n; k++) {
+            Centers[k] = TDoublePoint(randomIn(-100, 100), randomIn(-100, 100));
+            Radii[k] = randomIn(0, 10);
+        }
+        TSpatialGrid G;
+        G.build(Centers, Radii, randomIn(1, 30));
+
+        //compare the search by the grid with the linear search
+        for(int t=0; t<10; t++) {
+            TDoublePoint P(randomIn(-120, 120), randomIn(-120, 120));
+            double r = randomIn(0, 40);
+
+            std::vector<int> indices;
+            G.searchRange(indices, P, r);
+
+            std::vector<int> expected;
+            for(int k=0; k<n; k++)
+                if(Mod(Centers[k] - P) < r + Radii[k])
+                    expected.push_back(k);
+
+            if(indices != expected) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+    }
+
+    //check the preconditions
+    try {
+        TSpatialGrid G;
+        G.build(std::vector<TDoublePoint>(1), std::vector<double>(1), 0);
+        CPPUNIT_ASSERT(false);
+        return;
+    } catch(EImproperArgument&) {
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestSpatialGrid::test_searchNearest()
+{
+    srand(2);
+
+    //for several sets of random circles
+    for(int n=0; n<100; n++) {
+        std::vector<TDoublePoint> Centers(n);
+        std::vector<double> Radii(n, 0);
+        for(int k=0; k<n; k++)
+            Centers[k] = TDoublePoint(randomIn(-100, 100), randomIn(-100, 100));
+        //repeat some centers for check the order of equal distances
+        if(n > 2)
+            Centers[n-1] = Centers[0];
+        TSpatialGrid G;
+        G.build(Centers, Radii, randomIn(1, 30));
+
+        //compare the search by the grid with the linear search
+        for(int t=0; t<10; t++) {
+            TDoublePoint P(randomIn(-300, 300), randomIn(-300, 300));
+            int k = rand()%(n + 2);
+
+            std::vector<int> indices;
+            G.searchNearest(indices, P, k);
+
+            std::vector<std::pair<double, int> > pairs;
+            for(int l=0; l<n; l++)
+                pairs.push_back(std::pair<double, int>(Mod(Centers[l] - P), l));
+            std::sort(pairs.begin(), pairs.end());
+            std::vector<int> expected;
+            for(int l=0; l<n && l<k; l++)
+                expected.push_back(pairs[l].second);
+
+            if(indices != expected) {
+                CPPUNIT_ASSERT(false);
+                return;
+            }
+        }
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+void TestSpatialGrid::test_update()
+{
+    std::vector<TDoublePoint> Centers;
+    std::vector<double> Radii;
+    for(int k=0; k<10; k++) {
+        Centers.push_back(TDoublePoint(10*k, -5*k));
+        Radii.push_back(k);
+    }
+
+    //the first update builds the grid
+    TSpatialGrid G;
+    if(!G.update(Centers, Radii, 20) || G.getCount() != 10) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the same circles keep the grid
+    if(G.update(Centers, Radii, 20)) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //other center, radius or side rebuild the grid
+    Centers[3].x += 100;
+    if(!G.update(Centers, Radii, 20)) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    Radii[7] = 0;
+    if(!G.update(Centers, Radii, 20) || G.update(Centers, Radii, 20)) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+    if(!G.update(Centers, Radii, 25)) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    //the rebuilt grid searchs the new circles
+    std::vector<int> indices;
+    G.searchRange(indices, TDoublePoint(130, -15), 1);
+    if(indices.size() != 1 || indices[0] != 3) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2012-2017 Isaac Morales Durán. All rights reserved.
+// Institute of Astrophysics of Andalusia, IAA-CSIC
+//
+// This file is part of FMPT (Fiber MOS Positioning Tools)
+//
+// FMPT is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+//---------------------------------------------------------------------------
+//File: testWorkers.cpp
+//Content: test for the module Workers
+//Author: Isaac Morales Durán
+//---------------------------------------------------------------------------
+
+#include "testWorkers.h"
+#include "../src/Workers.h"
+//#include "cppunit_assert_emulator.h" //Qt only.
+
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <atomic>
+
+using namespace Workers;
+
+//---------------------------------------------------------------------------
+
+//commented in Qt:
+CPPUNIT_TEST_SUITE_REGISTRATION(TestWorkers);
+
+//overide setUp(), init data, etc
+void TestWorkers::setUp() {
+}
+
+//overide tearDown(), free allocated memory, etc
+void TestWorkers::tearDown() {
+}
+
+//---------------------------------------------------------------------------
+
+void TestWorkers::test_getNworkers()
+{
+    try {
+        //the number of workers should be limited by the number of tasks
+        if(isWorker() || getNworkers(4, 2)!=2 || getNworkers(4, 8)!=4 || getNworkers(4, 0)!=1) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        //by default, the number of workers should be the number of cores
+        int Ncores = int(std::thread::hardware_concurrency());
+        if(getNworkers(0, 1) != 1 || (Ncores>1 && Ncores<1000 && getNworkers(0, 1000)!=Ncores)) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //the loops of a worker should be executed sequentially,
+        //and the mark should not affect to other threads
+        bool worker = false;
+        int Nworkers = 0;
+        std::thread T([&]() {
+            setWorker(true);
+            worker = isWorker();
+            Nworkers = getNworkers(4, 8);
+        });
+        T.join();
+        if(!worker || Nworkers!=1 || isWorker() || getNworkers(4, 8)!=4) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //after unmark the thread, the loops should be distributed again
+        setWorker(true);
+        Nworkers = getNworkers(4, 8);
+        setWorker(false);
+        if(Nworkers!=1 || getNworkers(4, 8)!=4) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+//---------------------------------------------------------------------------
+
+void TestWorkers::test_TWorkerPool()
+{
+    try {
+        //the pool should execute all iterations of several loops,
+        //in worker threads
+        TWorkerPool Pool(4);
+        if(Pool.getNthreads() != 4) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+        for(int n=0; n<20; n++) {
+            std::vector<int> executed(n, 0);
+            std::vector<char> workers(n, false);
+            Pool.run(n, [&](int k) {
+                executed[k]++;
+                workers[k] = isWorker();
+            });
+            for(int k=0; k<n; k++)
+                if(executed[k]!=1 || (n>1 && !workers[k])) {
+                    CPPUNIT_ASSERT(false);
+                    return;
+                }
+        }
+
+        //the pool should rethrow the exception of the first iteration
+        //which has failed, and continue being usable
+        int failed = -1;
+        try {
+            Pool.run(8, [&](int k) {
+                if(k == 3 || k == 6)
+                    throw std::runtime_error(k == 3 ? "3" : "6");
+            });
+        } catch(std::runtime_error& e) {
+            failed = (std::string(e.what()) == "3") ? 3 : 6;
+        }
+        std::atomic<int> count(0);
+        Pool.run(8, [&](int) {count++;});
+        if(failed!=3 || count.load()!=8) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+
+        //a pool without threads should execute the loops in the calling thread
+        TWorkerPool Seq(1);
+        std::vector<char> workers(4, true);
+        Seq.run(4, [&](int k) {workers[k] = isWorker();});
+        if(Seq.getNthreads()!=0 || workers[0] || workers[3]) {
+            CPPUNIT_ASSERT(false);
+            return;
+        }
+    } catch(...) {
+        CPPUNIT_ASSERT(false);
+        return;
+    }
+
+    CPPUNIT_ASSERT(true);
+}
+
+//---------------------------------------------------------------------------